@@ -0,0 +1,200 @@
+// 합성 손 동작 부하 테스트
+// HandSynthesizer로 랜드마크 스트림을 만들어 배치 경로(predictBatch, recognizeBatch)에
+// 바로 넣고 생성/추론 처리량과 규칙 기반 인식 일치율을 출력합니다.
+// 마지막으로 프레임을 여러 스트림에 돌아가며 나눠 StreamTable 상태 갱신 비용을 잽니다.
+//
+//   make hand-loadgen && ./build/hand_loadgen [--frames N] [--batch N] [--hands 1|2]
+//                                            [--jitter 값] [--dropout 값] [--seed N] [--streams N]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "hand_synth.h"
+#include "sign_recognition.h"
+#include "stream_table.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    int frames = 200000;
+    int batch = 256;
+    int streams = 256;
+    HandSynthConfig synth;
+};
+
+double elapsedSeconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 합성 제스처 → 규칙 기반 인식 결과 id (규칙에 없는 제스처는 0: 감지되지 않음)
+int expectedRuleId(int gesture) {
+    switch (static_cast<SynthGesture>(gesture)) {
+    case SynthGesture::Open: return 1;
+    case SynthGesture::Fist: return 2;
+    case SynthGesture::Point: return 3;
+    case SynthGesture::Victory: return 4;
+    case SynthGesture::Three: return 5;
+    default: return 0;
+    }
+}
+
+// recognizeBatch JSON에서 "id" 값을 순서대로 추출
+void parseIds(const std::string& json, std::vector<int>& ids) {
+    ids.clear();
+    size_t pos = 0;
+    while ((pos = json.find("\"id\":", pos)) != std::string::npos) {
+        pos += 5;
+        ids.push_back(std::atoi(json.c_str() + pos));
+    }
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        const char* value = argv[i + 1];
+        if (arg == "--frames") {
+            options.frames = std::max(1, std::atoi(value));
+        } else if (arg == "--batch") {
+            options.batch = std::max(1, std::atoi(value));
+        } else if (arg == "--streams") {
+            options.streams = std::max(1, std::atoi(value));
+        } else if (arg == "--hands") {
+            options.synth.hands = std::atoi(value);
+        } else if (arg == "--jitter") {
+            options.synth.jitter = static_cast<float>(std::atof(value));
+        } else if (arg == "--dropout") {
+            options.synth.dropoutRate = static_cast<float>(std::atof(value));
+        } else if (arg == "--seed") {
+            options.synth.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (argc % 2 == 0) {
+        std::fprintf(stderr, "missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    const int frames = options.frames;
+    const int batch = options.batch;
+    std::vector<float> features(static_cast<size_t>(batch) * SYNTH_FEATURE_FLOATS);
+    std::vector<float> xy(static_cast<size_t>(batch) * SYNTH_XY_FLOATS);
+    std::vector<int32_t> labels(batch);
+    std::vector<int32_t> classes(batch);
+
+    // 1. 생성기 단독 처리량
+    {
+        HandSynthesizer synth(options.synth);
+        Clock::time_point start = Clock::now();
+        for (int done = 0; done < frames; done += batch) {
+            synth.generateFeatures(features.data(), std::min(batch, frames - done));
+        }
+        double seconds = elapsedSeconds(start);
+        std::printf("generator      %8.2f Mframes/s (%d hand%s)\n", frames / seconds * 1e-6,
+                    synth.config().hands, synth.config().hands > 1 ? "s" : "");
+    }
+
+    // 2. 126차원 특징 → predictBatch (GEMM 경로)
+    {
+        HandSynthesizer synth(options.synth);
+        SignRecognition recognition;
+        std::vector<int> histogram(16, 0);
+        double inferSeconds = 0.0;
+        for (int done = 0; done < frames; done += batch) {
+            int count = std::min(batch, frames - done);
+            synth.generateFeatures(features.data(), count);
+
+            Clock::time_point start = Clock::now();
+            recognition.predictBatch(reinterpret_cast<uintptr_t>(features.data()), count,
+                                     reinterpret_cast<uintptr_t>(classes.data()));
+            inferSeconds += elapsedSeconds(start);
+            for (int f = 0; f < count; f++) histogram[std::min(classes[f], 15)]++;
+        }
+        std::printf("predictBatch   %8.2f Mframes/s, classes:", frames / inferSeconds * 1e-6);
+        for (int c = 0; c < 16; c++) {
+            if (histogram[c] > 0) std::printf(" %d=%d", c, histogram[c]);
+        }
+        std::printf("\n");
+    }
+
+    // 3. 2D 랜드마크 → recognizeBatch (특징 추출 + 심층 모델 + 규칙), 규칙 제스처 일치율
+    {
+        HandSynthesizer synth(options.synth);
+        SignRecognizer recognizer;
+        recognizer.initialize();
+        int recognizeFrames = std::min(frames, 20000);  // 프레임당 심층 모델을 돌리므로 일부만
+        int labelled = 0;
+        int matched = 0;
+        double inferSeconds = 0.0;
+        std::vector<int> ids;
+
+        for (int done = 0; done < recognizeFrames; done += batch) {
+            int count = std::min(batch, recognizeFrames - done);
+            synth.generateRecognizerFrames(xy.data(), count, labels.data());
+
+            Clock::time_point start = Clock::now();
+            std::string json = recognizer.recognizeBatch(xy.data(), count, SYNTH_XY_FLOATS);
+            inferSeconds += elapsedSeconds(start);
+
+            parseIds(json, ids);
+            for (int f = 0; f < count && f < static_cast<int>(ids.size()); f++) {
+                if (labels[f] < 0 || expectedRuleId(labels[f]) == 0) continue;
+                labelled++;
+                matched += (ids[f] == expectedRuleId(labels[f]));
+            }
+        }
+        std::printf("recognizeBatch %8.2f kframes/s, rule gesture agreement %.1f%% (%d frames)\n",
+                    recognizeFrames / inferSeconds * 1e-3, labelled > 0 ? 100.0 * matched / labelled : 0.0,
+                    labelled);
+    }
+
+    // 4. 다중 스트림 상태 갱신 (One-Euro 평활 + 기록 링 + 결과 누적), 30fps 타임스탬프
+    {
+        HandSynthesizer synth(options.synth);
+        StreamTable table;
+        std::vector<StreamHandle> handles(options.streams);
+        for (StreamHandle& handle : handles) handle = table.open(0.0);
+        std::vector<float> filtered(StreamTable::LANDMARK_VALUES);
+        double stateSeconds = 0.0;
+        int smoothedAgreement = 0;
+        int labelled = 0;
+
+        for (int done = 0; done < frames; done += batch) {
+            int count = std::min(batch, frames - done);
+            synth.generateRecognizerFrames(xy.data(), count, labels.data());
+
+            Clock::time_point start = Clock::now();
+            for (int f = 0; f < count; f++) {
+                int frame = done + f;
+                StreamHandle handle = handles[frame % options.streams];
+                double timestampMs = (frame / options.streams) * (1000.0 / 30.0);
+                table.pushLandmarks(handle, xy.data() + static_cast<size_t>(f) * SYNTH_XY_FLOATS,
+                                    SYNTH_XY_FLOATS, timestampMs, filtered.data());
+                if (labels[f] >= 0) {
+                    labelled++;
+                    smoothedAgreement += (table.pushResult(handle, labels[f], 1.0f) == labels[f]);
+                }
+            }
+            stateSeconds += elapsedSeconds(start);
+        }
+        int evicted = table.evictIdle(1e12);
+        std::printf("streamTable    %8.1f ns/frame over %d streams, smoothed label agreement %.1f%%, evicted %d\n",
+                    stateSeconds / frames * 1e9, options.streams,
+                    labelled > 0 ? 100.0 * smoothedAgreement / labelled : 0.0, evicted);
+    }
+    return 0;
+}
@@ -0,0 +1,294 @@
+// 네이티브 커널 벤치마크
+// 커널별 실행 시간과 하드웨어 카운터(perf_event_open), 해석적 FLOP/바이트 수로
+// IPC, 달성 GFLOP/s, 연산 강도를 계산하고 기기 최고치(루프라인)와 비교합니다.
+//
+//   make native-bench && ./build/native_bench [--kernel 이름] [--min-time 초]
+//                                            [--peak-gflops 값] [--peak-gbs 값]
+//
+// 최고치를 주지 않으면 시작 시 AVX mul+add 루프와 순차 읽기 루프로 측정합니다.
+// 엔진 커널이 FMA를 쓰지 않으므로 연산 최고치도 mul+add 기준입니다.
+// 대역폭 지붕은 두 단계입니다: 작업 집합이 CACHE_ROOF_BYTES 이하인 커널(예: 제스처 MLP 가중치)은
+// 캐시 읽기 대역폭, 그보다 큰 커널은 메모리(DRAM) 읽기 대역폭과 비교합니다.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <immintrin.h>
+#include "mlp_model.h"
+#include "perf_counters.h"
+#include "sign_recognition.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string kernel;
+    double minTime = 0.3;
+    double peakGflops = 0.0;
+    double peakGbs = 0.0;
+};
+
+// 캐시 지붕 측정 버퍼이자 캐시 상주로 보는 작업 집합 상한 (대부분의 코어에서 L2 안)
+constexpr size_t CACHE_ROOF_BYTES = 256 * 1024;
+constexpr size_t DRAM_ROOF_BYTES = 64u << 20;
+
+// 벤치마크 대상: run() 한 번에 해당하는 해석적 FLOP/바이트 수
+// bytes는 커널이 최소한 읽고 써야 하는 데이터(가중치, 입력, 출력) 기준이며,
+// workingSet은 반복 실행 사이에 캐시에 남을 수 있는 데이터 크기입니다.
+struct Kernel {
+    std::string name;
+    double flops;
+    double bytes;
+    double workingSet;
+    std::function<void()> run;
+};
+
+struct Measurement {
+    double seconds = 0.0;  // run() 1회당
+    long runs = 0;
+    PerfSample counters;
+};
+
+volatile float sink;
+
+double elapsedSeconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+Measurement measure(const Kernel& kernel, PerfCounters& perf, double minTime) {
+    // 캐시/분기 예측기 예열
+    kernel.run();
+
+    Measurement result;
+    perf.start();
+    Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        kernel.run();
+        result.runs++;
+        elapsed = elapsedSeconds(start);
+    } while (elapsed < minTime);
+    result.counters = perf.stop();
+    result.seconds = elapsed / result.runs;
+    return result;
+}
+
+// 독립 누적기 12개의 mul+add 체인 (지연 시간을 숨겨 처리량 한계 측정)
+double measurePeakGflops() {
+    constexpr int CHAINS = 12;
+    constexpr long ITERATIONS = 20000000;
+    __m256 acc[CHAINS];
+    for (int i = 0; i < CHAINS; i++) acc[i] = _mm256_set1_ps(1.0f + i * 0.01f);
+    const __m256 m = _mm256_set1_ps(0.999f);
+    const __m256 c = _mm256_set1_ps(0.001f);
+
+    Clock::time_point start = Clock::now();
+    for (long n = 0; n < ITERATIONS; n++) {
+        for (int i = 0; i < CHAINS; i++) acc[i] = _mm256_add_ps(_mm256_mul_ps(acc[i], m), c);
+    }
+    double seconds = elapsedSeconds(start);
+
+    __m256 total = acc[0];
+    for (int i = 1; i < CHAINS; i++) total = _mm256_add_ps(total, acc[i]);
+    sink = _mm256_cvtss_f32(total);
+
+    return 2.0 * SIMD_WIDTH * CHAINS * ITERATIONS / seconds * 1e-9;
+}
+
+// bufferBytes 크기 버퍼를 AVX로 순차 읽기 (최소 64MB 분량 반복, 3회 중 최고)
+double measureReadGbs(size_t bufferBytes) {
+    const size_t FLOATS = bufferBytes / sizeof(float);
+    const int passes = static_cast<int>(std::max<size_t>(1, DRAM_ROOF_BYTES / bufferBytes));
+    AlignedFloatVector buffer(FLOATS, 1.0f);
+    double best = 0.0;
+
+    for (int trial = 0; trial < 3; trial++) {
+        __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+        __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+        Clock::time_point start = Clock::now();
+        for (int pass = 0; pass < passes; pass++) {
+            for (size_t i = 0; i < FLOATS; i += 4 * SIMD_WIDTH) {
+                a0 = _mm256_add_ps(a0, _mm256_load_ps(&buffer[i]));
+                a1 = _mm256_add_ps(a1, _mm256_load_ps(&buffer[i + 8]));
+                a2 = _mm256_add_ps(a2, _mm256_load_ps(&buffer[i + 16]));
+                a3 = _mm256_add_ps(a3, _mm256_load_ps(&buffer[i + 24]));
+            }
+        }
+        double seconds = elapsedSeconds(start);
+        sink = _mm256_cvtss_f32(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+        best = std::max(best, static_cast<double>(passes) * bufferBytes / seconds * 1e-9);
+    }
+    return best;
+}
+
+std::vector<float> randomVector(size_t n, unsigned seed) {
+    std::vector<float> values(n);
+    for (auto& v : values) {
+        seed = seed * 1103515245u + 12345u;
+        v = static_cast<float>((seed >> 8) & 0xffff) / 65536.0f - 0.5f;
+    }
+    return values;
+}
+
+// 내장 제스처 MLP(126→128→64→4) 한 프레임의 곱셈·덧셈 수와 가중치 바이트
+constexpr double MLP_MACS = 126.0 * 128 + 128.0 * 64 + 64.0 * 4;
+constexpr double MLP_WEIGHT_BYTES = 4.0 * (128 * 128 + 128 + 64 * 128 + 64 + 4 * 64 + 4);  // 패딩 포함
+
+std::vector<Kernel> buildKernels() {
+    std::vector<Kernel> kernels;
+
+    // predictMLP: 256프레임 (스케일링 126 sub+div, 레이어 GEMV, 바이어스)
+    {
+        constexpr int FRAMES = 256;
+        auto recognition = std::make_shared<SignRecognition>();
+        auto features = std::make_shared<std::vector<std::vector<float>>>();
+        for (int f = 0; f < FRAMES; f++) features->push_back(randomVector(126, 7 + f));
+
+        double flopsPerFrame = 2.0 * MLP_MACS + 2.0 * 126 + (128 + 64 + 4);
+        double bytesPerFrame = MLP_WEIGHT_BYTES + 126 * 4 * 3;  // 가중치 + 입력/평균/스케일
+        kernels.push_back({"predictMLP", flopsPerFrame * FRAMES, bytesPerFrame * FRAMES, bytesPerFrame,
+                           [recognition, features]() {
+            int total = 0;
+            for (const auto& frame : *features) total += recognition->predictMLP(frame);
+            sink = static_cast<float>(total);
+        }});
+
+        // 같은 프레임을 GEMM 경로로: 가중치는 배치 타일마다 한 번만 읽음
+        auto flat = std::make_shared<std::vector<float>>();
+        for (const auto& frame : *features) flat->insert(flat->end(), frame.begin(), frame.end());
+        auto classes = std::make_shared<std::vector<int32_t>>(FRAMES);
+        double batchBytes = MLP_WEIGHT_BYTES * (FRAMES / 32) + FRAMES * (126 + 1) * 4.0;
+        kernels.push_back({"predictBatch", flopsPerFrame * FRAMES, batchBytes, MLP_WEIGHT_BYTES + FRAMES * 127 * 4.0,
+                           [recognition, flat, classes]() {
+            recognition->predictBatch(reinterpret_cast<uintptr_t>(flat->data()), FRAMES,
+                                      reinterpret_cast<uintptr_t>(classes->data()));
+        }});
+    }
+
+    // matrixMultiplyLarge: 512×512 (2N³ FLOP, A/B 읽기 + C 쓰기)
+    {
+        constexpr int N = 512;
+        auto recognizer = std::make_shared<SignRecognizer>();
+        auto a = std::make_shared<std::vector<float>>(randomVector(static_cast<size_t>(N) * N, 1));
+        auto b = std::make_shared<std::vector<float>>(randomVector(static_cast<size_t>(N) * N, 2));
+        auto c = std::make_shared<std::vector<float>>(static_cast<size_t>(N) * N);
+        double bytes = 3.0 * N * N * sizeof(float);
+        kernels.push_back({"matrixMultiplyLarge", 2.0 * N * N * N, bytes, bytes, [recognizer, a, b, c]() {
+            recognizer->matrixMultiplyLarge(a->data(), b->data(), c->data(), N);
+        }});
+    }
+
+    // 가우시안 블러 5×5, 640×480 RGBA (채널당 25 mul + 25 add, 읽기 + 임시 버퍼 쓰기 + 복사)
+    {
+        constexpr int W = 640;
+        constexpr int H = 480;
+        auto recognizer = std::make_shared<SignRecognizer>();
+        auto image = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(W) * H * 4);
+        for (size_t i = 0; i < image->size(); i++) (*image)[i] = static_cast<uint8_t>(i * 31 + (i >> 11));
+        double pixels = static_cast<double>(W - 4) * (H - 4);
+        kernels.push_back({"blur", 50.0 * 4 * pixels, 4.0 * W * H * 4, 2.0 * W * H * 4, [recognizer, image]() {
+            recognizer->processImageData(image->data(), W, H, 0);
+        }});
+    }
+
+    return kernels;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        if (arg == "--kernel") {
+            options.kernel = value;
+        } else if (arg == "--min-time") {
+            options.minTime = std::atof(value);
+        } else if (arg == "--peak-gflops") {
+            options.peakGflops = std::atof(value);
+        } else if (arg == "--peak-gbs") {
+            options.peakGbs = std::atof(value);
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+void printCounter(const PerfSample& counters, PerfEvent event, long runs) {
+    if (counters.has(event)) {
+        std::printf(" %12.0f", static_cast<double>(counters.get(event)) / runs);
+    } else {
+        std::printf(" %12s", "n/a");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    std::vector<Kernel> kernels = buildKernels();
+    if (!options.kernel.empty()) {
+        auto it = std::find_if(kernels.begin(), kernels.end(),
+                               [&](const Kernel& kernel) { return kernel.name == options.kernel; });
+        if (it == kernels.end()) {
+            std::string names;
+            for (const Kernel& kernel : kernels) names += (names.empty() ? "" : ", ") + kernel.name;
+            std::fprintf(stderr, "unknown kernel '%s' (%s)\n", options.kernel.c_str(), names.c_str());
+            return 1;
+        }
+        kernels = {*it};
+    }
+
+    PerfCounters perf;
+    if (!perf.available()) {
+        std::printf("hardware counters unavailable: %s\n", perf.error().c_str());
+    }
+
+    double peakGflops = options.peakGflops > 0.0 ? options.peakGflops : measurePeakGflops();
+    double dramGbs = options.peakGbs > 0.0 ? options.peakGbs : measureReadGbs(DRAM_ROOF_BYTES);
+    double cacheGbs = std::max(dramGbs, measureReadGbs(CACHE_ROOF_BYTES));
+    std::printf("peak %.1f GFLOP/s (mul+add), cache %.1f GB/s (ridge %.2f), DRAM %.1f GB/s (ridge %.2f FLOP/byte)\n\n",
+                peakGflops, cacheGbs, peakGflops / cacheGbs, dramGbs, peakGflops / dramGbs);
+
+    std::printf("%-20s %10s %6s %9s %8s %9s %6s %-7s %12s %12s %12s\n", "kernel", "us/run", "IPC", "GFLOP/s",
+                "FLOP/B", "roof", "%roof", "bound", "L1d-miss", "LLC-miss", "br-miss");
+
+    for (const Kernel& kernel : kernels) {
+        Measurement m = measure(kernel, perf, options.minTime);
+        double gflops = kernel.flops / m.seconds * 1e-9;
+        double intensity = kernel.flops / kernel.bytes;
+        bool cacheResident = kernel.workingSet <= CACHE_ROOF_BYTES;
+        double bandwidth = cacheResident ? cacheGbs : dramGbs;
+        double roof = std::min(peakGflops, intensity * bandwidth);
+        const char* bound = intensity * bandwidth >= peakGflops ? "compute" : (cacheResident ? "cache" : "DRAM");
+
+        std::printf("%-20s %10.1f", kernel.name.c_str(), m.seconds * 1e6);
+        if (m.counters.has(PerfEvent::Cycles) && m.counters.has(PerfEvent::Instructions) &&
+            m.counters.get(PerfEvent::Cycles) > 0) {
+            std::printf(" %6.2f", static_cast<double>(m.counters.get(PerfEvent::Instructions)) /
+                                      m.counters.get(PerfEvent::Cycles));
+        } else {
+            std::printf(" %6s", "n/a");
+        }
+        std::printf(" %9.2f %8.2f %9.2f %5.0f%% %-7s", gflops, intensity, roof, 100.0 * gflops / roof, bound);
+        printCounter(m.counters, PerfEvent::L1DMisses, m.runs);
+        printCounter(m.counters, PerfEvent::LlcMisses, m.runs);
+        printCounter(m.counters, PerfEvent::BranchMisses, m.runs);
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char* const EVENT_NAMES[] = {"cycles", "instructions", "L1d-misses", "LLC-misses", "branch-misses"};
+static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) == PERF_EVENT_COUNT, "event name table out of sync");
+
+#ifdef __linux__
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+const EventSpec EVENT_SPECS[PERF_EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int openEvent(const EventSpec& spec) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+} // namespace
+
+PerfCounters::PerfCounters() : openCount(0) {
+    for (int& fd : fds) fd = -1;
+
+#ifdef __linux__
+    // 그룹으로 묶지 않음: 이벤트 하나가 지원되지 않아도 나머지는 측정
+    int firstErrno = 0;
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        fds[i] = openEvent(EVENT_SPECS[i]);
+        if (fds[i] >= 0) {
+            openCount++;
+        } else if (firstErrno == 0) {
+            firstErrno = errno;
+        }
+    }
+    if (openCount == 0) {
+        lastError = std::string("perf_event_open failed: ") + std::strerror(firstErrno) +
+                    (firstErrno == EACCES || firstErrno == EPERM ? " (check /proc/sys/kernel/perf_event_paranoid)" : "");
+    }
+#else
+    lastError = "perf_event_open is only available on Linux";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (fds[i] < 0) continue;
+
+        // value, time_enabled, time_running
+        uint64_t buffer[3] = {0, 0, 0};
+        if (read(fds[i], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)) || buffer[2] == 0) continue;
+
+        double scale = static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]);
+        sample.values[i] = static_cast<uint64_t>(static_cast<double>(buffer[0]) * scale);
+        sample.supported[i] = true;
+    }
+#endif
+    return sample;
+}
+
+const char* PerfCounters::name(PerfEvent event) {
+    return EVENT_NAMES[static_cast<int>(event)];
+}
@@ -0,0 +1,57 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+// 측정하는 하드웨어 이벤트 (순서가 PerfSample::values 인덱스)
+enum class PerfEvent {
+    Cycles = 0,
+    Instructions,
+    L1DMisses,
+    LlcMisses,
+    BranchMisses,
+    COUNT
+};
+
+constexpr int PERF_EVENT_COUNT = static_cast<int>(PerfEvent::COUNT);
+
+// 한 구간의 카운터 값
+// 이벤트가 지원되지 않으면 supported[i]가 false이며 값은 0입니다.
+// 다중화(multiplexing)로 일부 시간만 측정된 경우 실행 시간 비율로 보정된 값입니다.
+struct PerfSample {
+    uint64_t values[PERF_EVENT_COUNT] = {};
+    bool supported[PERF_EVENT_COUNT] = {};
+
+    uint64_t get(PerfEvent event) const { return values[static_cast<int>(event)]; }
+    bool has(PerfEvent event) const { return supported[static_cast<int>(event)]; }
+};
+
+// Linux perf_event_open 카운터 묶음 (현재 스레드, 사용자 공간만)
+// 커널이 PMU를 노출하지 않거나(가상 머신, 컨테이너) perf_event_paranoid로 막힌 경우
+// available()이 false가 되고 start/stop은 아무 일도 하지 않습니다.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return openCount > 0; }
+
+    // 열지 못한 이유 (available()이 false일 때)
+    const std::string& error() const { return lastError; }
+
+    void start();
+    PerfSample stop();
+
+    static const char* name(PerfEvent event);
+
+private:
+    int fds[PERF_EVENT_COUNT];
+    int openCount;
+    std::string lastError;
+};
+
+#endif // PERF_COUNTERS_H
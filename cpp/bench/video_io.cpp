@@ -0,0 +1,157 @@
+#include "video_io.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+inline uint8_t clampByte(int v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+} // namespace
+
+// Y4M 헤더 "YUV4MPEG2 W640 H480 F30:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL"
+bool parseY4mHeader(VideoSource& video, std::string& error) {
+    const char* begin = reinterpret_cast<const char*>(video.data);
+    const char* end = static_cast<const char*>(std::memchr(begin, '\n', std::min<size_t>(video.size, 4096)));
+    if (end == nullptr) {
+        error = "missing Y4M header line";
+        return false;
+    }
+    video.streamHeader.assign(begin, end);
+
+    size_t pos = 0;
+    const std::string& header = video.streamHeader;
+    while (pos < header.size()) {
+        size_t next = header.find(' ', pos);
+        if (next == std::string::npos) next = header.size();
+        std::string token = header.substr(pos, next - pos);
+        pos = next + 1;
+
+        if (token.empty()) continue;
+        if (token[0] == 'W') video.width = std::atoi(token.c_str() + 1);
+        if (token[0] == 'H') video.height = std::atoi(token.c_str() + 1);
+        if (token[0] == 'C') {
+            // 4:2:0 8비트 태그만 (C420p10 등 고비트 깊이는 평면 크기가 달라 거부)
+            if (token == "C420" || token == "C420jpeg" || token == "C420paldv" || token == "C420mpeg2") {
+                video.chroma = ChromaFormat::Yuv420;
+            } else if (token == "C444") {
+                video.chroma = ChromaFormat::Yuv444;
+            } else if (token == "Cmono") {
+                video.chroma = ChromaFormat::Mono;
+            } else {
+                error = "unsupported Y4M colorspace " + token + " (8-bit 420/444/mono only)";
+                return false;
+            }
+        }
+        if (token == "XCOLORRANGE=FULL") video.fullRange = true;
+    }
+    if (video.width <= 0 || video.height <= 0) {
+        error = "Y4M header has no frame size";
+        return false;
+    }
+
+    // 프레임: "FRAME[ 매개변수]\n" + 평면 데이터
+    size_t offset = static_cast<size_t>(end - begin) + 1;
+    size_t frameBytes = video.planeBytes();
+    while (offset + 6 <= video.size && std::memcmp(video.data + offset, "FRAME", 5) == 0) {
+        const void* lineEnd = std::memchr(video.data + offset, '\n', std::min<size_t>(video.size - offset, 1024));
+        if (lineEnd == nullptr) break;
+        size_t dataStart = static_cast<const uint8_t*>(lineEnd) - video.data + 1;
+        if (dataStart + frameBytes > video.size) break;
+        video.frameOffsets.push_back(dataStart);
+        offset = dataStart + frameBytes;
+    }
+    return true;
+}
+
+// BT.601 YUV → RGBA (16.16 고정소수점)
+void decodeFrame(const VideoSource& video, size_t index, uint8_t* rgba) {
+    const uint8_t* src = video.data + video.frameOffsets[index];
+    const int w = video.width;
+    const int h = video.height;
+    const size_t pixels = static_cast<size_t>(w) * h;
+
+    if (!video.y4m) {
+        std::memcpy(rgba, src, pixels * 4);
+        return;
+    }
+
+    const uint8_t* yPlane = src;
+    const uint8_t* uPlane = nullptr;
+    const uint8_t* vPlane = nullptr;
+    int chromaStride = 0;
+    int shift = 0;
+    if (video.chroma == ChromaFormat::Yuv420) {
+        chromaStride = (w + 1) / 2;
+        uPlane = src + pixels;
+        vPlane = uPlane + static_cast<size_t>(chromaStride) * ((h + 1) / 2);
+        shift = 1;
+    } else if (video.chroma == ChromaFormat::Yuv444) {
+        chromaStride = w;
+        uPlane = src + pixels;
+        vPlane = uPlane + pixels;
+    }
+
+    // 제한 범위: Y 16..235, UV 16..240 / 전체 범위: 0..255
+    const int yOffset = video.fullRange ? 0 : 16;
+    const int yScale = video.fullRange ? 65536 : 76309;
+    const int rv = video.fullRange ? 91881 : 104597;
+    const int gu = video.fullRange ? 22554 : 25675;
+    const int gv = video.fullRange ? 46802 : 53279;
+    const int bu = video.fullRange ? 116130 : 132201;
+
+    for (int y = 0; y < h; y++) {
+        const uint8_t* yRow = yPlane + static_cast<size_t>(y) * w;
+        const uint8_t* uRow = uPlane ? uPlane + static_cast<size_t>(y >> shift) * chromaStride : nullptr;
+        const uint8_t* vRow = vPlane ? vPlane + static_cast<size_t>(y >> shift) * chromaStride : nullptr;
+        uint8_t* out = rgba + static_cast<size_t>(y) * w * 4;
+        for (int x = 0; x < w; x++) {
+            int luma = (yRow[x] - yOffset) * yScale;
+            int u = uRow ? uRow[x >> shift] - 128 : 0;
+            int v = vRow ? vRow[x >> shift] - 128 : 0;
+            out[x * 4 + 0] = clampByte((luma + rv * v + 32768) >> 16);
+            out[x * 4 + 1] = clampByte((luma - gu * u - gv * v + 32768) >> 16);
+            out[x * 4 + 2] = clampByte((luma + bu * u + 32768) >> 16);
+            out[x * 4 + 3] = 255;
+        }
+    }
+}
+
+// RGBA → 제한 범위 BT.601 4:2:0 (크로마는 2×2 평균)
+void encodeYuv420(const uint8_t* rgba, int w, int h, std::vector<uint8_t>& out) {
+    const int cw = (w + 1) / 2;
+    const int ch = (h + 1) / 2;
+    out.resize(static_cast<size_t>(w) * h + 2 * static_cast<size_t>(cw) * ch);
+    uint8_t* yPlane = out.data();
+    uint8_t* uPlane = yPlane + static_cast<size_t>(w) * h;
+    uint8_t* vPlane = uPlane + static_cast<size_t>(cw) * ch;
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            const uint8_t* p = rgba + (static_cast<size_t>(y) * w + x) * 4;
+            yPlane[static_cast<size_t>(y) * w + x] =
+                clampByte(((16829 * p[0] + 33039 * p[1] + 6416 * p[2] + 32768) >> 16) + 16);
+        }
+    }
+    for (int cy = 0; cy < ch; cy++) {
+        for (int cx = 0; cx < cw; cx++) {
+            int r = 0, g = 0, b = 0, n = 0;
+            for (int dy = 0; dy < 2 && cy * 2 + dy < h; dy++) {
+                for (int dx = 0; dx < 2 && cx * 2 + dx < w; dx++) {
+                    const uint8_t* p = rgba + (static_cast<size_t>(cy * 2 + dy) * w + cx * 2 + dx) * 4;
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                    n++;
+                }
+            }
+            r /= n;
+            g /= n;
+            b /= n;
+            uPlane[static_cast<size_t>(cy) * cw + cx] = clampByte(((-9714 * r - 19070 * g + 28784 * b + 32768) >> 16) + 128);
+            vPlane[static_cast<size_t>(cy) * cw + cx] = clampByte(((28784 * r - 24103 * g - 4681 * b + 32768) >> 16) + 128);
+        }
+    }
+}
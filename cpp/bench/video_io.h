@@ -0,0 +1,44 @@
+#ifndef VIDEO_IO_H
+#define VIDEO_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 오프라인 영상 도구의 입력/출력 형식 (원시 RGBA, 8비트 Y4M)
+
+enum class ChromaFormat { Yuv420, Yuv444, Mono };
+
+// 매핑한 입력 영상
+struct VideoSource {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    int width = 0;
+    int height = 0;
+    bool y4m = false;
+    bool fullRange = false;
+    ChromaFormat chroma = ChromaFormat::Yuv420;
+    std::string streamHeader;             // Y4M 헤더 줄 (출력에 재사용)
+    std::vector<size_t> frameOffsets;     // 프레임 픽셀 데이터 시작 위치
+
+    size_t planeBytes() const {
+        size_t luma = static_cast<size_t>(width) * height;
+        switch (chroma) {
+        case ChromaFormat::Yuv444: return luma * 3;
+        case ChromaFormat::Mono: return luma;
+        default: return luma + 2 * (static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2));
+        }
+    }
+};
+
+// Y4M 스트림 헤더를 읽어 크기/색 형식과 프레임 위치를 채움 (video.data/size는 미리 설정)
+bool parseY4mHeader(VideoSource& video, std::string& error);
+
+// index번째 프레임 → RGBA (Y4M은 BT.601, 원시 RGBA는 복사)
+void decodeFrame(const VideoSource& video, size_t index, uint8_t* rgba);
+
+// RGBA → 제한 범위 BT.601 4:2:0 평면
+void encodeYuv420(const uint8_t* rgba, int w, int h, std::vector<uint8_t>& out);
+
+#endif // VIDEO_IO_H
@@ -0,0 +1,407 @@
+// 오프라인 영상 처리 도구
+// 녹화한 원시 RGBA 또는 Y4M 파일을 메모리 매핑하여 프레임마다 필터 체인
+// (SignRecognizer::processImageData)을 여러 스레드에서 실행하고, 필요하면 결과를 기록합니다.
+// 동시에 처리 중인 프레임 수를 제한하여 메모리 사용량이 입력 길이와 무관합니다.
+//
+//   make video-pipeline
+//   ./build/video_pipeline input.y4m [--filters blur,clahe,lowlight] [--threads 4] [--inflight 8]
+//                          [--frames N] [--output out.y4m|out.rgba]
+//   ./build/video_pipeline input.rgba --width 640 --height 480 ...
+//
+// Y4M은 4:2:0/4:4:4/mono 8비트를 지원하며 BT.601로 RGBA 변환합니다.
+// 출력 형식은 확장자로 정합니다(.y4m이면 4:2:0 Y4M, 그 외에는 원시 RGBA).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "sign_recognition.h"
+#include "video_io.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedSeconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 엔진 필터 (processImageData filterType)
+struct FilterSpec {
+    const char* name;
+    int filterType;
+};
+
+const FilterSpec FILTERS[] = {
+    {"blur", 0},
+    {"clahe", 1},
+    {"lowlight", 2},
+};
+
+struct Options {
+    std::string input;
+    std::string output;
+    std::vector<int> filters;
+    int width = 0;
+    int height = 0;
+    int threads = 0;
+    int inflight = 0;
+    int maxFrames = 0;
+};
+
+bool openSource(const Options& options, VideoSource& video, std::string& error) {
+    int fd = open(options.input.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + options.input;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        error = "empty input " + options.input;
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        error = "mmap failed for " + options.input;
+        return false;
+    }
+    madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+    video.data = static_cast<const uint8_t*>(mapped);
+    video.size = static_cast<size_t>(info.st_size);
+    video.y4m = video.size >= 9 && std::memcmp(video.data, "YUV4MPEG2", 9) == 0;
+
+    if (video.y4m) return parseY4mHeader(video, error);
+
+    if (options.width <= 0 || options.height <= 0) {
+        error = "raw RGBA input needs --width and --height";
+        return false;
+    }
+    video.width = options.width;
+    video.height = options.height;
+    size_t frameBytes = static_cast<size_t>(video.width) * video.height * 4;
+    for (size_t offset = 0; offset + frameBytes <= video.size; offset += frameBytes) {
+        video.frameOffsets.push_back(offset);
+    }
+    return true;
+}
+
+
+// 처리 중인 프레임 슬롯
+struct FrameSlot {
+    std::vector<uint8_t> rgba;
+    size_t index = 0;
+    bool done = false;
+};
+
+// 스레드별 통계 (마지막에 합산)
+struct WorkerStats {
+    std::vector<double> filterSeconds;
+    double decodeSeconds = 0.0;
+};
+
+class Pipeline {
+public:
+    Pipeline(const VideoSource& video, const Options& options)
+        : video(video), options(options), stop(false), writeError(false) {
+        size_t frameBytes = static_cast<size_t>(video.width) * video.height * 4;
+        slots.resize(options.inflight);
+        for (auto& slot : slots) slot.rgba.resize(frameBytes);
+        for (int i = 0; i < options.inflight; i++) freeSlots.push_back(i);
+        stats.resize(options.threads);
+        for (auto& s : stats) s.filterSeconds.assign(options.filters.size(), 0.0);
+    }
+
+    // frames개 프레임 처리, 출력 시간 반환
+    double run(size_t frames, FILE* output) {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < options.threads; t++) workers.emplace_back([this, t]() { workerLoop(t); });
+
+        std::vector<uint8_t> encoded;
+        std::vector<int> order(frames, -1);  // 프레임 → 슬롯
+        size_t submitted = 0;
+        size_t written = 0;
+        double writeSeconds = 0.0;
+
+        while (written < frames) {
+            std::unique_lock<std::mutex> lock(mutex);
+            // 빈 슬롯이 있으면 다음 프레임 제출 (디코드는 작업 스레드에서)
+            if (submitted < frames && !freeSlots.empty()) {
+                int slot = freeSlots.front();
+                freeSlots.pop_front();
+                slots[slot].index = submitted;
+                slots[slot].done = false;
+                order[submitted] = slot;
+                work.push_back(slot);
+                submitted++;
+                workReady.notify_one();
+                continue;
+            }
+
+            // 다음 순서의 프레임이 끝날 때까지 대기 후 순서대로 기록
+            int slot = order[written];
+            frameDone.wait(lock, [&]() { return slots[slot].done; });
+            lock.unlock();
+
+            if (output != nullptr) {
+                Clock::time_point start = Clock::now();
+                bool ok = writeFrame(slots[slot].rgba.data(), encoded, output);
+                writeSeconds += elapsedSeconds(start);
+                if (!ok) {
+                    // 짧게 기록됨 (디스크 가득 참 등): 남은 프레임은 버리고 작업 스레드를 정리
+                    writeError = true;
+                    break;
+                }
+            }
+
+            lock.lock();
+            freeSlots.push_back(slot);
+            written++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        workReady.notify_all();
+        for (auto& worker : workers) worker.join();
+        return writeSeconds;
+    }
+
+    const std::vector<WorkerStats>& workerStats() const { return stats; }
+    bool writeFailed() const { return writeError; }
+
+private:
+    void workerLoop(int id) {
+        SignRecognizer recognizer;
+        WorkerStats& local = stats[id];
+
+        for (;;) {
+            int slot;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workReady.wait(lock, [&]() { return stop || !work.empty(); });
+                if (work.empty()) return;
+                slot = work.front();
+                work.pop_front();
+            }
+
+            FrameSlot& frame = slots[slot];
+            Clock::time_point start = Clock::now();
+            decodeFrame(video, frame.index, frame.rgba.data());
+            local.decodeSeconds += elapsedSeconds(start);
+
+            for (size_t f = 0; f < options.filters.size(); f++) {
+                start = Clock::now();
+                recognizer.processImageData(frame.rgba.data(), video.width, video.height, options.filters[f]);
+                local.filterSeconds[f] += elapsedSeconds(start);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                frame.done = true;
+            }
+            frameDone.notify_one();
+        }
+    }
+
+    // 모두 기록했으면 true
+    bool writeFrame(const uint8_t* rgba, std::vector<uint8_t>& encoded, FILE* output) {
+        if (isY4mOutput(options.output)) {
+            encodeYuv420(rgba, video.width, video.height, encoded);
+            return std::fwrite("FRAME\n", 1, 6, output) == 6 &&
+                   std::fwrite(encoded.data(), 1, encoded.size(), output) == encoded.size();
+        }
+        size_t bytes = static_cast<size_t>(video.width) * video.height * 4;
+        return std::fwrite(rgba, 1, bytes, output) == bytes;
+    }
+
+public:
+    static bool isY4mOutput(const std::string& path) {
+        return path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+    }
+
+private:
+    const VideoSource& video;
+    const Options& options;
+
+    std::vector<FrameSlot> slots;
+    std::deque<int> freeSlots;
+    std::deque<int> work;
+    std::vector<WorkerStats> stats;
+
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable frameDone;
+    bool stop;
+    bool writeError;
+};
+
+bool parseFilters(const std::string& list, std::vector<int>& filters) {
+    size_t pos = 0;
+    while (pos <= list.size()) {
+        size_t next = list.find(',', pos);
+        if (next == std::string::npos) next = list.size();
+        std::string name = list.substr(pos, next - pos);
+        pos = next + 1;
+        if (name.empty()) continue;
+
+        bool found = false;
+        for (const FilterSpec& spec : FILTERS) {
+            if (name == spec.name) {
+                filters.push_back(spec.filterType);
+                found = true;
+            }
+        }
+        if (!found) {
+            std::fprintf(stderr, "unknown filter '%s'\n", name.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* filterName(int filterType) {
+    for (const FilterSpec& spec : FILTERS) {
+        if (spec.filterType == filterType) return spec.name;
+    }
+    return "?";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            options.input = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--filters") {
+            if (!parseFilters(value, options.filters)) return false;
+        } else if (arg == "--threads") {
+            options.threads = std::atoi(value);
+        } else if (arg == "--inflight") {
+            options.inflight = std::atoi(value);
+        } else if (arg == "--frames") {
+            options.maxFrames = std::atoi(value);
+        } else if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--width") {
+            options.width = std::atoi(value);
+        } else if (arg == "--height") {
+            options.height = std::atoi(value);
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (options.input.empty()) {
+        std::fprintf(stderr, "usage: video_pipeline input.(y4m|rgba) [--width W --height H] [--filters blur,...]\n"
+                             "       [--threads N] [--inflight N] [--frames N] [--output out.(y4m|rgba)]\n");
+        return false;
+    }
+    if (options.filters.empty()) options.filters.push_back(0);
+    if (options.threads <= 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (options.inflight <= 0) options.inflight = options.threads * 2;
+    options.inflight = std::max(options.inflight, 1);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    VideoSource video;
+    std::string error;
+    if (!openSource(options, video, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    size_t frames = video.frameOffsets.size();
+    if (options.maxFrames > 0) frames = std::min(frames, static_cast<size_t>(options.maxFrames));
+    if (frames == 0) {
+        std::fprintf(stderr, "no complete frames in %s\n", options.input.c_str());
+        return 1;
+    }
+
+    FILE* output = nullptr;
+    if (!options.output.empty()) {
+        output = std::fopen(options.output.c_str(), "wb");
+        if (output == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", options.output.c_str());
+            return 1;
+        }
+        if (Pipeline::isY4mOutput(options.output)) {
+            char header[128];
+            std::snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F30:1 Ip A1:1 C420jpeg\n", video.width, video.height);
+            std::string line = video.y4m ? video.streamHeader + "\n" : header;
+            // 입력 헤더의 색공간은 출력(4:2:0 제한 범위)에 맞게 교체
+            if (video.y4m) {
+                size_t c = line.find(" C");
+                if (c != std::string::npos) line.erase(c, line.find_first_of(" \n", c + 1) - c);
+                size_t range = line.find(" XCOLORRANGE=");
+                if (range != std::string::npos) line.erase(range, line.find_first_of(" \n", range + 1) - range);
+                line.insert(line.size() - 1, " C420jpeg");
+            }
+            if (std::fwrite(line.data(), 1, line.size(), output) != line.size()) {
+                std::fprintf(stderr, "write to %s failed\n", options.output.c_str());
+                std::fclose(output);
+                return 1;
+            }
+        }
+    }
+
+    std::printf("%s: %dx%d %s, %zu frames, %zu filter%s, %d threads, %d in flight\n", options.input.c_str(),
+                video.width, video.height, video.y4m ? "Y4M" : "RGBA", frames, options.filters.size(),
+                options.filters.size() > 1 ? "s" : "", options.threads, options.inflight);
+
+    Pipeline pipeline(video, options);
+    Clock::time_point start = Clock::now();
+    double writeSeconds = pipeline.run(frames, output);
+    double wall = elapsedSeconds(start);
+
+    bool writeFailed = pipeline.writeFailed();
+    if (output != nullptr && std::fclose(output) != 0) writeFailed = true;
+    munmap(const_cast<uint8_t*>(video.data), video.size);
+    if (writeFailed) {
+        std::fprintf(stderr, "write to %s failed\n", options.output.c_str());
+        return 1;
+    }
+
+    // 스레드별 시간 합산 (CPU 시간 기준, 프레임당 평균)
+    std::vector<double> filterSeconds(options.filters.size(), 0.0);
+    double decodeSeconds = 0.0;
+    for (const WorkerStats& s : pipeline.workerStats()) {
+        decodeSeconds += s.decodeSeconds;
+        for (size_t f = 0; f < filterSeconds.size(); f++) filterSeconds[f] += s.filterSeconds[f];
+    }
+
+    std::printf("throughput %.1f fps (%.3f s wall)\n", frames / wall, wall);
+    std::printf("  %-10s %8.3f ms/frame\n", "decode", decodeSeconds / frames * 1e3);
+    for (size_t f = 0; f < filterSeconds.size(); f++) {
+        std::printf("  %-2zu %-7s %8.3f ms/frame\n", f, filterName(options.filters[f]), filterSeconds[f] / frames * 1e3);
+    }
+    if (output != nullptr) std::printf("  %-10s %8.3f ms/frame\n", "write", writeSeconds / frames * 1e3);
+    return 0;
+}
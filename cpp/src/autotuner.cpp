@@ -0,0 +1,259 @@
+#include "autotuner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "thread_pool.h"
+
+namespace {
+
+constexpr const char* PROFILE_MAGIC = "signtune";
+constexpr const char* PROFILE_VERSION = "v1";
+
+// 측정 한 번의 최소 길이 (타이머 해상도보다 충분히 길게)
+constexpr double MIN_TRIAL_SECONDS = 0.001;
+constexpr int TRIALS = 3;
+
+struct GemmKernelName {
+    GemmKernel kernel;
+    const char* name;
+};
+
+const GemmKernelName GEMM_KERNELS[] = {
+    {GemmKernel::Rows4Frames2, "4x2"},
+    {GemmKernel::Rows4Frames3, "4x3"},
+    {GemmKernel::Rows2Frames4, "2x4"},
+    {GemmKernel::Rows8Frames1, "8x1"},
+};
+
+const int SPARSE_FRAME_TILES[] = {4, 8};
+const int BATCH_TILES[] = {8, 16, 32, 64};
+
+double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// fn을 반복 실행해 1회당 최소 시간(초)을 측정
+template <typename Fn>
+double measure(Fn&& fn) {
+    fn(); // 워밍업 (스크래치 할당, 캐시 적재)
+
+    double start = nowSeconds();
+    fn();
+    double single = std::max(nowSeconds() - start, 1e-7);
+    int reps = std::max(1, static_cast<int>(MIN_TRIAL_SECONDS / single));
+
+    double best = 1e30;
+    for (int t = 0; t < TRIALS; t++) {
+        start = nowSeconds();
+        for (int r = 0; r < reps; r++) fn();
+        best = std::min(best, (nowSeconds() - start) / reps);
+    }
+    return best;
+}
+
+// 결정적 의사 난수 입력 (재현 가능한 튜닝)
+void fillInput(std::vector<float>& data) {
+    uint32_t state = 0x9e3779b9u;
+    for (float& v : data) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        v = static_cast<float>(state & 0xffff) / 32768.0f - 1.0f;
+    }
+}
+
+const char* gemmKernelName(GemmKernel kernel) {
+    for (const auto& entry : GEMM_KERNELS) {
+        if (entry.kernel == kernel) return entry.name;
+    }
+    return GEMM_KERNELS[0].name;
+}
+
+} // namespace
+
+TuneProfile Autotuner::tune(MlpModel& model, int batchSize) {
+    TuneProfile profile;
+    profile.shape = model.shapeSignature();
+    if (model.empty()) return profile;
+
+    batchSize = std::max(batchSize, 1);
+    std::vector<float> input(static_cast<size_t>(batchSize) * model.inputDim());
+    std::vector<float> output(static_cast<size_t>(batchSize) * model.outputDim());
+    fillInput(input);
+
+    // 1. 레이어별 형식: 밀도가 애매한 레이어만 두 커널을 직접 비교 (GEMV 기준)
+    for (auto& layer : model.layers) {
+        if (layer.measureDensity() <= TUNE_FORMAT_DENSITY_LIMIT) {
+            AlignedFloatVector x(layer.stride, 0.0f);
+            std::copy(input.begin(), input.begin() + layer.inDim, x.begin());
+            std::vector<float> y(layer.outDim);
+
+            LayerFormat formats[] = {LayerFormat::Dense, LayerFormat::BlockSparse};
+            LayerFormat best = layer.format;
+            double bestTime = 1e30;
+            for (LayerFormat format : formats) {
+                layer.setFormat(format);
+                double t = measure([&]() { layer.forward(x.data(), y.data(), true); });
+                if (t < bestTime) {
+                    bestTime = t;
+                    best = format;
+                }
+            }
+            layer.setFormat(best);
+        }
+        profile.formats.push_back(layer.format);
+    }
+
+    // 2. GEMM 마이크로 커널 × 희소 프레임 타일 (배치 전체를 한 타일로)
+    KernelConfig config = model.kernelConfig;
+    config.batchTile = batchSize;
+    double bestTime = 1e30;
+    KernelConfig best = config;
+    for (const auto& kernel : GEMM_KERNELS) {
+        for (int sparseTile : SPARSE_FRAME_TILES) {
+            config.gemmKernel = kernel.kernel;
+            config.sparseFrameTile = sparseTile;
+            model.kernelConfig = config;
+            double t = measure([&]() { model.forwardBatch(input.data(), output.data(), batchSize); });
+            if (t < bestTime) {
+                bestTime = t;
+                best = config;
+            }
+        }
+    }
+
+    // 3. 배치 타일 크기
+    config = best;
+    for (int tile : BATCH_TILES) {
+        if (tile > batchSize) break;
+        config.batchTile = tile;
+        model.kernelConfig = config;
+        double t = measure([&]() { model.forwardBatch(input.data(), output.data(), batchSize); });
+        if (t < bestTime) {
+            bestTime = t;
+            best = config;
+        }
+    }
+
+    model.kernelConfig = best;
+    profile.config = best;
+
+    // 4. 참여자 수: 1, 2, 4, … 현재 상한까지 (같으면 적은 쪽, 작은 배치는 나눌수록 느려질 수 있음)
+    if (model.intraOpPool != nullptr) {
+        const int limit = model.intraOpPool->participantsFor(model.intraOpThreads);
+        int bestThreads = 1;
+        bestTime = 1e30;
+        for (int threads = 1;; threads = std::min(threads * 2, limit)) {
+            model.intraOpThreads = threads;
+            double t = measure([&]() { model.forwardBatch(input.data(), output.data(), batchSize); });
+            if (t < bestTime) {
+                bestTime = t;
+                bestThreads = threads;
+            }
+            if (threads == limit) break;
+        }
+        model.intraOpThreads = bestThreads;
+        profile.threads = bestThreads;
+    }
+    return profile;
+}
+
+bool Autotuner::apply(const TuneProfile& profile, MlpModel& model) {
+    if (profile.shape != model.shapeSignature() || profile.formats.size() != model.layers.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < model.layers.size(); i++) {
+        model.layers[i].setFormat(profile.formats[i]);
+    }
+    model.kernelConfig = profile.config;
+    if (profile.threads > 0) model.intraOpThreads = profile.threads;
+    return true;
+}
+
+std::string Autotuner::serialize(const TuneProfile& profile) {
+    std::string formats;
+    for (LayerFormat format : profile.formats) {
+        formats += (format == LayerFormat::BlockSparse) ? 'S' : 'D';
+    }
+
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), "%s %s shape=%s gemm=%s sparseTile=%d batchTile=%d formats=%s threads=%d",
+                  PROFILE_MAGIC, PROFILE_VERSION, profile.shape.c_str(),
+                  gemmKernelName(profile.config.gemmKernel), profile.config.sparseFrameTile,
+                  profile.config.batchTile, formats.c_str(), profile.threads);
+    return buffer;
+}
+
+bool Autotuner::parse(const std::string& blob, TuneProfile& profile) {
+    // 공백 기준 토큰 분리
+    std::vector<std::string> tokens;
+    size_t pos = 0;
+    while (pos < blob.size()) {
+        size_t start = blob.find_first_not_of(" \t\r\n", pos);
+        if (start == std::string::npos) break;
+        size_t end = blob.find_first_of(" \t\r\n", start);
+        if (end == std::string::npos) end = blob.size();
+        tokens.push_back(blob.substr(start, end - start));
+        pos = end;
+    }
+    if (tokens.size() < 2 || tokens[0] != PROFILE_MAGIC || tokens[1] != PROFILE_VERSION) {
+        return false;
+    }
+
+    TuneProfile parsed;
+    for (size_t t = 2; t < tokens.size(); t++) {
+        const std::string& token = tokens[t];
+        size_t eq = token.find('=');
+        if (eq == std::string::npos) return false;
+        std::string key = token.substr(0, eq);
+        std::string value = token.substr(eq + 1);
+
+        if (key == "shape") {
+            parsed.shape = value;
+        } else if (key == "gemm") {
+            bool found = false;
+            for (const auto& entry : GEMM_KERNELS) {
+                if (value == entry.name) {
+                    parsed.config.gemmKernel = entry.kernel;
+                    found = true;
+                }
+            }
+            if (!found) return false;
+        } else if (key == "sparseTile") {
+            parsed.config.sparseFrameTile = std::atoi(value.c_str()) == 8 ? 8 : 4;
+        } else if (key == "batchTile") {
+            parsed.config.batchTile = std::max(1, std::atoi(value.c_str()));
+        } else if (key == "formats") {
+            for (char c : value) {
+                if (c != 'D' && c != 'S') return false;
+                parsed.formats.push_back(c == 'S' ? LayerFormat::BlockSparse : LayerFormat::Dense);
+            }
+        } else if (key == "threads") {
+            parsed.threads = std::max(0, std::atoi(value.c_str()));
+        }
+        // 알 수 없는 키는 무시 (이후 버전 호환)
+    }
+
+    if (parsed.shape.empty()) return false;
+    profile = parsed;
+    return true;
+}
+
+bool Autotuner::saveFile(const std::string& path, const TuneProfile& profile) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) return false;
+    std::string blob = serialize(profile);
+    bool ok = std::fputs(blob.c_str(), file) >= 0 && std::fputc('\n', file) != EOF;
+    return std::fclose(file) == 0 && ok;
+}
+
+bool Autotuner::loadFile(const std::string& path, TuneProfile& profile) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (file == nullptr) return false;
+    char buffer[512];
+    bool ok = std::fgets(buffer, sizeof(buffer), file) != nullptr;
+    std::fclose(file);
+    return ok && parse(buffer, profile);
+}
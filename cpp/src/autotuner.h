@@ -0,0 +1,44 @@
+#ifndef AUTOTUNER_H
+#define AUTOTUNER_H
+
+#include <string>
+#include <vector>
+#include "mlp_model.h"
+
+// 튜닝 시 사용하는 기본 배치 크기
+constexpr int DEFAULT_TUNE_BATCH = 64;
+
+// 밀도가 이 값 이하인 레이어는 밀집/희소 커널을 직접 측정해 선택
+constexpr float TUNE_FORMAT_DENSITY_LIMIT = 0.75f;
+
+// 기기별 커널 튜닝 결과
+struct TuneProfile {
+    std::string shape;                // MlpModel::shapeSignature()
+    KernelConfig config;
+    std::vector<LayerFormat> formats; // 레이어별 가중치 형식
+    int threads = 0;                  // 배치 추론 참여자 수 (0이면 풀이 없어 측정하지 않음, 적용 시 현재 설정 유지)
+};
+
+// 시작 시 자동 튜너
+// 모델의 실제 레이어 크기로 배치 타일, GEMM 마이크로 커널 형태, 희소 프레임 타일,
+// 레이어별 밀집/희소 형식과 (intraOpPool이 있으면) 배치 추론 참여자 수를 벤치마크하여 가장 빠른 조합을 고릅니다.
+// 결과는 작은 텍스트 프로파일로 직렬화되어 JS(localStorage 등)나 파일에 저장하고,
+// 다음 세션에서는 apply()로 바로 적용해 튜닝을 건너뜁니다.
+class Autotuner {
+public:
+    // 튜닝 후 model에 적용하고 결과 반환
+    static TuneProfile tune(MlpModel& model, int batchSize = DEFAULT_TUNE_BATCH);
+
+    // 저장된 프로파일 적용 (모델 형태가 다르면 false)
+    static bool apply(const TuneProfile& profile, MlpModel& model);
+
+    // "signtune v1 shape=126x128x64x4 gemm=4x2 sparseTile=4 batchTile=32 formats=DDD threads=2"
+    static std::string serialize(const TuneProfile& profile);
+    static bool parse(const std::string& blob, TuneProfile& profile);
+
+    // 네이티브 환경에서 파일로 저장/로드
+    static bool saveFile(const std::string& path, const TuneProfile& profile);
+    static bool loadFile(const std::string& path, TuneProfile& profile);
+};
+
+#endif // AUTOTUNER_H
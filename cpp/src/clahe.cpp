@@ -0,0 +1,265 @@
+#include "clahe.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+constexpr int BINS = 256;
+constexpr int SUB_HISTOGRAMS = 4;
+constexpr int REMAP_BAND_ROWS = 16;
+
+// BT.601 휘도 (정수 가중치 합 256)
+inline int lumaOf(int r, int g, int b) {
+    return (77 * r + 150 * g + 29 * b + 128) >> 8;
+}
+
+// RGBA 8픽셀 → 32비트 레인별 R, G, B, 휘도
+inline __m256i lumaOf8(__m256i pixels, __m256i& r, __m256i& g, __m256i& b) {
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    r = _mm256_and_si256(pixels, byteMask);
+    g = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask);
+    b = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask);
+    __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(r, _mm256_set1_epi32(77)),
+                                   _mm256_mullo_epi32(g, _mm256_set1_epi32(150)));
+    sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(b, _mm256_set1_epi32(29)));
+    return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(128)), 8);
+}
+
+// 보간 대상 타일 쌍과 뒤쪽 타일 가중치 (타일 중심 사이에서 선형, 가장자리 중심 바깥은 한 타일)
+void interpolationTiles(const std::vector<int>& bounds, int position, int& first, int& second, float& weight) {
+    const int tiles = static_cast<int>(bounds.size()) - 1;
+    auto center = [&](int t) { return 0.5f * (bounds[t] + bounds[t + 1] - 1); };
+    if (position <= center(0)) {
+        first = second = 0;
+        weight = 0.0f;
+        return;
+    }
+    if (position >= center(tiles - 1)) {
+        first = second = tiles - 1;
+        weight = 0.0f;
+        return;
+    }
+    first = 0;
+    while (center(first + 1) <= position) first++;
+    second = first + 1;
+    weight = (position - center(first)) / (center(second) - center(first));
+}
+
+} // namespace
+
+ClaheFilter::ClaheFilter(const ClaheConfig& config)
+    : settings(config), cachedWidth(0), cachedHeight(0), meanLuma(0.0f) {}
+
+void ClaheFilter::prepareGeometry(int width, int height) {
+    if (width == cachedWidth && height == cachedHeight) return;
+    cachedWidth = width;
+    cachedHeight = height;
+
+    const int tilesX = std::max(1, std::min(settings.tilesX, width));
+    const int tilesY = std::max(1, std::min(settings.tilesY, height));
+    tileX0.resize(tilesX + 1);
+    tileY0.resize(tilesY + 1);
+    for (int t = 0; t <= tilesX; t++) tileX0[t] = static_cast<int>(static_cast<int64_t>(t) * width / tilesX);
+    for (int t = 0; t <= tilesY; t++) tileY0[t] = static_cast<int>(static_cast<int64_t>(t) * height / tilesY);
+
+    // 열별 보간 타일 (SIMD 경로가 8픽셀씩 바로 읽도록 패딩)
+    const int padded = padToSimd(width);
+    columnLut0.assign(padded, 0);
+    columnLut1.assign(padded, 0);
+    columnWeight.assign(padded, 0.0f);
+    for (int x = 0; x < width; x++) {
+        int first, second;
+        interpolationTiles(tileX0, x, first, second, columnWeight[x]);
+        columnLut0[x] = first * BINS;
+        columnLut1[x] = second * BINS;
+    }
+
+    rowTile0.resize(height);
+    rowTile1.resize(height);
+    rowWeight.resize(height);
+    for (int y = 0; y < height; y++) interpolationTiles(tileY0, y, rowTile0[y], rowTile1[y], rowWeight[y]);
+
+    histograms.assign(static_cast<size_t>(tilesY) * tilesX * SUB_HISTOGRAMS * BINS, 0);
+    luts.assign(static_cast<size_t>(tilesY) * tilesX * BINS, 0.0f);
+    rowLumaSums.assign(tilesY, 0);
+}
+
+// 타일 행 하나의 히스토그램과 휘도 합
+void ClaheFilter::countTileRow(const uint8_t* rgba, int width, int tileRow) {
+    const int tilesX = static_cast<int>(tileX0.size()) - 1;
+    uint32_t* counts = &histograms[static_cast<size_t>(tileRow) * tilesX * SUB_HISTOGRAMS * BINS];
+    std::memset(counts, 0, static_cast<size_t>(tilesX) * SUB_HISTOGRAMS * BINS * sizeof(uint32_t));
+
+    // 행 휘도를 먼저 바이트로 계산한 뒤 타일 구간마다 부분 히스토그램 4개에 번갈아 셈
+    thread_local std::vector<uint8_t> lumas;
+    lumas.resize(padToSimd(width));
+    for (int y = tileY0[tileRow]; y < tileY0[tileRow + 1]; y++) {
+        const uint8_t* row = rgba + static_cast<size_t>(y) * width * 4;
+        int x = 0;
+        for (; x + SIMD_WIDTH <= width; x += SIMD_WIDTH) {
+            __m256i r, g, b;
+            __m256i luma = lumaOf8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x * 4)), r, g, b);
+            __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(luma), _mm256_extracti128_si256(luma, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(&lumas[x]), _mm_packus_epi16(packed, packed));
+        }
+        for (; x < width; x++) lumas[x] = static_cast<uint8_t>(lumaOf(row[x * 4], row[x * 4 + 1], row[x * 4 + 2]));
+
+        for (int tx = 0; tx < tilesX; tx++) {
+            uint32_t* h = counts + tx * SUB_HISTOGRAMS * BINS;
+            int i = tileX0[tx];
+            const int end = tileX0[tx + 1];
+            for (; i + SUB_HISTOGRAMS <= end; i += SUB_HISTOGRAMS) {
+                h[lumas[i]]++;
+                h[BINS + lumas[i + 1]]++;
+                h[2 * BINS + lumas[i + 2]]++;
+                h[3 * BINS + lumas[i + 3]]++;
+            }
+            for (; i < end; i++) h[lumas[i]]++;
+        }
+    }
+
+    uint64_t lumaSum = 0;
+    for (int tx = 0; tx < tilesX; tx++) {
+        uint32_t* h = counts + tx * SUB_HISTOGRAMS * BINS;
+        for (int i = 0; i < BINS; i += SIMD_WIDTH) {
+            __m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i));
+            for (int s = 1; s < SUB_HISTOGRAMS; s++) {
+                sum = _mm256_add_epi32(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + s * BINS + i)));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(h + i), sum);
+        }
+        for (int i = 0; i < BINS; i++) lumaSum += static_cast<uint64_t>(i) * h[i];
+    }
+    rowLumaSums[tileRow] = lumaSum;
+}
+
+// 타일 행 하나의 히스토그램 → 클립/재분배 → LUT
+void ClaheFilter::buildTileRow(int tileRow) {
+    const int tilesX = static_cast<int>(tileX0.size()) - 1;
+    const int tileHeight = tileY0[tileRow + 1] - tileY0[tileRow];
+    uint32_t* counts = &histograms[static_cast<size_t>(tileRow) * tilesX * SUB_HISTOGRAMS * BINS];
+    for (int tx = 0; tx < tilesX; tx++) {
+        uint32_t* h = counts + tx * SUB_HISTOGRAMS * BINS;
+        const int pixels = (tileX0[tx + 1] - tileX0[tx]) * tileHeight;
+        float* lut = &luts[(static_cast<size_t>(tileRow) * tilesX + tx) * BINS];
+        if (pixels == 0) {
+            for (int i = 0; i < BINS; i++) lut[i] = static_cast<float>(i);
+            continue;
+        }
+
+        // 상한을 넘는 개수를 모든 구간에 고르게, 나머지는 일정 간격으로 하나씩
+        const uint32_t clip = std::max(1u, static_cast<uint32_t>(settings.clipLimit * pixels / BINS));
+        uint32_t excess = 0;
+        for (int i = 0; i < BINS; i++) {
+            if (h[i] > clip) {
+                excess += h[i] - clip;
+                h[i] = clip;
+            }
+        }
+        const uint32_t batch = excess / BINS;
+        uint32_t residual = excess - batch * BINS;
+        for (int i = 0; i < BINS; i++) h[i] += batch;
+        if (residual > 0) {
+            const int step = std::max(1, BINS / static_cast<int>(residual));
+            for (int i = 0; i < BINS && residual > 0; i += step, residual--) h[i]++;
+        }
+
+        const float scale = 255.0f / pixels;
+        uint32_t cumulative = 0;
+        for (int i = 0; i < BINS; i++) {
+            cumulative += h[i];
+            lut[i] = cumulative * scale;
+        }
+    }
+}
+
+// 쌍선형 보간한 휘도로 R/G/B를 같은 양만큼 이동
+void ClaheFilter::remapRows(uint8_t* rgba, int width, int rowBegin, int rowEnd) const {
+    const int tilesX = static_cast<int>(tileX0.size()) - 1;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i maxValue = _mm256_set1_epi32(255);
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+    for (int y = rowBegin; y < rowEnd; y++) {
+        uint8_t* row = rgba + static_cast<size_t>(y) * width * 4;
+        const float* top = &luts[static_cast<size_t>(rowTile0[y]) * tilesX * BINS];
+        const float* bottom = &luts[static_cast<size_t>(rowTile1[y]) * tilesX * BINS];
+        const float wy = rowWeight[y];
+        const __m256 vwy = _mm256_set1_ps(wy);
+
+        int x = 0;
+        for (; x + SIMD_WIDTH <= width; x += SIMD_WIDTH) {
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x * 4));
+            __m256i r, g, b;
+            __m256i luma = lumaOf8(pixels, r, g, b);
+            __m256i left = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&columnLut0[x])), luma);
+            __m256i right = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&columnLut1[x])), luma);
+            __m256 wx = _mm256_load_ps(&columnWeight[x]);
+
+            __m256 topLeft = _mm256_i32gather_ps(top, left, 4);
+            __m256 topRight = _mm256_i32gather_ps(top, right, 4);
+            __m256 bottomLeft = _mm256_i32gather_ps(bottom, left, 4);
+            __m256 bottomRight = _mm256_i32gather_ps(bottom, right, 4);
+            __m256 upper = _mm256_add_ps(topLeft, _mm256_mul_ps(wx, _mm256_sub_ps(topRight, topLeft)));
+            __m256 lower = _mm256_add_ps(bottomLeft, _mm256_mul_ps(wx, _mm256_sub_ps(bottomRight, bottomLeft)));
+            __m256 mapped = _mm256_add_ps(upper, _mm256_mul_ps(vwy, _mm256_sub_ps(lower, upper)));
+
+            __m256i delta = _mm256_sub_epi32(_mm256_cvtps_epi32(mapped), luma);
+            r = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(r, delta), zero), maxValue);
+            g = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(g, delta), zero), maxValue);
+            b = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(b, delta), zero), maxValue);
+            __m256i out = _mm256_or_si256(_mm256_and_si256(pixels, alphaMask), r);
+            out = _mm256_or_si256(out, _mm256_slli_epi32(g, 8));
+            out = _mm256_or_si256(out, _mm256_slli_epi32(b, 16));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + x * 4), out);
+        }
+        for (; x < width; x++) {
+            uint8_t* p = row + x * 4;
+            int luma = lumaOf(p[0], p[1], p[2]);
+            const float wx = columnWeight[x];
+            float upper = top[columnLut0[x] + luma] + wx * (top[columnLut1[x] + luma] - top[columnLut0[x] + luma]);
+            float lower = bottom[columnLut0[x] + luma] +
+                          wx * (bottom[columnLut1[x] + luma] - bottom[columnLut0[x] + luma]);
+            // SIMD 경로(cvtps)와 같은 짝수 쪽 반올림
+            int delta = static_cast<int>(std::lrintf(upper + wy * (lower - upper))) - luma;
+            for (int c = 0; c < 3; c++) p[c] = static_cast<uint8_t>(std::min(255, std::max(0, p[c] + delta)));
+        }
+    }
+}
+
+bool ClaheFilter::apply(uint8_t* rgba, int width, int height, bool onlyWhenDark, ThreadPool* pool, int maxParticipants) {
+    if (rgba == nullptr || width <= 0 || height <= 0) return false;
+    prepareGeometry(width, height);
+
+    const int tilesY = static_cast<int>(tileY0.size()) - 1;
+    auto countRow = [&](int tileRow) { countTileRow(rgba, width, tileRow); };
+    if (pool != nullptr) {
+        pool->parallelFor(tilesY, countRow, maxParticipants);
+    } else {
+        for (int t = 0; t < tilesY; t++) countRow(t);
+    }
+
+    // 밝은 영상은 LUT를 만들기 전에 돌려보냄
+    uint64_t lumaSum = 0;
+    for (uint64_t sum : rowLumaSums) lumaSum += sum;
+    meanLuma = static_cast<float>(static_cast<double>(lumaSum) / (static_cast<double>(width) * height));
+    if (onlyWhenDark && meanLuma >= settings.darkMeanLuma) return false;
+
+    auto buildRow = [&](int tileRow) { buildTileRow(tileRow); };
+    if (pool != nullptr) {
+        pool->parallelFor(tilesY, buildRow, maxParticipants);
+    } else {
+        for (int t = 0; t < tilesY; t++) buildRow(t);
+    }
+
+    auto remap = [&](int rowBegin, int rowEnd) { remapRows(rgba, width, rowBegin, rowEnd); };
+    if (pool != nullptr) {
+        pool->parallelFor(0, height, REMAP_BAND_ROWS, remap, maxParticipants);
+    } else {
+        remap(0, height);
+    }
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef CLAHE_H
+#define CLAHE_H
+
+#include <cstdint>
+#include <vector>
+#include "mlp_model.h"
+
+class ThreadPool;
+
+// CLAHE 설정 (OpenCV 기본값과 같은 8×8 타일, 클립 2.0)
+struct ClaheConfig {
+    int tilesX = 8;
+    int tilesY = 8;
+    float clipLimit = 2.0f;       // 히스토그램 구간 상한 = clipLimit × (타일 픽셀 수 / 256)
+    float darkMeanLuma = 70.0f;   // 자동 모드: 평균 휘도가 이보다 낮을 때만 적용 (0–255)
+};
+
+// 대비 제한 적응형 히스토그램 평활화 (저조도 보정)
+// 1. 행마다 AVX2로 8픽셀씩 휘도를 바이트로 계산하고, 이웃 픽셀을 서로 다른 부분 히스토그램 4개에 나눠 세어
+//    같은 구간을 연달아 올릴 때의 저장-적재 의존을 피함 (부분 히스토그램 합산도 AVX2, 타일 행끼리 병렬)
+// 2. 평균 휘도를 확인한 뒤 타일별로 클립 상한을 넘는 개수를 모든 구간에 고르게 재분배한 뒤 누적 분포로 LUT 생성
+// 3. 픽셀마다 주변 타일 LUT 4개를 gather로 읽어 쌍선형 보간하고, 휘도 변화량을 R/G/B에 같이 더해
+//    색차(Cb/Cr)는 그대로 두고 휘도만 바꿈 (알파 유지, 반올림은 짝수 쪽)
+// 작업 버퍼는 객체에 보관되어 같은 크기 영상을 반복 처리할 때 할당하지 않습니다.
+class ClaheFilter {
+public:
+    explicit ClaheFilter(const ClaheConfig& config = ClaheConfig());
+
+    // RGBA 영상에 제자리 적용, 적용했으면 true
+    // onlyWhenDark면 평균 휘도가 darkMeanLuma 이상일 때 히스토그램만 세고 LUT를 만들지 않은 채 그대로 둠
+    // pool이 있으면 타일 행/행 띠 단위로 나눠 최대 maxParticipants개(0이면 풀 전체) 스레드에서 실행
+    bool apply(uint8_t* rgba, int width, int height, bool onlyWhenDark, ThreadPool* pool, int maxParticipants = 0);
+
+    // 마지막 apply에서 측정한 평균 휘도 (0–255)
+    float lastMeanLuma() const { return meanLuma; }
+
+    const ClaheConfig& config() const { return settings; }
+    void setDarkMeanLuma(float luma) { settings.darkMeanLuma = luma; }
+
+private:
+    void prepareGeometry(int width, int height);
+    void countTileRow(const uint8_t* rgba, int width, int tileRow);
+    void buildTileRow(int tileRow);
+    void remapRows(uint8_t* rgba, int width, int rowBegin, int rowEnd) const;
+
+    ClaheConfig settings;
+
+    std::vector<int> tileX0;                // 타일 열 경계 (tilesX + 1)
+    std::vector<int> tileY0;                // 타일 행 경계 (tilesY + 1)
+    std::vector<int32_t> columnLut0;        // 열별 왼쪽/오른쪽 보간 타일의 LUT 오프셋 (타일 열 × 256)
+    std::vector<int32_t> columnLut1;
+    AlignedFloatVector columnWeight;        // 열별 오른쪽 타일 가중치
+    std::vector<int> rowTile0;              // 행별 위/아래 보간 타일 행
+    std::vector<int> rowTile1;
+    std::vector<float> rowWeight;           // 행별 아래 타일 가중치
+    std::vector<uint32_t> histograms;       // 타일 행마다 tilesX × 4 × 256 (타일 행끼리 병렬)
+    std::vector<float> luts;                // tilesY × tilesX × 256
+    std::vector<uint64_t> rowLumaSums;      // 타일 행별 휘도 합
+    int cachedWidth;
+    int cachedHeight;
+    float meanLuma;
+};
+
+#endif // CLAHE_H
@@ -0,0 +1,175 @@
+#include "crop_align.h"
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+#include "mlp_model.h"
+
+namespace {
+
+// 정렬 템플릿 (출력 한 변에 대한 비율)
+constexpr float HAND_WRIST_X = 0.5f;
+constexpr float HAND_WRIST_Y = 0.88f;
+constexpr float HAND_MCP_X = 0.5f;
+constexpr float HAND_MCP_Y = 0.52f;
+constexpr float FACE_LEFT_EYE_X = 0.342f;
+constexpr float FACE_RIGHT_EYE_X = 0.658f;
+constexpr float FACE_EYE_Y = 0.461f;
+
+inline int clampIndex(int value, int limit) {
+    return std::min(std::max(value, 0), limit - 1);
+}
+
+// 정규화 좌표 두 점 → 템플릿 두 점으로 변환을 구해 warp
+bool alignTwoPoints(const uint8_t* rgba, int width, int height, const float* normalized, const float* templateRatio,
+                    int size, uint8_t* out) {
+    if (rgba == nullptr || out == nullptr || width <= 0 || height <= 0 || size <= 0) return false;
+    const float source[4] = {normalized[0] * width, normalized[1] * height, normalized[2] * width,
+                             normalized[3] * height};
+    const float target[4] = {templateRatio[0] * size, templateRatio[1] * size, templateRatio[2] * size,
+                             templateRatio[3] * size};
+    SimilarityTransform transform;
+    if (!estimateSimilarity(source, target, 2, transform)) return false;
+    warpSimilarity(rgba, width, height, transform, size, out);
+    return true;
+}
+
+} // namespace
+
+bool estimateSimilarity(const float* source, const float* target, int count, SimilarityTransform& transform) {
+    if (source == nullptr || target == nullptr || count < 2) return false;
+
+    double sx = 0.0, sy = 0.0, tx = 0.0, ty = 0.0;
+    for (int i = 0; i < count; i++) {
+        sx += source[i * 2];
+        sy += source[i * 2 + 1];
+        tx += target[i * 2];
+        ty += target[i * 2 + 1];
+    }
+    sx /= count;
+    sy /= count;
+    tx /= count;
+    ty /= count;
+
+    // 중심을 뺀 좌표에서 a = Σ(s·t) / Σ|s|², b = Σ(s × t) / Σ|s|²
+    double dot = 0.0, cross = 0.0, norm = 0.0;
+    for (int i = 0; i < count; i++) {
+        double px = source[i * 2] - sx, py = source[i * 2 + 1] - sy;
+        double qx = target[i * 2] - tx, qy = target[i * 2 + 1] - ty;
+        dot += px * qx + py * qy;
+        cross += px * qy - py * qx;
+        norm += px * px + py * py;
+    }
+    if (norm < 1e-12) return false;
+
+    double a = dot / norm;
+    double b = cross / norm;
+    transform.a = static_cast<float>(a);
+    transform.b = static_cast<float>(b);
+    transform.tx = static_cast<float>(tx - (a * sx - b * sy));
+    transform.ty = static_cast<float>(ty - (b * sx + a * sy));
+    return true;
+}
+
+void warpSimilarity(const uint8_t* rgba, int width, int height, const SimilarityTransform& sourceToCrop, int size,
+                    uint8_t* out) {
+    // 역변환: 출력 (u, v) → 원본 (x, y), 한 행 안에서 x, y는 u에 대해 선형
+    const float scale2 = sourceToCrop.a * sourceToCrop.a + sourceToCrop.b * sourceToCrop.b;
+    if (scale2 < 1e-20f) return;
+    const float ia = sourceToCrop.a / scale2;
+    const float ib = sourceToCrop.b / scale2;
+    auto sourceX = [&](float u, float v) { return ia * (u - sourceToCrop.tx) + ib * (v - sourceToCrop.ty); };
+    auto sourceY = [&](float u, float v) { return -ib * (u - sourceToCrop.tx) + ia * (v - sourceToCrop.ty); };
+
+    const int* pixels = reinterpret_cast<const int*>(rgba);
+    const __m256 ramp = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i maxX = _mm256_set1_epi32(width - 1);
+    const __m256i maxY = _mm256_set1_epi32(height - 1);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i rowStride = _mm256_set1_epi32(width);
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+
+    for (int v = 0; v < size; v++) {
+        // 픽셀 중심 (u + 0.5, v + 0.5) → 원본 연속 좌표, 원본 픽셀 i의 중심은 i + 0.5
+        const float rowX = sourceX(0.5f, v + 0.5f) - 0.5f;
+        const float rowY = sourceY(0.5f, v + 0.5f) - 0.5f;
+        uint32_t* outRow = reinterpret_cast<uint32_t*>(out) + static_cast<size_t>(v) * size;
+
+        int u = 0;
+        for (; u + SIMD_WIDTH <= size; u += SIMD_WIDTH) {
+            __m256 steps = _mm256_add_ps(ramp, _mm256_set1_ps(static_cast<float>(u)));
+            __m256 x = _mm256_add_ps(_mm256_set1_ps(rowX), _mm256_mul_ps(steps, _mm256_set1_ps(ia)));
+            __m256 y = _mm256_add_ps(_mm256_set1_ps(rowY), _mm256_mul_ps(steps, _mm256_set1_ps(-ib)));
+            __m256 x0f = _mm256_floor_ps(x);
+            __m256 y0f = _mm256_floor_ps(y);
+            __m256 wx = _mm256_sub_ps(x, x0f);
+            __m256 wy = _mm256_sub_ps(y, y0f);
+
+            __m256i x0 = _mm256_cvtps_epi32(x0f);
+            __m256i y0 = _mm256_cvtps_epi32(y0f);
+            __m256i x1 = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(x0, one), zero), maxX);
+            __m256i y1 = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(y0, one), zero), maxY);
+            x0 = _mm256_min_epi32(_mm256_max_epi32(x0, zero), maxX);
+            y0 = _mm256_min_epi32(_mm256_max_epi32(y0, zero), maxY);
+            __m256i top = _mm256_mullo_epi32(y0, rowStride);
+            __m256i bottom = _mm256_mullo_epi32(y1, rowStride);
+
+            __m256i p00 = _mm256_i32gather_epi32(pixels, _mm256_add_epi32(top, x0), 4);
+            __m256i p01 = _mm256_i32gather_epi32(pixels, _mm256_add_epi32(top, x1), 4);
+            __m256i p10 = _mm256_i32gather_epi32(pixels, _mm256_add_epi32(bottom, x0), 4);
+            __m256i p11 = _mm256_i32gather_epi32(pixels, _mm256_add_epi32(bottom, x1), 4);
+
+            __m256i result = zero;
+            for (int shift = 0; shift < 32; shift += 8) {
+                __m256 c00 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p00, shift), byteMask));
+                __m256 c01 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p01, shift), byteMask));
+                __m256 c10 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p10, shift), byteMask));
+                __m256 c11 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p11, shift), byteMask));
+                __m256 upper = _mm256_add_ps(c00, _mm256_mul_ps(wx, _mm256_sub_ps(c01, c00)));
+                __m256 lower = _mm256_add_ps(c10, _mm256_mul_ps(wx, _mm256_sub_ps(c11, c10)));
+                __m256 value = _mm256_add_ps(upper, _mm256_mul_ps(wy, _mm256_sub_ps(lower, upper)));
+                __m256i channel = _mm256_cvttps_epi32(_mm256_add_ps(value, half));
+                result = _mm256_or_si256(result, _mm256_slli_epi32(channel, shift));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(outRow + u), result);
+        }
+
+        for (; u < size; u++) {
+            float x = rowX + u * ia;
+            float y = rowY - u * ib;
+            float x0f = std::floor(x), y0f = std::floor(y);
+            float wx = x - x0f, wy = y - y0f;
+            int x0 = static_cast<int>(x0f), y0 = static_cast<int>(y0f);
+            int x1 = clampIndex(x0 + 1, width), y1 = clampIndex(y0 + 1, height);
+            x0 = clampIndex(x0, width);
+            y0 = clampIndex(y0, height);
+            const uint8_t* p00 = rgba + (static_cast<size_t>(y0) * width + x0) * 4;
+            const uint8_t* p01 = rgba + (static_cast<size_t>(y0) * width + x1) * 4;
+            const uint8_t* p10 = rgba + (static_cast<size_t>(y1) * width + x0) * 4;
+            const uint8_t* p11 = rgba + (static_cast<size_t>(y1) * width + x1) * 4;
+            uint8_t* target = reinterpret_cast<uint8_t*>(outRow + u);
+            for (int c = 0; c < 4; c++) {
+                float upper = p00[c] + wx * (p01[c] - p00[c]);
+                float lower = p10[c] + wx * (p11[c] - p10[c]);
+                target[c] = static_cast<uint8_t>(upper + wy * (lower - upper) + 0.5f);
+            }
+        }
+    }
+}
+
+bool alignHandCrop(const uint8_t* rgba, int width, int height, const float* landmarks, int count, int size,
+                   uint8_t* out) {
+    const int components = count == 63 ? 3 : (count == 42 ? 2 : 0);
+    if (landmarks == nullptr || components == 0) return false;
+    const float points[4] = {landmarks[0], landmarks[1], landmarks[9 * components], landmarks[9 * components + 1]};
+    const float templateRatio[4] = {HAND_WRIST_X, HAND_WRIST_Y, HAND_MCP_X, HAND_MCP_Y};
+    return alignTwoPoints(rgba, width, height, points, templateRatio, size, out);
+}
+
+bool alignFaceCrop(const uint8_t* rgba, int width, int height, float leftEyeX, float leftEyeY, float rightEyeX,
+                   float rightEyeY, int size, uint8_t* out) {
+    const float points[4] = {leftEyeX, leftEyeY, rightEyeX, rightEyeY};
+    const float templateRatio[4] = {FACE_LEFT_EYE_X, FACE_EYE_Y, FACE_RIGHT_EYE_X, FACE_EYE_Y};
+    return alignTwoPoints(rgba, width, height, points, templateRatio, size, out);
+}
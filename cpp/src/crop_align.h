@@ -0,0 +1,36 @@
+#ifndef CROP_ALIGN_H
+#define CROP_ALIGN_H
+
+#include <cstdint>
+
+// 2차원 닮음 변환 (회전 + 균일 배율 + 이동, 반사 없음)
+// x' = a·x − b·y + tx,  y' = b·x + a·y + ty
+struct SimilarityTransform {
+    float a = 1.0f;
+    float b = 0.0f;
+    float tx = 0.0f;
+    float ty = 0.0f;
+};
+
+// source 점들을 target 점들로 옮기는 최소제곱 닮음 변환 (x, y 쌍 count개)
+// 두 점이면 정확히 맞고, 더 많으면 제곱 오차 합이 최소 (Umeyama 2차원 닫힌 형태)
+// 점이 모두 한 곳에 모여 있으면 false
+bool estimateSimilarity(const float* source, const float* target, int count, SimilarityTransform& transform);
+
+// RGBA 영상을 sourceToCrop으로 옮긴 size × size RGBA를 out에 기록 (회전된 중간 영상 없이 한 번에)
+// 출력 픽셀 중심을 역변환해 원본에서 쌍선형 보간하며, AVX2로 8픽셀씩 이웃 4개를 gather합니다.
+// 영상 밖은 가장자리 픽셀을 복제합니다.
+void warpSimilarity(const uint8_t* rgba, int width, int height, const SimilarityTransform& sourceToCrop, int size,
+                    uint8_t* out);
+
+// 손 정렬: 정규화 랜드마크(42/63개 float, 0–1)의 손목(0) → 중지 MCP(9) 축을 세로로 세우고
+// 손목을 아래쪽, MCP를 가운데 조금 위에 둔 size × size 영역 (왼손/오른손 모두 반사 없이)
+bool alignHandCrop(const uint8_t* rgba, int width, int height, const float* landmarks, int count, int size,
+                   uint8_t* out);
+
+// 얼굴 정렬: 정규화 좌표(0–1)의 두 눈 중심(영상 왼쪽 눈, 오른쪽 눈)을 수평으로 맞춘 size × size 영역
+// (눈 위치는 흔히 쓰는 112×112 얼굴 인식 템플릿 비율)
+bool alignFaceCrop(const uint8_t* rgba, int width, int height, float leftEyeX, float leftEyeY, float rightEyeX,
+                   float rightEyeY, int size, uint8_t* out);
+
+#endif // CROP_ALIGN_H
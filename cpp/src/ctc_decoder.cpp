@@ -0,0 +1,274 @@
+#include "ctc_decoder.h"
+#include <algorithm>
+#include <cmath>
+#include "output_head.h"
+
+namespace {
+
+// -ffast-math에서는 무한대를 쓸 수 없으므로 충분히 작은 유한값 사용
+constexpr float LOG_ZERO = -1e30f;
+
+constexpr int MIN_COMPACT_NODES = 1024;
+constexpr int COMPACT_INTERVAL = 64;   // 확정 출력을 내보내는 최대 프레임 간격
+
+inline float logAdd(float a, float b) {
+    if (a < b) std::swap(a, b);
+    if (b <= LOG_ZERO * 0.5f) return a;
+    return a + std::log1p(std::exp(b - a));
+}
+
+inline uint32_t hashKey(int parent, int label) {
+    uint32_t h = static_cast<uint32_t>(parent) * 0x9E3779B1u ^ static_cast<uint32_t>(label) * 0x85EBCA77u;
+    return h ^ (h >> 15);
+}
+
+} // namespace
+
+CtcBeamDecoder::CtcBeamDecoder(int numClasses, const CtcDecoderConfig& config)
+    : classes(std::max(1, numClasses)), settings(config), frameStamp(0), compactLimit(MIN_COMPACT_NODES) {
+    settings.beamWidth = std::max(1, settings.beamWidth);
+    settings.maxCandidates = std::max(1, settings.maxCandidates);
+    settings.blank = std::max(0, std::min(settings.blank, classes - 1));
+    allowedClass.assign(classes, 1);
+    frameScratch.resize(classes);
+    classOrder.reserve(classes);
+    reset();
+}
+
+void CtcBeamDecoder::setLexicon(const std::vector<int>& allowed) {
+    allowedClass.assign(classes, allowed.empty() ? 1 : 0);
+    for (int c : allowed) {
+        if (c >= 0 && c < classes) allowedClass[c] = 1;
+    }
+}
+
+bool CtcBeamDecoder::setBigram(const float* probabilities, int count) {
+    if (probabilities == nullptr) {
+        bigramLog.clear();
+        reset();
+        return true;
+    }
+    if (count != (classes + 1) * classes) return false;
+
+    bigramLog.resize(count);
+    for (int i = 0; i < count; i++) {
+        bigramLog[i] = std::log(std::max(probabilities[i], 1e-8f));
+    }
+    // 노드에 누적된 사전 확률이 바뀌므로 처음부터 다시 디코딩
+    reset();
+    return true;
+}
+
+void CtcBeamDecoder::reset() {
+    nodes.clear();
+    nodes.push_back({-1, -1, 0.0f, -1, -1});
+    childTable.assign(MIN_COMPACT_NODES * 2, -1);
+    beams.clear();
+    beams.push_back({0, 0.0f, LOG_ZERO, 0.0f});
+    committed.clear();
+    frameStamp = 0;
+    compactLimit = std::max(MIN_COMPACT_NODES,
+                            settings.beamWidth * std::min(classes, settings.maxCandidates) * 8);
+}
+
+void CtcBeamDecoder::pushLogits(const float* logits, int frames) {
+    for (int f = 0; f < frames; f++) {
+        const float* row = logits + static_cast<size_t>(f) * classes;
+        float logNorm = logSumExp(row, classes);
+        for (int c = 0; c < classes; c++) frameScratch[c] = row[c] - logNorm;
+        step(frameScratch.data());
+    }
+}
+
+void CtcBeamDecoder::pushLogProbs(const float* logProbs, int frames) {
+    for (int f = 0; f < frames; f++) {
+        step(logProbs + static_cast<size_t>(f) * classes);
+    }
+}
+
+// 접두사 + label 노드 (없으면 풀에 추가)
+int CtcBeamDecoder::childOf(int node, int label) {
+    uint32_t mask = static_cast<uint32_t>(childTable.size() - 1);
+    uint32_t slot = hashKey(node, label) & mask;
+    while (childTable[slot] >= 0) {
+        const Node& n = nodes[childTable[slot]];
+        if (n.parent == node && n.label == label) return childTable[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back({node, label, nodes[node].lmScore + extensionPrior(node, label), -1, -1});
+    childTable[slot] = index;
+
+    // 적재율 1/2 초과 시 테이블 확장
+    if (nodes.size() * 2 > childTable.size()) {
+        childTable.assign(childTable.size() * 2, -1);
+        mask = static_cast<uint32_t>(childTable.size() - 1);
+        for (int i = 1; i < static_cast<int>(nodes.size()); i++) {
+            uint32_t s = hashKey(nodes[i].parent, nodes[i].label) & mask;
+            while (childTable[s] >= 0) s = (s + 1) & mask;
+            childTable[s] = i;
+        }
+    }
+    return index;
+}
+
+int CtcBeamDecoder::candidateFor(int node) {
+    Node& n = nodes[node];
+    if (n.stamp != frameStamp) {
+        n.stamp = frameStamp;
+        n.candidate = static_cast<int>(candidates.size());
+        candidates.push_back({node, LOG_ZERO, LOG_ZERO, 0.0f});
+    }
+    return n.candidate;
+}
+
+float CtcBeamDecoder::extensionPrior(int node, int label) const {
+    float prior = settings.insertionBonus;
+    if (!bigramLog.empty()) {
+        int previous = nodes[node].label;
+        int row = previous < 0 ? classes : previous;
+        prior += settings.lmWeight * bigramLog[static_cast<size_t>(row) * classes + label];
+    }
+    return prior;
+}
+
+// 한 프레임 prefix 빔 탐색
+void CtcBeamDecoder::step(const float* logProbs) {
+    frameStamp++;
+    candidates.clear();
+
+    // 확장할 클래스: 허용 목록 안에서 log 확률 임계값 이상, 최대 maxCandidates개
+    const int blank = settings.blank;
+    float best = *std::max_element(logProbs, logProbs + classes);
+    classOrder.clear();
+    for (int c = 0; c < classes; c++) {
+        if (c != blank && allowedClass[c] && logProbs[c] >= best + settings.classPruneLogProb) {
+            classOrder.push_back(c);
+        }
+    }
+    if (static_cast<int>(classOrder.size()) > settings.maxCandidates) {
+        std::nth_element(classOrder.begin(), classOrder.begin() + settings.maxCandidates, classOrder.end(),
+                         [logProbs](int a, int b) { return logProbs[a] > logProbs[b]; });
+        classOrder.resize(settings.maxCandidates);
+    }
+
+    for (const Beam& beam : beams) {
+        const int node = beam.node;
+        const int last = nodes[node].label;
+        const float total = logAdd(beam.blankScore, beam.labelScore);
+
+        // 공백: 접두사 유지, 공백으로 끝남
+        int self = candidateFor(node);
+        candidates[self].blankScore = logAdd(candidates[self].blankScore, total + logProbs[blank]);
+
+        // 같은 라벨 반복: 축약되어 접두사 유지
+        if (last >= 0) {
+            candidates[self].labelScore = logAdd(candidates[self].labelScore, beam.labelScore + logProbs[last]);
+        }
+
+        // 새 라벨 추가 (같은 라벨은 사이에 공백이 있어야 새 라벨)
+        for (int c : classOrder) {
+            int child = candidateFor(childOf(node, c));
+            float score = (c == last ? beam.blankScore : total) + logProbs[c];
+            candidates[child].labelScore = logAdd(candidates[child].labelScore, score);
+        }
+    }
+
+    selectBeams();
+
+    if (static_cast<int>(nodes.size()) > compactLimit || frameStamp % COMPACT_INTERVAL == 0) {
+        compact();
+    }
+}
+
+// 상위 beamWidth개 가설 선택 (부분 정렬), 최고 가설을 맨 앞에 두고 점수 정규화
+void CtcBeamDecoder::selectBeams() {
+    for (Beam& c : candidates) {
+        c.total = logAdd(c.blankScore, c.labelScore) + nodes[c.node].lmScore;
+    }
+    auto byScore = [](const Beam& a, const Beam& b) { return a.total > b.total; };
+    if (static_cast<int>(candidates.size()) > settings.beamWidth) {
+        std::nth_element(candidates.begin(), candidates.begin() + settings.beamWidth, candidates.end(), byScore);
+        candidates.resize(settings.beamWidth);
+    }
+    std::iter_swap(candidates.begin(), std::min_element(candidates.begin(), candidates.end(), byScore));
+
+    // 긴 스트림에서 log 점수가 계속 작아지지 않도록 최고 음향 점수 기준으로 이동
+    float offset = logAdd(candidates[0].blankScore, candidates[0].labelScore);
+    for (Beam& c : candidates) {
+        c.blankScore -= offset;
+        c.labelScore -= offset;
+        c.total -= offset;
+    }
+    beams.swap(candidates);
+}
+
+// 모든 빔의 공통 조상까지를 확정 출력으로 옮기고, 살아 있는 노드만 남겨 풀을 재구성
+void CtcBeamDecoder::compact() {
+    const int nodeCount = static_cast<int>(nodes.size());
+    const int beamCount = static_cast<int>(beams.size());
+
+    // 노드별로 지나가는 빔 수 (candidate 필드를 계수기로 재사용)
+    for (Node& n : nodes) n.candidate = 0;
+    for (const Beam& beam : beams) {
+        for (int n = beam.node; n >= 0; n = nodes[n].parent) nodes[n].candidate++;
+    }
+
+    int newRoot = beams[0].node;
+    while (nodes[newRoot].candidate < beamCount) newRoot = nodes[newRoot].parent;
+
+    // 기존 root 다음부터 새 root까지의 라벨 확정
+    size_t firstNew = committed.size();
+    for (int n = newRoot; n > 0; n = nodes[n].parent) committed.push_back(nodes[n].label);
+    std::reverse(committed.begin() + firstNew, committed.end());
+
+    // 새 root의 자손 중 빔이 지나가는 노드만 유지 (부모는 항상 자식보다 앞 번호)
+    std::vector<int>& remap = classOrder;
+    remap.assign(nodeCount, -1);
+    const float rootLm = nodes[newRoot].lmScore;
+    int kept = 0;
+    for (int i = newRoot; i < nodeCount; i++) {
+        const Node& n = nodes[i];
+        if (i != newRoot && (n.candidate == 0 || n.parent < newRoot || remap[n.parent] < 0)) continue;
+        Node moved = {i == newRoot ? -1 : remap[n.parent], n.label, n.lmScore - rootLm, -1, -1};
+        remap[i] = kept;
+        nodes[kept++] = moved;
+    }
+    nodes.resize(kept);
+    for (Beam& beam : beams) beam.node = remap[beam.node];
+
+    childTable.assign(childTable.size(), -1);
+    uint32_t mask = static_cast<uint32_t>(childTable.size() - 1);
+    for (int i = 1; i < kept; i++) {
+        uint32_t s = hashKey(nodes[i].parent, nodes[i].label) & mask;
+        while (childTable[s] >= 0) s = (s + 1) & mask;
+        childTable[s] = i;
+    }
+
+    frameStamp = 0;
+    if (kept * 2 > compactLimit) compactLimit *= 2;
+}
+
+void CtcBeamDecoder::bestPath(std::vector<int>& labels) const {
+    labels = committed;
+    size_t firstNew = labels.size();
+    for (int n = beams[0].node; n > 0; n = nodes[n].parent) labels.push_back(nodes[n].label);
+    std::reverse(labels.begin() + firstNew, labels.end());
+}
+
+std::string CtcBeamDecoder::bestPathJson() const {
+    std::vector<int> labels;
+    bestPath(labels);
+    std::string json = "{\"labels\":[";
+    for (size_t i = 0; i < labels.size(); i++) {
+        if (i > 0) json += ",";
+        json += std::to_string(labels[i]);
+    }
+    json += "],\"committed\":" + std::to_string(committed.size()) + "}";
+    return json;
+}
+
+float CtcBeamDecoder::bestScore() const {
+    return beams[0].total;
+}
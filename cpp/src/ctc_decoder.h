@@ -0,0 +1,95 @@
+#ifndef CTC_DECODER_H
+#define CTC_DECODER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 빔 탐색 설정
+struct CtcDecoderConfig {
+    int beamWidth = 16;
+    int blank = 0;                    // 공백(수어 없음) 클래스 번호
+    float classPruneLogProb = -10.0f; // 프레임 최고 log 확률보다 이만큼 낮은 클래스는 확장하지 않음
+    int maxCandidates = 32;           // 프레임당 확장할 최대 클래스 수
+    float lmWeight = 0.5f;            // 바이그램 log 확률 가중치
+    float insertionBonus = 0.0f;      // 단어(수어) 하나를 추가할 때마다 더하는 점수
+};
+
+// 연속 수어용 스트리밍 CTC prefix 빔 탐색 디코더
+// 프레임마다 클래스 logit(또는 log 확률)을 받아 공백/반복 축약 규칙으로 접두사 가설을 확장하고,
+// 선택적으로 어휘 제한(lexicon)과 바이그램 사전 확률을 적용합니다.
+// - 가설은 접두사 트리 노드 풀에 저장되어 같은 접두사를 공유하고 프레임마다 할당하지 않습니다.
+// - 상위 beamWidth개 선택은 nth_element 부분 정렬을 사용합니다.
+// - 모든 빔이 공유하는 접두사는 확정 출력으로 옮기고 트리를 압축하므로 긴 스트림에서도 메모리가 일정합니다.
+class CtcBeamDecoder {
+public:
+    explicit CtcBeamDecoder(int numClasses, const CtcDecoderConfig& config = CtcDecoderConfig());
+
+    // 허용 클래스 목록 (비어 있으면 전체 허용)
+    void setLexicon(const std::vector<int>& allowed);
+
+    // 바이그램 확률: (numClasses + 1) × numClasses, 마지막 행은 문장 시작 분포
+    // 크기가 맞지 않으면 false (nullptr이면 해제)
+    bool setBigram(const float* probabilities, int count);
+
+    // frames × numClasses logit (내부에서 log-softmax)
+    void pushLogits(const float* logits, int frames = 1);
+
+    // frames × numClasses log 확률
+    void pushLogProbs(const float* logProbs, int frames = 1);
+
+    // 확정 출력 + 현재 최고 가설의 라벨 열
+    void bestPath(std::vector<int>& labels) const;
+    std::string bestPathJson() const;
+    float bestScore() const;
+
+    // 모든 빔이 합의하여 더 이상 바뀌지 않는 라벨 수
+    int committedLength() const { return static_cast<int>(committed.size()); }
+
+    int numClasses() const { return classes; }
+    const CtcDecoderConfig& config() const { return settings; }
+
+    void reset();
+
+private:
+    // 접두사 트리 노드 (root는 빈 접두사)
+    struct Node {
+        int parent;
+        int label;        // 마지막 라벨 (root는 -1)
+        float lmScore;    // 누적 사전 확률 점수
+        int stamp;        // 이번 프레임 후보 표시
+        int candidate;    // 이번 프레임 후보 번호
+    };
+
+    // 빔 가설 (log 영역)
+    struct Beam {
+        int node;
+        float blankScore;     // 공백으로 끝나는 경로
+        float labelScore;     // 라벨로 끝나는 경로
+        float total;
+    };
+
+    int childOf(int node, int label);
+    int candidateFor(int node);
+    float extensionPrior(int node, int label) const;
+    void step(const float* logProbs);
+    void selectBeams();
+    void compact();
+
+    int classes;
+    CtcDecoderConfig settings;
+    std::vector<uint8_t> allowedClass;
+    std::vector<float> bigramLog;          // 비어 있으면 사전 확률 없음
+
+    std::vector<Node> nodes;
+    std::vector<int> childTable;           // (parent, label) → node 개방 주소 해시
+    std::vector<Beam> beams;
+    std::vector<Beam> candidates;
+    std::vector<float> frameScratch;
+    std::vector<int> classOrder;
+    std::vector<int> committed;
+    int frameStamp;
+    int compactLimit;
+};
+
+#endif // CTC_DECODER_H
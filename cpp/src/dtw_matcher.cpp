@@ -0,0 +1,277 @@
+#include "dtw_matcher.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <immintrin.h>
+
+namespace {
+
+// -ffast-math에서 무한대 대신 사용하는 큰 유한값
+constexpr float DTW_INFINITY = 1e30f;
+
+inline float horizontalSum(__m256 v) {
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    __m128 shuf = _mm_movehdup_ps(lo);
+    __m128 sums = _mm_add_ps(lo, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+} // namespace
+
+DtwMatcher::DtwMatcher(int dims, int length, int band)
+    : featureDims(std::max(1, dims)),
+      stride(padToSimd(std::max(1, dims))),
+      sequenceLength(std::max(2, length)),
+      band(std::max(0, std::min(band, std::max(2, length) - 1))) {
+    sequenceFloats = static_cast<size_t>(sequenceLength) * stride;
+    query.resize(sequenceFloats);
+    queryUpper.resize(sequenceFloats);
+    queryLower.resize(sequenceFloats);
+    projection.resize(sequenceFloats);
+    projectionUpper.resize(sequenceFloats);
+    projectionLower.resize(sequenceFloats);
+    frameBound.resize(sequenceLength);
+    reverseBound.resize(sequenceLength);
+    cumulativeBound.resize(sequenceLength);
+    costRows.resize(static_cast<size_t>(sequenceLength) * 2);
+}
+
+bool DtwMatcher::addTemplate(const float* frames, int frameCount, int label) {
+    if (frames == nullptr || frameCount < 2) return false;
+
+    size_t offset = sequences.size();
+    sequences.resize(offset + sequenceFloats);
+    uppers.resize(offset + sequenceFloats);
+    lowers.resize(offset + sequenceFloats);
+    resample(frames, frameCount, sequences.data() + offset);
+    envelope(sequences.data() + offset, uppers.data() + offset, lowers.data() + offset);
+    labels.push_back(label);
+    return true;
+}
+
+void DtwMatcher::clear() {
+    sequences.clear();
+    uppers.clear();
+    lowers.clear();
+    labels.clear();
+}
+
+void DtwMatcher::resample(const float* frames, int frameCount, float* out) const {
+    const float step = static_cast<float>(frameCount - 1) / (sequenceLength - 1);
+    for (int i = 0; i < sequenceLength; i++) {
+        float position = i * step;
+        int f0 = std::min(static_cast<int>(position), frameCount - 2);
+        float t = position - f0;
+        const float* a = frames + static_cast<size_t>(f0) * featureDims;
+        const float* b = a + featureDims;
+        float* row = out + static_cast<size_t>(i) * stride;
+        for (int d = 0; d < featureDims; d++) row[d] = a[d] + (b[d] - a[d]) * t;
+        for (int d = featureDims; d < stride; d++) row[d] = 0.0f;
+    }
+}
+
+void DtwMatcher::envelope(const float* sequence, float* upper, float* lower) const {
+    for (int i = 0; i < sequenceLength; i++) {
+        int first = std::max(0, i - band);
+        int last = std::min(sequenceLength - 1, i + band);
+        for (int d = 0; d < stride; d += SIMD_WIDTH) {
+            __m256 hi = _mm256_load_ps(sequence + static_cast<size_t>(first) * stride + d);
+            __m256 lo = hi;
+            for (int j = first + 1; j <= last; j++) {
+                __m256 v = _mm256_load_ps(sequence + static_cast<size_t>(j) * stride + d);
+                hi = _mm256_max_ps(hi, v);
+                lo = _mm256_min_ps(lo, v);
+            }
+            _mm256_store_ps(upper + static_cast<size_t>(i) * stride + d, hi);
+            _mm256_store_ps(lower + static_cast<size_t>(i) * stride + d, lo);
+        }
+    }
+}
+
+// 제곱 유클리드 거리 (누산기 2개로 의존성 분산)
+float DtwMatcher::frameDistance(const float* a, const float* b) const {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    int d = 0;
+    for (; d + 2 * SIMD_WIDTH <= stride; d += 2 * SIMD_WIDTH) {
+        __m256 d0 = _mm256_sub_ps(_mm256_load_ps(a + d), _mm256_load_ps(b + d));
+        __m256 d1 = _mm256_sub_ps(_mm256_load_ps(a + d + SIMD_WIDTH), _mm256_load_ps(b + d + SIMD_WIDTH));
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(d0, d0));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(d1, d1));
+    }
+    if (d < stride) {
+        __m256 d0 = _mm256_sub_ps(_mm256_load_ps(a + d), _mm256_load_ps(b + d));
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(d0, d0));
+    }
+    return horizontalSum(_mm256_add_ps(acc0, acc1));
+}
+
+// 포락선 밖으로 벗어난 양의 제곱합
+float DtwMatcher::lbKeogh(const float* sequence, const float* upper, const float* lower, float* perFrame,
+                          float limit) const {
+    const __m256 zero = _mm256_setzero_ps();
+    float total = 0.0f;
+    for (int i = 0; i < sequenceLength; i++) {
+        size_t row = static_cast<size_t>(i) * stride;
+        __m256 acc = _mm256_setzero_ps();
+        for (int d = 0; d < stride; d += SIMD_WIDTH) {
+            __m256 v = _mm256_load_ps(sequence + row + d);
+            __m256 above = _mm256_max_ps(_mm256_sub_ps(v, _mm256_load_ps(upper + row + d)), zero);
+            __m256 below = _mm256_max_ps(_mm256_sub_ps(_mm256_load_ps(lower + row + d), v), zero);
+            __m256 outside = _mm256_add_ps(above, below);
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(outside, outside));
+        }
+        float frame = horizontalSum(acc);
+        if (perFrame != nullptr) perFrame[i] = frame;
+        total += frame;
+        if (total >= limit) return total;
+    }
+    return total;
+}
+
+// 띠 제한 DTW, limit 이상이 확실해지면 중단하고 limit 이상 값 반환
+float DtwMatcher::dtw(const float* q, const float* candidate, const float* bound, float limit) {
+    const int n = sequenceLength;
+    float* previous = costRows.data();
+    float* current = previous + n;
+
+    for (int i = 0; i < n; i++) {
+        int first = std::max(0, i - band);
+        int last = std::min(n - 1, i + band);
+        std::fill(current, current + n, DTW_INFINITY);
+
+        const float* qRow = q + static_cast<size_t>(i) * stride;
+        float rowMin = DTW_INFINITY;
+        for (int j = first; j <= last; j++) {
+            float best;
+            if (i == 0) {
+                best = j == 0 ? 0.0f : current[j - 1];
+            } else {
+                best = previous[j];
+                if (j > 0) best = std::min(best, std::min(previous[j - 1], current[j - 1]));
+            }
+            float cost = best + frameDistance(qRow, candidate + static_cast<size_t>(j) * stride);
+            current[j] = cost;
+            rowMin = std::min(rowMin, cost);
+        }
+
+        if (rowMin + bound[i] >= limit) return rowMin + bound[i];
+        std::swap(previous, current);
+    }
+    return previous[n - 1];
+}
+
+int DtwMatcher::match(const float* frames, int frameCount, DtwMatch* results, int k, float maxDistance) {
+    lastStats = DtwStats();
+    lastStats.templates = templateCount();
+    if (frames == nullptr || frameCount < 2 || results == nullptr || k <= 0) return 0;
+
+    const int n = sequenceLength;
+    resample(frames, frameCount, query.data());
+    envelope(query.data(), queryUpper.data(), queryLower.data());
+
+    // 제곱 거리 합 기준 임계값 (거리 = sqrt(합 / 프레임 수))
+    const float maxSum = maxDistance > 0.0f ? maxDistance * maxDistance * n : DTW_INFINITY;
+    std::vector<float> bestSums;
+    std::vector<int> bestIndices;
+    bestSums.reserve(k + 1);
+    bestIndices.reserve(k + 1);
+
+    const float* qFirst = query.data();
+    const float* qLast = query.data() + static_cast<size_t>(n - 1) * stride;
+
+    for (int t = 0; t < templateCount(); t++) {
+        const float limit = static_cast<int>(bestSums.size()) == k ? bestSums.back() : maxSum;
+        const size_t offset = static_cast<size_t>(t) * sequenceFloats;
+        const float* candidate = sequences.data() + offset;
+
+        // 1. 양 끝 프레임은 모든 정렬 경로에 포함
+        float kim = frameDistance(qFirst, candidate) +
+                    frameDistance(qLast, candidate + static_cast<size_t>(n - 1) * stride);
+        if (kim >= limit) {
+            lastStats.prunedKim++;
+            continue;
+        }
+
+        // 2. 질의가 템플릿 포락선을 벗어난 양
+        float lb = lbKeogh(query.data(), uppers.data() + offset, lowers.data() + offset, frameBound.data(), limit);
+        if (lb >= limit) {
+            lastStats.prunedKeogh++;
+            continue;
+        }
+
+        // 3. 템플릿이 질의 포락선을 벗어난 양
+        float reverse = lbKeogh(candidate, queryUpper.data(), queryLower.data(), reverseBound.data(), limit);
+        if (reverse >= limit) {
+            lastStats.prunedReverse++;
+            continue;
+        }
+
+        // 4. LB_Improved: 질의를 템플릿 포락선에 투영한 시퀀스의 포락선으로 두 번째 항 추가
+        {
+            const float* upper = uppers.data() + offset;
+            const float* lower = lowers.data() + offset;
+            for (size_t i = 0; i < sequenceFloats; i += SIMD_WIDTH) {
+                __m256 v = _mm256_load_ps(query.data() + i);
+                v = _mm256_min_ps(_mm256_max_ps(v, _mm256_load_ps(lower + i)), _mm256_load_ps(upper + i));
+                _mm256_store_ps(projection.data() + i, v);
+            }
+            envelope(projection.data(), projectionUpper.data(), projectionLower.data());
+            float improved = lb + lbKeogh(candidate, projectionUpper.data(), projectionLower.data(), nullptr, limit - lb);
+            if (improved >= limit) {
+                lastStats.prunedImproved++;
+                continue;
+            }
+        }
+
+        // 5. 행 i 이후 남은 비용의 하한: 질의 프레임 i+1.. / 템플릿 프레임 i+band+1.. 중 큰 쪽
+        float querySuffix = 0.0f;
+        for (int i = n - 1; i >= 0; i--) {
+            cumulativeBound[i] = querySuffix;
+            querySuffix += frameBound[i];
+        }
+        float templateSuffix = 0.0f;
+        for (int i = n - 1; i >= 0; i--) {
+            if (i + band + 1 < n) templateSuffix += reverseBound[i + band + 1];
+            cumulativeBound[i] = std::max(cumulativeBound[i], templateSuffix);
+        }
+
+        float sum = dtw(query.data(), candidate, cumulativeBound.data(), limit);
+        if (sum >= limit) {
+            lastStats.abandoned++;
+            continue;
+        }
+        lastStats.fullDtw++;
+
+        // k개 최근접 유지 (삽입 정렬)
+        int position = static_cast<int>(bestSums.size());
+        while (position > 0 && bestSums[position - 1] > sum) position--;
+        bestSums.insert(bestSums.begin() + position, sum);
+        bestIndices.insert(bestIndices.begin() + position, t);
+        if (static_cast<int>(bestSums.size()) > k) {
+            bestSums.pop_back();
+            bestIndices.pop_back();
+        }
+    }
+
+    for (size_t r = 0; r < bestSums.size(); r++) {
+        results[r].label = labels[bestIndices[r]];
+        results[r].templateIndex = bestIndices[r];
+        results[r].distance = std::sqrt(bestSums[r] / n);
+    }
+    return static_cast<int>(bestSums.size());
+}
+
+std::string DtwMatcher::matchJson(const float* frames, int frameCount, float maxDistance) {
+    DtwMatch best;
+    match(frames, frameCount, &best, 1, maxDistance);
+
+    char buffer[192];
+    std::snprintf(buffer, sizeof(buffer),
+                  "{\"label\":%d,\"templateIndex\":%d,\"distance\":%.5f,\"templates\":%d,\"dtw\":%d}",
+                  best.label, best.templateIndex, best.distance, lastStats.templates,
+                  lastStats.fullDtw + lastStats.abandoned);
+    return std::string(buffer);
+}
@@ -0,0 +1,87 @@
+#ifndef DTW_MATCHER_H
+#define DTW_MATCHER_H
+
+#include <string>
+#include <vector>
+#include "mlp_model.h"
+
+// 템플릿 정합 결과
+struct DtwMatch {
+    int label = -1;           // 템플릿 라벨 (-1: 임계값 안에 없음)
+    int templateIndex = -1;
+    float distance = 0.0f;    // 프레임당 평균 제곱 거리의 제곱근
+};
+
+// 단계별 가지치기 통계 (마지막 match 호출)
+struct DtwStats {
+    int templates = 0;
+    int prunedKim = 0;        // 시작/끝 프레임 하한
+    int prunedKeogh = 0;      // LB_Keogh(질의, 템플릿 포락선)
+    int prunedReverse = 0;    // LB_Keogh(템플릿, 질의 포락선)
+    int prunedImproved = 0;   // LB_Improved 두 번째 항
+    int abandoned = 0;        // DTW 도중 조기 중단
+    int fullDtw = 0;          // 끝까지 계산한 DTW
+};
+
+// 동적 수어용 DTW 템플릿 정합기
+// 정규화된 랜드마크 특징 시퀀스(프레임 × dims)를 고정 길이로 리샘플링해 템플릿 라이브러리와 비교합니다.
+// - Sakoe–Chiba 띠(band 프레임) 안에서만 정렬
+// - LB_Kim → LB_Keogh 양방향 → LB_Improved 하한 순으로 대부분의 템플릿을 DTW 없이 제외
+// - DTW는 행 최솟값 + 남은 프레임의 LB_Keogh 누적 하한이 현재 k번째 거리를 넘으면 중단
+// - 프레임 거리와 포락선 연산은 dims를 SIMD_WIDTH로 패딩한 AVX 루프
+class DtwMatcher {
+public:
+    DtwMatcher(int dims, int length = 32, int band = 4);
+
+    // frameCount × dims 시퀀스를 템플릿으로 추가 (프레임이 2개 미만이면 false)
+    bool addTemplate(const float* frames, int frameCount, int label);
+    void clear();
+
+    // 가장 가까운 k개 템플릿 (거리 오름차순), maxDistance를 넘으면 제외 (0이면 제한 없음)
+    int match(const float* frames, int frameCount, DtwMatch* results, int k = 1, float maxDistance = 0.0f);
+
+    // {"label":2,"templateIndex":14,"distance":0.12,"templates":500,"dtw":9}
+    std::string matchJson(const float* frames, int frameCount, float maxDistance = 0.0f);
+
+    int templateCount() const { return static_cast<int>(labels.size()); }
+    int dims() const { return featureDims; }
+    int length() const { return sequenceLength; }
+    const DtwStats& stats() const { return lastStats; }
+
+private:
+    // frameCount 프레임을 sequenceLength 프레임으로 선형 보간 (패딩 열은 0)
+    void resample(const float* frames, int frameCount, float* out) const;
+    // 띠 폭의 상한/하한 포락선
+    void envelope(const float* sequence, float* upper, float* lower) const;
+
+    float frameDistance(const float* a, const float* b) const;
+    // 프레임별 하한을 perFrame에 기록하고 합 반환 (limit 초과 시 중단)
+    float lbKeogh(const float* sequence, const float* upper, const float* lower, float* perFrame, float limit) const;
+    float dtw(const float* query, const float* candidate, const float* cumulativeBound, float limit);
+
+    int featureDims;
+    int stride;
+    int sequenceLength;
+    int band;
+    size_t sequenceFloats;
+
+    AlignedFloatVector sequences;    // 템플릿 × length × stride
+    AlignedFloatVector uppers;
+    AlignedFloatVector lowers;
+    std::vector<int> labels;
+
+    // 질의별 작업 공간 (할당 재사용)
+    AlignedFloatVector query;
+    AlignedFloatVector queryUpper;
+    AlignedFloatVector queryLower;
+    AlignedFloatVector projection;
+    AlignedFloatVector projectionUpper;
+    AlignedFloatVector projectionLower;
+    std::vector<float> frameBound;
+    std::vector<float> reverseBound;
+    std::vector<float> cumulativeBound;
+    std::vector<float> costRows;
+    DtwStats lastStats;
+};
+
+#endif // DTW_MATCHER_H
@@ -0,0 +1,213 @@
+#include "gesture_segmenter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// 속도를 재는 관절: 손목과 다섯 손가락 끝
+constexpr int SPEED_JOINTS[] = {0, 4, 8, 12, 16, 20};
+constexpr int SPEED_JOINT_COUNT = sizeof(SPEED_JOINTS) / sizeof(SPEED_JOINTS[0]);
+
+} // namespace
+
+RunningWindow::RunningWindow(int capacity)
+    : values(std::max(1, capacity), 0.0f), head(0), filled(0), sinceRecompute(0), sum(0.0), sumSquares(0.0) {}
+
+void RunningWindow::push(float value) {
+    const int capacity = static_cast<int>(values.size());
+    if (filled == capacity) {
+        float old = values[head];
+        sum -= old;
+        sumSquares -= static_cast<double>(old) * old;
+    } else {
+        filled++;
+    }
+    values[head] = value;
+    sum += value;
+    sumSquares += static_cast<double>(value) * value;
+    head = (head + 1) % capacity;
+
+    // 한 바퀴마다 합을 새로 계산 (분할 상환 O(1))
+    if (++sinceRecompute >= capacity) {
+        sinceRecompute = 0;
+        sum = 0.0;
+        sumSquares = 0.0;
+        for (int i = 0; i < filled; i++) {
+            sum += values[i];
+            sumSquares += static_cast<double>(values[i]) * values[i];
+        }
+    }
+}
+
+void RunningWindow::clear() {
+    head = 0;
+    filled = 0;
+    sinceRecompute = 0;
+    sum = 0.0;
+    sumSquares = 0.0;
+}
+
+float RunningWindow::mean() const {
+    return filled > 0 ? static_cast<float>(sum / filled) : 0.0f;
+}
+
+float RunningWindow::variance() const {
+    if (filled < 2) return 0.0f;
+    double m = sum / filled;
+    return static_cast<float>(std::max(0.0, sumSquares / filled - m * m));
+}
+
+GestureSegmenter::GestureSegmenter(const SegmenterConfig& config)
+    : settings(config), speedWindow(config.windowFrames), poseWindow(config.windowFrames) {
+    reset();
+}
+
+void GestureSegmenter::reset() {
+    speedWindow.clear();
+    poseWindow.clear();
+    hasPrevious = false;
+    previousMs = 0.0;
+    onsetRun = 0;
+    offsetRun = 0;
+    offsetStartMs = 0.0;
+    offsetStartFrame = 0;
+    absentRun = 0;
+    onsetStartMs = 0.0;
+    onsetStartFrame = 0;
+    lastPresentMs = 0.0;
+    lastPresentFrame = 0;
+    inSegment = false;
+    segment = GestureSegment();
+    frame = 0;
+}
+
+SegmentEvent GestureSegmenter::push(const float* landmarks, int count, double timestampMs) {
+    SegmentEvent event = SegmentEvent::None;
+    const int64_t index = frame++;
+
+    bool present = landmarks != nullptr && count == POINTS * 2;
+    if (present) {
+        float magnitude = 0.0f;
+        for (int i = 0; i < POINTS * 2; i++) magnitude += std::fabs(landmarks[i]);
+        present = magnitude > 0.0f;
+    }
+
+    if (!present) {
+        // 손이 다시 나타나면 속도 창과 종료 카운트를 새로 채움 (재검출 순간의 점프 방지)
+        hasPrevious = false;
+        speedWindow.clear();
+        poseWindow.clear();
+        onsetRun = 0;
+        offsetRun = 0;
+        if (inSegment && ++absentRun >= settings.absentFrames) {
+            endSegment(lastPresentMs, lastPresentFrame, event);
+        }
+        return event;
+    }
+    absentRun = 0;
+
+    // 손 크기(손목–중지 기저부)로 정규화한 손목 기준 자세
+    float dx = landmarks[9 * 2] - landmarks[0];
+    float dy = landmarks[9 * 2 + 1] - landmarks[1];
+    float invScale = 1.0f / std::max(std::sqrt(dx * dx + dy * dy), 1e-6f);
+    float pose[POINTS * 2];
+    for (int i = 0; i < POINTS; i++) {
+        pose[i * 2] = (landmarks[i * 2] - landmarks[0]) * invScale;
+        pose[i * 2 + 1] = (landmarks[i * 2 + 1] - landmarks[1]) * invScale;
+    }
+
+    if (hasPrevious) {
+        float dt = static_cast<float>(std::max((timestampMs - previousMs) * 0.001, 1e-3));
+
+        float travel = 0.0f;
+        for (int j : SPEED_JOINTS) {
+            float mx = landmarks[j * 2] - previous[j * 2];
+            float my = landmarks[j * 2 + 1] - previous[j * 2 + 1];
+            travel += std::sqrt(mx * mx + my * my);
+        }
+        speedWindow.push(travel * invScale / (SPEED_JOINT_COUNT * dt));
+
+        float change = 0.0f;
+        for (int i = 0; i < POINTS; i++) {
+            float px = pose[i * 2] - previousPose[i * 2];
+            float py = pose[i * 2 + 1] - previousPose[i * 2 + 1];
+            change += std::sqrt(px * px + py * py);
+        }
+        poseWindow.push(change / POINTS);
+    }
+    std::memcpy(previous, landmarks, sizeof(previous));
+    std::memcpy(previousPose, pose, sizeof(previousPose));
+    hasPrevious = true;
+    previousMs = timestampMs;
+    lastPresentMs = timestampMs;
+    lastPresentFrame = index;
+
+    const float speed = speedWindow.mean();
+
+    if (!inSegment) {
+        // 시작: 창 평균 속도가 onsetFrames 동안 임계값 이상
+        if (speedWindow.count() > 0 && speed >= settings.onsetSpeed) {
+            if (onsetRun++ == 0) {
+                onsetStartMs = timestampMs;
+                onsetStartFrame = index;
+            }
+            if (onsetRun >= settings.onsetFrames) {
+                inSegment = true;
+                offsetRun = 0;
+                segment = GestureSegment();
+                segment.startMs = onsetStartMs;
+                segment.startFrame = onsetStartFrame;
+                segment.peakSpeed = speed;
+                event = SegmentEvent::Start;
+            }
+        } else {
+            onsetRun = 0;
+        }
+        return event;
+    }
+
+    segment.peakSpeed = std::max(segment.peakSpeed, speed);
+
+    // 종료: 느려지고 자세 변화가 작은 상태가 offsetFrames 동안 유지 (끝 시각은 안정되기 시작한 프레임)
+    // 다시 나타난 첫 프레임은 속도 창이 비어 있어 평균이 0이므로 세지 않음
+    float poseChange = poseWindow.mean() + 2.0f * std::sqrt(poseWindow.variance());
+    if (speedWindow.count() > 0 && speed <= settings.offsetSpeed && poseChange <= settings.stablePoseChange) {
+        if (offsetRun++ == 0) {
+            offsetStartMs = timestampMs;
+            offsetStartFrame = index;
+        }
+        if (offsetRun >= settings.offsetFrames) {
+            endSegment(offsetStartMs, offsetStartFrame, event);
+        }
+    } else {
+        offsetRun = 0;
+    }
+
+    if (inSegment && timestampMs - segment.startMs >= settings.maxSegmentMs) {
+        endSegment(timestampMs, index, event);
+    }
+    return event;
+}
+
+void GestureSegmenter::endSegment(double endMs, int64_t endFrame, SegmentEvent& event) {
+    inSegment = false;
+    onsetRun = 0;
+    offsetRun = 0;
+    absentRun = 0;
+    segment.endMs = endMs;
+    segment.endFrame = endFrame;
+    event = endMs - segment.startMs >= settings.minSegmentMs ? SegmentEvent::End : SegmentEvent::Cancel;
+}
+
+std::string GestureSegmenter::segmentJson() const {
+    char buffer[192];
+    std::snprintf(buffer, sizeof(buffer),
+                  "{\"active\":%s,\"startMs\":%.1f,\"endMs\":%.1f,\"startFrame\":%lld,\"endFrame\":%lld,"
+                  "\"peakSpeed\":%.3f}",
+                  inSegment ? "true" : "false", segment.startMs, segment.endMs,
+                  static_cast<long long>(segment.startFrame), static_cast<long long>(segment.endFrame),
+                  segment.peakSpeed);
+    return std::string(buffer);
+}
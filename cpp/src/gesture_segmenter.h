@@ -0,0 +1,110 @@
+#ifndef GESTURE_SEGMENTER_H
+#define GESTURE_SEGMENTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 고정 길이 창의 평균/분산 (링 버퍼 + 누적 합, 프레임당 O(1))
+// 누적 오차는 창이 한 바퀴 돌 때마다 합을 다시 계산해 제거합니다.
+class RunningWindow {
+public:
+    explicit RunningWindow(int capacity = 8);
+
+    void push(float value);
+    void clear();
+
+    int count() const { return filled; }
+    bool full() const { return filled == static_cast<int>(values.size()); }
+    float mean() const;
+    float variance() const;
+
+private:
+    std::vector<float> values;
+    int head;
+    int filled;
+    int sinceRecompute;
+    double sum;
+    double sumSquares;
+};
+
+// 분할 설정 (속도는 손 크기/초 단위: 손목–중지 기저부 거리를 1로 정규화)
+struct SegmenterConfig {
+    int windowFrames = 6;           // 이동 평균/분산 창
+    float onsetSpeed = 1.2f;        // 창 평균 속도가 이 값 이상이면 시작 후보
+    float offsetSpeed = 0.5f;       // 이 값 이하이고 자세가 안정되면 종료 후보 (히스테리시스)
+    float stablePoseChange = 0.03f; // 프레임 간 자세 변화량(평균 + 2σ)이 이 값 이하이면 안정
+    int onsetFrames = 3;            // 시작 조건이 연속으로 유지되어야 하는 프레임 수
+    int offsetFrames = 8;           // 종료 조건이 연속으로 유지되어야 하는 프레임 수
+    int absentFrames = 5;           // 손이 이만큼 연속으로 사라지면 종료
+    double minSegmentMs = 200.0;    // 더 짧은 구간은 버림
+    double maxSegmentMs = 6000.0;   // 더 길면 강제로 끊음
+};
+
+// 분할 이벤트
+enum class SegmentEvent {
+    None = 0,
+    Start = 1,
+    End = 2,
+    Cancel = 3      // 시작했지만 minSegmentMs보다 짧아 버림
+};
+
+// 수어 구간
+struct GestureSegment {
+    double startMs = 0.0;
+    double endMs = 0.0;
+    int64_t startFrame = 0;
+    int64_t endFrame = 0;
+    float peakSpeed = 0.0f;
+};
+
+// 랜드마크 스트림 증분 분할기
+// 인식기 입력(21 × x, y)을 프레임마다 받아 손 속도, 검출 여부, 자세 안정도로 수어 시작/끝을 찾습니다.
+// 무거운 시퀀스 모델(DTW, CTC 등)은 Start와 End 사이에서만 돌리면 됩니다.
+class GestureSegmenter {
+public:
+    explicit GestureSegmenter(const SegmenterConfig& config = SegmenterConfig());
+
+    // landmarks: 42 float (count가 42가 아니거나 전부 0이면 손 없음)
+    SegmentEvent push(const float* landmarks, int count, double timestampMs);
+
+    bool active() const { return inSegment; }
+
+    // 진행 중이면 시작 정보, 끝났으면 마지막 구간
+    const GestureSegment& currentSegment() const { return segment; }
+    std::string segmentJson() const;
+
+    float windowSpeed() const { return speedWindow.mean(); }
+
+    void reset();
+
+private:
+    static constexpr int POINTS = 21;
+
+    void endSegment(double endMs, int64_t endFrame, SegmentEvent& event);
+
+    SegmenterConfig settings;
+    RunningWindow speedWindow;
+    RunningWindow poseWindow;
+
+    float previous[POINTS * 2];
+    float previousPose[POINTS * 2];
+    bool hasPrevious;
+    double previousMs;
+
+    int onsetRun;
+    int offsetRun;
+    double offsetStartMs;
+    int64_t offsetStartFrame;
+    int absentRun;
+    double onsetStartMs;
+    int64_t onsetStartFrame;
+    double lastPresentMs;
+    int64_t lastPresentFrame;
+
+    bool inSegment;
+    GestureSegment segment;
+    int64_t frame;
+};
+
+#endif // GESTURE_SEGMENTER_H
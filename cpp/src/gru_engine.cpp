@@ -0,0 +1,226 @@
+#include "gru_engine.h"
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+// tanh 유리 함수 근사 (홀수 13차 / 짝수 6차 다항식, |x| ≥ 7.9이면 ±1)
+inline __m256 tanh256(__m256 x) {
+    const __m256 limit = _mm256_set1_ps(7.90531110763549805f);
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_sub_ps(_mm256_setzero_ps(), limit)), limit);
+    const __m256 x2 = _mm256_mul_ps(x, x);
+
+    __m256 p = _mm256_set1_ps(-2.76076847742355e-16f);
+    p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(2.00018790482477e-13f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(-8.60467152213735e-11f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(5.12229709037114e-08f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(1.48572235717979e-05f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(6.37261928875436e-04f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(4.89352455891786e-03f));
+    p = _mm256_mul_ps(p, x);
+
+    __m256 q = _mm256_set1_ps(1.19825839466702e-06f);
+    q = _mm256_add_ps(_mm256_mul_ps(q, x2), _mm256_set1_ps(1.18534705686654e-04f));
+    q = _mm256_add_ps(_mm256_mul_ps(q, x2), _mm256_set1_ps(2.26843463243900e-03f));
+    q = _mm256_add_ps(_mm256_mul_ps(q, x2), _mm256_set1_ps(4.89352518554385e-03f));
+    return _mm256_div_ps(p, q);
+}
+
+// σ(x) = 0.5 · tanh(x / 2) + 0.5
+inline __m256 sigmoid256(__m256 x) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    return _mm256_add_ps(_mm256_mul_ps(half, tanh256(_mm256_mul_ps(half, x))), half);
+}
+
+// [outputs][inputs] 가중치 + 바이어스를 형식에 맞춰 패킹 (16비트는 그대로)
+void packGate(const NpyArray& weights, const NpyArray& bias, DenseLayer& layer) {
+    const int outputs = weights.shape[0];
+    const int inputs = weights.shape[1];
+    std::vector<float> biasValues = bias.toFloat();
+    if (weights.dtype == NpyDtype::Float32) {
+        layer.pack(weights.data.data(), biasValues.data(), outputs, inputs);
+    } else {
+        WeightPrecision precision = weights.dtype == NpyDtype::Float16 ? WeightPrecision::F16 : WeightPrecision::BF16;
+        layer.packHalf(weights.halfData.data(), precision, biasValues.data(), outputs, inputs);
+    }
+}
+
+const NpyArray* findGateArray(const std::map<std::string, NpyArray>& arrays, const char* name, int layer) {
+    auto it = arrays.find(std::string(name) + "_l" + std::to_string(layer));
+    return it == arrays.end() ? nullptr : &it->second;
+}
+
+} // namespace
+
+GruEngine::GruEngine() : hidden(0), bufferRows(0) {}
+
+bool GruEngine::loadFromArrays(const std::map<std::string, NpyArray>& arrays, std::string& error) {
+    std::vector<Layer> loaded;
+    int hiddenUnits = 0;
+
+    for (int k = 0;; k++) {
+        const NpyArray* wIh = findGateArray(arrays, "weight_ih", k);
+        const NpyArray* wHh = findGateArray(arrays, "weight_hh", k);
+        const NpyArray* bIh = findGateArray(arrays, "bias_ih", k);
+        const NpyArray* bHh = findGateArray(arrays, "bias_hh", k);
+        if (wIh == nullptr && wHh == nullptr) break;
+
+        std::string name = "gru layer " + std::to_string(k);
+        if (wIh == nullptr || wHh == nullptr || bIh == nullptr || bHh == nullptr) {
+            error = name + ": weight_ih/weight_hh/bias_ih/bias_hh are incomplete";
+            return false;
+        }
+        if (wIh->shape.size() != 2 || wHh->shape.size() != 2) {
+            error = name + ": expected 2-d weights";
+            return false;
+        }
+        const int units = wHh->shape[1];
+        if (units <= 0 || units % SIMD_WIDTH != 0 || wHh->shape[0] != 3 * units || wIh->shape[0] != 3 * units ||
+            static_cast<int>(bIh->size()) != 3 * units || static_cast<int>(bHh->size()) != 3 * units) {
+            error = name + ": expected weight_hh [3H][H] with H a multiple of 8 and matching weight_ih/biases";
+            return false;
+        }
+        if (k > 0 && (units != hiddenUnits || wIh->shape[1] != hiddenUnits)) {
+            error = name + ": hidden size does not match previous layer";
+            return false;
+        }
+        hiddenUnits = units;
+
+        loaded.emplace_back();
+        packGate(*wIh, *bIh, loaded.back().input);
+        packGate(*wHh, *bHh, loaded.back().recurrent);
+    }
+
+    if (loaded.empty()) {
+        error = "no weight_ih_l0/weight_hh_l0 arrays found";
+        return false;
+    }
+
+    MlpModel head;
+    if (!head.loadFromArrays(arrays, error)) return false;
+    if (head.inputDim() != hiddenUnits) {
+        error = "output layer input size does not match GRU hidden size";
+        return false;
+    }
+
+    layers = std::move(loaded);
+    outputHead = std::move(head);
+    hidden = hiddenUnits;
+    bufferRows = 0;
+    return true;
+}
+
+bool GruEngine::loadFromNpzBuffer(const uint8_t* data, size_t size, std::string& error) {
+    std::map<std::string, NpyArray> arrays;
+    if (!NpzReader::parse(data, size, arrays, error)) return false;
+    return loadFromArrays(arrays, error);
+}
+
+GruState GruEngine::createState() const {
+    GruState state;
+    state.hidden.assign(static_cast<size_t>(layers.size()) * hidden, 0.0f);
+    return state;
+}
+
+void GruEngine::prepareBuffers(int rows) {
+    if (rows <= bufferRows) return;
+    const size_t n = static_cast<size_t>(rows);
+    inputRows.assign(n * layers.front().input.stride, 0.0f);
+    hiddenRows.assign(n * hidden, 0.0f);
+    gateRows.assign(n * 3 * hidden, 0.0f);
+    recurrentRows.assign(n * 3 * hidden, 0.0f);
+    logitRows.assign(n * std::max(1, classes()), 0.0f);
+    bufferRows = rows;
+}
+
+void GruEngine::updateHidden(const float* gates, const float* recurrentGates, float* h) const {
+    const int H = hidden;
+    for (int i = 0; i < H; i += SIMD_WIDTH) {
+        __m256 r = sigmoid256(_mm256_add_ps(_mm256_load_ps(gates + i), _mm256_load_ps(recurrentGates + i)));
+        __m256 z = sigmoid256(_mm256_add_ps(_mm256_load_ps(gates + H + i), _mm256_load_ps(recurrentGates + H + i)));
+        __m256 n = tanh256(_mm256_add_ps(_mm256_load_ps(gates + 2 * H + i),
+                                         _mm256_mul_ps(r, _mm256_load_ps(recurrentGates + 2 * H + i))));
+        __m256 previous = _mm256_load_ps(h + i);
+        _mm256_store_ps(h + i, _mm256_add_ps(n, _mm256_mul_ps(z, _mm256_sub_ps(previous, n))));
+    }
+}
+
+void GruEngine::stepBatch(GruState* const* states, const float* features, int count, float* logits) {
+    if (empty() || count <= 0) return;
+    prepareBuffers(count);
+    const int H = hidden;
+    const int gateStride = 3 * H;
+    const int inputStride = layers.front().input.stride;
+    const int inputs = inputSize();
+
+    for (int r = 0; r < count; r++) {
+        std::memcpy(&inputRows[static_cast<size_t>(r) * inputStride], features + static_cast<size_t>(r) * inputs,
+                    sizeof(float) * inputs);
+    }
+
+    const float* x = inputRows.data();
+    int xStride = inputStride;
+    for (size_t k = 0; k < layers.size(); k++) {
+        const Layer& layer = layers[k];
+        // 입력 투영을 먼저 끝내야 hiddenRows(이전 레이어 출력)를 이 레이어 상태로 덮어쓸 수 있음
+        layer.input.forwardBatch(x, xStride, gateRows.data(), gateStride, count, false);
+        for (int r = 0; r < count; r++) {
+            std::memcpy(&hiddenRows[static_cast<size_t>(r) * H], &states[r]->hidden[k * H], sizeof(float) * H);
+        }
+        layer.recurrent.forwardBatch(hiddenRows.data(), H, recurrentRows.data(), gateStride, count, false);
+        for (int r = 0; r < count; r++) {
+            float* h = &hiddenRows[static_cast<size_t>(r) * H];
+            updateHidden(&gateRows[static_cast<size_t>(r) * gateStride],
+                         &recurrentRows[static_cast<size_t>(r) * gateStride], h);
+            std::memcpy(&states[r]->hidden[k * H], h, sizeof(float) * H);
+        }
+        x = hiddenRows.data();
+        xStride = H;
+    }
+
+    outputHead.forwardBatch(hiddenRows.data(), logitRows.data(), count);
+    if (logits != nullptr) std::memcpy(logits, logitRows.data(), sizeof(float) * count * classes());
+}
+
+int GruEngine::step(GruState& state, const float* features, float* logits) {
+    if (empty()) return -1;
+    GruState* states[1] = {&state};
+    stepBatch(states, features, 1, logits);
+    const float* row = logitRows.data();
+    return static_cast<int>(std::max_element(row, row + classes()) - row);
+}
+
+int GruEngine::runSequence(GruState& state, const float* features, int frames, float* logits) {
+    if (empty() || frames <= 0) return -1;
+    prepareBuffers(frames);
+    const int H = hidden;
+    const int gateStride = 3 * H;
+    const int inputStride = layers.front().input.stride;
+    const int inputs = inputSize();
+
+    for (int t = 0; t < frames; t++) {
+        std::memcpy(&inputRows[static_cast<size_t>(t) * inputStride], features + static_cast<size_t>(t) * inputs,
+                    sizeof(float) * inputs);
+    }
+
+    // 레이어마다: 전 프레임 입력 투영을 GEMM 한 번으로 → 시간 순서대로 은닉 투영 GEMV + 게이트 갱신
+    const float* x = inputRows.data();
+    int xStride = inputStride;
+    for (size_t k = 0; k < layers.size(); k++) {
+        const Layer& layer = layers[k];
+        layer.input.forwardBatch(x, xStride, gateRows.data(), gateStride, frames, false);
+        float* h = &state.hidden[k * H];
+        for (int t = 0; t < frames; t++) {
+            layer.recurrent.forward(h, recurrentRows.data(), false);
+            updateHidden(&gateRows[static_cast<size_t>(t) * gateStride], recurrentRows.data(), h);
+            std::memcpy(&hiddenRows[static_cast<size_t>(t) * H], h, sizeof(float) * H);
+        }
+        x = hiddenRows.data();
+        xStride = H;
+    }
+
+    outputHead.forward(&hiddenRows[static_cast<size_t>(frames - 1) * H], logitRows.data());
+    const float* row = logitRows.data();
+    if (logits != nullptr) std::memcpy(logits, row, sizeof(float) * classes());
+    return static_cast<int>(std::max_element(row, row + classes()) - row);
+}
@@ -0,0 +1,79 @@
+#ifndef GRU_ENGINE_H
+#define GRU_ENGINE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "mlp_model.h"
+#include "npz_reader.h"
+
+// 스트림 하나의 GRU 은닉 상태 (레이어마다 hiddenSize, 8의 배수)
+struct GruState {
+    AlignedFloatVector hidden;   // layers × hiddenSize
+
+    void reset() { std::fill(hidden.begin(), hidden.end(), 0.0f); }
+};
+
+// 프레임별 특징(126차원)용 GRU 레이어 엔진 + 출력 MLP
+// PyTorch nn.GRU와 같은 식과 게이트 순서(r, z, n)를 씁니다.
+//   r = σ(W_ir·x + b_ir + W_hr·h + b_hr),  z = σ(W_iz·x + b_iz + W_hz·h + b_hz)
+//   n = tanh(W_in·x + b_in + r ⊙ (W_hn·h + b_hn)),  h' = n + z ⊙ (h − n)
+// 세 게이트의 입력 가중치와 은닉 가중치를 각각 [3H][in] 한 행렬로 묶어 GEMV 두 번으로 모든 게이트를 구하고,
+// σ/tanh(유리 함수 근사, 절대 오차 약 1e-6)와 상태 갱신은 AVX 한 번의 순회로 융합합니다.
+// 배치 모드는 여러 스트림의 은닉 상태를 행으로 모아 같은 DenseLayer GEMM으로 한 번에 진행하고,
+// 시퀀스 모드는 입력 투영 전체를 시간 축 GEMM 한 번으로 먼저 계산합니다.
+// 작업 버퍼를 객체에 두므로 한 객체는 한 스레드에서 사용합니다.
+class GruEngine {
+public:
+    GruEngine();
+
+    // NPZ 배열 로드 (PyTorch state_dict 이름): weight_ih_l{k} [3H][in], weight_hh_l{k} [3H][H],
+    // bias_ih_l{k}, bias_hh_l{k} (k = 0, 1, ...), 출력층은 SignRecognition 모델과 같은 w1/b1, w2/b2, ...
+    // '<f2'/'<u2' 가중치는 16비트 그대로 저장
+    bool loadFromArrays(const std::map<std::string, NpyArray>& arrays, std::string& error);
+    bool loadFromNpzBuffer(const uint8_t* data, size_t size, std::string& error);
+
+    bool empty() const { return layers.empty(); }
+    int inputSize() const { return layers.empty() ? 0 : layers.front().input.inDim; }
+    int hiddenSize() const { return hidden; }
+    int layerCount() const { return static_cast<int>(layers.size()); }
+    int classes() const { return outputHead.outputDim(); }
+
+    // 0으로 초기화된 은닉 상태
+    GruState createState() const;
+
+    // 한 프레임 진행, logits(classes개, nullptr 가능) 기록 후 최대 클래스 반환
+    int step(GruState& state, const float* features, float* logits);
+
+    // 서로 다른 스트림 count개를 한 프레임씩 진행 (게이트 GEMV를 count행 GEMM으로)
+    // features: count × inputSize, logits: count × classes (nullptr 가능)
+    void stepBatch(GruState* const* states, const float* features, int count, float* logits);
+
+    // 한 스트림에 frames개 프레임을 차례로 넣고 마지막 프레임의 logits 기록, 최대 클래스 반환
+    int runSequence(GruState& state, const float* features, int frames, float* logits);
+
+private:
+    struct Layer {
+        DenseLayer input;       // [3H][in], 바이어스 b_ih
+        DenseLayer recurrent;   // [3H][H], 바이어스 b_hh
+    };
+
+    void prepareBuffers(int rows);
+    // 입력 게이트 투영(gates, 3H) + 은닉 투영(recurrentGates, 3H) → h 갱신
+    void updateHidden(const float* gates, const float* recurrentGates, float* h) const;
+
+    std::vector<Layer> layers;
+    MlpModel outputHead;
+    int hidden;
+
+    int bufferRows;
+    AlignedFloatVector inputRows;      // rows × 첫 레이어 stride
+    AlignedFloatVector hiddenRows;     // rows × H
+    AlignedFloatVector gateRows;       // rows × 3H
+    AlignedFloatVector recurrentRows;  // rows × 3H
+    AlignedFloatVector logitRows;      // rows × classes
+};
+
+#endif // GRU_ENGINE_H
@@ -0,0 +1,117 @@
+#ifndef HALF_FLOAT_H
+#define HALF_FLOAT_H
+
+#include <cstdint>
+#include <cstring>
+
+// 16비트 부동소수점 변환 (fp16: IEEE binary16, bf16: bfloat16)
+// 가중치 저장용으로, 커널에서는 widenHalf8/widenBf16x8로 레지스터 안에서 fp32로 확장합니다.
+
+inline uint32_t floatBits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+inline float bitsToFloat(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// fp32 → fp16 (가장 가까운 짝수로 반올림, 범위 초과 시 inf)
+inline uint16_t floatToHalf(float value) {
+    uint32_t f = floatBits(value);
+    uint32_t sign = (f >> 16) & 0x8000;
+    uint32_t absBits = f & 0x7fffffff;
+
+    if (absBits >= 0x7f800000) {
+        // inf / NaN
+        return static_cast<uint16_t>(sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0));
+    }
+    if (absBits >= 0x477ff000) {
+        // 65520 이상은 반올림하면 범위를 넘음
+        return static_cast<uint16_t>(sign | 0x7c00);
+    }
+    if (absBits < 0x38800000) {
+        // fp16 비정규 수 영역: 2^-14 단위로 반올림
+        float magnitude = bitsToFloat(absBits) * 16777216.0f; // 2^24
+        uint32_t mant = static_cast<uint32_t>(magnitude);
+        float rest = magnitude - static_cast<float>(mant);
+        if (rest > 0.5f || (rest == 0.5f && (mant & 1))) mant++;
+        return static_cast<uint16_t>(sign | mant);
+    }
+
+    uint32_t mant = absBits & 0x7fffff;
+    uint32_t exp = (absBits >> 23) - 127 + 15;
+    uint32_t half = (exp << 10) | (mant >> 13);
+    uint32_t rest = mant & 0x1fff;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+// fp16 → fp32
+inline float halfToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t magnitude = h & 0x7fff;
+    if (magnitude >= 0x7c00) {
+        return bitsToFloat(sign | 0x7f800000 | ((magnitude & 0x3ff) << 13));
+    }
+    if (magnitude >= 0x0400) {
+        // 정규 수: 지수 편향 15 → 127 (지수 필드에 112를 더함)
+        return bitsToFloat(sign | ((magnitude << 13) + 0x38000000));
+    }
+    if (magnitude == 0) return bitsToFloat(sign);
+    // 비정규 수 m × 2^-24: 최상위 1 비트를 비트 10으로 옮기고 그만큼 지수를 낮춤
+    // (정수 연산만 사용하므로 -ffast-math의 DAZ/FTZ에서도 0이 되지 않음)
+    int shift = __builtin_clz(magnitude) - 21;
+    uint32_t mant = (magnitude << shift) & 0x3ff;
+    return bitsToFloat(sign | (static_cast<uint32_t>(113 - shift) << 23) | (mant << 13));
+}
+
+// fp32 → bf16 (가장 가까운 짝수로 반올림)
+inline uint16_t floatToBf16(float value) {
+    uint32_t f = floatBits(value);
+    if ((f & 0x7fffffff) > 0x7f800000) {
+        return static_cast<uint16_t>((f >> 16) | 0x40); // quiet NaN 유지
+    }
+    f += 0x7fff + ((f >> 16) & 1);
+    return static_cast<uint16_t>(f >> 16);
+}
+
+// bf16 → fp32
+inline float bf16ToFloat(uint16_t b) {
+    return bitsToFloat(static_cast<uint32_t>(b) << 16);
+}
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+// fp16 8개 → fp32 8개 (AVX2 정수 연산, F16C 불필요)
+inline __m256 widenHalf8(const uint16_t* p) {
+    __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    __m256i sign = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x8000)), 16);
+    __m256i magnitude = _mm256_and_si256(h, _mm256_set1_epi32(0x7fff));
+
+    // 정규 수: 지수 필드에 112를 더함
+    __m256 value = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_slli_epi32(magnitude, 13),
+                                                        _mm256_set1_epi32(0x38000000)));
+    // 비정규 수(지수 0): 정수 m을 변환(하드웨어 정규화)한 뒤 2^-24를 곱함
+    // 두 피연산자와 결과가 모두 fp32 정규 수라 DAZ/FTZ에서도 값이 유지됨
+    __m256 subnormal = _mm256_mul_ps(_mm256_cvtepi32_ps(magnitude), _mm256_set1_ps(5.9604644775390625e-8f));
+    value = _mm256_blendv_ps(value, subnormal,
+                             _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(0x0400), magnitude)));
+    // inf/NaN: 지수를 모두 1로
+    __m256i infNan = _mm256_cmpgt_epi32(magnitude, _mm256_set1_epi32(0x7bff));
+    value = _mm256_or_ps(value, _mm256_castsi256_ps(_mm256_and_si256(infNan, _mm256_set1_epi32(0x7f800000))));
+    return _mm256_or_ps(value, _mm256_castsi256_ps(sign));
+}
+
+// bf16 8개 → fp32 8개 (상위 16비트로 이동)
+inline __m256 widenBf16x8(const uint16_t* p) {
+    __m256i b = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(b, 16));
+}
+#endif
+
+#endif // HALF_FLOAT_H
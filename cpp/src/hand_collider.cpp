@@ -0,0 +1,230 @@
+#include "hand_collider.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+// 뼈 b(1..20)의 부모 랜드마크: 손가락 첫 마디(1, 5, 9, 13, 17)는 손목(0)에서, 나머지는 바로 앞 마디에서 시작
+inline int boneParent(int child) {
+    return child % 4 == 1 ? 0 : child - 1;
+}
+
+// 빈 칸 캡슐 위치 (거리 제곱이 float 범위 안에 들도록 유한값)
+constexpr float FAR_AWAY = 1e15f;
+
+constexpr int MAX_DEPTH = 8;
+
+} // namespace
+
+HandCollider::HandCollider() : radius(0.0f), active(false) {
+    points.resize(LANDMARKS * 3, 0.0f);
+    boneOrder.resize(BONES);
+    boneCenter.resize(BONES * 3);
+    nodes.reserve(2 * BONES);
+    leaves.reserve(BONES);
+}
+
+bool HandCollider::update(const float* landmarks, int count, float capsuleRadius) {
+    const int components = count == LANDMARKS * 3 ? 3 : (count == LANDMARKS * 2 ? 2 : 0);
+    if (landmarks == nullptr || components == 0 || !(capsuleRadius > 0.0f)) {
+        active = false;
+        return false;
+    }
+
+    for (int i = 0; i < LANDMARKS; i++) {
+        points[i * 3] = landmarks[i * components];
+        points[i * 3 + 1] = landmarks[i * components + 1];
+        points[i * 3 + 2] = components == 3 ? landmarks[i * components + 2] : 0.0f;
+    }
+    for (int b = 0; b < BONES; b++) {
+        const float* a = &points[boneParent(b + 1) * 3];
+        const float* c = &points[(b + 1) * 3];
+        for (int k = 0; k < 3; k++) boneCenter[b * 3 + k] = 0.5f * (a[k] + c[k]);
+        boneOrder[b] = b;
+    }
+
+    radius = capsuleRadius;
+    nodes.assign(1, Node());
+    leaves.clear();
+    build(0, 0, BONES);
+    active = true;
+    return true;
+}
+
+// boneOrder[begin, end)로 nodes[index]를 채움 (내부 노드의 두 자식은 연속 배치)
+void HandCollider::build(int index, int begin, int end) {
+    float lower[3] = {FAR_AWAY, FAR_AWAY, FAR_AWAY};
+    float upper[3] = {-FAR_AWAY, -FAR_AWAY, -FAR_AWAY};
+    float centerLower[3] = {FAR_AWAY, FAR_AWAY, FAR_AWAY};
+    float centerUpper[3] = {-FAR_AWAY, -FAR_AWAY, -FAR_AWAY};
+    for (int i = begin; i < end; i++) {
+        int b = boneOrder[i];
+        const float* a = &points[boneParent(b + 1) * 3];
+        const float* c = &points[(b + 1) * 3];
+        for (int k = 0; k < 3; k++) {
+            lower[k] = std::min(lower[k], std::min(a[k], c[k]) - radius);
+            upper[k] = std::max(upper[k], std::max(a[k], c[k]) + radius);
+            centerLower[k] = std::min(centerLower[k], boneCenter[b * 3 + k]);
+            centerUpper[k] = std::max(centerUpper[k], boneCenter[b * 3 + k]);
+        }
+    }
+    std::memcpy(nodes[index].lower, lower, sizeof(lower));
+    std::memcpy(nodes[index].upper, upper, sizeof(upper));
+
+    if (end - begin <= LEAF_CAPSULES) {
+        // 잎: 캡슐을 SoA로 옮기고 빈 칸은 먼 곳의 반지름 0 캡슐로 채움
+        LeafBlock block;
+        for (int lane = 0; lane < LEAF_CAPSULES; lane++) {
+            if (begin + lane >= end) {
+                block.ax[lane] = block.ay[lane] = block.az[lane] = FAR_AWAY;
+                block.abx[lane] = block.aby[lane] = block.abz[lane] = 0.0f;
+                block.invLength2[lane] = 0.0f;
+                block.radius2[lane] = 0.0f;
+                continue;
+            }
+            int b = boneOrder[begin + lane];
+            const float* a = &points[boneParent(b + 1) * 3];
+            const float* c = &points[(b + 1) * 3];
+            float abx = c[0] - a[0], aby = c[1] - a[1], abz = c[2] - a[2];
+            float length2 = abx * abx + aby * aby + abz * abz;
+            block.ax[lane] = a[0];
+            block.ay[lane] = a[1];
+            block.az[lane] = a[2];
+            block.abx[lane] = abx;
+            block.aby[lane] = aby;
+            block.abz[lane] = abz;
+            block.invLength2[lane] = length2 > 1e-12f ? 1.0f / length2 : 0.0f;  // 길이 0이면 구
+            block.radius2[lane] = radius * radius;
+        }
+        nodes[index].left = -1;
+        nodes[index].leaf = static_cast<int>(leaves.size());
+        leaves.push_back(block);
+        return;
+    }
+
+    // 중점 범위가 가장 긴 축의 중앙값으로 분할
+    int axis = 0;
+    for (int k = 1; k < 3; k++) {
+        if (centerUpper[k] - centerLower[k] > centerUpper[axis] - centerLower[axis]) axis = k;
+    }
+    int middle = (begin + end) / 2;
+    std::nth_element(boneOrder.begin() + begin, boneOrder.begin() + middle, boneOrder.begin() + end,
+                     [&](int x, int y) { return boneCenter[x * 3 + axis] < boneCenter[y * 3 + axis]; });
+
+    int left = static_cast<int>(nodes.size());
+    nodes[index].left = left;
+    nodes[index].leaf = -1;
+    nodes.resize(nodes.size() + 2);
+    build(left, begin, middle);
+    build(left + 1, middle, end);
+}
+
+bool HandCollider::collideParticle(float* position, float* velocity, float restitution) const {
+    const float px = position[0], py = position[1], pz = position[2];
+    const __m256 vx = _mm256_set1_ps(px);
+    const __m256 vy = _mm256_set1_ps(py);
+    const __m256 vz = _mm256_set1_ps(pz);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    int stack[MAX_DEPTH * 2];
+    int top = 0;
+    stack[top++] = 0;
+
+    float bestDepth = 0.0f;
+    float closest[3] = {0.0f, 0.0f, 0.0f};
+    float bestDistance = 0.0f;
+
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (px < node.lower[0] || px > node.upper[0] || py < node.lower[1] || py > node.upper[1] ||
+            pz < node.lower[2] || pz > node.upper[2]) {
+            continue;
+        }
+        if (node.left >= 0) {
+            stack[top++] = node.left;
+            stack[top++] = node.left + 1;
+            continue;
+        }
+
+        // 잎: 캡슐 8개까지의 최근접점 거리 제곱
+        const LeafBlock& block = leaves[node.leaf];
+        __m256 dx = _mm256_sub_ps(vx, _mm256_load_ps(block.ax));
+        __m256 dy = _mm256_sub_ps(vy, _mm256_load_ps(block.ay));
+        __m256 dz = _mm256_sub_ps(vz, _mm256_load_ps(block.az));
+        __m256 abx = _mm256_load_ps(block.abx);
+        __m256 aby = _mm256_load_ps(block.aby);
+        __m256 abz = _mm256_load_ps(block.abz);
+        __m256 t = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, abx), _mm256_mul_ps(dy, aby)), _mm256_mul_ps(dz, abz));
+        t = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(t, _mm256_load_ps(block.invLength2)), zero), one);
+        dx = _mm256_sub_ps(dx, _mm256_mul_ps(t, abx));
+        dy = _mm256_sub_ps(dy, _mm256_mul_ps(t, aby));
+        dz = _mm256_sub_ps(dz, _mm256_mul_ps(t, abz));
+        __m256 distance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                         _mm256_mul_ps(dz, dz));
+        int hits = _mm256_movemask_ps(_mm256_cmp_ps(distance2, _mm256_load_ps(block.radius2), _CMP_LT_OQ));
+        if (hits == 0) continue;
+
+        alignas(32) float distanceLanes[LEAF_CAPSULES];
+        alignas(32) float tLanes[LEAF_CAPSULES];
+        _mm256_store_ps(distanceLanes, distance2);
+        _mm256_store_ps(tLanes, t);
+        while (hits != 0) {
+            int lane = __builtin_ctz(hits);
+            hits &= hits - 1;
+            float distance = std::sqrt(distanceLanes[lane]);
+            float depth = radius - distance;
+            if (depth <= bestDepth) continue;
+            bestDepth = depth;
+            bestDistance = distance;
+            closest[0] = block.ax[lane] + tLanes[lane] * block.abx[lane];
+            closest[1] = block.ay[lane] + tLanes[lane] * block.aby[lane];
+            closest[2] = block.az[lane] + tLanes[lane] * block.abz[lane];
+        }
+    }
+    if (bestDepth <= 0.0f) return false;
+
+    // 표면 법선 (뼈 위에 정확히 놓인 경우는 위쪽으로)
+    float n[3] = {px - closest[0], py - closest[1], pz - closest[2]};
+    if (bestDistance > 1e-6f) {
+        float inv = 1.0f / bestDistance;
+        n[0] *= inv;
+        n[1] *= inv;
+        n[2] *= inv;
+    } else {
+        n[0] = 0.0f;
+        n[1] = 1.0f;
+        n[2] = 0.0f;
+    }
+
+    position[0] = closest[0] + n[0] * radius;
+    position[1] = closest[1] + n[1] * radius;
+    position[2] = closest[2] + n[2] * radius;
+
+    float normalSpeed = velocity[0] * n[0] + velocity[1] * n[1] + velocity[2] * n[2];
+    if (normalSpeed < 0.0f) {
+        float impulse = (1.0f + restitution) * normalSpeed;
+        velocity[0] -= impulse * n[0];
+        velocity[1] -= impulse * n[1];
+        velocity[2] -= impulse * n[2];
+    }
+    return true;
+}
+
+int HandCollider::collide(float* positions, float* velocities, int particleCount, float restitution) const {
+    if (!active) return 0;
+    const Node& root = nodes.front();
+    int collisions = 0;
+    for (int i = 0; i < particleCount; i++) {
+        float* p = positions + static_cast<size_t>(i) * 3;
+        // 대부분의 파티클은 손에서 멀리 있으므로 루트 상자 검사만 하고 넘어감
+        if (p[0] < root.lower[0] || p[0] > root.upper[0] || p[1] < root.lower[1] || p[1] > root.upper[1] ||
+            p[2] < root.lower[2] || p[2] > root.upper[2]) {
+            continue;
+        }
+        collisions += collideParticle(p, velocities + static_cast<size_t>(i) * 3, restitution);
+    }
+    return collisions;
+}
@@ -0,0 +1,60 @@
+#ifndef HAND_COLLIDER_H
+#define HAND_COLLIDER_H
+
+#include <cstdint>
+#include <vector>
+#include "mlp_model.h"
+
+// 손 뼈대 캡슐 충돌체 (파티클 시뮬레이션용)
+// 21개 랜드마크의 부모-자식 연결 20개를 반지름 r인 캡슐(선분 + 반지름)로 보고,
+// 매 프레임 작은 BVH(캡슐 중심 기준 중앙값 분할, 잎당 최대 8개)를 다시 만듭니다.
+// 파티클은 루트 AABB 밖이면 바로 건너뛰고, 안이면 겹치는 잎만 내려가
+// 잎의 캡슐 8개와의 거리를 AVX로 한 번에 계산합니다.
+// 가장 깊이 파고든 캡슐의 표면 밖으로 밀어내고, 표면 쪽으로 향하는 속도 성분은 반사(감쇠)합니다.
+class HandCollider {
+public:
+    static constexpr int LANDMARKS = 21;
+    static constexpr int BONES = 20;
+    static constexpr int LEAF_CAPSULES = SIMD_WIDTH;
+
+    HandCollider();
+
+    // landmarks: 42개(x, y, z = 0) 또는 63개(x, y, z) float, 파티클과 같은 좌표계
+    // 개수가 맞지 않으면 false (충돌체는 비활성)
+    bool update(const float* landmarks, int count, float radius);
+
+    void clear() { active = false; }
+    bool isActive() const { return active; }
+
+    // positions/velocities: particleCount × 3 float, 충돌한 파티클 수 반환
+    int collide(float* positions, float* velocities, int particleCount, float restitution) const;
+
+private:
+    struct Node {
+        float lower[3];
+        float upper[3];
+        int left;   // 내부 노드: 자식 인덱스 (오른쪽은 left + 1), 잎: -1
+        int leaf;   // 잎: leaves 블록 번호
+    };
+
+    // 잎 하나의 캡슐 8개 (SoA, 빈 칸은 먼 곳의 반지름 0 캡슐)
+    struct alignas(32) LeafBlock {
+        float ax[LEAF_CAPSULES], ay[LEAF_CAPSULES], az[LEAF_CAPSULES];
+        float abx[LEAF_CAPSULES], aby[LEAF_CAPSULES], abz[LEAF_CAPSULES];
+        float invLength2[LEAF_CAPSULES];
+        float radius2[LEAF_CAPSULES];
+    };
+
+    void build(int index, int begin, int end);
+    bool collideParticle(float* position, float* velocity, float restitution) const;
+
+    std::vector<float> points;      // 21 × 3
+    std::vector<int> boneOrder;     // 분할 중 정렬되는 뼈 번호
+    std::vector<float> boneCenter;  // 뼈별 중점 (분할 기준)
+    std::vector<Node> nodes;
+    std::vector<LeafBlock> leaves;
+    float radius;
+    bool active;
+};
+
+#endif // HAND_COLLIDER_H
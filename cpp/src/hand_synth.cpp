@@ -0,0 +1,318 @@
+#include "hand_synth.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr float TWO_PI = 6.2831853f;
+
+// 손가락 체인 형상 (오른손, 손바닥이 카메라를 향함, 손목–중지 기저부 거리 = 1)
+// base: 체인 시작 관절(엄지는 1번 CMC, 나머지는 MCP)의 로컬 좌표
+// angle: 손바닥 평면에서 -y(위쪽) 기준 방향 (라디안, +x 쪽이 양수)
+// length: 세 마디 길이, flex: curl=1일 때 관절별 굽힘 각도
+// turn: 엄지 전용, curl=1일 때 손바닥 쪽(+x)으로 도는 평면 내 각도
+struct FingerShape {
+    float baseX, baseY;
+    float angle;
+    float length[3];
+    float flex[3];
+    float turn[3];
+};
+
+const FingerShape FINGER_SHAPES[HAND_FINGERS] = {
+    {-0.25f, -0.20f, -0.90f, {0.30f, 0.27f, 0.22f}, {0.20f, 0.40f, 0.30f}, {0.50f, 0.70f, 0.60f}},  // 엄지
+    {-0.30f, -0.95f, -0.15f, {0.45f, 0.27f, 0.22f}, {1.50f, 1.70f, 1.20f}, {0.0f, 0.0f, 0.0f}},     // 검지
+    {0.00f, -1.00f, 0.00f, {0.50f, 0.30f, 0.23f}, {1.50f, 1.70f, 1.20f}, {0.0f, 0.0f, 0.0f}},       // 중지
+    {0.25f, -0.92f, 0.12f, {0.47f, 0.28f, 0.22f}, {1.50f, 1.70f, 1.20f}, {0.0f, 0.0f, 0.0f}},       // 약지
+    {0.45f, -0.80f, 0.25f, {0.36f, 0.20f, 0.18f}, {1.50f, 1.70f, 1.20f}, {0.0f, 0.0f, 0.0f}},       // 소지
+};
+
+// 손목 궤적 주파수 (Hz)와 진폭
+constexpr float SWAY_HZ = 0.31f;
+constexpr float BOB_HZ = 0.47f;
+constexpr float ROLL_HZ = 0.19f;
+constexpr float DEPTH_HZ = 0.11f;
+constexpr float SWAY_AMPLITUDE = 0.06f;
+constexpr float BOB_AMPLITUDE = 0.04f;
+constexpr float ROLL_AMPLITUDE = 0.15f;   // 라디안
+constexpr float DEPTH_AMPLITUDE = 0.10f;  // 크기 변화 비율
+
+// 페이저 오차 누적을 막기 위해 정규화하는 주기 (프레임)
+constexpr int RENORMALIZE_INTERVAL = 1024;
+
+inline float smoothstep(float t) {
+    return t * t * (3.0f - 2.0f * t);
+}
+
+} // namespace
+
+HandPose handPosePreset(SynthGesture gesture) {
+    // 엄지, 검지, 중지, 약지, 소지
+    static const float CURLS[static_cast<int>(SynthGesture::COUNT)][HAND_FINGERS] = {
+        {0.0f, 0.0f, 0.0f, 0.0f, 0.0f},  // Open
+        {1.0f, 1.0f, 1.0f, 1.0f, 1.0f},  // Fist
+        {1.0f, 0.0f, 1.0f, 1.0f, 1.0f},  // Point
+        {1.0f, 0.0f, 0.0f, 1.0f, 1.0f},  // Victory
+        {1.0f, 0.0f, 0.0f, 0.0f, 1.0f},  // Three
+        {0.0f, 0.0f, 1.0f, 1.0f, 0.0f},  // ILoveYou
+        {0.0f, 1.0f, 1.0f, 1.0f, 1.0f},  // ThumbsUp
+    };
+
+    HandPose pose;
+    int index = std::max(0, std::min(static_cast<int>(gesture), static_cast<int>(SynthGesture::COUNT) - 1));
+    std::memcpy(pose.curl, CURLS[index], sizeof(pose.curl));
+    pose.spread = (gesture == SynthGesture::Victory) ? 1.8f : 1.0f;
+    return pose;
+}
+
+void HandSynthesizer::Phasor::init(float radiansPerFrame, float phase) {
+    c = std::cos(phase);
+    s = std::sin(phase);
+    stepC = std::cos(radiansPerFrame);
+    stepS = std::sin(radiansPerFrame);
+}
+
+void HandSynthesizer::Phasor::advance() {
+    float nc = c * stepC - s * stepS;
+    s = s * stepC + c * stepS;
+    c = nc;
+}
+
+HandSynthesizer::HandSynthesizer(const HandSynthConfig& config) : settings(config) {
+    settings.hands = std::max(1, std::min(settings.hands, MAX_SYNTH_HANDS));
+    settings.fps = settings.fps > 0.0f ? settings.fps : 30.0f;
+    settings.dropoutFrames = std::max(1, settings.dropoutFrames);
+
+    if (settings.sequence.empty()) {
+        for (int g = 0; g < static_cast<int>(SynthGesture::COUNT); g++) {
+            settings.sequence.push_back(static_cast<SynthGesture>(g));
+        }
+    }
+    for (SynthGesture gesture : settings.sequence) poses.push_back(handPosePreset(gesture));
+
+    holdFrames = std::max(1, static_cast<int>(settings.holdSeconds * settings.fps));
+    transitionFrames = std::max(0, static_cast<int>(settings.transitionSeconds * settings.fps));
+
+    reset();
+}
+
+void HandSynthesizer::reset() {
+    frame = 0;
+    rng = settings.seed != 0 ? settings.seed : 0x9e3779b9u;
+    renormalizeCounter = 0;
+
+    int cycle = holdFrames + transitionFrames;
+    for (int h = 0; h < MAX_SYNTH_HANDS; h++) {
+        HandState& hand = handStates[h];
+        hand.side = (h == 0) ? 1.0f : -1.0f;
+        hand.centerX = (settings.hands == 1) ? 0.5f : (h == 0 ? 0.35f : 0.65f);
+        hand.centerY = 0.6f;
+        hand.boneScale = 0.95f + 0.1f * static_cast<float>(nextRandom() & 0xffff) / 65535.0f;
+        // 두 번째 손은 시퀀스 절반만큼 어긋나게 재생
+        hand.sequenceOffset = (h == 0) ? 0 : static_cast<int>(poses.size() / 2) * cycle + cycle / 3;
+        hand.dropoutLeft = 0;
+        hand.cachedStep = -2;
+
+        float phase = static_cast<float>(h) * 1.7f;
+        hand.sway.init(TWO_PI * SWAY_HZ / settings.fps, phase);
+        hand.bob.init(TWO_PI * BOB_HZ / settings.fps, phase * 0.5f);
+        hand.roll.init(TWO_PI * ROLL_HZ / settings.fps, phase * 1.3f);
+        hand.depth.init(TWO_PI * DEPTH_HZ / settings.fps, phase * 0.7f);
+    }
+}
+
+uint32_t HandSynthesizer::nextRandom() {
+    // xorshift32
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+float HandSynthesizer::gaussian() {
+    // 균등 분포 두 개의 합(삼각 분포)을 분산 1로 맞춘 근사 가우시안
+    uint32_t r = nextRandom();
+    float u = static_cast<float>(r & 0xffff) + static_cast<float>(r >> 16);
+    return (u * (1.0f / 65536.0f) - 1.0f) * 2.4494897f;  // sqrt(6)
+}
+
+void HandSynthesizer::computeLocal(HandState& hand, const HandPose& pose) const {
+    float* local = hand.local;
+    local[0] = local[1] = local[2] = 0.0f;
+
+    for (int f = 0; f < HAND_FINGERS; f++) {
+        const FingerShape& shape = FINGER_SHAPES[f];
+        float curl = std::max(0.0f, std::min(pose.curl[f], 1.0f));
+
+        float x = shape.baseX;
+        float y = shape.baseY;
+        float z = 0.0f;
+        float angle = shape.angle * (f == 0 ? 1.0f : pose.spread);
+        float flex = 0.0f;
+
+        int joint = 1 + f * 4;
+        local[joint * 3 + 0] = x * hand.side * hand.boneScale;
+        local[joint * 3 + 1] = y * hand.boneScale;
+        local[joint * 3 + 2] = 0.0f;
+
+        for (int k = 0; k < 3; k++) {
+            angle += curl * shape.turn[k];
+            flex += curl * shape.flex[k];
+            float planar = std::cos(flex) * shape.length[k];
+            x += std::sin(angle) * planar;
+            y -= std::cos(angle) * planar;
+            z -= std::sin(flex) * shape.length[k];  // 손바닥 쪽으로 굽으면 카메라에 가까워짐
+
+            int j = joint + 1 + k;
+            local[j * 3 + 0] = x * hand.side * hand.boneScale;
+            local[j * 3 + 1] = y * hand.boneScale;
+            local[j * 3 + 2] = z * hand.boneScale;
+        }
+    }
+}
+
+bool HandSynthesizer::emitHand(HandState& hand, float* out, int32_t& label) {
+    // 시퀀스 위치: 유지 구간이면 해당 제스처, 전환 구간이면 다음 제스처로 보간
+    int cycle = holdFrames + transitionFrames;
+    int64_t position = (frame + hand.sequenceOffset) % (static_cast<int64_t>(cycle) * poses.size());
+    int step = static_cast<int>(position / cycle);
+    int within = static_cast<int>(position % cycle);
+
+    if (within < holdFrames) {
+        label = static_cast<int32_t>(settings.sequence[step]);
+        if (hand.cachedStep != step) {
+            computeLocal(hand, poses[step]);
+            hand.cachedStep = step;
+        }
+    } else {
+        label = -1;
+        const HandPose& from = poses[step];
+        const HandPose& to = poses[(step + 1) % poses.size()];
+        float t = smoothstep(static_cast<float>(within - holdFrames + 1) / (transitionFrames + 1));
+        HandPose blended;
+        for (int f = 0; f < HAND_FINGERS; f++) blended.curl[f] = from.curl[f] + (to.curl[f] - from.curl[f]) * t;
+        blended.spread = from.spread + (to.spread - from.spread) * t;
+        computeLocal(hand, blended);
+        hand.cachedStep = -1;
+    }
+
+    // 손 미검출 구간 (연속 프레임)
+    if (hand.dropoutLeft > 0) {
+        hand.dropoutLeft--;
+        return false;
+    }
+    if (settings.dropoutRate > 0.0f &&
+        static_cast<float>(nextRandom() & 0xffffff) * (1.0f / 16777216.0f) < settings.dropoutRate) {
+        hand.dropoutLeft = static_cast<int>(nextRandom() % static_cast<uint32_t>(2 * settings.dropoutFrames - 1));
+        return false;
+    }
+
+    // 손목 궤적과 2D 유사 변환 (작은 회전각은 다항식 근사)
+    float scale = settings.handScale * (1.0f + DEPTH_AMPLITUDE * hand.depth.s);
+    float theta = ROLL_AMPLITUDE * hand.roll.s;
+    float theta2 = theta * theta;
+    float cosT = (1.0f - 0.5f * theta2) * scale;
+    float sinT = theta * (1.0f - theta2 * (1.0f / 6.0f)) * scale;
+    float cx = hand.centerX + SWAY_AMPLITUDE * hand.sway.s;
+    float cy = hand.centerY + BOB_AMPLITUDE * hand.bob.s;
+    float noise = settings.jitter;
+
+    const float* local = hand.local;
+    for (int j = 0; j < HAND_JOINTS; j++) {
+        float lx = local[j * 3 + 0];
+        float ly = local[j * 3 + 1];
+        out[j * 3 + 0] = cx + cosT * lx - sinT * ly + noise * gaussian();
+        out[j * 3 + 1] = cy + sinT * lx + cosT * ly + noise * gaussian();
+        out[j * 3 + 2] = scale * local[j * 3 + 2] + noise * gaussian();
+    }
+    return true;
+}
+
+void HandSynthesizer::advanceFrame() {
+    frame++;
+    bool renormalize = ++renormalizeCounter >= RENORMALIZE_INTERVAL;
+    if (renormalize) renormalizeCounter = 0;
+
+    for (int h = 0; h < settings.hands; h++) {
+        HandState& hand = handStates[h];
+        Phasor* phasors[] = {&hand.sway, &hand.bob, &hand.roll, &hand.depth};
+        for (Phasor* p : phasors) {
+            p->advance();
+            if (renormalize) {
+                float inv = 1.0f / std::sqrt(p->c * p->c + p->s * p->s);
+                p->c *= inv;
+                p->s *= inv;
+            }
+        }
+    }
+}
+
+void HandSynthesizer::generateLandmarks(float* out, int frames, uint8_t* present, int32_t* labels) {
+    int hands = settings.hands;
+    for (int f = 0; f < frames; f++) {
+        int32_t label = -1;
+        for (int h = 0; h < hands; h++) {
+            float* dst = out + (static_cast<size_t>(f) * hands + h) * HAND_FLOATS;
+            int32_t handLabel;
+            bool visible = emitHand(handStates[h], dst, handLabel);
+            if (!visible) std::memset(dst, 0, HAND_FLOATS * sizeof(float));
+            if (present != nullptr) present[static_cast<size_t>(f) * hands + h] = visible ? 1 : 0;
+            if (h == 0) label = handLabel;
+        }
+        if (labels != nullptr) labels[f] = label;
+        advanceFrame();
+    }
+}
+
+void HandSynthesizer::generateRecognizerFrames(float* out, int frames, int32_t* labels) {
+    float hand[HAND_FLOATS];
+    for (int f = 0; f < frames; f++) {
+        float* dst = out + static_cast<size_t>(f) * SYNTH_XY_FLOATS;
+        int32_t label = -1;
+        bool visible = emitHand(handStates[0], hand, label);
+        for (int h = 1; h < settings.hands; h++) {
+            float unused[HAND_FLOATS];
+            int32_t unusedLabel;
+            emitHand(handStates[h], unused, unusedLabel);
+        }
+
+        for (int j = 0; j < HAND_JOINTS; j++) {
+            dst[j * 2 + 0] = visible ? hand[j * 3 + 0] : 0.0f;
+            dst[j * 2 + 1] = visible ? hand[j * 3 + 1] : 0.0f;
+        }
+        if (labels != nullptr) labels[f] = label;
+        advanceFrame();
+    }
+}
+
+void HandSynthesizer::generateFeatures(float* out, int frames, int32_t* labels) {
+    float hand[HAND_FLOATS];
+    for (int f = 0; f < frames; f++) {
+        float* dst = out + static_cast<size_t>(f) * SYNTH_FEATURE_FLOATS;
+        std::memset(dst, 0, SYNTH_FEATURE_FLOATS * sizeof(float));
+        int32_t label = -1;
+
+        for (int h = 0; h < settings.hands; h++) {
+            int32_t handLabel;
+            bool visible = emitHand(handStates[h], hand, handLabel);
+            if (h == 0) label = handLabel;
+            if (!visible) continue;
+
+            // 왼손은 0~62, 오른손은 63~125 (웹 앱 convertLandmarksToVector와 동일)
+            float* features = dst + (handStates[h].side > 0.0f ? HAND_FLOATS : 0);
+            float rx = hand[27] - hand[0];
+            float ry = hand[28] - hand[1];
+            float rz = hand[29] - hand[2];
+            float norm = std::sqrt(rx * rx + ry * ry + rz * rz);
+            float inv = norm > 0.0f ? 1.0f / norm : 1.0f;
+            for (int j = 0; j < HAND_JOINTS; j++) {
+                features[j * 3 + 0] = (hand[j * 3 + 0] - hand[0]) * inv;
+                features[j * 3 + 1] = (hand[j * 3 + 1] - hand[1]) * inv;
+                features[j * 3 + 2] = (hand[j * 3 + 2] - hand[2]) * inv;
+            }
+        }
+        if (labels != nullptr) labels[f] = label;
+        advanceFrame();
+    }
+}
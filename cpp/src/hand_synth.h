@@ -0,0 +1,120 @@
+#ifndef HAND_SYNTH_H
+#define HAND_SYNTH_H
+
+#include <cstdint>
+#include <vector>
+
+// 21관절 손 토폴로지 (MediaPipe와 동일)
+// 0: 손목, 엄지 1–4, 검지 5–8, 중지 9–12, 약지 13–16, 소지 17–20
+constexpr int HAND_JOINTS = 21;
+constexpr int HAND_FINGERS = 5;
+constexpr int HAND_FLOATS = HAND_JOINTS * 3;      // x, y, z
+constexpr int MAX_SYNTH_HANDS = 2;
+
+// 인식기 입력 형식
+constexpr int SYNTH_XY_FLOATS = HAND_JOINTS * 2;  // recognizeBatch: 첫 번째 손의 x, y
+constexpr int SYNTH_FEATURE_FLOATS = 126;         // predictBatch: 왼손 63 + 오른손 63 (손목 기준 정규화)
+
+// 손가락 자세: curl 0이면 펴짐, 1이면 완전히 굽힘 (엄지, 검지, 중지, 약지, 소지 순)
+struct HandPose {
+    float curl[HAND_FINGERS] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float spread = 1.0f;  // 손가락 사이 벌림 배율
+};
+
+// 미리 정의된 제스처 (규칙 기반 인식기와 학습 데이터 라벨을 따라 구성)
+enum class SynthGesture {
+    Open = 0,     // 다섯 손가락 모두 폄 (안녕하세요 / hello)
+    Fist,         // 주먹 (감사합니다)
+    Point,        // 검지만 폄 (예)
+    Victory,      // 검지 + 중지 (V)
+    Three,        // 검지 + 중지 + 약지 (OK)
+    ILoveYou,     // 엄지 + 검지 + 소지 (love)
+    ThumbsUp,     // 엄지만 폄 (nice)
+    COUNT
+};
+
+HandPose handPosePreset(SynthGesture gesture);
+
+// 생성 설정
+struct HandSynthConfig {
+    int hands = 1;                      // 1: 오른손만, 2: 오른손 + 왼손
+    std::vector<SynthGesture> sequence; // 순환 재생 (비어 있으면 전체 제스처 순서대로)
+    float fps = 30.0f;
+    float holdSeconds = 0.8f;           // 제스처 유지 시간
+    float transitionSeconds = 0.25f;    // 다음 제스처로 보간하는 시간
+    float jitter = 0.002f;              // 관절 좌표 노이즈 표준편차 (이미지 좌표 비율)
+    float dropoutRate = 0.01f;          // 프레임마다 손이 사라지기 시작할 확률
+    int dropoutFrames = 4;              // 한 번 사라지면 유지되는 평균 프레임 수
+    float handScale = 0.18f;            // 손목–중지 기저부 거리 (이미지 높이 비율)
+    uint32_t seed = 1;
+};
+
+// 매개변수 운동학 손 모델 기반 랜드마크 스트림 생성기
+// - 손가락은 손바닥 평면에서 시작해 관절마다 카메라 쪽으로 굽는 4마디 체인
+// - 손목 위치/회전/크기는 느린 리사주 궤적으로 움직임 (회전 페이저로 삼각함수 없이 갱신)
+// - 관절 로컬 좌표는 자세가 바뀌는 전환 구간에서만 다시 계산하고,
+//   유지 구간에서는 2D 변환과 노이즈만 적용하여 초당 수백만 프레임을 생성합니다.
+class HandSynthesizer {
+public:
+    explicit HandSynthesizer(const HandSynthConfig& config = HandSynthConfig());
+
+    // 원시 랜드마크: frames × hands × 63 (이미지 좌표 x, y ∈ [0,1], 상대 깊이 z)
+    // present(선택): frames × hands, 손이 검출되지 않은 프레임은 0이며 좌표도 0
+    // labels(선택): 프레임별 제스처 번호 (전환 구간은 -1)
+    void generateLandmarks(float* out, int frames, uint8_t* present = nullptr, int32_t* labels = nullptr);
+
+    // recognizeBatch 입력: frames × 42 (첫 번째 손의 x, y)
+    void generateRecognizerFrames(float* out, int frames, int32_t* labels = nullptr);
+
+    // predictBatch 입력: frames × 126 (웹 앱과 같은 손목 기준, 중지 기저부 거리 정규화)
+    void generateFeatures(float* out, int frames, int32_t* labels = nullptr);
+
+    // 재생 위치를 처음으로 (같은 seed면 같은 스트림)
+    void reset();
+
+    const HandSynthConfig& config() const { return settings; }
+
+private:
+    struct Phasor {
+        float c = 1.0f;
+        float s = 0.0f;
+        float stepC = 1.0f;
+        float stepS = 0.0f;
+        void init(float radiansPerFrame, float phase);
+        void advance();
+    };
+
+    struct HandState {
+        float side = 1.0f;              // 오른손 1, 왼손 -1 (x 미러)
+        float boneScale = 1.0f;         // 사람마다 다른 손 크기
+        float centerX = 0.5f;
+        float centerY = 0.6f;
+        int sequenceOffset = 0;
+        int dropoutLeft = 0;
+        int cachedStep = -2;            // local이 계산된 시퀀스 위치 (-2: 없음)
+        float local[HAND_FLOATS];       // 손목 기준 로컬 좌표 (손 크기 단위)
+        Phasor sway;                    // 손목 x/y 흔들림
+        Phasor bob;
+        Phasor roll;                    // 손목 회전
+        Phasor depth;                   // 카메라 거리 (크기 변화)
+    };
+
+    // 현재 프레임의 손 하나를 이미지 좌표로 계산 (미검출이면 false)
+    bool emitHand(HandState& hand, float* out, int32_t& label);
+    void advanceFrame();
+    void computeLocal(HandState& hand, const HandPose& pose) const;
+
+    uint32_t nextRandom();
+    float gaussian();
+
+    HandSynthConfig settings;
+    std::vector<HandPose> poses;
+    HandState handStates[MAX_SYNTH_HANDS];
+    int holdFrames;
+    int transitionFrames;
+    int64_t frame;
+    uint32_t rng;
+    int renormalizeCounter;
+};
+
+#endif // HAND_SYNTH_H
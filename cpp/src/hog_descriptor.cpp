@@ -0,0 +1,234 @@
+#include "hog_descriptor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+constexpr float HOG_PI = 3.14159265358979f;
+
+// 부호 없는 방향 atan2(y, x) mod π, 최대 오차 약 1e-5 rad
+inline __m256 unsignedOrientation(__m256 gx, __m256 gy) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 ax = _mm256_andnot_ps(signMask, gx);
+    __m256 ay = _mm256_andnot_ps(signMask, gy);
+    __m256 hi = _mm256_max_ps(ax, ay);
+    __m256 lo = _mm256_min_ps(ax, ay);
+    __m256 a = _mm256_div_ps(lo, _mm256_max_ps(hi, _mm256_set1_ps(1e-20f)));
+    __m256 s = _mm256_mul_ps(a, a);
+
+    __m256 r = _mm256_set1_ps(0.0208351f);
+    r = _mm256_add_ps(_mm256_mul_ps(r, s), _mm256_set1_ps(-0.0851330f));
+    r = _mm256_add_ps(_mm256_mul_ps(r, s), _mm256_set1_ps(0.1801410f));
+    r = _mm256_add_ps(_mm256_mul_ps(r, s), _mm256_set1_ps(-0.3302995f));
+    r = _mm256_add_ps(_mm256_mul_ps(r, s), _mm256_set1_ps(0.9998660f));
+    r = _mm256_mul_ps(r, a);
+
+    // |y| > |x|이면 π/2 - r, x·y < 0이면 π - r
+    __m256 steep = _mm256_cmp_ps(ay, ax, _CMP_GT_OQ);
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(HOG_PI * 0.5f), r), steep);
+    __m256 opposite = _mm256_xor_ps(gx, gy);  // 부호 비트 = x·y < 0
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(HOG_PI), r), opposite);
+    return r;
+}
+
+} // namespace
+
+HogDescriptor::HogDescriptor(const HogConfig& config)
+    : settings(config), grayStride(0), gradientStride(0), cachedWidth(-1) {
+    settings.cellSize = std::max(1, settings.cellSize);
+    settings.blockCells = std::max(1, settings.blockCells);
+    settings.bins = std::max(2, settings.bins);
+}
+
+int HogDescriptor::descriptorSize(int width, int height) const {
+    int cellsX = width / settings.cellSize;
+    int cellsY = height / settings.cellSize;
+    int blocksX = cellsX - settings.blockCells + 1;
+    int blocksY = cellsY - settings.blockCells + 1;
+    if (blocksX <= 0 || blocksY <= 0) return 0;
+    return blocksX * blocksY * settings.blockCells * settings.blockCells * settings.bins;
+}
+
+int HogDescriptor::compute(const uint8_t* rgba, int imageWidth, int imageHeight, int x, int y, int width,
+                           int height, float* out) {
+    if (rgba == nullptr || out == nullptr) return 0;
+
+    // 이미지 안으로 자르고 셀 배수로 맞춤
+    int x0 = std::max(0, x);
+    int y0 = std::max(0, y);
+    int x1 = std::min(imageWidth, x + width);
+    int y1 = std::min(imageHeight, y + height);
+    const int cellsX = (x1 - x0) / settings.cellSize;
+    const int cellsY = (y1 - y0) / settings.cellSize;
+    const int size = descriptorSize(x1 - x0, y1 - y0);
+    if (size == 0) return 0;
+    const int w = cellsX * settings.cellSize;
+    const int h = cellsY * settings.cellSize;
+
+    // 1. 휘도 (가장자리 1픽셀 복제, 행 끝은 SIMD 로드용 여유)
+    grayStride = padToSimd(w + 2) + SIMD_WIDTH;
+    gradientStride = padToSimd(w);
+    gray.resize(static_cast<size_t>(h + 2) * grayStride);
+    for (int row = 0; row < h + 2; row++) {
+        int sy = std::min(std::max(y0 + row - 1, y0), y0 + h - 1);
+        const uint8_t* src = rgba + (static_cast<size_t>(sy) * imageWidth + x0) * 4;
+        float* dst = gray.data() + static_cast<size_t>(row) * grayStride;
+        for (int col = 0; col < w; col++) {
+            const uint8_t* p = src + col * 4;
+            dst[col + 1] = (77.0f * p[0] + 150.0f * p[1] + 29.0f * p[2]) * (1.0f / 256.0f);
+        }
+        dst[0] = dst[1];
+        dst[w + 1] = dst[w];
+        std::fill(dst + w + 2, dst + grayStride, dst[w]);
+    }
+
+    accumulateCells(w, h, cellsX, cellsY);
+    return normalizeBlocks(cellsX, cellsY, out);
+}
+
+// 2. 한 행의 기울기, 크기, 방향을 8픽셀씩 계산하고 투표량을 미리 곱해 둠
+//    (방향 선형 보간 2구간 × 셀 x 선형 보간 2셀 = 4개, 셀 y 가중치는 행 단위로 적용)
+void HogDescriptor::computeRowVotes(int row, int width) {
+    const float* above = gray.data() + static_cast<size_t>(row) * grayStride + 1;
+    const float* center = above + grayStride;
+    const float* below = center + grayStride;
+    const int bins = settings.bins;
+    const __m256 binScale = _mm256_set1_ps(bins / HOG_PI);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i binCount = _mm256_set1_epi32(bins);
+    const __m256i zero = _mm256_setzero_si256();
+
+    float* low0 = rowVotes.data();
+    float* high0 = low0 + gradientStride;
+    float* low1 = high0 + gradientStride;
+    float* high1 = low1 + gradientStride;
+    int32_t* binLow = rowBins.data();
+    int32_t* binHigh = binLow + gradientStride;
+
+    for (int col = 0; col < width; col += SIMD_WIDTH) {
+        __m256 gx = _mm256_sub_ps(_mm256_loadu_ps(center + col + 1), _mm256_loadu_ps(center + col - 1));
+        __m256 gy = _mm256_sub_ps(_mm256_loadu_ps(below + col), _mm256_loadu_ps(above + col));
+        __m256 m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)));
+
+        // 구간 중심이 (b + 0.5)·180°/bins가 되도록 0.5 이동, 양 끝 구간은 순환
+        __m256 position = _mm256_sub_ps(_mm256_mul_ps(unsignedOrientation(gx, gy), binScale), half);
+        __m256 floored = _mm256_floor_ps(position);
+        __m256 highWeight = _mm256_mul_ps(m, _mm256_sub_ps(position, floored));
+        __m256 lowWeight = _mm256_sub_ps(m, highWeight);
+        __m256i b0 = _mm256_cvttps_epi32(floored);
+        __m256i b1 = _mm256_add_epi32(b0, _mm256_set1_epi32(1));
+        b0 = _mm256_add_epi32(b0, _mm256_and_si256(_mm256_cmpgt_epi32(zero, b0), binCount));
+        b1 = _mm256_sub_epi32(b1, _mm256_andnot_si256(_mm256_cmpgt_epi32(binCount, b1), binCount));
+
+        __m256 wx1 = _mm256_load_ps(cellWeightX.data() + col);
+        __m256 wx0 = _mm256_sub_ps(one, wx1);
+        _mm256_store_ps(low0 + col, _mm256_mul_ps(lowWeight, wx0));
+        _mm256_store_ps(high0 + col, _mm256_mul_ps(highWeight, wx0));
+        _mm256_store_ps(low1 + col, _mm256_mul_ps(lowWeight, wx1));
+        _mm256_store_ps(high1 + col, _mm256_mul_ps(highWeight, wx1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(binLow + col), b0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(binHigh + col), b1);
+    }
+}
+
+// 3. 삼선형 보간 투표
+//    행마다 양옆에 여분 셀을 둔 행 히스토그램에 분기 없이 모은 뒤,
+//    셀 중심 기준 y 가중치로 위/아래 셀 행에 더합니다.
+void HogDescriptor::accumulateCells(int width, int height, int cellsX, int cellsY) {
+    const int bins = settings.bins;
+    const int cell = settings.cellSize;
+    const float invCell = 1.0f / cell;
+    cellHistograms.assign(static_cast<size_t>(cellsX) * cellsY * bins, 0.0f);
+
+    // 열별 왼쪽 셀 위치(여분 셀 포함 번호)와 오른쪽 셀 가중치는 영역 폭이 같으면 재사용
+    if (cachedWidth != width) {
+        cachedWidth = width;
+        cellOffsetX.resize(width);
+        cellWeightX.assign(gradientStride, 0.0f);
+        for (int col = 0; col < width; col++) {
+            float cx = (col + 0.5f) * invCell - 0.5f;
+            int c0 = static_cast<int>(std::floor(cx));
+            cellOffsetX[col] = (c0 + 1) * bins;
+            cellWeightX[col] = cx - c0;
+        }
+    }
+    rowVotes.resize(static_cast<size_t>(gradientStride) * 4);
+    rowBins.resize(static_cast<size_t>(gradientStride) * 2);
+
+    const int rowFloats = cellsX * bins;
+    for (int row = 0; row < height; row++) {
+        computeRowVotes(row, width);
+
+        rowHistogram.assign(static_cast<size_t>(cellsX + 2) * bins, 0.0f);
+        float* hist = rowHistogram.data();
+        const float* low0 = rowVotes.data();
+        const float* high0 = low0 + gradientStride;
+        const float* low1 = high0 + gradientStride;
+        const float* high1 = low1 + gradientStride;
+        const int32_t* binLow = rowBins.data();
+        const int32_t* binHigh = binLow + gradientStride;
+
+        for (int col = 0; col < width; col++) {
+            float* left = hist + cellOffsetX[col];
+            float* right = left + bins;
+            left[binLow[col]] += low0[col];
+            left[binHigh[col]] += high0[col];
+            right[binLow[col]] += low1[col];
+            right[binHigh[col]] += high1[col];
+        }
+
+        // 여분 셀(영역 밖)을 버리고 위/아래 셀 행에 y 가중치로 합산
+        float cy = (row + 0.5f) * invCell - 0.5f;
+        int r0 = static_cast<int>(std::floor(cy));
+        float wy1 = cy - r0;
+        float wy0 = 1.0f - wy1;
+        const float* inside = hist + bins;
+        if (r0 >= 0) {
+            float* top = cellHistograms.data() + static_cast<size_t>(r0) * rowFloats;
+            for (int i = 0; i < rowFloats; i++) top[i] += inside[i] * wy0;
+        }
+        if (r0 + 1 < cellsY) {
+            float* bottom = cellHistograms.data() + static_cast<size_t>(r0 + 1) * rowFloats;
+            for (int i = 0; i < rowFloats; i++) bottom[i] += inside[i] * wy1;
+        }
+    }
+}
+
+// 4. 블록 L2-Hys: L2 정규화 → clip으로 자르기 → 다시 L2 정규화
+int HogDescriptor::normalizeBlocks(int cellsX, int cellsY, float* out) const {
+    const int bins = settings.bins;
+    const int blockCells = settings.blockCells;
+    const int rowFloats = blockCells * bins;
+    const int blockFloats = blockCells * rowFloats;
+    const float epsilon = 1e-3f;
+    float* dst = out;
+
+    for (int by = 0; by + blockCells <= cellsY; by++) {
+        for (int bx = 0; bx + blockCells <= cellsX; bx++) {
+            // 블록 안의 셀 행은 히스토그램에서 연속
+            for (int r = 0; r < blockCells; r++) {
+                const float* src = cellHistograms.data() + (static_cast<size_t>(by + r) * cellsX + bx) * bins;
+                std::memcpy(dst + r * rowFloats, src, rowFloats * sizeof(float));
+            }
+
+            float sum = 0.0f;
+            for (int i = 0; i < blockFloats; i++) sum += dst[i] * dst[i];
+            float scale = 1.0f / std::sqrt(sum + epsilon * epsilon);
+
+            float clippedSum = 0.0f;
+            for (int i = 0; i < blockFloats; i++) {
+                float v = std::min(dst[i] * scale, settings.clip);
+                dst[i] = v;
+                clippedSum += v * v;
+            }
+            float rescale = 1.0f / std::sqrt(clippedSum + epsilon * epsilon);
+            for (int i = 0; i < blockFloats; i++) dst[i] *= rescale;
+
+            dst += blockFloats;
+        }
+    }
+    return static_cast<int>(dst - out);
+}
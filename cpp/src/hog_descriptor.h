@@ -0,0 +1,55 @@
+#ifndef HOG_DESCRIPTOR_H
+#define HOG_DESCRIPTOR_H
+
+#include <cstdint>
+#include <vector>
+#include "mlp_model.h"
+
+// HOG 설정 (Dalal–Triggs 기본값)
+struct HogConfig {
+    int cellSize = 8;       // 셀 한 변의 픽셀 수
+    int blockCells = 2;     // 블록 한 변의 셀 수 (블록은 한 셀씩 이동)
+    int bins = 9;           // 0–180° 부호 없는 방향 구간 수
+    float clip = 0.2f;      // L2-Hys 잘라내기 값
+};
+
+// 손/얼굴 영역의 HOG(방향 기울기 히스토그램) 특징
+// 1. RGBA → 휘도 (가장자리 복제 패딩)
+// 2. AVX로 [-1, 0, 1] 기울기, 크기, 다항식 atan2 근사로 방향을 8픽셀씩 계산하고 투표량을 미리 곱함
+// 3. 방향 2구간 × 인접 셀 2×2에 삼선형 보간으로 투표 (x는 행 히스토그램, y는 행 단위로 분리)
+// 4. 블록별 L2-Hys 정규화
+// 작업 버퍼는 객체에 보관되어 같은 크기 영역을 반복 처리할 때 할당하지 않습니다.
+class HogDescriptor {
+public:
+    explicit HogDescriptor(const HogConfig& config = HogConfig());
+
+    // width × height 영역의 특징 길이 (셀보다 작으면 0)
+    int descriptorSize(int width, int height) const;
+
+    // RGBA 이미지의 (x, y, width, height) 영역을 out에 기록, 특징 길이 반환
+    // 영역이 이미지를 벗어나면 잘라내고, 셀 배수가 아닌 나머지 픽셀은 무시합니다.
+    int compute(const uint8_t* rgba, int imageWidth, int imageHeight, int x, int y, int width, int height,
+                float* out);
+
+    const HogConfig& config() const { return settings; }
+
+private:
+    void computeRowVotes(int row, int width);
+    void accumulateCells(int width, int height, int cellsX, int cellsY);
+    int normalizeBlocks(int cellsX, int cellsY, float* out) const;
+
+    HogConfig settings;
+
+    AlignedFloatVector gray;         // (height + 2) × grayStride, 가장자리 복제
+    AlignedFloatVector rowVotes;     // 한 행의 투표량 4종 × gradientStride
+    std::vector<int32_t> rowBins;    // 한 행의 아래/위 방향 구간 2종 × gradientStride
+    std::vector<float> rowHistogram; // (셀 수 + 2) × bins, 양 끝은 영역 밖 여분 셀
+    std::vector<float> cellHistograms;
+    std::vector<int> cellOffsetX;    // 열별 왼쪽 셀의 rowHistogram 오프셋 (영역 폭이 바뀔 때만 갱신)
+    AlignedFloatVector cellWeightX;  // 열별 오른쪽 셀 가중치
+    int grayStride;
+    int gradientStride;
+    int cachedWidth;
+};
+
+#endif // HOG_DESCRIPTOR_H
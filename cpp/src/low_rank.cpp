@@ -0,0 +1,414 @@
+#include "low_rank.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// 랜덤 부분공간에 더하는 여분 차수와 거듭제곱 반복 횟수 (작은 특이값 구간의 분리 개선)
+constexpr int OVERSAMPLE = 8;
+constexpr int POWER_ITERATIONS = 2;
+constexpr int JACOBI_SWEEPS = 40;
+
+// 시험할 랭크 후보 (최대 랭크가 이 목록에 없으면 마지막에 추가)
+const int RANK_CANDIDATES[] = {4, 8, 16, 24, 32, 48, 64, 96, 128, 192, 256};
+
+// 측정 한 번의 최소 길이 (타이머 해상도보다 충분히 길게)
+constexpr double MIN_TRIAL_SECONDS = 0.001;
+constexpr int TRIALS = 3;
+
+double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// fn을 반복 실행해 1회당 최소 시간(초)을 측정
+template <typename Fn>
+double measure(Fn&& fn) {
+    fn(); // 워밍업
+
+    double start = nowSeconds();
+    fn();
+    double single = std::max(nowSeconds() - start, 1e-7);
+    int reps = std::max(1, static_cast<int>(MIN_TRIAL_SECONDS / single));
+
+    double best = 1e30;
+    for (int t = 0; t < TRIALS; t++) {
+        start = nowSeconds();
+        for (int r = 0; r < reps; r++) fn();
+        best = std::min(best, (nowSeconds() - start) / reps);
+    }
+    return best;
+}
+
+// 결정적 표준 정규 난수 (xorshift + Box–Muller)
+struct Gaussian {
+    uint32_t state = 0x2545f491u;
+
+    double uniform() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return (static_cast<double>(state) + 1.0) / 4294967297.0;
+    }
+
+    double next() {
+        return std::sqrt(-2.0 * std::log(uniform())) * std::cos(6.283185307179586 * uniform());
+    }
+};
+
+double dot(const double* a, const double* b, int n) {
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+// count개 벡터(각 length)를 수정 Gram–Schmidt로 두 번 직교화 (선형 종속 벡터는 0으로)
+void orthonormalize(std::vector<double>& vectors, int count, int length) {
+    for (int pass = 0; pass < 2; pass++) {
+        for (int j = 0; j < count; j++) {
+            double* v = &vectors[static_cast<size_t>(j) * length];
+            for (int k = 0; k < j; k++) {
+                const double* q = &vectors[static_cast<size_t>(k) * length];
+                double proj = dot(v, q, length);
+                for (int i = 0; i < length; i++) v[i] -= proj * q[i];
+            }
+            double norm = std::sqrt(dot(v, v, length));
+            double inv = norm > 1e-12 ? 1.0 / norm : 0.0;
+            for (int i = 0; i < length; i++) v[i] *= inv;
+        }
+    }
+}
+
+// out_j = W · in_j (W: rows × cols 행 우선, in_j 길이 cols, out_j 길이 rows)
+void multiply(const std::vector<double>& w, int rows, int cols, const std::vector<double>& in, int count,
+              std::vector<double>& out) {
+    out.assign(static_cast<size_t>(count) * rows, 0.0);
+    for (int j = 0; j < count; j++) {
+        const double* x = &in[static_cast<size_t>(j) * cols];
+        double* y = &out[static_cast<size_t>(j) * rows];
+        for (int r = 0; r < rows; r++) y[r] = dot(&w[static_cast<size_t>(r) * cols], x, cols);
+    }
+}
+
+// out_j = Wᵀ · in_j (in_j 길이 rows, out_j 길이 cols), W를 행 순서로 한 번만 훑음
+void multiplyTransposed(const std::vector<double>& w, int rows, int cols, const std::vector<double>& in, int count,
+                        std::vector<double>& out) {
+    out.assign(static_cast<size_t>(count) * cols, 0.0);
+    for (int r = 0; r < rows; r++) {
+        const double* row = &w[static_cast<size_t>(r) * cols];
+        for (int j = 0; j < count; j++) {
+            double scale = in[static_cast<size_t>(j) * rows + r];
+            if (scale == 0.0) continue;
+            double* y = &out[static_cast<size_t>(j) * cols];
+            for (int c = 0; c < cols; c++) y[c] += scale * row[c];
+        }
+    }
+}
+
+// 대칭 행렬 a(n × n)의 순환 Jacobi 고유분해: 대각에 고유값, vectors의 열 k가 고유벡터
+void symmetricEigen(std::vector<double>& a, int n, std::vector<double>& vectors) {
+    vectors.assign(static_cast<size_t>(n) * n, 0.0);
+    for (int i = 0; i < n; i++) vectors[static_cast<size_t>(i) * n + i] = 1.0;
+
+    double total = 0.0;
+    for (double v : a) total += v * v;
+
+    for (int sweep = 0; sweep < JACOBI_SWEEPS; sweep++) {
+        double off = 0.0;
+        for (int p = 0; p < n; p++)
+            for (int q = p + 1; q < n; q++) off += a[static_cast<size_t>(p) * n + q] * a[static_cast<size_t>(p) * n + q];
+        if (off <= 1e-28 * total) break;
+
+        for (int p = 0; p < n; p++) {
+            for (int q = p + 1; q < n; q++) {
+                double apq = a[static_cast<size_t>(p) * n + q];
+                if (std::fabs(apq) < 1e-300) continue;
+                double app = a[static_cast<size_t>(p) * n + p];
+                double aqq = a[static_cast<size_t>(q) * n + q];
+                double theta = (aqq - app) / (2.0 * apq);
+                double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+
+                for (int k = 0; k < n; k++) {
+                    double akp = a[static_cast<size_t>(k) * n + p];
+                    double akq = a[static_cast<size_t>(k) * n + q];
+                    a[static_cast<size_t>(k) * n + p] = c * akp - s * akq;
+                    a[static_cast<size_t>(k) * n + q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < n; k++) {
+                    double apk = a[static_cast<size_t>(p) * n + k];
+                    double aqk = a[static_cast<size_t>(q) * n + k];
+                    a[static_cast<size_t>(p) * n + k] = c * apk - s * aqk;
+                    a[static_cast<size_t>(q) * n + k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < n; k++) {
+                    double vkp = vectors[static_cast<size_t>(k) * n + p];
+                    double vkq = vectors[static_cast<size_t>(k) * n + q];
+                    vectors[static_cast<size_t>(k) * n + p] = c * vkp - s * vkq;
+                    vectors[static_cast<size_t>(k) * n + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+// 분해 레이어 두 개의 패킹 후 가중치 원소 수 (바이어스 포함, 원래 레이어와 같은 정밀도 가정)
+size_t factoredElements(int rows, int cols, int rank, size_t elementBytes) {
+    size_t weights = static_cast<size_t>(rank) * padToSimd(cols) + static_cast<size_t>(rows) * padToSimd(rank);
+    size_t bias = static_cast<size_t>(rank + rows) * sizeof(float) / elementBytes;
+    return weights + bias;
+}
+
+// 보정 입력에 대한 argmax 정확도
+float evaluate(const MlpModel& model, const float* inputs, const int32_t* labels, int frames,
+               std::vector<float>& logits) {
+    const int numClasses = model.outputDim();
+    logits.resize(static_cast<size_t>(frames) * numClasses);
+    model.forwardBatch(inputs, logits.data(), frames);
+
+    int correct = 0;
+    for (int f = 0; f < frames; f++) {
+        const float* row = logits.data() + static_cast<size_t>(f) * numClasses;
+        correct += (std::max_element(row, row + numClasses) - row) == labels[f];
+    }
+    return static_cast<float>(correct) / frames;
+}
+
+} // namespace
+
+bool LowRankCompressor::factorize(const float* rowMajor, int rows, int cols, int maxRank, LowRankFactors& out) {
+    const int full = std::min(rows, cols);
+    if (rowMajor == nullptr || full <= 0 || maxRank <= 0) return false;
+    const int rank = std::min(maxRank, full);
+    const int sketch = std::min(rank + OVERSAMPLE, full);
+
+    std::vector<double> w(rowMajor, rowMajor + static_cast<size_t>(rows) * cols);
+
+    // 1. Y = W·Ω로 열 공간 근사, 거듭제곱 반복 (W·Wᵀ)^q로 특이값 간격 확대
+    std::vector<double> omega(static_cast<size_t>(sketch) * cols);
+    Gaussian gaussian;
+    for (double& v : omega) v = gaussian.next();
+
+    std::vector<double> q;
+    std::vector<double> z;
+    multiply(w, rows, cols, omega, sketch, q);
+    orthonormalize(q, sketch, rows);
+    for (int it = 0; it < POWER_ITERATIONS; it++) {
+        multiplyTransposed(w, rows, cols, q, sketch, z);
+        orthonormalize(z, sketch, cols);
+        multiply(w, rows, cols, z, sketch, q);
+        orthonormalize(q, sketch, rows);
+    }
+
+    // 2. B = Qᵀ·W (sketch × cols), B·Bᵀ의 고유분해로 B의 SVD
+    std::vector<double> b;
+    multiplyTransposed(w, rows, cols, q, sketch, b);
+
+    std::vector<double> gram(static_cast<size_t>(sketch) * sketch);
+    for (int i = 0; i < sketch; i++) {
+        for (int j = i; j < sketch; j++) {
+            double v = dot(&b[static_cast<size_t>(i) * cols], &b[static_cast<size_t>(j) * cols], cols);
+            gram[static_cast<size_t>(i) * sketch + j] = v;
+            gram[static_cast<size_t>(j) * sketch + i] = v;
+        }
+    }
+    std::vector<double> eigenvectors;
+    symmetricEigen(gram, sketch, eigenvectors);
+
+    std::vector<int> order(sketch);
+    for (int i = 0; i < sketch; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int x, int y) {
+        return gram[static_cast<size_t>(x) * sketch + x] > gram[static_cast<size_t>(y) * sketch + y];
+    });
+
+    // 3. U = Q·E, Vt = Eᵀ·B / σ
+    out.rows = rows;
+    out.cols = cols;
+    out.rank = rank;
+    out.u.assign(static_cast<size_t>(rows) * rank, 0.0f);
+    out.singular.assign(rank, 0.0f);
+    out.vt.assign(static_cast<size_t>(rank) * cols, 0.0f);
+
+    std::vector<double> acc(std::max(rows, cols));
+    for (int k = 0; k < rank; k++) {
+        const int e = order[k];
+        double sigma = std::sqrt(std::max(gram[static_cast<size_t>(e) * sketch + e], 0.0));
+        out.singular[k] = static_cast<float>(sigma);
+
+        std::fill(acc.begin(), acc.begin() + rows, 0.0);
+        for (int a = 0; a < sketch; a++) {
+            double coeff = eigenvectors[static_cast<size_t>(a) * sketch + e];
+            const double* qa = &q[static_cast<size_t>(a) * rows];
+            for (int r = 0; r < rows; r++) acc[r] += coeff * qa[r];
+        }
+        for (int r = 0; r < rows; r++) out.u[static_cast<size_t>(r) * rank + k] = static_cast<float>(acc[r]);
+
+        if (sigma <= 1e-12) continue;
+        std::fill(acc.begin(), acc.begin() + cols, 0.0);
+        for (int a = 0; a < sketch; a++) {
+            double coeff = eigenvectors[static_cast<size_t>(a) * sketch + e] / sigma;
+            const double* ba = &b[static_cast<size_t>(a) * cols];
+            for (int c = 0; c < cols; c++) acc[c] += coeff * ba[c];
+        }
+        for (int c = 0; c < cols; c++) out.vt[static_cast<size_t>(k) * cols + c] = static_cast<float>(acc[c]);
+    }
+    return true;
+}
+
+void LowRankCompressor::buildLayers(const LowRankFactors& factors, int rank, const std::vector<float>& bias,
+                                    DenseLayer& first, DenseLayer& second) {
+    rank = std::max(1, std::min(rank, factors.rank));
+
+    std::vector<float> v(static_cast<size_t>(rank) * factors.cols);
+    for (int k = 0; k < rank; k++) {
+        float s = std::sqrt(factors.singular[k]);
+        for (int c = 0; c < factors.cols; c++) {
+            v[static_cast<size_t>(k) * factors.cols + c] = s * factors.vt[static_cast<size_t>(k) * factors.cols + c];
+        }
+    }
+
+    std::vector<float> u(static_cast<size_t>(factors.rows) * rank);
+    for (int r = 0; r < factors.rows; r++) {
+        for (int k = 0; k < rank; k++) {
+            u[static_cast<size_t>(r) * rank + k] =
+                std::sqrt(factors.singular[k]) * factors.u[static_cast<size_t>(r) * factors.rank + k];
+        }
+    }
+
+    std::vector<float> zero(rank, 0.0f);
+    first = DenseLayer();
+    first.pack(v.data(), zero.data(), rank, factors.cols);
+    first.linear = true;
+
+    second = DenseLayer();
+    second.pack(u.data(), bias.data(), factors.rows, rank);
+}
+
+bool LowRankCompressor::compress(MlpModel& model, int layerIndex, const float* inputs, const int32_t* labels,
+                                 int frames, float targetAccuracy, LowRankReport& report, std::string& error) {
+    if (layerIndex < 0 || layerIndex >= static_cast<int>(model.layers.size())) {
+        error = "layer index out of range";
+        return false;
+    }
+    if (inputs == nullptr || frames <= 0) {
+        error = "calibration frames are required";
+        return false;
+    }
+    const DenseLayer& original = model.layers[layerIndex];
+    if (original.linear) {
+        error = "layer is already a low-rank factor";
+        return false;
+    }
+
+    // 원래 레이어보다 작아지는 최대 랭크
+    const int rows = original.outDim;
+    const int cols = original.inDim;
+    const size_t elementBytes = original.precision == WeightPrecision::F32 ? sizeof(float) : sizeof(uint16_t);
+    const size_t originalElements =
+        static_cast<size_t>(rows) * padToSimd(cols) + static_cast<size_t>(rows) * sizeof(float) / elementBytes;
+    int maxRank = 0;
+    for (int r = 1; r <= std::min(std::min(rows, cols), MAX_LOW_RANK); r++) {
+        if (factoredElements(rows, cols, r, elementBytes) < originalElements) maxRank = r;
+    }
+    if (maxRank == 0) {
+        error = "layer is too small to factorize";
+        return false;
+    }
+
+    std::vector<float> dense;
+    original.unpack(dense);
+    LowRankFactors factors;
+    if (!factorize(dense.data(), rows, cols, maxRank, factors)) {
+        error = "factorization failed";
+        return false;
+    }
+
+    report = LowRankReport();
+    report.layer = layerIndex;
+    report.maxRank = maxRank;
+    report.baselineBytes = model.byteSize();
+    report.baselineMicroseconds = measure([&]() {
+        thread_local std::vector<float> scratch;
+        scratch.resize(model.outputDim());
+        model.forward(inputs, scratch.data());
+    }) * 1e6;
+
+    // 레이블이 없으면 원래 모델의 예측을 정답으로 사용
+    std::vector<float> logits;
+    std::vector<int32_t> reference;
+    if (labels == nullptr) {
+        const int numClasses = model.outputDim();
+        logits.resize(static_cast<size_t>(frames) * numClasses);
+        model.forwardBatch(inputs, logits.data(), frames);
+        reference.resize(frames);
+        for (int f = 0; f < frames; f++) {
+            const float* row = logits.data() + static_cast<size_t>(f) * numClasses;
+            reference[f] = static_cast<int32_t>(std::max_element(row, row + numClasses) - row);
+        }
+        labels = reference.data();
+        report.baselineAccuracy = 1.0f;
+    } else {
+        report.baselineAccuracy = evaluate(model, inputs, labels, frames, logits);
+    }
+    report.target = std::min(targetAccuracy, report.baselineAccuracy);
+
+    std::vector<int> ranks;
+    for (int r : RANK_CANDIDATES) {
+        if (r < maxRank) ranks.push_back(r);
+    }
+    ranks.push_back(maxRank);
+
+    // 후보 랭크를 모두 시험해 정확도/크기/속도 곡선을 기록하고, 목표를 만족하는 가장 작은 랭크 선택
+    MlpModel best;
+    for (int r : ranks) {
+        MlpModel trial(model);
+        DenseLayer first;
+        DenseLayer second;
+        buildLayers(factors, r, original.bias, first, second);
+        first.setPrecision(original.precision);
+        second.setPrecision(original.precision);
+        trial.layers[layerIndex] = std::move(second);
+        trial.layers.insert(trial.layers.begin() + layerIndex, std::move(first));
+
+        RankTrial result;
+        result.rank = r;
+        result.accuracy = evaluate(trial, inputs, labels, frames, logits);
+        result.bytes = trial.byteSize();
+        result.microseconds = measure([&]() {
+            thread_local std::vector<float> scratch;
+            scratch.resize(trial.outputDim());
+            trial.forward(inputs, scratch.data());
+        }) * 1e6;
+        report.trials.push_back(result);
+
+        if (report.rank == 0 && result.accuracy >= report.target) {
+            report.rank = r;
+            best = std::move(trial);
+        }
+    }
+
+    if (report.rank > 0) model = std::move(best);
+    return true;
+}
+
+std::string LowRankCompressor::reportJson(const LowRankReport& report) {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "{\"layer\":%d,\"rank\":%d,\"maxRank\":%d,\"target\":%g,\"baselineAccuracy\":%g,"
+                  "\"baselineBytes\":%zu,\"baselineUs\":%.2f,\"trials\":[",
+                  report.layer, report.rank, report.maxRank, static_cast<double>(report.target),
+                  static_cast<double>(report.baselineAccuracy), report.baselineBytes, report.baselineMicroseconds);
+    std::string json = buffer;
+
+    for (size_t i = 0; i < report.trials.size(); i++) {
+        const RankTrial& trial = report.trials[i];
+        std::snprintf(buffer, sizeof(buffer), "%s{\"rank\":%d,\"accuracy\":%g,\"bytes\":%zu,\"us\":%.2f}",
+                      i > 0 ? "," : "", trial.rank, static_cast<double>(trial.accuracy), trial.bytes,
+                      trial.microseconds);
+        json += buffer;
+    }
+    json += "]}";
+    return json;
+}
@@ -0,0 +1,67 @@
+#ifndef LOW_RANK_H
+#define LOW_RANK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mlp_model.h"
+
+// 한 번에 분해하는 최대 랭크 (로드 시간 SVD 비용 제한)
+constexpr int MAX_LOW_RANK = 256;
+
+// 절단 SVD: W ≈ U · diag(singular) · Vt
+struct LowRankFactors {
+    int rows = 0;
+    int cols = 0;
+    int rank = 0;
+    std::vector<float> u;         // rows × rank (열 k = k번째 왼쪽 특이 벡터)
+    std::vector<float> singular;  // 내림차순
+    std::vector<float> vt;        // rank × cols
+};
+
+// 랭크 후보 하나의 보정 결과
+struct RankTrial {
+    int rank = 0;
+    float accuracy = 0.0f;       // 레이블 정확도 (레이블이 없으면 원래 모델과의 argmax 일치율)
+    size_t bytes = 0;            // 모델 전체 바이트 수
+    double microseconds = 0.0;   // 한 프레임 추론 시간
+};
+
+struct LowRankReport {
+    int layer = -1;
+    int rank = 0;                // 적용한 랭크 (0이면 목표를 만족하는 후보가 없어 원래 레이어 유지)
+    int maxRank = 0;             // 원래 레이어보다 작아지는 최대 랭크
+    float target = 0.0f;
+    float baselineAccuracy = 1.0f;
+    size_t baselineBytes = 0;
+    double baselineMicroseconds = 0.0;
+    std::vector<RankTrial> trials;
+};
+
+// 로드 시점 저랭크 압축
+// 밀집 레이어 W(out × in)를 랜덤 부분공간 반복 SVD로 분해해 두 개의 얇은 레이어
+// V(r × in, 선형) → U(out × r, 원래 바이어스/ReLU)로 바꿉니다.
+// 가중치 수가 out·in에서 r·(out + in)으로 줄어 한 프레임 GEMV의 메모리 대역폭이 감소합니다.
+// 랭크는 보정 데이터에서 후보 랭크를 차례로 시험해 목표 정확도를 만족하는 가장 작은 값을 고르며,
+// 랭크별 정확도/크기/속도를 함께 보고합니다.
+class LowRankCompressor {
+public:
+    // 행 우선 rows × cols 행렬의 상위 maxRank개 특이 성분 (maxRank ≥ min(rows, cols)이면 정확한 분해)
+    static bool factorize(const float* rowMajor, int rows, int cols, int maxRank, LowRankFactors& out);
+
+    // 상위 rank개 성분으로 두 레이어 구성 (√σ를 양쪽에 나눠 곱해 두 인자의 크기를 맞춤)
+    static void buildLayers(const LowRankFactors& factors, int rank, const std::vector<float>& bias,
+                            DenseLayer& first, DenseLayer& second);
+
+    // model.layers[layerIndex]를 분해해 목표를 만족하는 가장 작은 랭크로 교체
+    // inputs: frames × inputDim (스케일 적용된 보정 입력)
+    // labels: frames개 정답 클래스 (nullptr이면 원래 모델의 argmax를 정답으로 사용)
+    // 레이블 정확도가 원래 모델보다 낮으면 목표는 원래 모델의 정확도로 낮춰집니다.
+    static bool compress(MlpModel& model, int layerIndex, const float* inputs, const int32_t* labels, int frames,
+                         float targetAccuracy, LowRankReport& report, std::string& error);
+
+    // {"layer":0,"rank":16,...,"trials":[{"rank":8,"accuracy":0.97,"bytes":..,"us":..},...]}
+    static std::string reportJson(const LowRankReport& report);
+};
+
+#endif // LOW_RANK_H
@@ -1,5 +1,17 @@
 #include "sign_recognition.h"
+#include "sign_log.h"
+#include "metrics.h"
+#include "hand_synth.h"
+#include "ctc_decoder.h"
+#include "dtw_matcher.h"
+#include "gesture_segmenter.h"
+#include "output_head.h"
+#include "transformer_encoder.h"
+#include "gru_engine.h"
+#include <cstdio>
 #include <emscripten/bind.h>
+#include <emscripten/threading.h>
+#include <emscripten/val.h>
 
 // C 스타일 함수들 (기존 코드와의 호환성을 위해)
 extern "C" {
@@ -9,6 +21,53 @@ extern "C" {
     }
 }
 
+// JS 로그 콜백 (callback(level, message))
+// JS 함수는 메인 스레드에서만 호출할 수 있으므로 워커 스레드의 로그는 stderr로 보냄
+static emscripten::val* jsLogCallback = nullptr;
+
+static void jsLogSink(LogLevel level, const char* message, void*) {
+    if (jsLogCallback != nullptr && emscripten_is_main_runtime_thread()) {
+        (*jsLogCallback)(static_cast<int>(level), std::string(message));
+    } else {
+        std::fprintf(stderr, "%s\n", message);
+    }
+}
+
+void setLogCallback(emscripten::val callback) {
+    setLogSink(nullptr, nullptr);
+    delete jsLogCallback;
+    jsLogCallback = nullptr;
+
+    if (!callback.isNull() && !callback.isUndefined()) {
+        jsLogCallback = new emscripten::val(callback);
+        setLogSink(jsLogSink, nullptr);
+    }
+}
+
+void setLogLevelFromJs(int level) {
+    setLogLevel(static_cast<LogLevel>(std::max(0, std::min(level, static_cast<int>(LogLevel::Error)))));
+}
+
+// 지표 스냅샷을 Float64Array(HEAPF64)로 복사, 복사한 개수 반환
+// JS: const ptr = Module._malloc(8 * n); Module.readMetrics(ptr, n); HEAPF64.subarray(ptr >> 3, (ptr >> 3) + n)
+int readMetrics(uintptr_t outPtr, int capacity) {
+    int64_t snapshot[METRIC_COUNT];
+    int count = Metrics::snapshot(snapshot, std::min(capacity, METRIC_COUNT));
+    double* out = reinterpret_cast<double*>(outPtr);
+    for (int i = 0; i < count; i++) out[i] = static_cast<double>(snapshot[i]);
+    return count;
+}
+
+// 스냅샷 순서의 지표 이름 (쉼표 구분)
+std::string getMetricNames() {
+    std::string names;
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (i > 0) names += ',';
+        names += Metrics::name(static_cast<Metric>(i));
+    }
+    return names;
+}
+
 // WASM 바인딩을 위한 래퍼 함수
 class SignRecognizerWrapper {
 public:
@@ -32,6 +91,27 @@ public:
     void setDetectionThreshold(float threshold) {
         recognizer.setDetectionThreshold(threshold);
     }
+
+    void setIntraOpThreads(int threads) {
+        recognizer.setIntraOpThreads(threads);
+    }
+
+    int getIntraOpThreads() const {
+        return recognizer.getIntraOpThreads();
+    }
+
+    // precision: 0 = fp32, 1 = fp16, 2 = bf16
+    void setAdvancedModelPrecision(int precision) {
+        recognizer.setAdvancedModelPrecision(precision);
+    }
+
+    void pruneAdvancedModel(float sparsity) {
+        recognizer.pruneAdvancedModel(sparsity);
+    }
+
+    double getAdvancedModelBytes() {
+        return static_cast<double>(recognizer.getAdvancedModelBytes());
+    }
     
     void setRecognitionThreshold(float threshold) {
         recognizer.setRecognitionThreshold(threshold);
@@ -40,6 +120,307 @@ public:
     std::string getVersion() {
         return recognizer.getVersion();
     }
+
+    // HOG 특징: imagePtr은 width × height RGBA, outPtr에는 getHogSize 개수의 float
+    int computeHog(uintptr_t imagePtr, int width, int height, int x, int y, int cropWidth, int cropHeight,
+                   uintptr_t outPtr) {
+        return recognizer.computeHog(reinterpret_cast<const uint8_t*>(imagePtr), width, height, x, y, cropWidth,
+                                     cropHeight, reinterpret_cast<float*>(outPtr));
+    }
+
+    int getHogSize(int cropWidth, int cropHeight) const {
+        return recognizer.getHogSize(cropWidth, cropHeight);
+    }
+
+    // 정렬 영역: imagePtr은 width × height RGBA, outPtr에는 size × size RGBA
+    bool alignHandCrop(uintptr_t imagePtr, int width, int height, uintptr_t landmarksPtr, int count, int size,
+                       uintptr_t outPtr) {
+        return recognizer.alignHandCrop(reinterpret_cast<const uint8_t*>(imagePtr), width, height,
+                                        reinterpret_cast<const float*>(landmarksPtr), count, size,
+                                        reinterpret_cast<uint8_t*>(outPtr));
+    }
+
+    bool alignFaceCrop(uintptr_t imagePtr, int width, int height, float leftEyeX, float leftEyeY, float rightEyeX,
+                       float rightEyeY, int size, uintptr_t outPtr) {
+        return recognizer.alignFaceCrop(reinterpret_cast<const uint8_t*>(imagePtr), width, height, leftEyeX,
+                                        leftEyeY, rightEyeX, rightEyeY, size, reinterpret_cast<uint8_t*>(outPtr));
+    }
+
+    // imagePtr: width × height RGBA (제자리), filterType은 SignRecognizer::processImageData 참고
+    void processImageData(uintptr_t imagePtr, int width, int height, int filterType) {
+        recognizer.processImageData(reinterpret_cast<uint8_t*>(imagePtr), width, height, filterType);
+    }
+
+    void setLowLightLuma(float meanLuma) {
+        recognizer.setLowLightLuma(meanLuma);
+    }
+
+    // positionsPtr/velocitiesPtr: particleCount × 3 float (HEAPF32)
+    void simulateParticles(uintptr_t positionsPtr, uintptr_t velocitiesPtr, int particleCount, float deltaTime) {
+        recognizer.simulateParticles(reinterpret_cast<float*>(positionsPtr), reinterpret_cast<float*>(velocitiesPtr),
+                                     particleCount, deltaTime);
+    }
+
+    bool setParticleHand(uintptr_t landmarksPtr, int count, float radius) {
+        return recognizer.setParticleHand(reinterpret_cast<const float*>(landmarksPtr), count, radius);
+    }
+
+    void clearParticleHand() {
+        recognizer.clearParticleHand();
+    }
+};
+
+// 합성 손 동작 생성기 래퍼 (브라우저 부하 테스트용)
+// 출력 버퍼는 JS에서 _malloc으로 할당한 HEAPF32 영역
+class HandSynthesizerWrapper {
+public:
+    HandSynthConfig config;
+    HandSynthesizer synth;
+
+    HandSynthesizerWrapper(int hands, int seed) : synth(makeConfig(hands, seed)) {}
+
+    // 생성 설정 변경 (재생 위치는 처음으로 돌아감)
+    void configure(float jitter, float dropoutRate, float fps) {
+        config.jitter = jitter;
+        config.dropoutRate = dropoutRate;
+        config.fps = fps;
+        synth = HandSynthesizer(config);
+    }
+
+    // frames × 126 특징 (predictBatch 입력)
+    void generateFeatures(uintptr_t outPtr, int frames) {
+        synth.generateFeatures(reinterpret_cast<float*>(outPtr), frames);
+    }
+
+    // frames × 42 좌표 (recognizeBatch 입력)
+    void generateRecognizerFrames(uintptr_t outPtr, int frames) {
+        synth.generateRecognizerFrames(reinterpret_cast<float*>(outPtr), frames);
+    }
+
+    void reset() {
+        synth.reset();
+    }
+
+private:
+    HandSynthConfig makeConfig(int hands, int seed) {
+        config.hands = hands;
+        config.seed = static_cast<uint32_t>(seed);
+        return config;
+    }
+};
+
+// 연속 수어 CTC 빔 탐색 디코더 래퍼
+// 입력 버퍼는 predictBatchLogits 출력(HEAPF32)을 그대로 사용
+class CtcDecoderWrapper {
+public:
+    CtcBeamDecoder decoder;
+
+    CtcDecoderWrapper(int numClasses, int beamWidth, int blank)
+        : decoder(numClasses, makeConfig(beamWidth, blank)) {}
+
+    void pushLogits(uintptr_t logitsPtr, int frames) {
+        decoder.pushLogits(reinterpret_cast<const float*>(logitsPtr), frames);
+    }
+
+    // (numClasses + 1) × numClasses 확률, 설정하면 처음부터 다시 디코딩
+    bool setBigram(uintptr_t probabilitiesPtr, int count) {
+        return decoder.setBigram(reinterpret_cast<const float*>(probabilitiesPtr), count);
+    }
+
+    void setLexicon(const std::vector<int>& allowed) {
+        decoder.setLexicon(allowed);
+    }
+
+    // {"labels":[...],"committed":N}
+    std::string getBestPath() const {
+        return decoder.bestPathJson();
+    }
+
+    void reset() {
+        decoder.reset();
+    }
+
+private:
+    static CtcDecoderConfig makeConfig(int beamWidth, int blank) {
+        CtcDecoderConfig config;
+        config.beamWidth = beamWidth;
+        config.blank = blank;
+        return config;
+    }
+};
+
+// 동적 수어 DTW 템플릿 정합기 래퍼
+// 시퀀스는 HEAPF32의 frames × dims float
+class DtwMatcherWrapper {
+public:
+    DtwMatcher matcher;
+
+    DtwMatcherWrapper(int dims, int length, int band) : matcher(dims, length, band) {}
+
+    bool addTemplate(uintptr_t framesPtr, int frameCount, int label) {
+        return matcher.addTemplate(reinterpret_cast<const float*>(framesPtr), frameCount, label);
+    }
+
+    // {"label":2,"templateIndex":14,"distance":0.12,"templates":500,"dtw":9}
+    std::string match(uintptr_t framesPtr, int frameCount, float maxDistance) {
+        return matcher.matchJson(reinterpret_cast<const float*>(framesPtr), frameCount, maxDistance);
+    }
+
+    int templateCount() const {
+        return matcher.templateCount();
+    }
+
+    void clear() {
+        matcher.clear();
+    }
+};
+
+// 수어 시작/끝 분할기 래퍼
+// push 반환값: 0 없음, 1 시작, 2 끝, 3 너무 짧아 취소
+class GestureSegmenterWrapper {
+public:
+    GestureSegmenter segmenter;
+
+    int push(uintptr_t landmarksPtr, int count, double timestampMs) {
+        return static_cast<int>(segmenter.push(reinterpret_cast<const float*>(landmarksPtr), count, timestampMs));
+    }
+
+    bool isActive() const {
+        return segmenter.active();
+    }
+
+    // {"active":..,"startMs":..,"endMs":..,"startFrame":..,"endFrame":..,"peakSpeed":..}
+    std::string getSegment() const {
+        return segmenter.segmentJson();
+    }
+
+    void reset() {
+        segmenter.reset();
+    }
+};
+
+// 큰 어휘 출력층 래퍼
+// 은닉 벡터는 HEAPF32의 hiddenSize()개 float
+class OutputHeadWrapper {
+public:
+    OutputHead head;
+
+    // NPZ(w1/b1) 버퍼 로드
+    bool loadFromBuffer(uintptr_t dataPtr, int size) {
+        return head.loadFromNpzBuffer(reinterpret_cast<const uint8_t*>(dataPtr), static_cast<size_t>(size), lastError);
+    }
+
+    bool setWeights(uintptr_t weightsPtr, uintptr_t biasPtr, int classes, int hidden) {
+        return head.setWeights(reinterpret_cast<const float*>(weightsPtr), reinterpret_cast<const float*>(biasPtr),
+                               classes, hidden);
+    }
+
+    void buildClusters(int clusters, int probes) {
+        head.buildClusters(clusters, probes);
+    }
+
+    // {"candidates":[{"label":..,"probability":..},...],"evaluated":N}
+    std::string topK(uintptr_t hiddenPtr, int k) {
+        return head.topKJson(reinterpret_cast<const float*>(hiddenPtr), k);
+    }
+
+    int getClasses() const {
+        return head.classes();
+    }
+
+    std::string getLastError() const {
+        return lastError;
+    }
+
+private:
+    std::string lastError;
+};
+
+// 스트리밍 트랜스포머 인코더 (스트림 하나의 키/값 캐시를 함께 보관)
+class TransformerEncoderWrapper {
+public:
+    TransformerEncoder encoder;
+    TransformerState state;
+
+    // NPZ 버퍼 로드 (heads, window는 학습 설정과 같아야 함), 성공하면 캐시 초기화
+    bool loadFromBuffer(uintptr_t dataPtr, int size, int heads, int window) {
+        if (!encoder.loadFromNpzBuffer(reinterpret_cast<const uint8_t*>(dataPtr), static_cast<size_t>(size), heads,
+                                       window, lastError)) {
+            return false;
+        }
+        state = encoder.createState();
+        return true;
+    }
+
+    // 126차원 특징 한 프레임 추가, logitsPtr(클래스 수만큼, 0 가능)에 기록하고 최대 클래스 반환
+    int step(uintptr_t featuresPtr, uintptr_t logitsPtr) {
+        return encoder.step(state, reinterpret_cast<const float*>(featuresPtr), reinterpret_cast<float*>(logitsPtr));
+    }
+
+    void reset() {
+        state.reset();
+    }
+
+    int getClasses() const {
+        return encoder.config().classes;
+    }
+
+    int getWindow() const {
+        return encoder.config().window;
+    }
+
+    std::string getLastError() const {
+        return lastError;
+    }
+
+private:
+    std::string lastError;
+};
+
+// GRU 엔진 (스트림 하나의 은닉 상태를 함께 보관)
+class GruEngineWrapper {
+public:
+    GruEngine engine;
+    GruState state;
+
+    // NPZ 버퍼 로드 (weight_ih_l0 ... + 출력층 w1/b1 ...), 성공하면 은닉 상태 초기화
+    bool loadFromBuffer(uintptr_t dataPtr, int size) {
+        if (!engine.loadFromNpzBuffer(reinterpret_cast<const uint8_t*>(dataPtr), static_cast<size_t>(size), lastError)) {
+            return false;
+        }
+        state = engine.createState();
+        return true;
+    }
+
+    // 126차원 특징 한 프레임, logitsPtr(클래스 수만큼, 0 가능)에 기록하고 최대 클래스 반환
+    int step(uintptr_t featuresPtr, uintptr_t logitsPtr) {
+        return engine.step(state, reinterpret_cast<const float*>(featuresPtr), reinterpret_cast<float*>(logitsPtr));
+    }
+
+    // frames개 프레임을 차례로 넣고 마지막 프레임 결과 반환
+    int runSequence(uintptr_t featuresPtr, int frames, uintptr_t logitsPtr) {
+        return engine.runSequence(state, reinterpret_cast<const float*>(featuresPtr), frames,
+                                  reinterpret_cast<float*>(logitsPtr));
+    }
+
+    void reset() {
+        state.reset();
+    }
+
+    int getClasses() const {
+        return engine.classes();
+    }
+
+    int getHiddenSize() const {
+        return engine.hiddenSize();
+    }
+
+    std::string getLastError() const {
+        return lastError;
+    }
+
+private:
+    std::string lastError;
 };
 
 // Embind 바인딩
@@ -48,6 +429,14 @@ EMSCRIPTEN_BINDINGS(sign_wasm_module) {
     
     // C 스타일 함수 바인딩
     function("test_function", &test_function, allow_raw_pointers());
+
+    // 로그 싱크 (릴리스 빌드에서는 로그 호출이 컴파일되지 않음)
+    function("setLogCallback", &setLogCallback);
+    function("setLogLevel", &setLogLevelFromJs);
+
+    // 엔진 지표 (추론 스레드를 막지 않는 일관된 스냅샷)
+    function("readMetrics", &readMetrics);
+    function("getMetricNames", &getMetricNames);
     
     // HandLandmark 구조체 바인딩
     class_<HandLandmark>("HandLandmark")
@@ -69,10 +458,88 @@ EMSCRIPTEN_BINDINGS(sign_wasm_module) {
         .function("initialize", &SignRecognizerWrapper::initialize)
         .function("recognize", &SignRecognizerWrapper::recognize)
         .function("recognizeFromPointer", &SignRecognizerWrapper::recognizeFromPointer)
+        .function("setIntraOpThreads", &SignRecognizerWrapper::setIntraOpThreads)
+        .function("getIntraOpThreads", &SignRecognizerWrapper::getIntraOpThreads)
+        .function("setAdvancedModelPrecision", &SignRecognizerWrapper::setAdvancedModelPrecision)
+        .function("pruneAdvancedModel", &SignRecognizerWrapper::pruneAdvancedModel)
+        .function("getAdvancedModelBytes", &SignRecognizerWrapper::getAdvancedModelBytes)
         .function("setDetectionThreshold", &SignRecognizerWrapper::setDetectionThreshold)
         .function("setRecognitionThreshold", &SignRecognizerWrapper::setRecognitionThreshold)
-        .function("getVersion", &SignRecognizerWrapper::getVersion);
+        .function("getVersion", &SignRecognizerWrapper::getVersion)
+        .function("computeHog", &SignRecognizerWrapper::computeHog)
+        .function("getHogSize", &SignRecognizerWrapper::getHogSize)
+        .function("alignHandCrop", &SignRecognizerWrapper::alignHandCrop)
+        .function("alignFaceCrop", &SignRecognizerWrapper::alignFaceCrop)
+        .function("processImageData", &SignRecognizerWrapper::processImageData)
+        .function("setLowLightLuma", &SignRecognizerWrapper::setLowLightLuma)
+        .function("simulateParticles", &SignRecognizerWrapper::simulateParticles)
+        .function("setParticleHand", &SignRecognizerWrapper::setParticleHand)
+        .function("clearParticleHand", &SignRecognizerWrapper::clearParticleHand);
+    
+    // 합성 손 동작 생성기 (부하 테스트)
+    class_<HandSynthesizerWrapper>("HandSynthesizer")
+        .constructor<int, int>()
+        .function("configure", &HandSynthesizerWrapper::configure)
+        .function("generateFeatures", &HandSynthesizerWrapper::generateFeatures)
+        .function("generateRecognizerFrames", &HandSynthesizerWrapper::generateRecognizerFrames)
+        .function("reset", &HandSynthesizerWrapper::reset);
     
+    // 연속 수어 디코더
+    class_<CtcDecoderWrapper>("CtcDecoder")
+        .constructor<int, int, int>()
+        .function("pushLogits", &CtcDecoderWrapper::pushLogits)
+        .function("setBigram", &CtcDecoderWrapper::setBigram)
+        .function("setLexicon", &CtcDecoderWrapper::setLexicon)
+        .function("getBestPath", &CtcDecoderWrapper::getBestPath)
+        .function("reset", &CtcDecoderWrapper::reset);
+
+    register_vector<int>("VectorInt");
+
+    // 동적 수어 템플릿 정합
+    class_<DtwMatcherWrapper>("DtwMatcher")
+        .constructor<int, int, int>()
+        .function("addTemplate", &DtwMatcherWrapper::addTemplate)
+        .function("match", &DtwMatcherWrapper::match)
+        .function("templateCount", &DtwMatcherWrapper::templateCount)
+        .function("clear", &DtwMatcherWrapper::clear);
+
+    // 수어 구간 분할
+    class_<GestureSegmenterWrapper>("GestureSegmenter")
+        .constructor<>()
+        .function("push", &GestureSegmenterWrapper::push)
+        .function("isActive", &GestureSegmenterWrapper::isActive)
+        .function("getSegment", &GestureSegmenterWrapper::getSegment)
+        .function("reset", &GestureSegmenterWrapper::reset);
+
+    // 큰 어휘 출력층 (상위 k 후보)
+    class_<OutputHeadWrapper>("OutputHead")
+        .constructor<>()
+        .function("loadFromBuffer", &OutputHeadWrapper::loadFromBuffer)
+        .function("setWeights", &OutputHeadWrapper::setWeights)
+        .function("buildClusters", &OutputHeadWrapper::buildClusters)
+        .function("topK", &OutputHeadWrapper::topK)
+        .function("getClasses", &OutputHeadWrapper::getClasses)
+        .function("getLastError", &OutputHeadWrapper::getLastError);
+
+    class_<TransformerEncoderWrapper>("TransformerEncoder")
+        .constructor<>()
+        .function("loadFromBuffer", &TransformerEncoderWrapper::loadFromBuffer)
+        .function("step", &TransformerEncoderWrapper::step)
+        .function("reset", &TransformerEncoderWrapper::reset)
+        .function("getClasses", &TransformerEncoderWrapper::getClasses)
+        .function("getWindow", &TransformerEncoderWrapper::getWindow)
+        .function("getLastError", &TransformerEncoderWrapper::getLastError);
+
+    class_<GruEngineWrapper>("GruEngine")
+        .constructor<>()
+        .function("loadFromBuffer", &GruEngineWrapper::loadFromBuffer)
+        .function("step", &GruEngineWrapper::step)
+        .function("runSequence", &GruEngineWrapper::runSequence)
+        .function("reset", &GruEngineWrapper::reset)
+        .function("getClasses", &GruEngineWrapper::getClasses)
+        .function("getHiddenSize", &GruEngineWrapper::getHiddenSize)
+        .function("getLastError", &GruEngineWrapper::getLastError);
+
     // std::vector<HandLandmark> 바인딩
     register_vector<HandLandmark>("VectorHandLandmark");
 
@@ -85,6 +552,29 @@ EMSCRIPTEN_BINDINGS(sign_wasm_module) {
         // MLP 함수 바인딩
         .function("setScaler", &SignRecognition::setScaler)
         .function("predictMLP", &SignRecognition::predictMLP)
+
+        // NPZ 모델 로드
+        .function("loadModel", &SignRecognition::loadModel)
+        .function("loadModelFromBuffer", &SignRecognition::loadModelFromBuffer)
+        .function("loadModelAsync", &SignRecognition::loadModelAsync)
+        .function("isModelSwapPending", &SignRecognition::isModelSwapPending)
+        .function("getModelGeneration", &SignRecognition::getModelGeneration)
+        .function("getLastError", &SignRecognition::getLastError)
+
+        // 배치 추론 / 가지치기
+        .function("predictBatch", &SignRecognition::predictBatch)
+        .function("predictBatchLogits", &SignRecognition::predictBatchLogits)
+        .function("pruneModel", &SignRecognition::pruneModel)
+
+        // 기기별 자동 튜닝
+        .function("autotune", &SignRecognition::autotune)
+        .function("loadTuneProfile", &SignRecognition::loadTuneProfile)
+
+        // fp16/bf16 가중치 저장
+        .function("setWeightPrecision", &SignRecognition::setWeightPrecision)
+        .function("compressLowRank", &SignRecognition::compressLowRank)
+        .function("setThreads", &SignRecognition::setThreads)
+        .function("getThreads", &SignRecognition::getThreads)
         ;
 }
 
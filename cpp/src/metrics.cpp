@@ -0,0 +1,179 @@
+#include "metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include "threading.h"
+
+namespace {
+
+const char* const METRIC_NAMES[] = {
+    "framesProcessed",
+    "droppedFrames",
+    "modelBytes",
+    "modelGeneration",
+    "modelSwaps",
+    "modelLoadFailures",
+    "swapQueueDepth",
+    "scratchHighWaterBytes",
+    "deepModelCacheHits",
+    "deepModelCacheMisses",
+};
+static_assert(sizeof(METRIC_NAMES) / sizeof(METRIC_NAMES[0]) == METRIC_COUNT, "metric name table out of sync");
+
+enum class MetricKind { Counter, Gauge, HighWater };
+
+const MetricKind METRIC_KINDS[] = {
+    MetricKind::Counter,     // framesProcessed
+    MetricKind::Counter,     // droppedFrames
+    MetricKind::Gauge,       // modelBytes
+    MetricKind::Gauge,       // modelGeneration
+    MetricKind::Counter,     // modelSwaps
+    MetricKind::Counter,     // modelLoadFailures
+    MetricKind::Gauge,       // swapQueueDepth
+    MetricKind::HighWater,   // scratchHighWaterBytes
+    MetricKind::Counter,     // deepModelCacheHits
+    MetricKind::Counter,     // deepModelCacheMisses
+};
+static_assert(sizeof(METRIC_KINDS) / sizeof(METRIC_KINDS[0]) == METRIC_COUNT, "metric kind table out of sync");
+
+// 쓰기 샤드 수 (스레드는 처음 쓸 때 차례로 배정되며, 더 많으면 샤드를 나눠 씀)
+constexpr int SHARD_COUNT = 16;
+
+// 스레드별 쓰기 샤드: 시작/완료 쓰기 수와 카운터/최고치 값 (게이지 칸은 쓰지 않음)
+// 시작 수를 먼저, 완료 수를 나중에 올리므로 started == finished이면 진행 중인 쓰기가 없습니다.
+struct alignas(CACHE_LINE_SIZE) Shard {
+    std::atomic<uint32_t> started{0};
+    std::atomic<uint32_t> finished{0};
+    std::atomic<int64_t> values[METRIC_COUNT];
+};
+
+// 게이지 하나 (지표마다 다른 캐시 라인)
+struct alignas(CACHE_LINE_SIZE) GaugeSlot {
+    std::atomic<int64_t> value{0};
+};
+
+Shard shards[SHARD_COUNT];
+GaugeSlot gauges[METRIC_COUNT];
+std::atomic<int> nextShard{0};
+
+inline Shard& localShard() {
+    thread_local Shard* shard = &shards[nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT];
+    return *shard;
+}
+
+// 쓰기 구간: 시작 수를 올린 뒤 값을 쓰고, 끝나면 완료 수를 올림 (모두 이 샤드의 캐시 라인)
+struct WriteScope {
+    explicit WriteScope(Shard& shard) : shard(shard) {
+        shard.started.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    ~WriteScope() { shard.finished.fetch_add(1, std::memory_order_release); }
+    Shard& shard;
+};
+
+inline int index(Metric metric) {
+    return static_cast<int>(metric);
+}
+
+// 샤드를 합친 값 (카운터 합, 최고치 최댓값, 게이지 값)
+inline int64_t combined(int i) {
+    if (METRIC_KINDS[i] == MetricKind::Gauge) return gauges[i].value.load(std::memory_order_relaxed);
+    int64_t result = 0;
+    for (const Shard& shard : shards) {
+        int64_t v = shard.values[i].load(std::memory_order_relaxed);
+        result = METRIC_KINDS[i] == MetricKind::HighWater ? std::max(result, v) : result + v;
+    }
+    return result;
+}
+
+} // namespace
+
+void Metrics::add(Metric metric, int64_t delta) {
+    Shard& shard = localShard();
+    WriteScope scope(shard);
+    shard.values[index(metric)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+void Metrics::set(Metric metric, int64_t value) {
+    WriteScope scope(localShard());
+    gauges[index(metric)].value.store(value, std::memory_order_relaxed);
+}
+
+void Metrics::setMax(Metric metric, int64_t value) {
+    Shard& shard = localShard();
+    std::atomic<int64_t>& target = shard.values[index(metric)];
+    int64_t current = target.load(std::memory_order_relaxed);
+    if (value <= current) return;
+
+    WriteScope scope(shard);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+int64_t Metrics::get(Metric metric) {
+    return combined(index(metric));
+}
+
+int Metrics::snapshot(int64_t* out, int capacity, bool* consistent, int maxRetries) {
+    int count = std::min(capacity, METRIC_COUNT);
+    if (out == nullptr || count <= 0) {
+        if (consistent != nullptr) *consistent = true;
+        return 0;
+    }
+
+    bool ok = false;
+    for (int attempt = 0; attempt <= maxRetries && !ok; attempt++) {
+        // 1) 진행 중인 쓰기가 없는 샤드의 시작 수 기록 (완료 수를 먼저 읽어 시작 수와 비교)
+        uint32_t before[SHARD_COUNT];
+        bool quiet = true;
+        for (int s = 0; s < SHARD_COUNT && quiet; s++) {
+            uint32_t finished = shards[s].finished.load(std::memory_order_acquire);
+            before[s] = shards[s].started.load(std::memory_order_relaxed);
+            quiet = before[s] == finished;
+        }
+        if (!quiet) continue;
+
+        // 2) 복사 후 3) 시작 수가 그대로인지 확인 (복사한 값을 쓴 쓰기가 있었다면 시작 수가 보임)
+        for (int i = 0; i < count; i++) out[i] = combined(i);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        ok = true;
+        for (int s = 0; s < SHARD_COUNT && ok; s++) {
+            ok = shards[s].started.load(std::memory_order_relaxed) == before[s];
+        }
+    }
+
+    if (!ok) {
+        // 계속 쓰기 중이면 마지막 값이라도 반환 (지표별로는 원자적)
+        for (int i = 0; i < count; i++) out[i] = combined(i);
+    }
+    if (consistent != nullptr) *consistent = ok;
+    return count;
+}
+
+const char* Metrics::name(Metric metric) {
+    int index = static_cast<int>(metric);
+    return index >= 0 && index < METRIC_COUNT ? METRIC_NAMES[index] : "";
+}
+
+std::string Metrics::toText() {
+    int64_t snap[METRIC_COUNT];
+    int count = snapshot(snap, METRIC_COUNT);
+
+    std::string text;
+    char line[96];
+    for (int i = 0; i < count; i++) {
+        std::snprintf(line, sizeof(line), "%s %" PRId64 "\n", METRIC_NAMES[i], snap[i]);
+        text += line;
+    }
+    return text;
+}
+
+void Metrics::reset() {
+    for (Shard& shard : shards) {
+        WriteScope scope(shard);
+        for (auto& value : shard.values) value.store(0, std::memory_order_relaxed);
+    }
+    WriteScope scope(localShard());
+    for (GaugeSlot& gauge : gauges) gauge.value.store(0, std::memory_order_relaxed);
+}
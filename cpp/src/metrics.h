@@ -0,0 +1,55 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 엔진 내부 지표
+// 새 지표는 COUNT 앞에 추가하고 metrics.cpp의 이름 표에도 같은 순서로 추가합니다.
+enum class Metric : int {
+    FramesProcessed = 0,     // 카운터: 추론한 프레임 수 (단일 + 배치)
+    DroppedFrames,           // 카운터: 입력 크기가 맞지 않아 버린 프레임
+    ModelBytes,              // 게이지: 현재 모델 가중치 바이트
+    ModelGeneration,         // 게이지: 모델 세대 (교체마다 1 증가)
+    ModelSwaps,              // 카운터: 게시된 모델 수
+    ModelLoadFailures,       // 카운터: NPZ 로드/검증 실패
+    SwapQueueDepth,          // 게이지: 대기 중인 비동기 모델 교체 (0 또는 1)
+    ScratchHighWaterBytes,   // 최고치: 추론 스크래치 버퍼 최대 크기
+    DeepModelCacheHits,      // 카운터: 심층 모델 가중치 재사용
+    DeepModelCacheMisses,    // 카운터: 심층 모델 가중치 생성
+    COUNT
+};
+
+constexpr int METRIC_COUNT = static_cast<int>(Metric::COUNT);
+
+// 락 없는 전역 지표 레지스트리
+// - 쓰기(추론 경로): 스레드마다 배정된 샤드(캐시 라인 단위)에 relaxed 원자 연산으로 기록하며 기다리지 않습니다.
+//   샤드의 시작/완료 쓰기 수도 그 샤드에 있으므로, 스레드 수가 샤드 수 이하이면 다른 스레드와 캐시 라인을 나누지 않습니다.
+//   게이지는 지표마다 따로 둔 캐시 라인에 저장합니다 (모델 교체 때만 바뀜).
+// - 읽기(UI/내보내기): 모든 샤드의 시작/완료 수를 읽고, 값을 복사한 뒤 시작 수를 다시 읽어
+//   그 사이 어느 샤드에도 쓰기가 없었을 때만 받아들이므로, 여러 지표가 한 시점의 일관된 값으로 보입니다.
+//   카운터는 샤드 합, 최고치는 샤드 최댓값입니다. 읽는 쪽이 재시도할 뿐 추론 스레드를 막지 않습니다.
+class Metrics {
+public:
+    // 지표 종류(enum 주석)에 맞는 함수를 사용: 카운터는 add, 게이지는 set, 최고치는 setMax
+    static void add(Metric metric, int64_t delta = 1);
+    static void set(Metric metric, int64_t value);
+    static void setMax(Metric metric, int64_t value);
+    static int64_t get(Metric metric);
+
+    // 일관된 스냅샷을 out에 복사하고 복사한 개수 반환
+    // 쓰기가 계속되어 maxRetries 안에 일관된 복사에 실패하면 마지막 복사본을 쓰고 consistent=false
+    static int snapshot(int64_t* out, int capacity, bool* consistent = nullptr, int maxRetries = 64);
+
+    // 스냅샷 순서의 지표 이름
+    static const char* name(Metric metric);
+
+    // 스냅샷을 "이름 값" 줄 목록으로 (네이티브 내보내기/로그용)
+    static std::string toText();
+
+    // 모든 값을 0으로 (테스트/벤치마크용)
+    static void reset();
+};
+
+#endif // METRICS_H
@@ -0,0 +1,740 @@
+#include "mlp_model.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <immintrin.h>
+#include "half_float.h"
+#include "metrics.h"
+#include "thread_pool.h"
+
+namespace {
+
+inline float horizontalSum(__m256 v) {
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    __m128 shuf = _mm_movehdup_ps(lo);
+    __m128 sums = _mm_add_ps(lo, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+const NpyArray* findArray(const std::map<std::string, NpyArray>& arrays, char prefix, int index) {
+    char lower[16];
+    char upper[16];
+    std::snprintf(lower, sizeof(lower), "%c%d", prefix, index);
+    std::snprintf(upper, sizeof(upper), "%c%d", prefix - 'a' + 'A', index);
+
+    auto it = arrays.find(lower);
+    if (it == arrays.end()) it = arrays.find(upper);
+    return it == arrays.end() ? nullptr : &it->second;
+}
+
+// 가중치 로더: 원소 위치 i부터 8개를 fp32 레지스터로 읽음
+// 16비트 형식은 로드 직후 확장하므로 메모리 대역폭은 절반만 사용
+struct F32Weights {
+    const float* w;
+    __m256 load(size_t i) const { return _mm256_load_ps(w + i); }
+};
+
+struct F16Weights {
+    const uint16_t* w;
+    __m256 load(size_t i) const { return widenHalf8(w + i); }
+};
+
+struct Bf16Weights {
+    const uint16_t* w;
+    __m256 load(size_t i) const { return widenBf16x8(w + i); }
+};
+
+// 패딩된 한 행(row 시작 위치)과 x의 내적
+template <typename Weights>
+inline float dotPadded(const Weights& w, size_t row, const float* x, int stride) {
+    __m256 acc = _mm256_setzero_ps();
+    for (int k = 0; k < stride; k += SIMD_WIDTH) {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(w.load(row + k), _mm256_load_ps(x + k)));
+    }
+    return horizontalSum(acc);
+}
+
+// 밀집 GEMV: 4행씩 묶어 x 로드를 공유 (레지스터 블로킹), [rowBegin, rowEnd) 행만 계산
+template <typename Weights>
+void denseGemv(const DenseLayer& layer, const Weights& w, const float* x, float* y, bool relu, int rowBegin,
+               int rowEnd) {
+    const int stride = layer.stride;
+    const float* bias = layer.bias.data();
+    int r = rowBegin;
+
+    for (; r + 4 <= rowEnd; r += 4) {
+        size_t w0 = static_cast<size_t>(r) * stride;
+        size_t w1 = w0 + stride;
+        size_t w2 = w1 + stride;
+        size_t w3 = w2 + stride;
+
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        for (int k = 0; k < stride; k += SIMD_WIDTH) {
+            __m256 xv = _mm256_load_ps(x + k);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(w.load(w0 + k), xv));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(w.load(w1 + k), xv));
+            acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(w.load(w2 + k), xv));
+            acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(w.load(w3 + k), xv));
+        }
+
+        y[r] = bias[r] + horizontalSum(acc0);
+        y[r + 1] = bias[r + 1] + horizontalSum(acc1);
+        y[r + 2] = bias[r + 2] + horizontalSum(acc2);
+        y[r + 3] = bias[r + 3] + horizontalSum(acc3);
+    }
+
+    // 나머지 행
+    for (; r < rowEnd; r++) {
+        y[r] = bias[r] + dotPadded(w, static_cast<size_t>(r) * stride, x, stride);
+    }
+
+    if (relu) {
+        for (int i = rowBegin; i < rowEnd; i++) y[i] = std::max(y[i], 0.0f);
+    }
+}
+
+// 행 블록 누적 결과(8개)를 바이어스/ReLU 적용 후 유효 행만 기록
+inline void storeRowBlock(__m256 acc, const float* bias, int row, int outDim, bool relu, float* y) {
+    alignas(32) float tmp[SIMD_WIDTH];
+    _mm256_store_ps(tmp, acc);
+    int count = std::min(SPARSE_BLOCK_ROWS, outDim - row);
+    for (int i = 0; i < count; i++) {
+        float v = tmp[i] + bias[row + i];
+        y[row + i] = relu ? std::max(v, 0.0f) : v;
+    }
+}
+
+// ROWS행 × FRAMES프레임 밀집 GEMM: 가중치 로드를 FRAMES프레임에, x 로드를 ROWS행에 재사용
+// 처리한 프레임 수를 반환하며 나머지 프레임은 호출자가 GEMV로 처리
+template <int ROWS, int FRAMES, typename Weights>
+int denseGemm(const DenseLayer& layer, const Weights& w, const float* x, int xStride, float* y, int yStride,
+              int batch, bool relu) {
+    const float* bias = layer.bias.data();
+    const int stride = layer.stride;
+    const int outDim = layer.outDim;
+
+    int f = 0;
+    for (; f + FRAMES <= batch; f += FRAMES) {
+        const float* xs[FRAMES];
+        float* ys[FRAMES];
+        for (int j = 0; j < FRAMES; j++) {
+            xs[j] = x + static_cast<size_t>(f + j) * xStride;
+            ys[j] = y + static_cast<size_t>(f + j) * yStride;
+        }
+
+        int r = 0;
+        for (; r + ROWS <= outDim; r += ROWS) {
+            __m256 acc[ROWS][FRAMES];
+            for (int i = 0; i < ROWS; i++)
+                for (int j = 0; j < FRAMES; j++) acc[i][j] = _mm256_setzero_ps();
+
+            size_t wr = static_cast<size_t>(r) * stride;
+            for (int k = 0; k < stride; k += SIMD_WIDTH) {
+                __m256 xv[FRAMES];
+                for (int j = 0; j < FRAMES; j++) xv[j] = _mm256_load_ps(xs[j] + k);
+                for (int i = 0; i < ROWS; i++) {
+                    __m256 wv = w.load(wr + static_cast<size_t>(i) * stride + k);
+                    for (int j = 0; j < FRAMES; j++) acc[i][j] = _mm256_add_ps(acc[i][j], _mm256_mul_ps(wv, xv[j]));
+                }
+            }
+
+            for (int i = 0; i < ROWS; i++)
+                for (int j = 0; j < FRAMES; j++) ys[j][r + i] = bias[r + i] + horizontalSum(acc[i][j]);
+        }
+        for (; r < outDim; r++) {
+            size_t wr = static_cast<size_t>(r) * stride;
+            for (int j = 0; j < FRAMES; j++) ys[j][r] = bias[r] + dotPadded(w, wr, xs[j], stride);
+        }
+
+        if (relu) {
+            for (int j = 0; j < FRAMES; j++)
+                for (int i = 0; i < outDim; i++) ys[j][i] = std::max(ys[j][i], 0.0f);
+        }
+    }
+    return f;
+}
+
+// 블록 희소 GEMM: 8×1 블록 값 하나를 로드해 FRAMES프레임에 재사용
+template <int FRAMES>
+int sparseGemm(const DenseLayer& layer, const float* x, int xStride, float* y, int yStride, int batch, bool relu) {
+    int rowBlocks = static_cast<int>(layer.blockRowStart.size()) - 1;
+    const float* values = layer.blockValues.data();
+
+    int f = 0;
+    for (; f + FRAMES <= batch; f += FRAMES) {
+        for (int rb = 0; rb < rowBlocks; rb++) {
+            __m256 acc[FRAMES];
+            for (int j = 0; j < FRAMES; j++) acc[j] = _mm256_setzero_ps();
+
+            for (int k = layer.blockRowStart[rb]; k < layer.blockRowStart[rb + 1]; k++) {
+                __m256 wv = _mm256_load_ps(values + static_cast<size_t>(k) * SPARSE_BLOCK_ROWS);
+                const float* xc = x + static_cast<size_t>(f) * xStride + layer.blockCol[k];
+                for (int j = 0; j < FRAMES; j++) {
+                    acc[j] = _mm256_add_ps(acc[j], _mm256_mul_ps(wv, _mm256_set1_ps(xc[static_cast<size_t>(j) * xStride])));
+                }
+            }
+
+            for (int j = 0; j < FRAMES; j++) {
+                storeRowBlock(acc[j], layer.bias.data(), rb * SPARSE_BLOCK_ROWS, layer.outDim, relu,
+                              y + static_cast<size_t>(f + j) * yStride);
+            }
+        }
+    }
+    return f;
+}
+
+// 설정된 마이크로 커널 형태로 밀집 GEMM 실행
+template <typename Weights>
+int denseGemmDispatch(const DenseLayer& layer, const Weights& w, const float* x, int xStride, float* y, int yStride,
+                      int batch, bool relu, GemmKernel kernel) {
+    switch (kernel) {
+    case GemmKernel::Rows4Frames3:
+        return denseGemm<4, 3>(layer, w, x, xStride, y, yStride, batch, relu);
+    case GemmKernel::Rows2Frames4:
+        return denseGemm<2, 4>(layer, w, x, xStride, y, yStride, batch, relu);
+    case GemmKernel::Rows8Frames1:
+        return denseGemm<8, 1>(layer, w, x, xStride, y, yStride, batch, relu);
+    default:
+        return denseGemm<4, 2>(layer, w, x, xStride, y, yStride, batch, relu);
+    }
+}
+
+} // namespace
+
+void DenseLayer::pack(const float* rowMajor, const float* biasIn, int outputs, int inputs) {
+    inDim = inputs;
+    outDim = outputs;
+    stride = padToSimd(inputs);
+    format = LayerFormat::Dense;
+    precision = WeightPrecision::F32;
+
+    weights.assign(static_cast<size_t>(outputs) * stride, 0.0f);
+    for (int r = 0; r < outputs; r++) {
+        std::memcpy(&weights[static_cast<size_t>(r) * stride], rowMajor + static_cast<size_t>(r) * inputs,
+                    inputs * sizeof(float));
+    }
+
+    bias.assign(biasIn, biasIn + outputs);
+
+    AlignedHalfVector().swap(halfWeights);
+    blockRowStart.clear();
+    blockCol.clear();
+    blockValues.clear();
+}
+
+void DenseLayer::packHalf(const uint16_t* rowMajor, WeightPrecision halfPrecision, const float* biasIn,
+                          int outputs, int inputs) {
+    inDim = inputs;
+    outDim = outputs;
+    stride = padToSimd(inputs);
+    format = LayerFormat::Dense;
+    precision = halfPrecision;
+
+    // 패딩 구간은 +0 비트 패턴 (fp16/bf16 모두 0)
+    halfWeights.assign(static_cast<size_t>(outputs) * stride, 0);
+    for (int r = 0; r < outputs; r++) {
+        std::memcpy(&halfWeights[static_cast<size_t>(r) * stride], rowMajor + static_cast<size_t>(r) * inputs,
+                    inputs * sizeof(uint16_t));
+    }
+
+    bias.assign(biasIn, biasIn + outputs);
+
+    AlignedFloatVector().swap(weights);
+    blockRowStart.clear();
+    blockCol.clear();
+    blockValues.clear();
+}
+
+void DenseLayer::forward(const float* x, float* y, bool relu) const {
+    forwardRows(x, y, relu, 0, outDim);
+}
+
+void DenseLayer::forwardRows(const float* x, float* y, bool relu, int rowBegin, int rowEnd) const {
+    if (format == LayerFormat::BlockSparse) {
+        // 행 블록마다 8행 누적기를 레지스터에 유지하고 블록마다 x[col]을 브로드캐스트
+        int rowBlockEnd = (rowEnd + SPARSE_BLOCK_ROWS - 1) / SPARSE_BLOCK_ROWS;
+        for (int rb = rowBegin / SPARSE_BLOCK_ROWS; rb < rowBlockEnd; rb++) {
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+            int k = blockRowStart[rb];
+            int end = blockRowStart[rb + 1];
+            for (; k + 2 <= end; k += 2) {
+                acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_load_ps(&blockValues[static_cast<size_t>(k) * SPARSE_BLOCK_ROWS]),
+                                                         _mm256_set1_ps(x[blockCol[k]])));
+                acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_load_ps(&blockValues[static_cast<size_t>(k + 1) * SPARSE_BLOCK_ROWS]),
+                                                         _mm256_set1_ps(x[blockCol[k + 1]])));
+            }
+            if (k < end) {
+                acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_load_ps(&blockValues[static_cast<size_t>(k) * SPARSE_BLOCK_ROWS]),
+                                                         _mm256_set1_ps(x[blockCol[k]])));
+            }
+            storeRowBlock(_mm256_add_ps(acc0, acc1), bias.data(), rb * SPARSE_BLOCK_ROWS, outDim, relu, y);
+        }
+        return;
+    }
+
+    switch (precision) {
+    case WeightPrecision::F16:
+        denseGemv(*this, F16Weights{halfWeights.data()}, x, y, relu, rowBegin, rowEnd);
+        break;
+    case WeightPrecision::BF16:
+        denseGemv(*this, Bf16Weights{halfWeights.data()}, x, y, relu, rowBegin, rowEnd);
+        break;
+    default:
+        denseGemv(*this, F32Weights{weights.data()}, x, y, relu, rowBegin, rowEnd);
+        break;
+    }
+}
+
+void DenseLayer::forwardBatch(const float* x, int xStride, float* y, int yStride, int batch, bool relu,
+                              const KernelConfig& config) const {
+    int f = 0;
+
+    if (format == LayerFormat::BlockSparse) {
+        f = config.sparseFrameTile == 8 ? sparseGemm<8>(*this, x, xStride, y, yStride, batch, relu)
+                                        : sparseGemm<4>(*this, x, xStride, y, yStride, batch, relu);
+    } else if (precision == WeightPrecision::F16) {
+        f = denseGemmDispatch(*this, F16Weights{halfWeights.data()}, x, xStride, y, yStride, batch, relu,
+                              config.gemmKernel);
+    } else if (precision == WeightPrecision::BF16) {
+        f = denseGemmDispatch(*this, Bf16Weights{halfWeights.data()}, x, xStride, y, yStride, batch, relu,
+                              config.gemmKernel);
+    } else {
+        f = denseGemmDispatch(*this, F32Weights{weights.data()}, x, xStride, y, yStride, batch, relu,
+                              config.gemmKernel);
+    }
+
+    // 타일에 들어가지 않은 나머지 프레임은 GEMV로 처리
+    for (; f < batch; f++) {
+        forward(x + static_cast<size_t>(f) * xStride, y + static_cast<size_t>(f) * yStride, relu);
+    }
+}
+
+float DenseLayer::measureDensity() const {
+    // 16비트 레이어는 밀집 형식만 지원하므로 희소 변환 대상에서 제외
+    if (precision != WeightPrecision::F32) return 1.0f;
+
+    if (format == LayerFormat::BlockSparse) {
+        int rowBlocks = static_cast<int>(blockRowStart.size()) - 1;
+        size_t totalBlocks = static_cast<size_t>(rowBlocks) * inDim;
+        return totalBlocks == 0 ? 0.0f : static_cast<float>(blockCol.size()) / totalBlocks;
+    }
+
+    int rowBlocks = (outDim + SPARSE_BLOCK_ROWS - 1) / SPARSE_BLOCK_ROWS;
+    size_t nonZero = 0;
+    for (int rb = 0; rb < rowBlocks; rb++) {
+        int rowEnd = std::min(outDim, (rb + 1) * SPARSE_BLOCK_ROWS);
+        for (int c = 0; c < inDim; c++) {
+            for (int r = rb * SPARSE_BLOCK_ROWS; r < rowEnd; r++) {
+                if (weights[static_cast<size_t>(r) * stride + c] != 0.0f) {
+                    nonZero++;
+                    break;
+                }
+            }
+        }
+    }
+    size_t totalBlocks = static_cast<size_t>(rowBlocks) * inDim;
+    return totalBlocks == 0 ? 1.0f : static_cast<float>(nonZero) / totalBlocks;
+}
+
+void DenseLayer::convertToBlockSparse() {
+    int rowBlocks = (outDim + SPARSE_BLOCK_ROWS - 1) / SPARSE_BLOCK_ROWS;
+    blockRowStart.assign(1, 0);
+    blockCol.clear();
+    blockValues.clear();
+
+    for (int rb = 0; rb < rowBlocks; rb++) {
+        int rowBase = rb * SPARSE_BLOCK_ROWS;
+        for (int c = 0; c < inDim; c++) {
+            float block[SPARSE_BLOCK_ROWS] = {0.0f};
+            bool nonZero = false;
+            for (int i = 0; i < SPARSE_BLOCK_ROWS && rowBase + i < outDim; i++) {
+                block[i] = weights[static_cast<size_t>(rowBase + i) * stride + c];
+                nonZero |= (block[i] != 0.0f);
+            }
+            if (nonZero) {
+                blockCol.push_back(c);
+                blockValues.insert(blockValues.end(), block, block + SPARSE_BLOCK_ROWS);
+            }
+        }
+        blockRowStart.push_back(static_cast<int>(blockCol.size()));
+    }
+
+    // 밀집 가중치는 더 이상 필요 없음
+    AlignedFloatVector().swap(weights);
+    format = LayerFormat::BlockSparse;
+}
+
+void DenseLayer::convertToDense() {
+    weights.assign(static_cast<size_t>(outDim) * stride, 0.0f);
+
+    int rowBlocks = static_cast<int>(blockRowStart.size()) - 1;
+    for (int rb = 0; rb < rowBlocks; rb++) {
+        int rowBase = rb * SPARSE_BLOCK_ROWS;
+        for (int k = blockRowStart[rb]; k < blockRowStart[rb + 1]; k++) {
+            const float* block = &blockValues[static_cast<size_t>(k) * SPARSE_BLOCK_ROWS];
+            for (int i = 0; i < SPARSE_BLOCK_ROWS && rowBase + i < outDim; i++) {
+                weights[static_cast<size_t>(rowBase + i) * stride + blockCol[k]] = block[i];
+            }
+        }
+    }
+
+    blockRowStart.clear();
+    blockCol.clear();
+    AlignedFloatVector().swap(blockValues);
+    format = LayerFormat::Dense;
+}
+
+void DenseLayer::setFormat(LayerFormat target) {
+    if (target == format || precision != WeightPrecision::F32) return;
+    if (target == LayerFormat::BlockSparse) {
+        convertToBlockSparse();
+    } else {
+        convertToDense();
+    }
+}
+
+void DenseLayer::selectFormat() {
+    if (format == LayerFormat::Dense && measureDensity() <= SPARSE_DENSITY_THRESHOLD) {
+        convertToBlockSparse();
+    }
+}
+
+void DenseLayer::pruneByMagnitude(float sparsity) {
+    if (format != LayerFormat::Dense || precision != WeightPrecision::F32 || sparsity <= 0.0f) return;
+    sparsity = std::min(sparsity, 1.0f);
+
+    // 8×1 블록 단위 L2 노름 계산
+    int rowBlocks = (outDim + SPARSE_BLOCK_ROWS - 1) / SPARSE_BLOCK_ROWS;
+    std::vector<float> norms(static_cast<size_t>(rowBlocks) * inDim, 0.0f);
+    for (int r = 0; r < outDim; r++) {
+        const float* row = &weights[static_cast<size_t>(r) * stride];
+        float* blockNorms = &norms[static_cast<size_t>(r / SPARSE_BLOCK_ROWS) * inDim];
+        for (int c = 0; c < inDim; c++) blockNorms[c] += row[c] * row[c];
+    }
+
+    size_t pruneCount = static_cast<size_t>(sparsity * norms.size());
+    if (pruneCount == 0) return;
+
+    // 노름이 작은 순(같으면 블록 번호 순)으로 정확히 pruneCount개 선택
+    // (양자화되어 같은 노름이 많아도 요청한 비율보다 더 지우지 않음)
+    std::vector<uint32_t> order(norms.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+    auto smaller = [&](uint32_t a, uint32_t b) { return norms[a] < norms[b] || (norms[a] == norms[b] && a < b); };
+    if (pruneCount < order.size()) std::nth_element(order.begin(), order.begin() + pruneCount, order.end(), smaller);
+    std::vector<uint8_t> pruned(norms.size(), 0);
+    for (size_t i = 0; i < pruneCount; i++) pruned[order[i]] = 1;
+
+    for (int r = 0; r < outDim; r++) {
+        float* row = &weights[static_cast<size_t>(r) * stride];
+        const uint8_t* blockPruned = &pruned[static_cast<size_t>(r / SPARSE_BLOCK_ROWS) * inDim];
+        for (int c = 0; c < inDim; c++) {
+            if (blockPruned[c]) row[c] = 0.0f;
+        }
+    }
+
+    selectFormat();
+}
+
+void DenseLayer::setPrecision(WeightPrecision target) {
+    if (target == precision) return;
+
+    if (precision == WeightPrecision::F32) {
+        if (format == LayerFormat::BlockSparse) convertToDense();
+
+        halfWeights.resize(weights.size());
+        for (size_t i = 0; i < weights.size(); i++) {
+            halfWeights[i] = target == WeightPrecision::F16 ? floatToHalf(weights[i]) : floatToBf16(weights[i]);
+        }
+        AlignedFloatVector().swap(weights);
+    } else {
+        // 16비트 → fp32로 펼친 뒤 필요하면 다른 16비트 형식으로 다시 반올림
+        weights.resize(halfWeights.size());
+        for (size_t i = 0; i < halfWeights.size(); i++) {
+            weights[i] = precision == WeightPrecision::F16 ? halfToFloat(halfWeights[i]) : bf16ToFloat(halfWeights[i]);
+        }
+        AlignedHalfVector().swap(halfWeights);
+        precision = WeightPrecision::F32;
+        if (target != WeightPrecision::F32) setPrecision(target);
+        return;
+    }
+    precision = target;
+}
+
+size_t DenseLayer::byteSize() const {
+    return weights.size() * sizeof(float) + halfWeights.size() * sizeof(uint16_t) + bias.size() * sizeof(float) +
+           blockValues.size() * sizeof(float) + blockCol.size() * sizeof(int) +
+           blockRowStart.size() * sizeof(int);
+}
+
+void DenseLayer::unpack(std::vector<float>& rowMajor) const {
+    rowMajor.assign(static_cast<size_t>(outDim) * inDim, 0.0f);
+
+    if (format == LayerFormat::BlockSparse) {
+        int rowBlocks = static_cast<int>(blockRowStart.size()) - 1;
+        for (int rb = 0; rb < rowBlocks; rb++) {
+            int rowBase = rb * SPARSE_BLOCK_ROWS;
+            for (int k = blockRowStart[rb]; k < blockRowStart[rb + 1]; k++) {
+                const float* block = &blockValues[static_cast<size_t>(k) * SPARSE_BLOCK_ROWS];
+                for (int i = 0; i < SPARSE_BLOCK_ROWS && rowBase + i < outDim; i++) {
+                    rowMajor[static_cast<size_t>(rowBase + i) * inDim + blockCol[k]] = block[i];
+                }
+            }
+        }
+        return;
+    }
+
+    for (int r = 0; r < outDim; r++) {
+        size_t src = static_cast<size_t>(r) * stride;
+        float* dst = &rowMajor[static_cast<size_t>(r) * inDim];
+        if (precision == WeightPrecision::F16) {
+            for (int c = 0; c < inDim; c++) dst[c] = halfToFloat(halfWeights[src + c]);
+        } else if (precision == WeightPrecision::BF16) {
+            for (int c = 0; c < inDim; c++) dst[c] = bf16ToFloat(halfWeights[src + c]);
+        } else {
+            std::memcpy(dst, &weights[src], inDim * sizeof(float));
+        }
+    }
+}
+
+size_t MlpModel::byteSize() const {
+    size_t total = 0;
+    for (const auto& layer : layers) total += layer.byteSize();
+    return total;
+}
+
+void MlpModel::setInputScaler(const float* mean, const float* scale, int count) {
+    bool identity = true;
+    for (int i = 0; i < count && identity; i++) identity = mean[i] == 0.0f && scale[i] == 1.0f;
+    if (identity || count != inputDim()) {
+        inputMean.clear();
+        inputInvScale.clear();
+        return;
+    }
+    inputMean.assign(mean, mean + count);
+    inputInvScale.resize(count);
+    for (int i = 0; i < count; i++) inputInvScale[i] = scale[i] != 0.0f ? 1.0f / scale[i] : 1.0f;
+}
+
+void MlpModel::stageInput(const float* input, float* row) const {
+    const DenseLayer& first = layers.front();
+    if (inputMean.empty()) {
+        std::memcpy(row, input, first.inDim * sizeof(float));
+    } else {
+        int i = 0;
+        for (; i + SIMD_WIDTH <= first.inDim; i += SIMD_WIDTH) {
+            __m256 x = _mm256_sub_ps(_mm256_loadu_ps(input + i), _mm256_loadu_ps(&inputMean[i]));
+            _mm256_storeu_ps(row + i, _mm256_mul_ps(x, _mm256_loadu_ps(&inputInvScale[i])));
+        }
+        for (; i < first.inDim; i++) row[i] = (input[i] - inputMean[i]) * inputInvScale[i];
+    }
+    std::fill(row + first.inDim, row + first.stride, 0.0f);
+}
+
+void MlpModel::forward(const float* input, float* output) const {
+    if (layers.empty()) return;
+
+    // 스레드별 스크래치 (프레임마다 할당하지 않도록)
+    thread_local AlignedFloatVector bufferA;
+    thread_local AlignedFloatVector bufferB;
+
+    size_t maxStride = 0;
+    for (const auto& layer : layers) {
+        maxStride = std::max(maxStride, static_cast<size_t>(std::max(layer.stride, padToSimd(layer.outDim))));
+    }
+    if (bufferA.size() < maxStride) {
+        bufferA.resize(maxStride);
+        bufferB.resize(maxStride);
+        Metrics::setMax(Metric::ScratchHighWaterBytes, static_cast<int64_t>(2 * maxStride * sizeof(float)));
+    }
+
+    float* cur = bufferA.data();
+    float* next = bufferB.data();
+
+    stageInput(input, cur);
+
+    for (size_t l = 0; l < layers.size(); l++) {
+        const DenseLayer& layer = layers[l];
+        bool isLast = (l + 1 == layers.size());
+        bool relu = !isLast && !layer.linear;
+        float* y = isLast ? output : next;
+
+        if (intraOpPool != nullptr && intraOpPool->participantsFor(intraOpThreads) > 1 &&
+            layer.byteSize() >= PARALLEL_GEMV_MIN_BYTES) {
+            forwardLayerParallel(layer, cur, y, relu);
+        } else {
+            layer.forward(cur, y, relu);
+        }
+
+        if (!isLast) {
+            std::fill(next + layer.outDim, next + layers[l + 1].stride, 0.0f);
+            std::swap(cur, next);
+        }
+    }
+}
+
+// 출력 행을 참여자 수(intraOpThreads 상한 적용)만큼 연속 구간으로 나눔
+// 구간 경계를 16행(64바이트)에 맞춰 출력 캐시 라인을 공유하지 않고, 희소 행 블록(8행)도 쪼개지 않음
+void MlpModel::forwardLayerParallel(const DenseLayer& layer, const float* x, float* y, bool relu) const {
+    constexpr int ROW_ALIGN = CACHE_LINE_SIZE / sizeof(float);
+    const int parts = intraOpPool->participantsFor(intraOpThreads);
+    const int rowsPerPart = ((layer.outDim + parts - 1) / parts + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+
+    auto slice = [&](int part) {
+        int begin = part * rowsPerPart;
+        int end = std::min(layer.outDim, begin + rowsPerPart);
+        if (begin < end) layer.forwardRows(x, y, relu, begin, end);
+    };
+    intraOpPool->parallelFor(parts, slice, parts);
+}
+
+void MlpModel::forwardBatch(const float* input, float* output, int batch) const {
+    if (layers.empty() || batch <= 0) return;
+
+    // batchTile 프레임씩 전 레이어를 통과시켜 중간 활성값을 캐시에 유지
+    int tile = kernelConfig.batchTile > 0 ? std::min(kernelConfig.batchTile, batch) : batch;
+    int tiles = (batch + tile - 1) / tile;
+
+    // 타일끼리는 독립이므로 풀이 있으면 타일 단위로 나눠 실행 (타일마다 각 스레드의 스크래치 사용)
+    if (intraOpPool != nullptr && tiles > 1) {
+        auto run = [&](int first, int last) {
+            int start = first * tile;
+            forwardTile(input, output, start, std::min(last * tile, batch) - start, tile);
+        };
+        intraOpPool->parallelFor(0, tiles, 1, run, intraOpThreads);
+    } else {
+        forwardTile(input, output, 0, batch, tile);
+    }
+}
+
+void MlpModel::forwardTile(const float* input, float* output, int begin, int frames, int tile) const {
+    int maxStride = 0;
+    for (const auto& layer : layers) {
+        maxStride = std::max(maxStride, std::max(layer.stride, padToSimd(layer.outDim)));
+    }
+
+    thread_local AlignedFloatVector bufferA;
+    thread_local AlignedFloatVector bufferB;
+    size_t needed = static_cast<size_t>(tile) * maxStride;
+    if (bufferA.size() < needed) {
+        bufferA.resize(needed);
+        bufferB.resize(needed);
+        Metrics::setMax(Metric::ScratchHighWaterBytes, static_cast<int64_t>(2 * needed * sizeof(float)));
+    }
+
+    const DenseLayer& first = layers.front();
+    int numOutputs = outputDim();
+    int end = begin + frames;
+
+    for (int start = begin; start < end; start += tile) {
+        int count = std::min(tile, end - start);
+        float* cur = bufferA.data();
+        float* next = bufferB.data();
+
+        // 프레임마다 maxStride 간격으로 패딩하여 배치 행렬 구성
+        for (int f = 0; f < count; f++) {
+            stageInput(input + static_cast<size_t>(start + f) * first.inDim, cur + static_cast<size_t>(f) * maxStride);
+        }
+
+        for (size_t l = 0; l < layers.size(); l++) {
+            const DenseLayer& layer = layers[l];
+
+            if (l + 1 == layers.size()) {
+                layer.forwardBatch(cur, maxStride, output + static_cast<size_t>(start) * numOutputs, numOutputs,
+                                   count, false, kernelConfig);
+            } else {
+                layer.forwardBatch(cur, maxStride, next, maxStride, count, !layer.linear, kernelConfig);
+                int nextStride = layers[l + 1].stride;
+                for (int f = 0; f < count; f++) {
+                    float* row = next + static_cast<size_t>(f) * maxStride;
+                    std::fill(row + layer.outDim, row + nextStride, 0.0f);
+                }
+                std::swap(cur, next);
+            }
+        }
+    }
+}
+
+void MlpModel::pruneByMagnitude(float sparsity) {
+    for (auto& layer : layers) layer.pruneByMagnitude(sparsity);
+}
+
+void MlpModel::setWeightPrecision(WeightPrecision precision) {
+    for (auto& layer : layers) layer.setPrecision(precision);
+}
+
+std::string MlpModel::shapeSignature() const {
+    std::string signature = std::to_string(inputDim());
+    for (const auto& layer : layers) signature += "x" + std::to_string(layer.outDim);
+    return signature;
+}
+
+void MlpModel::addLayer(const float* rowMajor, const float* bias, int outputs, int inputs) {
+    layers.emplace_back();
+    layers.back().pack(rowMajor, bias, outputs, inputs);
+    layers.back().selectFormat();
+}
+
+bool MlpModel::loadFromArrays(const std::map<std::string, NpyArray>& arrays, std::string& error) {
+    std::vector<DenseLayer> loaded;
+
+    for (int index = 1;; index++) {
+        const NpyArray* w = findArray(arrays, 'w', index);
+        const NpyArray* b = findArray(arrays, 'b', index);
+        if (w == nullptr && b == nullptr) break;
+
+        std::string name = "layer " + std::to_string(index);
+        if (w == nullptr || b == nullptr) {
+            error = name + ": weight/bias pair is incomplete";
+            return false;
+        }
+        if (w->shape.size() != 2 || b->shape.size() != 1 || b->shape[0] != w->shape[0]) {
+            error = name + ": expected W[out][in] and B[out]";
+            return false;
+        }
+        int outputs = w->shape[0];
+        int inputs = w->shape[1];
+        if (!loaded.empty() && loaded.back().outDim != inputs) {
+            error = name + ": input size does not match previous layer";
+            return false;
+        }
+
+        // 바이어스는 크기가 작으므로 항상 fp32로 보관
+        std::vector<float> bias = b->toFloat();
+        loaded.emplace_back();
+        if (w->dtype == NpyDtype::Float32) {
+            loaded.back().pack(w->data.data(), bias.data(), outputs, inputs);
+
+            // 가지치기된 가중치(0 블록)가 충분하면 블록 희소 형식으로 저장
+            loaded.back().selectFormat();
+        } else {
+            WeightPrecision halfPrecision = w->dtype == NpyDtype::Float16 ? WeightPrecision::F16 : WeightPrecision::BF16;
+            loaded.back().packHalf(w->halfData.data(), halfPrecision, bias.data(), outputs, inputs);
+        }
+    }
+
+    if (loaded.empty()) {
+        error = "no w1/b1 arrays found";
+        return false;
+    }
+
+    layers = std::move(loaded);
+    return true;
+}
+
+bool MlpModel::loadFromNpzBuffer(const uint8_t* data, size_t size, std::string& error) {
+    std::map<std::string, NpyArray> arrays;
+    if (!NpzReader::parse(data, size, arrays, error)) return false;
+    return loadFromArrays(arrays, error);
+}
+
+bool MlpModel::loadFromNpzFile(const std::string& path, std::string& error) {
+    std::map<std::string, NpyArray> arrays;
+    if (!NpzReader::loadFile(path, arrays, error)) return false;
+    return loadFromArrays(arrays, error);
+}
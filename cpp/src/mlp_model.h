@@ -0,0 +1,215 @@
+#ifndef MLP_MODEL_H
+#define MLP_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include "npz_reader.h"
+#include "threading.h"
+
+// AVX 한 레지스터에 들어가는 float 개수
+constexpr int SIMD_WIDTH = 8;
+constexpr size_t SIMD_ALIGNMENT = 32;
+
+// 32바이트 정렬 할당자 (_mm256_load_ps 사용을 위해)
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        size_t bytes = (n * sizeof(T) + SIMD_ALIGNMENT - 1) & ~(SIMD_ALIGNMENT - 1);
+        void* p = std::aligned_alloc(SIMD_ALIGNMENT, bytes);
+        if (p == nullptr) std::abort();
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t) { std::free(p); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+using AlignedFloatVector = std::vector<float, AlignedAllocator<float>>;
+using AlignedHalfVector = std::vector<uint16_t, AlignedAllocator<uint16_t>>;
+
+// n을 SIMD_WIDTH 배수로 올림
+inline int padToSimd(int n) {
+    return (n + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1);
+}
+
+// 희소 블록 높이: 출력 8행 × 입력 1열 블록 하나가 AVX 레지스터 하나에 대응
+constexpr int SPARSE_BLOCK_ROWS = SIMD_WIDTH;
+
+// 0이 아닌 블록 비율이 이 값 이하이면 블록 희소 커널 사용
+// (블록당 브로드캐스트 비용 때문에 밀집 커널 대비 손익분기는 약 50%)
+constexpr float SPARSE_DENSITY_THRESHOLD = 0.4f;
+
+// 레이어 가중치 저장 형식
+enum class LayerFormat {
+    Dense,       // 행 우선 패딩 레이아웃
+    BlockSparse  // 8×1 블록 BSR
+};
+
+// 밀집 GEMM 마이크로 커널 형태 (출력 행 × 프레임 누적기 타일)
+enum class GemmKernel {
+    Rows4Frames2,  // 누적기 8개 (기본값)
+    Rows4Frames3,  // 누적기 12개: x 3개 + w 1개로 16 레지스터를 모두 사용
+    Rows2Frames4,
+    Rows8Frames1
+};
+
+// 가중치 저장 정밀도 (16비트 형식은 커널 안에서 레지스터 단위로 fp32로 확장)
+enum class WeightPrecision {
+    F32,
+    F16,   // IEEE half: 가수 10비트, 범위 ±65504
+    BF16   // bfloat16: 가수 7비트, fp32와 같은 지수 범위
+};
+
+// 배치 커널 선택 (기기별 자동 튜닝 결과, autotuner.h 참고)
+struct KernelConfig {
+    GemmKernel gemmKernel = GemmKernel::Rows4Frames2;
+    int sparseFrameTile = 4;  // 희소 GEMM에서 블록 하나를 재사용하는 프레임 수 (4 또는 8)
+    int batchTile = 32;       // 전 레이어를 통과시키는 프레임 묶음 크기 (활성값을 캐시에 유지)
+};
+
+// 완전 연결 레이어 (SIMD 패킹 레이아웃)
+// 가중치는 행(출력) 우선이며 각 행은 stride(=inDim을 8의 배수로 올린 값)만큼
+// 0으로 패딩되어 32바이트 경계에 정렬됩니다.
+// 가지치기된 레이어는 8×1 블록 희소(BSR) 형식으로 변환되어
+// 블록 값과 입력 원소 하나의 브로드캐스트 곱으로 8행을 한 번에 누적합니다.
+// fp16/bf16 레이어는 같은 패딩 레이아웃으로 halfWeights에 저장되며 밀집 형식만 지원합니다.
+struct DenseLayer {
+    int inDim = 0;
+    int outDim = 0;
+    int stride = 0;
+    LayerFormat format = LayerFormat::Dense;
+    WeightPrecision precision = WeightPrecision::F32;
+    bool linear = false;  // true면 은닉 레이어여도 ReLU를 적용하지 않음 (저랭크 분해의 앞쪽 인자)
+    AlignedFloatVector weights;
+    AlignedHalfVector halfWeights;
+    std::vector<float> bias;
+
+    // BlockSparse 전용: 행 블록별 시작 위치, 블록의 입력 열, 블록 값(블록당 8개)
+    std::vector<int> blockRowStart;
+    std::vector<int> blockCol;
+    AlignedFloatVector blockValues;
+
+    // 행 우선 [outDim][inDim] 가중치를 패킹 레이아웃으로 변환
+    void pack(const float* rowMajor, const float* biasIn, int outputs, int inputs);
+
+    // 16비트 비트 패턴(fp16 또는 bf16) 가중치를 변환 없이 패킹
+    void packHalf(const uint16_t* rowMajor, WeightPrecision halfPrecision, const float* biasIn,
+                  int outputs, int inputs);
+
+    // y = W·x + b (relu가 true면 ReLU 적용)
+    // x는 32바이트 정렬, stride 길이이며 패딩 구간은 0이어야 합니다.
+    void forward(const float* x, float* y, bool relu) const;
+
+    // [rowBegin, rowEnd) 출력 행만 계산 (행 단위 병렬 GEMV용)
+    // rowBegin은 8의 배수여야 합니다 (블록 희소 형식의 행 블록 경계).
+    void forwardRows(const float* x, float* y, bool relu, int rowBegin, int rowEnd) const;
+
+    // 여러 프레임 동시 처리 (GEMM): x는 batch × xStride, y는 batch × yStride
+    // xStride는 stride 이상의 8의 배수여야 합니다.
+    void forwardBatch(const float* x, int xStride, float* y, int yStride, int batch, bool relu,
+                      const KernelConfig& config = KernelConfig()) const;
+
+    // 0이 아닌 8×1 블록의 비율 (Dense 형식에서 측정, 16비트 레이어는 항상 1)
+    float measureDensity() const;
+
+    // 측정된 밀도에 따라 Dense/BlockSparse 선택
+    void selectFormat();
+
+    // 형식 강제 변환 (자동 튜닝 결과 적용용)
+    void setFormat(LayerFormat target);
+
+    // 블록 L2 노름이 작은 순으로 sparsity 비율만큼 0으로 만든 뒤 형식 재선택
+    void pruneByMagnitude(float sparsity);
+
+    // 가중치 정밀도 변환 (가장 가까운 짝수로 반올림, 희소 레이어는 밀집으로 되돌린 뒤 변환)
+    void setPrecision(WeightPrecision target);
+
+    // 패킹된 가중치와 바이어스의 바이트 수
+    size_t byteSize() const;
+
+    // 형식/정밀도와 관계없이 행 우선 [outDim][inDim] fp32 가중치로 복원
+    void unpack(std::vector<float>& rowMajor) const;
+
+private:
+    void convertToBlockSparse();
+    void convertToDense();
+};
+
+class ThreadPool;
+
+// 가중치가 이 크기 이상인 레이어만 한 프레임 추론을 스레드로 나눔 (작은 레이어는 동기화 비용이 더 큼)
+constexpr size_t PARALLEL_GEMV_MIN_BYTES = 256 * 1024;
+
+// 다층 퍼셉트론 (마지막 레이어와 linear 레이어를 제외하고 ReLU)
+class MlpModel {
+public:
+    std::vector<DenseLayer> layers;
+    KernelConfig kernelConfig;
+
+    // 설정하면 forward()에서 큰 레이어를 출력 행 구간으로, forwardBatch()에서 배치를 타일 단위로
+    // 나눠 풀의 스레드들이 함께 계산 (소유하지 않음)
+    ThreadPool* intraOpPool = nullptr;
+    // 함께 계산하는 참여자 수 상한 (호출 스레드 포함, 0이면 풀 전체)
+    int intraOpThreads = 0;
+
+    // 입력 표준화 (x − mean) / scale, 비어 있으면 입력을 그대로 사용
+    // 첫 레이어 입력 버퍼로 복사하면서 적용하므로 정규화된 특징 벡터를 따로 쓰고 다시 읽지 않습니다.
+    std::vector<float> inputMean;
+    std::vector<float> inputInvScale;
+
+    int inputDim() const { return layers.empty() ? 0 : layers.front().inDim; }
+    int outputDim() const { return layers.empty() ? 0 : layers.back().outDim; }
+    bool empty() const { return layers.empty(); }
+    size_t byteSize() const;
+
+    // 한 프레임 추론: input은 inputDim개, output은 outputDim개
+    void forward(const float* input, float* output) const;
+
+    // 배치 추론: input은 batch × inputDim, output은 batch × outputDim
+    void forwardBatch(const float* input, float* output, int batch) const;
+
+    // 입력 표준화 설정 (count는 inputDim, 항등 변환이면 해제)
+    void setInputScaler(const float* mean, const float* scale, int count);
+
+    // 모든 레이어를 크기 기준으로 가지치기하고 레이어별 형식 선택
+    void pruneByMagnitude(float sparsity);
+
+    // 모든 레이어의 가중치 정밀도 변환 (바이어스는 fp32 유지)
+    void setWeightPrecision(WeightPrecision precision);
+
+    // 레이어 크기 서명 (예: "126x128x64x4"), 튜닝 프로파일 검증용
+    std::string shapeSignature() const;
+
+    // 행 우선 배열 목록으로부터 구성 (gesture_weights.h 등)
+    void addLayer(const float* rowMajor, const float* bias, int outputs, int inputs);
+
+    // NPZ 배열(w1/b1, w2/b2, ... 대소문자 무관)로부터 구성하고 SIMD 레이아웃으로 패킹
+    // '<f2'/'<u2' 가중치는 fp32로 펼치지 않고 16비트 그대로 저장
+    bool loadFromArrays(const std::map<std::string, NpyArray>& arrays, std::string& error);
+    bool loadFromNpzBuffer(const uint8_t* data, size_t size, std::string& error);
+    bool loadFromNpzFile(const std::string& path, std::string& error);
+
+private:
+    // 한 프레임 입력을 첫 레이어 입력 행(stride만큼, 패딩은 0)으로 복사하면서 표준화
+    void stageInput(const float* input, float* row) const;
+
+    // [begin, begin + frames) 프레임을 tile개씩 전 레이어에 통과
+    void forwardTile(const float* input, float* output, int begin, int frames, int tile) const;
+    void forwardLayerParallel(const DenseLayer& layer, const float* x, float* y, bool relu) const;
+};
+
+#endif // MLP_MODEL_H
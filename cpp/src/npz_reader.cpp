@@ -0,0 +1,288 @@
+#include "npz_reader.h"
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// zip 시그니처
+constexpr uint32_t ZIP_LOCAL_HEADER_SIG = 0x04034b50;
+constexpr uint32_t ZIP_CENTRAL_HEADER_SIG = 0x02014b50;
+constexpr uint32_t ZIP_END_OF_CENTRAL_DIR_SIG = 0x06054b50;
+constexpr uint16_t ZIP_METHOD_STORED = 0;
+constexpr uint16_t ZIP64_EXTRA_ID = 0x0001;
+constexpr uint32_t ZIP64_MARKER = 0xFFFFFFFF;
+
+constexpr size_t LOCAL_HEADER_SIZE = 30;
+constexpr size_t CENTRAL_HEADER_SIZE = 46;
+constexpr size_t END_OF_CENTRAL_DIR_SIZE = 22;
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+// NPY 헤더 딕셔너리에서 키에 해당하는 값 문자열의 시작 위치를 찾음
+size_t findHeaderValue(const std::string& header, const char* key) {
+    size_t pos = header.find(key);
+    if (pos == std::string::npos) return pos;
+    pos = header.find(':', pos);
+    if (pos == std::string::npos) return pos;
+    pos++;
+    while (pos < header.size() && header[pos] == ' ') pos++;
+    return pos;
+}
+
+// zip64 extra 필드에서 0xFFFFFFFF로 표시된 크기/오프셋을 복원
+void applyZip64Extra(const uint8_t* extra, size_t extraLen,
+                     uint64_t& uncompressed, uint64_t& compressed, uint64_t& offset) {
+    size_t pos = 0;
+    while (pos + 4 <= extraLen) {
+        uint16_t id = readU16(extra + pos);
+        uint16_t len = readU16(extra + pos + 2);
+        const uint8_t* body = extra + pos + 4;
+        if (pos + 4 + len > extraLen) return;
+
+        if (id == ZIP64_EXTRA_ID) {
+            size_t field = 0;
+            if (uncompressed == ZIP64_MARKER && field + 8 <= len) {
+                uncompressed = readU64(body + field);
+                field += 8;
+            }
+            if (compressed == ZIP64_MARKER && field + 8 <= len) {
+                compressed = readU64(body + field);
+                field += 8;
+            }
+            if (offset == ZIP64_MARKER && field + 8 <= len) {
+                offset = readU64(body + field);
+            }
+            return;
+        }
+        pos += 4 + len;
+    }
+}
+
+} // namespace
+
+bool NpzReader::parseNpy(const uint8_t* data, size_t size, NpyArray& array, std::string& error) {
+    static const uint8_t MAGIC[6] = {0x93, 'N', 'U', 'M', 'P', 'Y'};
+    if (size < 10 || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "not an npy array";
+        return false;
+    }
+
+    // 버전 1.x: 헤더 길이 u16, 버전 2.x/3.x: u32
+    uint8_t major = data[6];
+    size_t headerLen = 0;
+    size_t headerStart = 0;
+    if (major == 1) {
+        headerLen = readU16(data + 8);
+        headerStart = 10;
+    } else if ((major == 2 || major == 3) && size >= 12) {
+        headerLen = readU32(data + 8);
+        headerStart = 12;
+    } else {
+        error = "unsupported npy version";
+        return false;
+    }
+    if (headerLen > size - headerStart) {
+        error = "truncated npy header";
+        return false;
+    }
+
+    std::string header(reinterpret_cast<const char*>(data + headerStart), headerLen);
+
+    size_t descrPos = findHeaderValue(header, "'descr'");
+    size_t elementSize = 0;
+    if (descrPos != std::string::npos && header.compare(descrPos, 5, "'<f4'") == 0) {
+        array.dtype = NpyDtype::Float32;
+        elementSize = 4;
+    } else if (descrPos != std::string::npos && header.compare(descrPos, 5, "'<f2'") == 0) {
+        array.dtype = NpyDtype::Float16;
+        elementSize = 2;
+    } else if (descrPos != std::string::npos && header.compare(descrPos, 5, "'<u2'") == 0) {
+        array.dtype = NpyDtype::BFloat16;
+        elementSize = 2;
+    } else {
+        error = "only little-endian '<f4', '<f2' and bfloat16 '<u2' arrays are supported";
+        return false;
+    }
+
+    size_t orderPos = findHeaderValue(header, "'fortran_order'");
+    if (orderPos == std::string::npos || header.compare(orderPos, 5, "False") != 0) {
+        error = "fortran_order arrays are not supported";
+        return false;
+    }
+
+    size_t shapePos = findHeaderValue(header, "'shape'");
+    if (shapePos == std::string::npos || header[shapePos] != '(') {
+        error = "missing shape";
+        return false;
+    }
+
+    // "(128, 126)" / "(128,)" / "()" 파싱
+    // 차원과 원소 수는 size_t로 누적하며, 곱이 넘치거나 차원이 int 범위를 넘는 헤더는 거부
+    array.shape.clear();
+    size_t count = 1;
+    size_t pos = shapePos + 1;
+    while (pos < header.size() && header[pos] != ')') {
+        if (header[pos] >= '0' && header[pos] <= '9') {
+            size_t dim = 0;
+            while (pos < header.size() && header[pos] >= '0' && header[pos] <= '9') {
+                size_t digit = static_cast<size_t>(header[pos] - '0');
+                if (dim > (static_cast<size_t>(INT_MAX) - digit) / 10) {
+                    error = "npy shape dimension too large";
+                    return false;
+                }
+                dim = dim * 10 + digit;
+                pos++;
+            }
+            if (dim != 0 && count > SIZE_MAX / dim) {
+                error = "npy shape overflows";
+                return false;
+            }
+            array.shape.push_back(static_cast<int>(dim));
+            count *= dim;
+        } else {
+            pos++;
+        }
+    }
+
+    size_t dataStart = headerStart + headerLen;
+    if (count > (size - dataStart) / elementSize) {
+        error = "truncated npy data";
+        return false;
+    }
+
+    if (array.dtype == NpyDtype::Float32) {
+        array.data.resize(count);
+        array.halfData.clear();
+        std::memcpy(array.data.data(), data + dataStart, count * sizeof(float));
+    } else {
+        array.halfData.resize(count);
+        array.data.clear();
+        std::memcpy(array.halfData.data(), data + dataStart, count * sizeof(uint16_t));
+    }
+    return true;
+}
+
+std::vector<float> NpyArray::toFloat() const {
+    if (dtype == NpyDtype::Float32) return data;
+
+    std::vector<float> values(halfData.size());
+    for (size_t i = 0; i < halfData.size(); i++) {
+        values[i] = dtype == NpyDtype::Float16 ? halfToFloat(halfData[i]) : bf16ToFloat(halfData[i]);
+    }
+    return values;
+}
+
+bool NpzReader::parse(const uint8_t* data, size_t size,
+                      std::map<std::string, NpyArray>& arrays, std::string& error) {
+    if (data == nullptr || size < END_OF_CENTRAL_DIR_SIZE) {
+        error = "buffer too small for a zip archive";
+        return false;
+    }
+
+    // End of Central Directory 레코드를 뒤에서부터 탐색 (주석 최대 64KB)
+    size_t eocd = size;
+    size_t searchEnd = size > END_OF_CENTRAL_DIR_SIZE + 0xFFFF ? size - END_OF_CENTRAL_DIR_SIZE - 0xFFFF : 0;
+    for (size_t i = size - END_OF_CENTRAL_DIR_SIZE + 1; i-- > searchEnd;) {
+        if (readU32(data + i) == ZIP_END_OF_CENTRAL_DIR_SIG) {
+            eocd = i;
+            break;
+        }
+    }
+    if (eocd == size) {
+        error = "end of central directory not found";
+        return false;
+    }
+
+    uint16_t entryCount = readU16(data + eocd + 10);
+    size_t centralOffset = readU32(data + eocd + 16);
+
+    size_t pos = centralOffset;
+    for (uint16_t entry = 0; entry < entryCount; entry++) {
+        if (pos + CENTRAL_HEADER_SIZE > size || readU32(data + pos) != ZIP_CENTRAL_HEADER_SIG) {
+            error = "corrupt central directory";
+            return false;
+        }
+
+        uint16_t method = readU16(data + pos + 10);
+        uint64_t compressed = readU32(data + pos + 20);
+        uint64_t uncompressed = readU32(data + pos + 24);
+        uint16_t nameLen = readU16(data + pos + 28);
+        uint16_t extraLen = readU16(data + pos + 30);
+        uint16_t commentLen = readU16(data + pos + 32);
+        uint64_t localOffset = readU32(data + pos + 42);
+
+        if (pos + CENTRAL_HEADER_SIZE + nameLen + extraLen > size) {
+            error = "corrupt central directory";
+            return false;
+        }
+
+        std::string name(reinterpret_cast<const char*>(data + pos + CENTRAL_HEADER_SIZE), nameLen);
+        applyZip64Extra(data + pos + CENTRAL_HEADER_SIZE + nameLen, extraLen,
+                        uncompressed, compressed, localOffset);
+        pos += CENTRAL_HEADER_SIZE + nameLen + extraLen + commentLen;
+
+        if (method != ZIP_METHOD_STORED) {
+            error = "compressed entry '" + name + "' (use np.savez, not np.savez_compressed)";
+            return false;
+        }
+
+        // 로컬 헤더의 이름/extra 길이는 central directory와 다를 수 있음
+        if (localOffset > size || LOCAL_HEADER_SIZE > size - localOffset ||
+            readU32(data + localOffset) != ZIP_LOCAL_HEADER_SIG) {
+            error = "corrupt local header for '" + name + "'";
+            return false;
+        }
+        size_t dataStart = localOffset + LOCAL_HEADER_SIZE +
+                           readU16(data + localOffset + 26) + readU16(data + localOffset + 28);
+        if (dataStart > size || compressed > size - dataStart) {
+            error = "truncated entry '" + name + "'";
+            return false;
+        }
+
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".npy") == 0) {
+            name.resize(name.size() - 4);
+        }
+
+        NpyArray array;
+        std::string npyError;
+        if (!parseNpy(data + dataStart, static_cast<size_t>(compressed), array, npyError)) {
+            error = name + ": " + npyError;
+            return false;
+        }
+        arrays[name] = std::move(array);
+    }
+
+    return true;
+}
+
+bool NpzReader::loadFile(const std::string& path,
+                         std::map<std::string, NpyArray>& arrays, std::string& error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::vector<uint8_t> buffer;
+    uint8_t chunk[16384];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+
+    return parse(buffer.data(), buffer.size(), arrays, error);
+}
@@ -0,0 +1,54 @@
+#ifndef NPZ_READER_H
+#define NPZ_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "half_float.h"
+
+// NPY 원소 형식
+enum class NpyDtype {
+    Float32,  // '<f4'
+    Float16,  // '<f2' (IEEE half)
+    BFloat16  // '<u2' (bfloat16 비트 패턴을 uint16으로 저장한 배열)
+};
+
+// NPY 배열 (리틀 엔디언, C 순서만 지원)
+// Float32는 data에, 16비트 형식은 변환 없이 halfData에 원본 비트로 보관합니다.
+struct NpyArray {
+    NpyDtype dtype = NpyDtype::Float32;
+    std::vector<int> shape;
+    std::vector<float> data;
+    std::vector<uint16_t> halfData;
+
+    // 전체 원소 개수
+    size_t size() const { return dtype == NpyDtype::Float32 ? data.size() : halfData.size(); }
+
+    // 형식과 관계없이 float32로 변환한 값
+    std::vector<float> toFloat() const;
+};
+
+// 최소 기능 NPZ 리더
+// - 압축되지 않은(stored) zip 엔트리만 지원 (np.savez 기본 출력)
+// - '<f4', '<f2', '<u2'(bfloat16) dtype, fortran_order=False 배열만 지원
+// 실패 시 false를 반환하고 error에 사유를 기록합니다.
+class NpzReader {
+public:
+    // 메모리 버퍼에서 NPZ 파싱 (키는 ".npy" 확장자를 제거한 이름)
+    static bool parse(const uint8_t* data, size_t size,
+                      std::map<std::string, NpyArray>& arrays,
+                      std::string& error);
+
+    // 파일에서 NPZ 로드 (네이티브 또는 Emscripten FS)
+    static bool loadFile(const std::string& path,
+                         std::map<std::string, NpyArray>& arrays,
+                         std::string& error);
+
+    // 단일 .npy 바이트열 파싱
+    static bool parseNpy(const uint8_t* data, size_t size,
+                         NpyArray& array, std::string& error);
+};
+
+#endif // NPZ_READER_H
@@ -0,0 +1,389 @@
+#include "output_head.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+inline float horizontalSum(__m256 v) {
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    __m128 shuf = _mm_movehdup_ps(lo);
+    __m128 sums = _mm_add_ps(lo, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+inline float horizontalMax(__m256 v) {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_movehdup_ps(m));
+    return _mm_cvtss_f32(m);
+}
+
+// exp(x) 8개 (Cephes 다항식): x = n·ln2 + r, exp(r)은 5차 다항식, 2^n은 지수 비트로 조립
+inline __m256 exp256(__m256 x) {
+    x = _mm256_max_ps(_mm256_min_ps(x, _mm256_set1_ps(88.0f)), _mm256_set1_ps(-87.0f));
+
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(n, _mm256_set1_ps(0.693359375f)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(n, _mm256_set1_ps(-2.12194440e-4f)));
+
+    __m256 p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(5.0000001201e-1f));
+    p = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(p, r), r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+
+    __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(bits));
+}
+
+float maxOf(const float* x, int count) {
+    int i = 0;
+    float best = -3.0e38f;
+    if (count >= SIMD_WIDTH) {
+        __m256 m = _mm256_loadu_ps(x);
+        for (i = SIMD_WIDTH; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) m = _mm256_max_ps(m, _mm256_loadu_ps(x + i));
+        best = horizontalMax(m);
+    }
+    for (; i < count; i++) best = std::max(best, x[i]);
+    return best;
+}
+
+// 힙 원소 비교: 값이 작을수록(같으면 인덱스가 클수록) 먼저 밀려남
+inline bool ranksBelow(const std::pair<float, int>& a, const std::pair<float, int>& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+constexpr uint32_t KMEANS_SEED = 0x51ed2705u;
+
+} // namespace
+
+float expShiftSum(const float* x, int count, float shift, float* out) {
+    const __m256 s = _mm256_set1_ps(shift);
+    __m256 acc = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) {
+        __m256 e = exp256(_mm256_sub_ps(_mm256_loadu_ps(x + i), s));
+        if (out != nullptr) _mm256_storeu_ps(out + i, e);
+        acc = _mm256_add_ps(acc, e);
+    }
+    float sum = horizontalSum(acc);
+    for (; i < count; i++) {
+        float e = std::exp(x[i] - shift);
+        if (out != nullptr) out[i] = e;
+        sum += e;
+    }
+    return sum;
+}
+
+float logSumExp(const float* logits, int count) {
+    if (count <= 0) return -1e30f;
+    float m = maxOf(logits, count);
+    return m + std::log(expShiftSum(logits, count, m, nullptr));
+}
+
+int selectTopK(const float* values, int count, int k, int* indices) {
+    k = std::min(k, count);
+    if (k <= 0) return 0;
+
+    // 크기 k 최소 힙 (힙 맨 앞이 현재 k번째 값)
+    thread_local std::vector<std::pair<float, int>> heap;
+    heap.clear();
+    for (int i = 0; i < k; i++) heap.push_back({values[i], i});
+    std::make_heap(heap.begin(), heap.end(), ranksBelow);
+    float threshold = heap.front().first;
+
+    auto offer = [&](int i) {
+        if (values[i] <= threshold) return;
+        std::pop_heap(heap.begin(), heap.end(), ranksBelow);
+        heap.back() = {values[i], i};
+        std::push_heap(heap.begin(), heap.end(), ranksBelow);
+        threshold = heap.front().first;
+    };
+
+    int i = k;
+    for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) {
+        __m256 greater = _mm256_cmp_ps(_mm256_loadu_ps(values + i), _mm256_set1_ps(threshold), _CMP_GT_OQ);
+        int mask = _mm256_movemask_ps(greater);
+        while (mask != 0) {
+            int bit = __builtin_ctz(mask);
+            offer(i + bit);
+            mask &= mask - 1;
+        }
+    }
+    for (; i < count; i++) offer(i);
+
+    std::sort(heap.begin(), heap.end(), ranksBelow);
+    for (int j = 0; j < k; j++) indices[j] = heap[j].second;
+    return k;
+}
+
+OutputHead::OutputHead() : probes(1), evaluated(0) {}
+
+bool OutputHead::setWeights(const float* rowMajor, const float* bias, int classes, int hidden) {
+    if (rowMajor == nullptr || bias == nullptr || classes <= 0 || hidden <= 0) return false;
+
+    classLayer = DenseLayer();
+    classLayer.pack(rowMajor, bias, classes, hidden);
+    clusterLayer = DenseLayer();
+    rowLabel.resize(classes);
+    for (int c = 0; c < classes; c++) rowLabel[c] = c;
+    clusterStart = {0, classes};
+    probes = 1;
+    return true;
+}
+
+bool OutputHead::loadFromNpzBuffer(const uint8_t* data, size_t size, std::string& error) {
+    MlpModel loaded;
+    if (!loaded.loadFromNpzBuffer(data, size, error)) return false;
+    if (loaded.layers.size() != 1) {
+        error = "output head must be a single w1/b1 layer";
+        return false;
+    }
+
+    // 군집 재배치와 행 구간 GEMV는 밀집 형식에서만 가능
+    classLayer = std::move(loaded.layers.front());
+    classLayer.setFormat(LayerFormat::Dense);
+    clusterLayer = DenseLayer();
+    rowLabel.resize(classLayer.outDim);
+    for (int c = 0; c < classLayer.outDim; c++) rowLabel[c] = c;
+    clusterStart = {0, classLayer.outDim};
+    probes = 1;
+    return true;
+}
+
+void OutputHead::setWeightPrecision(WeightPrecision precision) {
+    classLayer.setPrecision(precision);
+    clusterLayer.setPrecision(precision);
+}
+
+void OutputHead::buildClusters(int clusters, int probeCount, int iterations) {
+    const int rows = classLayer.outDim;
+    const int hidden = classLayer.inDim;
+    if (rows == 0) return;
+    const WeightPrecision precision = classLayer.precision;
+
+    std::vector<float> weights;
+    classLayer.unpack(weights);
+    const std::vector<float> bias = classLayer.bias;
+    const int dims = hidden + 1;
+
+    // 바이어스를 마지막 차원으로 붙인 행 (군집 중심의 점수가 구성원 logit의 평균이 되도록)
+    auto rowValue = [&](int r, int d) {
+        return d < hidden ? weights[static_cast<size_t>(r) * hidden + d] : bias[r];
+    };
+
+    clusters = std::max(1, std::min(clusters, rows));
+    std::vector<int> assignment(rows, 0);
+    std::vector<float> centroids(static_cast<size_t>(clusters) * dims, 0.0f);
+
+    if (clusters > 1) {
+        // k-means++ 초기화 (결정적 난수)
+        uint32_t state = KMEANS_SEED;
+        auto nextUniform = [&]() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<float>(state >> 8) / 16777216.0f;
+        };
+        auto distance = [&](int r, int c) {
+            float sum = 0.0f;
+            const float* centroid = &centroids[static_cast<size_t>(c) * dims];
+            for (int d = 0; d < dims; d++) {
+                float diff = rowValue(r, d) - centroid[d];
+                sum += diff * diff;
+            }
+            return sum;
+        };
+
+        std::vector<float> nearest(rows, 3.0e38f);
+        int pick = static_cast<int>(nextUniform() * rows) % rows;
+        for (int c = 0; c < clusters; c++) {
+            for (int d = 0; d < dims; d++) centroids[static_cast<size_t>(c) * dims + d] = rowValue(pick, d);
+            double total = 0.0;
+            for (int r = 0; r < rows; r++) {
+                nearest[r] = std::min(nearest[r], distance(r, c));
+                total += nearest[r];
+            }
+            double target = nextUniform() * total;
+            pick = rows - 1;
+            for (int r = 0; r < rows; r++) {
+                target -= nearest[r];
+                if (target <= 0.0) {
+                    pick = r;
+                    break;
+                }
+            }
+        }
+
+        // Lloyd 반복
+        std::vector<int> counts(clusters);
+        std::vector<float> rowDistance(rows);
+        for (int it = 0; it < iterations; it++) {
+            bool changed = false;
+            for (int r = 0; r < rows; r++) {
+                int best = 0;
+                float bestDistance = distance(r, 0);
+                for (int c = 1; c < clusters; c++) {
+                    float d = distance(r, c);
+                    if (d < bestDistance) {
+                        bestDistance = d;
+                        best = c;
+                    }
+                }
+                changed |= assignment[r] != best;
+                assignment[r] = best;
+                rowDistance[r] = bestDistance;
+            }
+            if (!changed && it > 0) break;
+
+            std::fill(centroids.begin(), centroids.end(), 0.0f);
+            std::fill(counts.begin(), counts.end(), 0);
+            for (int r = 0; r < rows; r++) {
+                float* centroid = &centroids[static_cast<size_t>(assignment[r]) * dims];
+                for (int d = 0; d < dims; d++) centroid[d] += rowValue(r, d);
+                counts[assignment[r]]++;
+            }
+            for (int c = 0; c < clusters; c++) {
+                float* centroid = &centroids[static_cast<size_t>(c) * dims];
+                if (counts[c] == 0) {
+                    // 빈 군집은 중심에서 가장 먼 행으로 다시 시작
+                    int far = static_cast<int>(std::max_element(rowDistance.begin(), rowDistance.end()) -
+                                               rowDistance.begin());
+                    for (int d = 0; d < dims; d++) centroid[d] = rowValue(far, d);
+                    rowDistance[far] = 0.0f;
+                    continue;
+                }
+                for (int d = 0; d < dims; d++) centroid[d] /= counts[c];
+            }
+        }
+    }
+
+    // 군집 순서로 행 재배치 (같은 군집의 클래스가 연속 행 구간이 되어 GEMV 한 번으로 계산)
+    std::vector<int> rowsByCluster(rows);
+    for (int r = 0; r < rows; r++) rowsByCluster[r] = r;
+    std::stable_sort(rowsByCluster.begin(), rowsByCluster.end(),
+                     [&](int a, int b) { return assignment[a] < assignment[b]; });
+
+    std::vector<float> sortedWeights(static_cast<size_t>(rows) * hidden);
+    std::vector<float> sortedBias(rows);
+    std::vector<int> sortedLabels(rows);
+    clusterStart.assign(clusters + 1, 0);
+    for (int i = 0; i < rows; i++) {
+        int r = rowsByCluster[i];
+        std::memcpy(&sortedWeights[static_cast<size_t>(i) * hidden], &weights[static_cast<size_t>(r) * hidden],
+                    hidden * sizeof(float));
+        sortedBias[i] = bias[r];
+        sortedLabels[i] = rowLabel[r];
+        clusterStart[assignment[r] + 1]++;
+    }
+    for (int c = 0; c < clusters; c++) clusterStart[c + 1] += clusterStart[c];
+
+    classLayer = DenseLayer();
+    classLayer.pack(sortedWeights.data(), sortedBias.data(), rows, hidden);
+    classLayer.setPrecision(precision);
+    rowLabel = std::move(sortedLabels);
+
+    clusterLayer = DenseLayer();
+    if (clusters > 1) {
+        std::vector<float> centroidWeights(static_cast<size_t>(clusters) * hidden);
+        std::vector<float> centroidBias(clusters);
+        for (int c = 0; c < clusters; c++) {
+            std::memcpy(&centroidWeights[static_cast<size_t>(c) * hidden], &centroids[static_cast<size_t>(c) * dims],
+                        hidden * sizeof(float));
+            centroidBias[c] = centroids[static_cast<size_t>(c) * dims + hidden];
+        }
+        clusterLayer.pack(centroidWeights.data(), centroidBias.data(), clusters, hidden);
+        clusterLayer.setPrecision(precision);
+    }
+    probes = std::max(1, std::min(probeCount, clusters));
+}
+
+void OutputHead::loadInput(const float* hidden) {
+    const int size = classLayer.inDim;
+    input.assign(classLayer.stride, 0.0f);
+    std::memcpy(input.data(), hidden, size * sizeof(float));
+    logits.resize(padToSimd(std::max(classLayer.outDim, std::max(clusterLayer.outDim, 1))));
+}
+
+int OutputHead::topK(const float* hidden, int k, HeadCandidate* out) {
+    const int rows = classLayer.outDim;
+    if (rows == 0 || hidden == nullptr || k <= 0) return 0;
+    loadInput(hidden);
+
+    const float* scores = logits.data();
+    int count = rows;
+    if (clusterCount() <= 1) {
+        classLayer.forward(input.data(), logits.data(), false);
+        evaluated = rows;
+    } else {
+        // 1단계: 군집 중심 점수 상위 probes개
+        candidateLogits.resize(padToSimd(clusterLayer.outDim));
+        clusterLayer.forward(input.data(), candidateLogits.data(), false);
+        order.resize(probes);
+        int picked = selectTopK(candidateLogits.data(), clusterLayer.outDim, probes, order.data());
+
+        // 2단계: 선택한 군집의 행 구간만 GEMV
+        candidateRows.clear();
+        candidateLogits.clear();
+        for (int i = 0; i < picked; i++) {
+            int begin = clusterStart[order[i]];
+            int end = clusterStart[order[i] + 1];
+            if (begin == end) continue;
+            classLayer.forwardRows(input.data(), logits.data(), false, begin, end);
+            for (int r = begin; r < end; r++) candidateRows.push_back(r);
+            candidateLogits.insert(candidateLogits.end(), logits.begin() + begin, logits.begin() + end);
+        }
+        scores = candidateLogits.data();
+        count = static_cast<int>(candidateRows.size());
+        evaluated = count;
+    }
+
+    const float norm = logSumExp(scores, count);
+    order.resize(std::min(k, count));
+    int found = selectTopK(scores, count, k, order.data());
+    for (int i = 0; i < found; i++) {
+        int index = order[i];
+        int row = clusterCount() <= 1 ? index : candidateRows[index];
+        out[i].label = rowLabel[row];
+        out[i].logit = scores[index];
+        out[i].probability = std::exp(scores[index] - norm);
+    }
+    return found;
+}
+
+void OutputHead::softmax(const float* hidden, float* probabilities) {
+    const int rows = classLayer.outDim;
+    if (rows == 0 || hidden == nullptr) return;
+    loadInput(hidden);
+    classLayer.forward(input.data(), logits.data(), false);
+    evaluated = rows;
+
+    // 최댓값 → exp/합 (한 번에) → 역수 곱, 재배치된 행은 원래 클래스 위치로
+    float m = maxOf(logits.data(), rows);
+    float inv = 1.0f / expShiftSum(logits.data(), rows, m, logits.data());
+    for (int r = 0; r < rows; r++) probabilities[rowLabel[r]] = logits[r] * inv;
+}
+
+std::string OutputHead::topKJson(const float* hidden, int k) {
+    std::vector<HeadCandidate> candidates(std::max(k, 0));
+    int found = topK(hidden, k, candidates.data());
+
+    std::string json = "{\"candidates\":[";
+    char buffer[96];
+    for (int i = 0; i < found; i++) {
+        std::snprintf(buffer, sizeof(buffer), "%s{\"label\":%d,\"probability\":%g}", i > 0 ? "," : "",
+                      candidates[i].label, static_cast<double>(candidates[i].probability));
+        json += buffer;
+    }
+    std::snprintf(buffer, sizeof(buffer), "],\"evaluated\":%d}", evaluated);
+    json += buffer;
+    return json;
+}
@@ -0,0 +1,80 @@
+#ifndef OUTPUT_HEAD_H
+#define OUTPUT_HEAD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mlp_model.h"
+
+// 상위 후보 하나
+struct HeadCandidate {
+    int label = -1;
+    float logit = 0.0f;
+    float probability = 0.0f;
+};
+
+// log Σ exp(logits): 최댓값 빼기/exp/합을 AVX로 한 번에 (exp는 다항식 근사, 상대 오차 약 1e-7)
+float logSumExp(const float* logits, int count);
+
+// Σ exp(x − shift), out이 있으면 exp(x − shift)도 기록 (out = x 제자리 가능)
+// shift에 최댓값을 넘기면 softmax의 최댓값 빼기/exp/합을 한 번에 처리합니다.
+float expShiftSum(const float* x, int count, float shift, float* out);
+
+// 값이 큰 순서로 k개의 인덱스를 indices에 기록하고 개수 반환 (부분 정렬)
+// 현재 k번째 값보다 큰 원소가 없는 8개 묶음은 비교 한 번으로 건너뜁니다.
+int selectTopK(const float* values, int count, int k, int* indices);
+
+// 큰 어휘(수천 클래스)용 출력층
+// 평면 모드: 은닉 벡터 → 전 클래스 GEMV → 융합 softmax 정규화 → 부분 정렬 상위 k
+// 군집 모드: 클래스 가중치 행을 k-평균으로 군집화해 군집끼리 연속 배치하고,
+//   군집 중심(평균 가중치/바이어스 = 군집 평균 logit) 점수가 높은 probes개 군집의 클래스만 계산합니다.
+//   확률은 계산한 후보들 안에서 정규화되며, 상위 후보에 확률 질량이 몰린 경우 평면 결과와 거의 같습니다.
+// 작업 버퍼를 객체에 두므로 한 객체는 한 스레드에서 사용합니다.
+class OutputHead {
+public:
+    OutputHead();
+
+    // 행 우선 [classes][hidden] 가중치와 바이어스 (군집 설정 초기화)
+    bool setWeights(const float* rowMajor, const float* bias, int classes, int hidden);
+
+    // NPZ의 w1/b1 한 층 로드, '<f2'/'<u2' 가중치는 16비트 그대로 사용
+    bool loadFromNpzBuffer(const uint8_t* data, size_t size, std::string& error);
+
+    // clusters개 군집으로 나누고 추론 시 probes개 군집만 평가 (clusters ≤ 1이면 평면 모드)
+    void buildClusters(int clusters, int probes, int iterations = 10);
+
+    // 16비트 가중치 저장 (GEMV 메모리 대역폭 절반)
+    void setWeightPrecision(WeightPrecision precision);
+
+    // hidden: hiddenSize()개 float, out에 확률 내림차순 최대 k개 기록, 개수 반환
+    int topK(const float* hidden, int k, HeadCandidate* out);
+
+    // 전 클래스 softmax (평면 GEMV 후 융합 정규화, 군집 설정과 무관)
+    void softmax(const float* hidden, float* probabilities);
+
+    // {"candidates":[{"label":12,"probability":0.83},...],"evaluated":240}
+    std::string topKJson(const float* hidden, int k);
+
+    int classes() const { return classLayer.outDim; }
+    int hiddenSize() const { return classLayer.inDim; }
+    int clusterCount() const { return static_cast<int>(clusterStart.size()) - 1; }
+    int lastEvaluated() const { return evaluated; }
+
+private:
+    void loadInput(const float* hidden);
+
+    DenseLayer classLayer;          // 군집 모드에서는 군집 순서로 재배치된 행
+    DenseLayer clusterLayer;        // 군집 중심 (군집 모드 전용)
+    std::vector<int> rowLabel;      // 재배치된 행 → 원래 클래스 번호
+    std::vector<int> clusterStart;  // 군집 c의 행 구간 [clusterStart[c], clusterStart[c + 1])
+    int probes;
+    int evaluated;
+
+    AlignedFloatVector input;       // 패딩된 은닉 벡터
+    std::vector<float> logits;
+    std::vector<float> candidateLogits;
+    std::vector<int> candidateRows;
+    std::vector<int> order;
+};
+
+#endif // OUTPUT_HEAD_H
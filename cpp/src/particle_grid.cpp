@@ -0,0 +1,52 @@
+#include "particle_grid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 셀 좌표 범위 (해시 곱이 넘쳐도 되지만 float → int 변환은 범위 안이어야 함)
+constexpr float CELL_LIMIT = 1e9f;
+
+inline int32_t cellCoordinate(float value, float inverseCell) {
+    float cell = std::floor(value * inverseCell);
+    // NaN은 두 비교가 모두 거짓이라 0 칸으로
+    if (!(cell > -CELL_LIMIT)) cell = cell < 0.0f ? -CELL_LIMIT : 0.0f;
+    if (cell > CELL_LIMIT) cell = CELL_LIMIT;
+    return static_cast<int32_t>(cell);
+}
+
+} // namespace
+
+ParticleGrid::ParticleGrid() : bucketMask(0), count(0) {
+    bucketStart.assign(2, 0);
+}
+
+uint32_t ParticleGrid::bucketOf(int32_t cx, int32_t cy, int32_t cz) const {
+    uint32_t hash = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u ^
+                    static_cast<uint32_t>(cz) * 83492791u;
+    return hash & bucketMask;
+}
+
+void ParticleGrid::build(const float* positions, int particleCount, float cellSize) {
+    count = std::max(0, particleCount);
+    uint32_t bucketCount = 1;
+    while (bucketCount < static_cast<uint32_t>(2 * count) && bucketCount < (1u << 30)) bucketCount <<= 1;
+    bucketMask = bucketCount - 1;
+
+    cells.resize(static_cast<size_t>(count) * 3);
+    buckets.resize(count);
+    sorted.resize(count);
+    bucketStart.assign(bucketCount + 1, 0);
+
+    const float inverseCell = cellSize > 0.0f ? 1.0f / cellSize : 1.0f;
+    for (int i = 0; i < count; i++) {
+        for (int k = 0; k < 3; k++) cells[i * 3 + k] = cellCoordinate(positions[i * 3 + k], inverseCell);
+        buckets[i] = bucketOf(cells[i * 3], cells[i * 3 + 1], cells[i * 3 + 2]);
+        bucketStart[buckets[i] + 1]++;
+    }
+
+    // 계수 정렬: 누적 합으로 시작 위치를 만들고 파티클 번호 순서를 유지하며 채움
+    for (uint32_t b = 0; b < bucketCount; b++) bucketStart[b + 1] += bucketStart[b];
+    cursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (int i = 0; i < count; i++) sorted[cursor[buckets[i]]++] = i;
+}
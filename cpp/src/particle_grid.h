@@ -0,0 +1,60 @@
+#ifndef PARTICLE_GRID_H
+#define PARTICLE_GRID_H
+
+#include <cstdint>
+#include <vector>
+
+// 파티클 간 상호작용용 균일 격자 (넓은 단계)
+// 셀 크기를 상호작용 반경으로 두면 거리가 반경 미만인 쌍은 항상 같은 셀이나 이웃 26칸에 있으므로,
+// 파티클마다 그 27칸만 훑어 고르게 퍼진 경우 O(N²) 쌍 검사를 O(N)으로 줄입니다.
+// 셀 좌표는 2의 거듭제곱 크기(파티클 수의 2배 이상) 해시 표에 계수 정렬로 넣으므로
+// 파티클이 넓게 흩어져도 메모리는 O(N)이고, 해시 충돌로 섞인 다른 셀의 파티클은 셀 좌표 비교로 걸러냅니다.
+// 작업 버퍼를 객체에 두므로 한 객체는 한 스레드에서 사용합니다.
+class ParticleGrid {
+public:
+    ParticleGrid();
+
+    // positions: count × 3 float, cellSize > 0 (상호작용 반경)
+    void build(const float* positions, int count, float cellSize);
+
+    // 같은 셀이나 이웃 셀에 있는 쌍 (i < j)마다 visit(i, j)를 정확히 한 번 호출
+    // (거리 판정은 visit에서, i 오름차순)
+    template <typename Visit>
+    void forEachPair(Visit&& visit) const;
+
+    int size() const { return count; }
+
+private:
+    uint32_t bucketOf(int32_t cx, int32_t cy, int32_t cz) const;
+
+    std::vector<int32_t> cells;        // count × 3 셀 좌표
+    std::vector<uint32_t> buckets;     // 파티클별 해시 버킷
+    std::vector<int> bucketStart;      // 버킷별 sorted 시작 위치 (bucketCount + 1)
+    std::vector<int> sorted;           // 버킷 순으로 정렬한 파티클 번호
+    std::vector<int> cursor;           // 계수 정렬 채움 위치
+    uint32_t bucketMask;
+    int count;
+};
+
+template <typename Visit>
+void ParticleGrid::forEachPair(Visit&& visit) const {
+    for (int i = 0; i < count; i++) {
+        const int32_t cx = cells[i * 3], cy = cells[i * 3 + 1], cz = cells[i * 3 + 2];
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    const int32_t nx = cx + dx, ny = cy + dy, nz = cz + dz;
+                    const uint32_t bucket = bucketOf(nx, ny, nz);
+                    for (int s = bucketStart[bucket]; s < bucketStart[bucket + 1]; s++) {
+                        const int j = sorted[s];
+                        // 같은 버킷의 다른 셀(해시 충돌)은 건너뜀 → 쌍마다 정확히 한 이웃 칸에서만 만남
+                        if (j <= i || cells[j * 3] != nx || cells[j * 3 + 1] != ny || cells[j * 3 + 2] != nz) continue;
+                        visit(i, j);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif // PARTICLE_GRID_H
@@ -0,0 +1,84 @@
+#ifndef RCU_SLOT_H
+#define RCU_SLOT_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "threading.h"
+
+// RCU 방식 포인터 슬롯
+// - 읽기(프레임 경로): 전역 락 없이 원자 연산 2~3회로 현재 객체를 고정합니다.
+// - 쓰기(모델 교체): 새 객체를 원자적으로 게시하고 에포크를 넘긴 뒤,
+//   이전 에포크의 읽기가 모두 끝나면 이전 객체를 해제합니다.
+//   처리 중인 프레임은 이전 모델로 끝나고 새 프레임은 새 모델을 사용합니다.
+// publish()는 이전 읽기를 기다리므로 프레임 스레드가 아닌 곳(백그라운드 로더)에서 호출합니다.
+template <typename T>
+class RcuSlot {
+public:
+    // 읽기 구간 동안 객체를 고정하는 가드
+    class ReadGuard {
+    public:
+        ReadGuard(const RcuSlot& slot) : counter(nullptr), object(nullptr) {
+            for (;;) {
+                unsigned e = slot.epoch.load();
+                counter = &slot.readers[e & 1].count;
+                counter->fetch_add(1);
+                // 증가 전에 에포크가 넘어갔다면 해당 쓰기가 이 카운터를 기다리지 않으므로 재시도
+                if (slot.epoch.load() == e) break;
+                counter->fetch_sub(1);
+            }
+            object = slot.current.load();
+        }
+        ~ReadGuard() { counter->fetch_sub(1, std::memory_order_release); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const T* get() const { return object; }
+        const T* operator->() const { return object; }
+        const T& operator*() const { return *object; }
+
+    private:
+        std::atomic<int>* counter;
+        const T* object;
+    };
+
+    explicit RcuSlot(T* initial) : current(initial), epoch(0) {}
+    ~RcuSlot() { delete current.load(); }
+
+    RcuSlot(const RcuSlot&) = delete;
+    RcuSlot& operator=(const RcuSlot&) = delete;
+
+    ReadGuard read() const { return ReadGuard(*this); }
+
+    // 새 객체를 게시하고 이전 객체의 읽기가 끝나면 해제
+    void publish(T* next) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+
+        T* old = current.exchange(next);
+        unsigned e = epoch.load();
+        epoch.store(e + 1);
+
+        // 이전 에포크에서 시작한 읽기(이전 객체를 볼 수 있는 유일한 읽기)가 빠질 때까지 대기
+        std::atomic<int>& oldReaders = readers[e & 1].count;
+        while (oldReaders.load(std::memory_order_acquire) != 0) {
+#if SIGN_HAS_THREADS
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+        }
+        delete old;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) ReaderCount {
+        std::atomic<int> count{0};
+    };
+
+    std::atomic<T*> current;
+    std::atomic<unsigned> epoch;
+    mutable ReaderCount readers[2];
+    std::mutex writerMutex;
+};
+
+#endif // RCU_SLOT_H
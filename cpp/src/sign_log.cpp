@@ -0,0 +1,59 @@
+#include "sign_log.h"
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+
+// 한 줄 로그 최대 길이 (넘으면 잘림)
+constexpr int LOG_LINE_SIZE = 512;
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info: return "INFO";
+    case LogLevel::Warn: return "WARN";
+    default: return "ERROR";
+    }
+}
+
+// 기본 싱크: stderr (Emscripten에서는 console.error로 전달)
+void stderrSink(LogLevel level, const char* message, void*) {
+    std::fprintf(stderr, "[sign_wasm %s] %s\n", levelName(level), message);
+}
+
+struct SinkState {
+    SignLogSink sink;
+    void* userData;
+};
+
+std::atomic<const SinkState*> currentSink{nullptr};
+std::atomic<int> minLevel{static_cast<int>(LogLevel::Debug)};
+
+} // namespace
+
+void setLogSink(SignLogSink sink, void* userData) {
+    // 교체된 이전 상태는 다른 스레드가 읽고 있을 수 있으므로 해제하지 않음 (싱크 교체는 드묾)
+    currentSink.store(sink != nullptr ? new SinkState{sink, userData} : nullptr);
+}
+
+void setLogLevel(LogLevel level) {
+    minLevel.store(static_cast<int>(level));
+}
+
+void signLogWrite(LogLevel level, const char* format, ...) {
+    if (static_cast<int>(level) < minLevel.load(std::memory_order_relaxed)) return;
+
+    char message[LOG_LINE_SIZE];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    const SinkState* state = currentSink.load(std::memory_order_acquire);
+    if (state != nullptr) {
+        state->sink(level, message, state->userData);
+    } else {
+        stderrSink(level, message, nullptr);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef SIGN_LOG_H
+#define SIGN_LOG_H
+
+// 로그 레벨
+enum class LogLevel {
+    Debug = 0,
+    Info = 1,
+    Warn = 2,
+    Error = 3
+};
+
+// 사용자 로그 싱크: 포맷된 한 줄 메시지를 받습니다.
+typedef void (*SignLogSink)(LogLevel level, const char* message, void* userData);
+
+// 싱크 교체 (nullptr이면 stderr 기본 싱크)
+void setLogSink(SignLogSink sink, void* userData);
+
+// 이 레벨 미만의 로그는 버림 (기본: Debug)
+void setLogLevel(LogLevel level);
+
+// printf 형식 로그 출력 (매크로를 통해 사용)
+void signLogWrite(LogLevel level, const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+// 릴리스 빌드(NDEBUG)에서는 로그 호출과 인자 평가가 모두 사라집니다.
+// 릴리스에서도 로그가 필요하면 -DSIGN_LOG_ENABLED=1로 빌드합니다.
+#ifndef SIGN_LOG_ENABLED
+#ifdef NDEBUG
+#define SIGN_LOG_ENABLED 0
+#else
+#define SIGN_LOG_ENABLED 1
+#endif
+#endif
+
+#if SIGN_LOG_ENABLED
+#define SIGN_LOG_DEBUG(...) signLogWrite(LogLevel::Debug, __VA_ARGS__)
+#define SIGN_LOG_INFO(...) signLogWrite(LogLevel::Info, __VA_ARGS__)
+#define SIGN_LOG_WARN(...) signLogWrite(LogLevel::Warn, __VA_ARGS__)
+#define SIGN_LOG_ERROR(...) signLogWrite(LogLevel::Error, __VA_ARGS__)
+#else
+#define SIGN_LOG_DEBUG(...) ((void)0)
+#define SIGN_LOG_INFO(...) ((void)0)
+#define SIGN_LOG_WARN(...) ((void)0)
+#define SIGN_LOG_ERROR(...) ((void)0)
+#endif
+
+#endif // SIGN_LOG_H
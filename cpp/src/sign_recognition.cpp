@@ -1,19 +1,47 @@
 #include "sign_recognition.h"
 #include <cmath>
 #include <algorithm>
-#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <numeric>
+#include <immintrin.h>
 #include "gesture_weights.h"
+#include "low_rank.h"
+#include "metrics.h"
+#include "sign_log.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+
+// 이미지 필터를 풀에서 나눠 처리할 때 조각 하나의 행 수
+constexpr int IMAGE_BAND_ROWS = 16;
+
+// 인식 결과를 JSON 객체로 추가 (iostream 없이 snprintf로 포맷)
+void appendResultJson(std::string& json, const RecognitionResult& result) {
+    char number[64];
+    json += "{\"gesture\":\"";
+    json += result.gesture;
+    std::snprintf(number, sizeof(number), "\",\"confidence\":%g,\"id\":%d}", result.confidence, result.id);
+    json += number;
+}
+
+// 가상 신경망 Layer 1 크기 (쌍별 거리 210개 → 128)
+constexpr int NEURAL_INPUTS = 210;
+constexpr int NEURAL_HIDDEN = 128;
+
+} // namespace
+
 // 정적 멤버 변수 초기화
 std::vector<std::vector<float>> SignRecognizer::neuralWeights;
 std::vector<float> SignRecognizer::neuralBiases;
+std::vector<float> SignRecognizer::neuralLayer1ColumnSums;
 
 SignRecognizer::SignRecognizer() 
-    : detectionThreshold(0.5f), recognitionThreshold(0.7f) {
+    : advancedPrecision(WeightPrecision::F32), advancedSparsity(0.0f), intraOpThreads(1),
+      detectionThreshold(0.5f), recognitionThreshold(0.7f) {
 }
 
 SignRecognizer::~SignRecognizer() {
@@ -21,7 +49,7 @@ SignRecognizer::~SignRecognizer() {
 
 bool SignRecognizer::initialize() {
     // 가상 신경망 가중치 초기화 (JavaScript와 완전히 동일한 고정값 사용)
-    std::cout << "🔧 C++ 가중치 생성 (고정값)" << std::endl;
+    SIGN_LOG_INFO("🔧 C++ 가중치 생성 (고정값)");
     
     const float fixedValue = 0.05f; // JavaScript와 동일한 고정값
     const float fixedBias = 0.01f;  // JavaScript와 동일한 바이어스
@@ -42,6 +70,12 @@ bool SignRecognizer::initialize() {
     
     // Layer 4: 32 -> 5
     neuralWeights.emplace_back(32 * 5, fixedValue);
+
+    // Layer 1 출력별 가중치 합 (융합 경로에서 특징 평균을 마지막에 한 번에 빼는 데 사용)
+    neuralLayer1ColumnSums.assign(NEURAL_HIDDEN, 0.0f);
+    for (int j = 0; j < NEURAL_INPUTS; j++) {
+        for (int i = 0; i < NEURAL_HIDDEN; i++) neuralLayer1ColumnSums[i] += neuralWeights[0][j * NEURAL_HIDDEN + i];
+    }
     
     return true;
 }
@@ -151,8 +185,10 @@ RecognitionResult SignRecognizer::recognizeByRules(const std::vector<HandLandmar
 
 RecognitionResult SignRecognizer::recognize(const std::vector<HandLandmark>& landmarks) {
     if (landmarks.size() != 21) {
+        Metrics::add(Metric::DroppedFrames);
         return {"감지되지 않음", 0.0f, 0};
     }
+    Metrics::add(Metric::FramesProcessed);
     
     // 고급 ML 스타일 인식 사용 (더 복잡한 계산)
     RecognitionResult mlResult = recognizeWithAdvancedML(landmarks);
@@ -175,11 +211,10 @@ RecognitionResult SignRecognizer::recognize(const std::vector<HandLandmark>& lan
 
 // 고급 ML 스타일 인식 구현
 RecognitionResult SignRecognizer::recognizeWithAdvancedML(const std::vector<HandLandmark>& landmarks) {
-    // 1. 복잡한 특징 추출
-    std::vector<float> features = extractComplexFeatures(landmarks);
-    
-    // 2. 신경망 추론
-    std::vector<float> outputs = neuralNetworkInference(features);
+    // 1~2. 특징 추출과 Layer 1을 합쳐 계산한 뒤 나머지 레이어 추론
+    alignas(32) float hidden[NEURAL_HIDDEN];
+    std::vector<float> outputs = fusedFeatureLayer1(landmarks, hidden) ? neuralNetworkTail(hidden)
+                                                                       : std::vector<float>(5, 0.0f);
     
     // 3. 결과 해석
     if (outputs.size() < 5) {
@@ -281,13 +316,82 @@ std::vector<float> SignRecognizer::extractComplexFeatures(const std::vector<Hand
     return features;
 }
 
-// 가상 신경망 추론
+// 특징 추출 + Layer 1 융합
+// 특징 f_j를 계산하는 즉시 누산기 acc(128개, L1에 머무는 32바이트 정렬 타일)에 f_j × W1[j]를 더하고,
+// 평균/분산은 Welford로 같은 순서에서 갱신합니다. 표준화 (f − μ) / σ는 선형이므로
+// Σ_j W1[j][i] (f_j − μ) / σ = (acc_i − μ · Σ_j W1[j][i]) / σ 로 마지막에 한 번 보정합니다.
+// extractComplexFeatures → neuralNetworkInference의 Layer 1과 같은 값 (앞 210개 특징이 입력, 통계는 전체 256개)
+bool SignRecognizer::fusedFeatureLayer1(const std::vector<HandLandmark>& landmarks, float* hidden) {
+    if (neuralWeights.empty() || landmarks.size() != 21) return false;
+
+    alignas(32) float acc[NEURAL_HIDDEN];
+    for (int i = 0; i < NEURAL_HIDDEN; i += 8) _mm256_store_ps(acc + i, _mm256_setzero_ps());
+
+    const float* w1 = neuralWeights[0].data();
+    int index = 0;
+    float count = 0.0f, runningMean = 0.0f, m2 = 0.0f;
+    auto emit = [&](float feature) {
+        count += 1.0f;
+        float delta = feature - runningMean;
+        runningMean += delta / count;
+        m2 += delta * (feature - runningMean);
+
+        if (index < NEURAL_INPUTS) {
+            const float* row = w1 + static_cast<size_t>(index) * NEURAL_HIDDEN;
+            __m256 f = _mm256_set1_ps(feature);
+            for (int i = 0; i < NEURAL_HIDDEN; i += 8) {
+                _mm256_store_ps(acc + i, _mm256_add_ps(_mm256_load_ps(acc + i),
+                                                       _mm256_mul_ps(f, _mm256_loadu_ps(row + i))));
+            }
+        }
+        index++;
+    };
+
+    // extractComplexFeatures와 같은 순서
+    for (int i = 0; i < 21; i++) {
+        for (int j = i + 1; j < 21; j++) emit(calculateDistance(landmarks[i], landmarks[j]));
+    }
+    const HandLandmark& wrist = landmarks[0];
+    for (int i = 1; i < 21; i++) emit(calculateDistance(landmarks[i], wrist));
+
+    static const int fingerTips[5] = {4, 8, 12, 16, 20};
+    static const int fingerPips[5] = {3, 6, 10, 14, 18};
+    static const int fingerMcps[5] = {2, 5, 9, 13, 17};
+    for (int i = 0; i < 5; i++) {
+        emit(calculateAngle(landmarks[fingerTips[i]], landmarks[fingerPips[i]], landmarks[fingerMcps[i]]));
+    }
+
+    float palmX = 0, palmY = 0;
+    for (int i = 0; i < 5; i++) {
+        palmX += landmarks[i].x;
+        palmY += landmarks[i].y;
+    }
+    emit(palmX / 5);
+    emit(palmY / 5);
+
+    for (int i = 1; i < 20; i++) emit(calculateAngle(landmarks[i - 1], landmarks[i], landmarks[i + 1]));
+
+    // 표준화 보정 + 바이어스 + ReLU
+    float stddev = std::sqrt(m2 / count);
+    bool standardize = stddev > 1e-6f;
+    __m256 shift = _mm256_set1_ps(standardize ? runningMean : 0.0f);
+    __m256 inv = _mm256_set1_ps(standardize ? 1.0f / stddev : 1.0f);
+    for (int i = 0; i < NEURAL_HIDDEN; i += 8) {
+        __m256 centered = _mm256_sub_ps(_mm256_load_ps(acc + i),
+                                        _mm256_mul_ps(shift, _mm256_loadu_ps(&neuralLayer1ColumnSums[i])));
+        __m256 sum = _mm256_add_ps(_mm256_mul_ps(centered, inv), _mm256_loadu_ps(&neuralBiases[i]));
+        _mm256_store_ps(hidden + i, _mm256_max_ps(sum, _mm256_setzero_ps()));
+    }
+    return true;
+}
+
+// 가상 신경망 추론 (특징 벡터를 받는 비융합 경로, 앞 210개 특징이 Layer 1 입력)
 std::vector<float> SignRecognizer::neuralNetworkInference(const std::vector<float>& features) {
-    if (neuralWeights.empty() || features.size() != 210) {
+    if (neuralWeights.empty() || features.size() < NEURAL_INPUTS) {
         return std::vector<float>(5, 0.0f);
     }
     
-    std::vector<float> layer1(128), layer2(64), layer3(32), output(5);
+    std::vector<float> layer1(128);
     
     // Layer 1: 210 -> 128 (SIMD 최적화)
     for (int i = 0; i < 128; i++) {
@@ -300,13 +404,20 @@ std::vector<float> SignRecognizer::neuralNetworkInference(const std::vector<floa
         layer1[i] = std::max(0.0f, sum); // ReLU
     }
     
+    return neuralNetworkTail(layer1.data());
+}
+
+// Layer 2~4
+std::vector<float> SignRecognizer::neuralNetworkTail(const float* layer1) {
+    std::vector<float> layer2(64), layer3(32), output(5);
+    
     // Layer 2: 128 -> 64 (SIMD 최적화)
     for (int i = 0; i < 64; i++) {
         std::vector<float> weights_col(128);
         for (int j = 0; j < 128; j++) {
             weights_col[j] = neuralWeights[1][j * 64 + i];
         }
-        float sum = vectorDotProduct(layer1.data(), weights_col.data(), 128);
+        float sum = vectorDotProduct(layer1, weights_col.data(), 128);
         layer2[i] = std::max(0.0f, sum); // ReLU
     }
     
@@ -340,15 +451,15 @@ float SignRecognizer::vectorDotProduct(const float* a, const float* b, int size)
     // SIMD 연산 (8개씩 처리)
     __m256 sum_vec = _mm256_setzero_ps();
     for (int i = 0; i < simd_size; i += 8) {
-        __m256 a_vec = _mm256_load_ps(&a[i]);
-        __m256 b_vec = _mm256_load_ps(&b[i]);
+        __m256 a_vec = _mm256_loadu_ps(&a[i]);
+        __m256 b_vec = _mm256_loadu_ps(&b[i]);
         __m256 mul_vec = _mm256_mul_ps(a_vec, b_vec);
         sum_vec = _mm256_add_ps(sum_vec, mul_vec);
     }
     
-    // 결과 합산
+    // 결과 합산 (호출자의 std::vector 버퍼는 32바이트 정렬이 보장되지 않음)
     float temp[8];
-    _mm256_store_ps(temp, sum_vec);
+    _mm256_storeu_ps(temp, sum_vec);
     for (int i = 0; i < 8; i++) {
         result += temp[i];
     }
@@ -436,6 +547,7 @@ void SignRecognizer::fastConvolution(const std::vector<float>& input,
 
 std::string SignRecognizer::recognizeFromPointer(float* landmarks, int count) {
     if (count != 42) { // 21 landmarks * 2 (x, y)
+        Metrics::add(Metric::DroppedFrames);
         return "{\"gesture\":\"감지되지 않음\",\"confidence\":0.0,\"id\":0}";
     }
     
@@ -454,12 +566,11 @@ std::string SignRecognizer::recognizeFromPointer(float* landmarks, int count) {
     RecognitionResult result = recognize(landmarkVec);
     
     // JSON 형식으로 반환
-    std::ostringstream json;
-    json << "{\"gesture\":\"" << result.gesture 
-         << "\",\"confidence\":" << result.confidence 
-         << ",\"id\":" << result.id << "}";
+    std::string json;
+    json.reserve(64);
+    appendResultJson(json, result);
     
-    return json.str();
+    return json;
 }
 
 void SignRecognizer::setDetectionThreshold(float threshold) {
@@ -477,11 +588,13 @@ std::string SignRecognizer::getVersion() const {
 // 배치 처리 구현 (진정한 WASM 성능을 위해)
 std::string SignRecognizer::recognizeBatch(float* landmarks, int frameCount, int landmarksPerFrame) {
     if (landmarksPerFrame != 42) { // 21 landmarks * 2 (x, y)
+        Metrics::add(Metric::DroppedFrames, std::max(frameCount, 0));
         return "{\"error\":\"Invalid landmarks per frame\",\"results\":[]}";
     }
     
-    std::ostringstream json;
-    json << "{\"results\":[";
+    std::string json;
+    json.reserve(16 + static_cast<size_t>(frameCount) * 64);
+    json += "{\"results\":[";
     
     // 배치로 모든 프레임 처리
     for (int frame = 0; frame < frameCount; frame++) {
@@ -503,14 +616,12 @@ std::string SignRecognizer::recognizeBatch(float* landmarks, int frameCount, int
         RecognitionResult result = recognize(landmarkVec);
         
         // JSON 배열에 추가
-        if (frame > 0) json << ",";
-        json << "{\"gesture\":\"" << result.gesture 
-             << "\",\"confidence\":" << result.confidence 
-             << ",\"id\":" << result.id << "}";
+        if (frame > 0) json += ",";
+        appendResultJson(json, result);
     }
     
-    json << "],\"frameCount\":" << frameCount << "}";
-    return json.str();
+    json += "],\"frameCount\":" + std::to_string(frameCount) + "}";
+    return json;
 }
 
 // === WASM이 빛나는 영역들 구현 ===
@@ -530,61 +641,104 @@ void SignRecognizer::processImageData(uint8_t* imageData, int width, int height,
         
         std::vector<uint8_t> temp(width * height * 4);
         
-        // 가우시안 블러 적용 (RGBA 채널별로)
-        for (int y = 2; y < height - 2; y++) {
-            for (int x = 2; x < width - 2; x++) {
-                for (int channel = 0; channel < 4; channel++) {
-                    float sum = 0;
+        // 가우시안 블러 적용 (RGBA 채널별로), 행 띠 단위로 풀에서 나눠 처리
+        auto blurRows = [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; y++) {
+                for (int x = 2; x < width - 2; x++) {
+                    for (int channel = 0; channel < 4; channel++) {
+                        float sum = 0;
                     
-                    for (int ky = 0; ky < kernelSize; ky++) {
-                        for (int kx = 0; kx < kernelSize; kx++) {
-                            int pixelY = y + ky - 2;
-                            int pixelX = x + kx - 2;
-                            int pixelIndex = (pixelY * width + pixelX) * 4 + channel;
-                            sum += imageData[pixelIndex] * kernel[ky * kernelSize + kx];
+                        for (int ky = 0; ky < kernelSize; ky++) {
+                            for (int kx = 0; kx < kernelSize; kx++) {
+                                int pixelY = y + ky - 2;
+                                int pixelX = x + kx - 2;
+                                int pixelIndex = (pixelY * width + pixelX) * 4 + channel;
+                                sum += imageData[pixelIndex] * kernel[ky * kernelSize + kx];
+                            }
                         }
-                    }
                     
-                    temp[(y * width + x) * 4 + channel] = (uint8_t)(sum / kernelSum);
+                        temp[(y * width + x) * 4 + channel] = (uint8_t)(sum / kernelSum);
+                    }
                 }
             }
+        };
+        if (intraOpPool) {
+            intraOpPool->parallelFor(2, height - 2, IMAGE_BAND_ROWS, blurRows, intraOpThreads);
+        } else {
+            blurRows(2, height - 2);
         }
         
         // 결과 복사
         std::memcpy(imageData, temp.data(), width * height * 4);
+    } else if (filterType == 1 || filterType == 2) { // CLAHE (2는 어두울 때만)
+        clahe.apply(imageData, width, height, filterType == 2, intraOpPool.get(), intraOpThreads);
     }
 }
 
+void SignRecognizer::setLowLightLuma(float meanLuma) {
+    clahe.setDarkMeanLuma(meanLuma);
+}
+
+// 1-1. HOG 특징
+int SignRecognizer::computeHog(const uint8_t* imageData, int width, int height, int x, int y, int cropWidth,
+                               int cropHeight, float* out) {
+    return hog.compute(imageData, width, height, x, y, cropWidth, cropHeight, out);
+}
+
+int SignRecognizer::getHogSize(int cropWidth, int cropHeight) const {
+    return hog.descriptorSize(cropWidth, cropHeight);
+}
+
+// 1-2. 랜드마크 정렬 영역
+bool SignRecognizer::alignHandCrop(const uint8_t* imageData, int width, int height, const float* landmarks, int count,
+                                   int size, uint8_t* out) {
+    return ::alignHandCrop(imageData, width, height, landmarks, count, size, out);
+}
+
+bool SignRecognizer::alignFaceCrop(const uint8_t* imageData, int width, int height, float leftEyeX, float leftEyeY,
+                                   float rightEyeX, float rightEyeY, int size, uint8_t* out) {
+    return ::alignFaceCrop(imageData, width, height, leftEyeX, leftEyeY, rightEyeX, rightEyeY, size, out);
+}
+
 // 2. 대용량 행렬 곱셈 (SIMD 최적화)
 void SignRecognizer::matrixMultiplyLarge(float* matA, float* matB, float* result, int size) {
     // 메모리 초기화
     std::memset(result, 0, size * size * sizeof(float));
     
     // 캐시 친화적 행렬 곱셈 (블록 단위)
+    // 행 블록끼리는 결과 행이 겹치지 않으므로 풀이 있으면 행 블록 단위로 나눠 실행
     const int BLOCK_SIZE = 64;
+    const int rowBlocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
     
-    for (int ii = 0; ii < size; ii += BLOCK_SIZE) {
-        for (int jj = 0; jj < size; jj += BLOCK_SIZE) {
-            for (int kk = 0; kk < size; kk += BLOCK_SIZE) {
+    auto multiplyRowBlocks = [&](int blockBegin, int blockEnd) {
+        for (int ii = blockBegin * BLOCK_SIZE; ii < std::min(blockEnd * BLOCK_SIZE, size); ii += BLOCK_SIZE) {
+            for (int jj = 0; jj < size; jj += BLOCK_SIZE) {
+                for (int kk = 0; kk < size; kk += BLOCK_SIZE) {
                 
-                int i_end = std::min(ii + BLOCK_SIZE, size);
-                int j_end = std::min(jj + BLOCK_SIZE, size);
-                int k_end = std::min(kk + BLOCK_SIZE, size);
+                    int i_end = std::min(ii + BLOCK_SIZE, size);
+                    int j_end = std::min(jj + BLOCK_SIZE, size);
+                    int k_end = std::min(kk + BLOCK_SIZE, size);
                 
-                for (int i = ii; i < i_end; i++) {
-                    for (int j = jj; j < j_end; j++) {
-                        float sum = 0.0f;
+                    for (int i = ii; i < i_end; i++) {
+                        for (int j = jj; j < j_end; j++) {
+                            float sum = 0.0f;
                         
-                        // SIMD 최적화 가능한 내부 루프
-                        for (int k = kk; k < k_end; k++) {
-                            sum += matA[i * size + k] * matB[k * size + j];
-                        }
+                            // SIMD 최적화 가능한 내부 루프
+                            for (int k = kk; k < k_end; k++) {
+                                sum += matA[i * size + k] * matB[k * size + j];
+                            }
                         
-                        result[i * size + j] += sum;
+                            result[i * size + j] += sum;
+                        }
                     }
                 }
             }
         }
+    };
+    if (intraOpPool) {
+        intraOpPool->parallelFor(0, rowBlocks, 1, multiplyRowBlocks, intraOpThreads);
+    } else {
+        multiplyRowBlocks(0, rowBlocks);
     }
 }
 
@@ -675,6 +829,7 @@ void SignRecognizer::sha256Hash(uint8_t* input, int length, uint8_t* output) {
 void SignRecognizer::simulateParticles(float* positions, float* velocities, int particleCount, float deltaTime) {
     const float gravity = -9.8f;
     const float damping = 0.99f;
+    const float interactionRadius = 1.0f;
     
     // 각 파티클 업데이트
     for (int i = 0; i < particleCount; i++) {
@@ -693,85 +848,409 @@ void SignRecognizer::simulateParticles(float* positions, float* velocities, int
             positions[idx + 1] = 0;
             velocities[idx + 1] = -velocities[idx + 1] * damping;
         }
-        
-        // 간단한 파티클 간 상호작용
-        for (int j = i + 1; j < particleCount; j++) {
-            int jdx = j * 3;
-            
-            float dx = positions[idx] - positions[jdx];
-            float dy = positions[idx + 1] - positions[jdx + 1];
-            float dz = positions[idx + 2] - positions[jdx + 2];
-            
-            float distance = std::sqrt(dx*dx + dy*dy + dz*dz);
-            
-            if (distance < 1.0f && distance > 0.001f) {
-                float force = 0.1f / distance;
-                
-                velocities[idx] += dx * force * deltaTime;
-                velocities[idx + 1] += dy * force * deltaTime;
-                velocities[idx + 2] += dz * force * deltaTime;
-                
-                velocities[jdx] -= dx * force * deltaTime;
-                velocities[jdx + 1] -= dy * force * deltaTime;
-                velocities[jdx + 2] -= dz * force * deltaTime;
-            }
-        }
     }
+
+    // 간단한 파티클 간 상호작용 (반경 1 안의 쌍만, 셀 크기 1 격자로 후보를 좁힘)
+    particleGrid.build(positions, particleCount, interactionRadius);
+    particleGrid.forEachPair([&](int i, int j) {
+        int idx = i * 3;
+        int jdx = j * 3;
+
+        float dx = positions[idx] - positions[jdx];
+        float dy = positions[idx + 1] - positions[jdx + 1];
+        float dz = positions[idx + 2] - positions[jdx + 2];
+
+        float distance = std::sqrt(dx*dx + dy*dy + dz*dz);
+
+        if (distance < interactionRadius && distance > 0.001f) {
+            float force = 0.1f / distance;
+
+            velocities[idx] += dx * force * deltaTime;
+            velocities[idx + 1] += dy * force * deltaTime;
+            velocities[idx + 2] += dz * force * deltaTime;
+
+            velocities[jdx] -= dx * force * deltaTime;
+            velocities[jdx + 1] -= dy * force * deltaTime;
+            velocities[jdx + 2] -= dz * force * deltaTime;
+        }
+    });
+
+    // 손 뼈대 충돌 (바닥과 같은 감쇠로 반사)
+    handCollider.collide(positions, velocities, particleCount, damping);
+}
+
+bool SignRecognizer::setParticleHand(const float* landmarks, int count, float radius) {
+    return handCollider.update(landmarks, count, radius);
+}
+
+void SignRecognizer::clearParticleHand() {
+    handCollider.clear();
 }
 
 // 생성자
-SignRecognition::SignRecognition() {
+SignRecognition::SignRecognition()
+    : model(createBuiltinModel()), batchThreads(1), modelGeneration(0), swapPending(false) {
     mean.resize(D_IN, 0.0f);
     scale.resize(D_IN, 1.0f);
+    Metrics::set(Metric::ModelBytes, static_cast<int64_t>(model.read()->byteSize()));
 }
 
 // 소멸자
-SignRecognition::~SignRecognition() {}
+SignRecognition::~SignRecognition() {
+    if (swapThread.joinable()) swapThread.join();
+}
+
+// 내장 가중치(gesture_weights.h)를 SIMD 레이아웃으로 패킹
+MlpModel* SignRecognition::createBuiltinModel() {
+    MlpModel* builtin = new MlpModel();
+    builtin->addLayer(W1, B1, H1, D_IN);
+    builtin->addLayer(W2, B2, H2, H1);
+    builtin->addLayer(W3, B3, NUM_CLASSES, H2);
+    return builtin;
+}
 
 // Scaler 설정 구현
+// 표준화는 모델의 입력 복사 단계에 합쳐지므로 새 scaler를 담은 복사본을 게시
 void SignRecognition::setScaler(const std::vector<float>& meanArr, const std::vector<float>& scaleArr) {
-    if (meanArr.size() == D_IN) mean = meanArr;
-    if (scaleArr.size() == D_IN) scale = scaleArr;
+    std::lock_guard<std::mutex> writer(writerMutex);
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (meanArr.size() == D_IN) mean = meanArr;
+        if (scaleArr.size() == D_IN) scale = scaleArr;
+    }
+    MlpModel* next = new MlpModel(*model.read());
+    publishModel(next);
 }
 
-// MLP 예측 구현
-int SignRecognition::predictMLP(const std::vector<float>& featureArr) {
-    if (featureArr.size() != D_IN) return -1;
+void SignRecognition::setLastError(const std::string& error) {
+    if (!error.empty()) SIGN_LOG_WARN("%s", error.c_str());
+    std::lock_guard<std::mutex> lock(errorMutex);
+    lastError = error;
+}
+
+void SignRecognition::publishModel(MlpModel* next) {
+    int64_t bytes = static_cast<int64_t>(next->byteSize());
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        next->intraOpPool = threadPool.get();
+        next->intraOpThreads = batchThreads;
+        next->setInputScaler(mean.data(), scale.data(), D_IN);
+        model.publish(next);
+    }
+    int generation = modelGeneration.fetch_add(1) + 1;
 
-    // 1. Scaler 적용
-    float x[D_IN];
-    for (int i = 0; i < D_IN; ++i) {
-        x[i] = (featureArr[i] - mean[i]) / scale[i];
+    Metrics::add(Metric::ModelSwaps);
+    Metrics::set(Metric::ModelGeneration, generation);
+    Metrics::set(Metric::ModelBytes, bytes);
+}
+
+bool SignRecognition::publishLoadedModel(MlpModel* loaded) {
+    if (loaded->inputDim() != D_IN) {
+        setLastError("model input size " + std::to_string(loaded->inputDim()) +
+                     " does not match feature size " + std::to_string(D_IN));
+        Metrics::add(Metric::ModelLoadFailures);
+        delete loaded;
+        return false;
     }
 
-    // 2. Layer 1
-    float h1[H1];
-    for (int i = 0; i < H1; ++i) {
-        float sum = B1[i];
-        for (int j = 0; j < D_IN; ++j) sum += W1[i * D_IN + j] * x[j];
-        h1[i] = std::max(sum, 0.f);
+    // 기기별 튜닝 결과는 새 모델에도 유지
+    std::lock_guard<std::mutex> writer(writerMutex);
+    loaded->kernelConfig = model.read()->kernelConfig;
+    SIGN_LOG_INFO("model loaded: %s (%zu bytes)", loaded->shapeSignature().c_str(), loaded->byteSize());
+    publishModel(loaded);
+    setLastError("");
+    return true;
+}
+
+// NPZ 파일에서 모델 로드
+bool SignRecognition::loadModel(const std::string& path) {
+    MlpModel* loaded = new MlpModel();
+    std::string error;
+    if (!loaded->loadFromNpzFile(path, error)) {
+        setLastError(error);
+        Metrics::add(Metric::ModelLoadFailures);
+        delete loaded;
+        return false;
+    }
+    return publishLoadedModel(loaded);
+}
+
+// JS에서 fetch한 NPZ 바이트(HEAPU8에 복사됨)로 모델 로드
+bool SignRecognition::loadModelFromBuffer(uintptr_t bufferPtr, int size) {
+    if (bufferPtr == 0 || size <= 0) {
+        setLastError("empty buffer");
+        return false;
+    }
+    MlpModel* loaded = new MlpModel();
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bufferPtr);
+    std::string error;
+    if (!loaded->loadFromNpzBuffer(data, static_cast<size_t>(size), error)) {
+        setLastError(error);
+        Metrics::add(Metric::ModelLoadFailures);
+        delete loaded;
+        return false;
+    }
+    return publishLoadedModel(loaded);
+}
+
+// 백그라운드 로드 후 교체
+bool SignRecognition::loadModelAsync(uintptr_t bufferPtr, int size) {
+    if (bufferPtr == 0 || size <= 0) {
+        setLastError("empty buffer");
+        return false;
+    }
+    if (swapPending.exchange(true)) {
+        setLastError("model swap already in progress");
+        return false;
+    }
+    if (swapThread.joinable()) swapThread.join();
+    Metrics::set(Metric::SwapQueueDepth, 1);
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bufferPtr);
+    std::vector<uint8_t> bytes(data, data + size);
+
+    auto task = [this, bytes = std::move(bytes)]() {
+        MlpModel* loaded = new MlpModel();
+        std::string error;
+        if (loaded->loadFromNpzBuffer(bytes.data(), bytes.size(), error)) {
+            publishLoadedModel(loaded);
+        } else {
+            setLastError(error);
+            Metrics::add(Metric::ModelLoadFailures);
+            delete loaded;
+        }
+        swapPending.store(false);
+        Metrics::set(Metric::SwapQueueDepth, 0);
+    };
+
+#if SIGN_HAS_THREADS
+    swapThread = std::thread(std::move(task));
+#else
+    task();
+#endif
+    return true;
+}
+
+bool SignRecognition::isModelSwapPending() const {
+    return swapPending.load();
+}
+
+int SignRecognition::getModelGeneration() const {
+    return modelGeneration.load();
+}
+
+std::string SignRecognition::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    return lastError;
+}
+
+// 배치 예측 구현
+int SignRecognition::predictBatch(uintptr_t featuresPtr, int frameCount, uintptr_t classesPtr) {
+    if (featuresPtr == 0 || classesPtr == 0 || frameCount <= 0) return 0;
+
+    const float* features = reinterpret_cast<const float*>(featuresPtr);
+    int32_t* classes = reinterpret_cast<int32_t*>(classesPtr);
+
+    Metrics::add(Metric::FramesProcessed, frameCount);
+
+    // 배치 전체를 같은 모델로 처리
+    auto current = model.read();
+    int numClasses = current->outputDim();
+
+    // 1. 배치 GEMM 추론 (scaler는 타일 입력 복사에 합쳐짐)
+    thread_local std::vector<float> logits;
+    logits.resize(static_cast<size_t>(frameCount) * numClasses);
+    current->forwardBatch(features, logits.data(), frameCount);
+
+    // 2. 프레임별 Argmax
+    for (int f = 0; f < frameCount; ++f) {
+        const float* row = logits.data() + static_cast<size_t>(f) * numClasses;
+        int argmax = 0;
+        for (int i = 1; i < numClasses; ++i) {
+            if (row[i] > row[argmax]) argmax = i;
+        }
+        classes[f] = argmax;
+    }
+
+    return frameCount;
+}
+
+int SignRecognition::predictBatchLogits(uintptr_t featuresPtr, int frameCount, uintptr_t logitsPtr) {
+    if (featuresPtr == 0 || logitsPtr == 0 || frameCount <= 0) return 0;
+
+    Metrics::add(Metric::FramesProcessed, frameCount);
+
+    auto current = model.read();
+    current->forwardBatch(reinterpret_cast<const float*>(featuresPtr), reinterpret_cast<float*>(logitsPtr),
+                          frameCount);
+    return current->outputDim();
+}
+
+void SignRecognition::setThreads(int threads) {
+    std::lock_guard<std::mutex> writer(writerMutex);
+    std::shared_ptr<ThreadPool> previous;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        previous = setBatchThreadsLocked(threads);
+    }
+    // 새 참여자 수를 가진 복사본을 게시 (publish가 이전 모델의 읽기를 기다린 뒤 previous가 풀을 놓음)
+    MlpModel* next = new MlpModel(*model.read());
+    publishModel(next);
+    SIGN_LOG_INFO("batch threads: %d", getThreads());
+}
+
+std::shared_ptr<ThreadPool> SignRecognition::setBatchThreadsLocked(int threads) {
+    std::shared_ptr<ThreadPool> previous;
+    if (threads > 1 && !threadPool) threadPool = ThreadPool::shared();
+    batchThreads = threadPool ? threadPool->participantsFor(std::max(1, threads)) : 1;
+    if (batchThreads <= 1) previous = std::move(threadPool);
+    return previous;
+}
+
+int SignRecognition::getThreads() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return batchThreads;
+}
+
+// 모델 변경은 복사본에 적용한 뒤 게시 (처리 중인 프레임에 영향 없음)
+// 복사부터 게시까지 writerMutex를 잡아, 그 사이 다른 변경/로드가 게시한 모델을 옛 복사본으로 덮어쓰지 않음
+void SignRecognition::pruneModel(float sparsity) {
+    std::lock_guard<std::mutex> writer(writerMutex);
+    MlpModel* next = new MlpModel(*model.read());
+    next->pruneByMagnitude(sparsity);
+    publishModel(next);
+}
+
+std::string SignRecognition::autotune() {
+    std::lock_guard<std::mutex> writer(writerMutex);
+    MlpModel* next = new MlpModel(*model.read());
+    TuneProfile tuned = Autotuner::tune(*next);
+    std::shared_ptr<ThreadPool> previous;
+    if (tuned.threads > 0) {
+        // 측정한 참여자 수를 이 객체의 설정으로 (publishModel이 모델에 다시 넣음)
+        std::lock_guard<std::mutex> lock(poolMutex);
+        previous = setBatchThreadsLocked(tuned.threads);
+    }
+    publishModel(next);
+    return Autotuner::serialize(tuned);
+}
+
+std::string SignRecognition::setWeightPrecision(int precision, uintptr_t featuresPtr, int frameCount) {
+    static const char* const NAMES[] = {"f32", "f16", "bf16"};
+    precision = std::max(0, std::min(precision, 2));
+    frameCount = featuresPtr != 0 ? std::max(frameCount, 0) : 0;
+
+    std::lock_guard<std::mutex> writer(writerMutex);
+    MlpModel* next = nullptr;
+    size_t previousBytes = 0;
+    int agree = 0;
+    float maxError = 0.0f;
+    {
+        // 읽기 가드는 게시 전에 풀어야 함 (publish가 이전 읽기를 기다림)
+        auto current = model.read();
+        next = new MlpModel(*current);
+        next->setWeightPrecision(static_cast<WeightPrecision>(precision));
+        previousBytes = current->byteSize();
+
+        // 보정 프레임이 있으면 변환 전 모델(기준)과 logit/argmax를 비교
+        if (frameCount > 0) {
+            const float* features = reinterpret_cast<const float*>(featuresPtr);
+            int numClasses = current->outputDim();
+            std::vector<float> reference(static_cast<size_t>(frameCount) * numClasses);
+            std::vector<float> converted(reference.size());
+
+            current->forwardBatch(features, reference.data(), frameCount);
+            next->forwardBatch(features, converted.data(), frameCount);
+
+            for (int f = 0; f < frameCount; ++f) {
+                const float* a = reference.data() + static_cast<size_t>(f) * numClasses;
+                const float* b = converted.data() + static_cast<size_t>(f) * numClasses;
+                agree += (std::max_element(a, a + numClasses) - a) == (std::max_element(b, b + numClasses) - b);
+                for (int i = 0; i < numClasses; ++i) maxError = std::max(maxError, std::fabs(a[i] - b[i]));
+            }
+        }
+    }
+
+    char report[192];
+    std::snprintf(report, sizeof(report),
+                  "{\"precision\":\"%s\",\"bytes\":%zu,\"previousBytes\":%zu,\"frames\":%d,\"agreement\":%g,\"maxLogitError\":%g}",
+                  NAMES[precision], next->byteSize(), previousBytes, frameCount,
+                  frameCount > 0 ? static_cast<double>(agree) / frameCount : 1.0, static_cast<double>(maxError));
+
+    publishModel(next);
+    return report;
+}
+
+std::string SignRecognition::compressLowRank(int layerIndex, float targetAccuracy, uintptr_t featuresPtr,
+                                             uintptr_t labelsPtr, int frameCount) {
+    if (featuresPtr == 0 || frameCount <= 0) {
+        setLastError("low-rank compression needs calibration frames");
+        return "";
+    }
+
+    // 모델 복사본이 scaler를 함께 가지므로 원본 특징을 그대로 사용
+    std::lock_guard<std::mutex> writer(writerMutex);
+    MlpModel* next = new MlpModel(*model.read());
+    LowRankReport report;
+    std::string error;
+    if (!LowRankCompressor::compress(*next, layerIndex, reinterpret_cast<const float*>(featuresPtr), reinterpret_cast<const int32_t*>(labelsPtr),
+                                     frameCount, targetAccuracy, report, error)) {
+        setLastError(error);
+        delete next;
+        return "";
     }
 
-    // 3. Layer 2
-    float h2[H2];
-    for (int i = 0; i < H2; ++i) {
-        float sum = B2[i];
-        for (int j = 0; j < H1; ++j) sum += W2[i * H1 + j] * h1[j];
-        h2[i] = std::max(sum, 0.f);
+    SIGN_LOG_INFO("low-rank layer %d: rank %d (max %d)", layerIndex, report.rank, report.maxRank);
+    if (report.rank > 0) {
+        publishModel(next);
+    } else {
+        delete next;
     }
+    return LowRankCompressor::reportJson(report);
+}
+
+bool SignRecognition::loadTuneProfile(const std::string& profile) {
+    TuneProfile parsed;
+    if (!Autotuner::parse(profile, parsed)) {
+        setLastError("invalid tune profile");
+        return false;
+    }
+    std::lock_guard<std::mutex> writer(writerMutex);
+    MlpModel* next = new MlpModel(*model.read());
+    if (!Autotuner::apply(parsed, *next)) {
+        setLastError("tune profile was recorded for a different model shape");
+        delete next;
+        return false;
+    }
+    std::shared_ptr<ThreadPool> previous;
+    if (parsed.threads > 0) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        previous = setBatchThreadsLocked(parsed.threads);
+    }
+    publishModel(next);
+    return true;
+}
 
-    // 4. Output Layer
-    float logits[NUM_CLASSES];
-    for (int i = 0; i < NUM_CLASSES; ++i) {
-        float sum = B3[i];
-        for (int j = 0; j < H2; ++j) sum += W3[i * H2 + j] * h2[j];
-        logits[i] = sum;
+// MLP 예측 구현
+int SignRecognition::predictMLP(const std::vector<float>& featureArr) {
+    if (featureArr.size() != D_IN) {
+        Metrics::add(Metric::DroppedFrames);
+        return -1;
     }
+    Metrics::add(Metric::FramesProcessed);
+
+    // 1. 패킹된 MLP 추론 (Layer 1~3, scaler는 첫 레이어 입력 복사에 합쳐짐)
+    // 교체 중이어도 이 프레임은 고정된 모델로 끝남
+    auto current = model.read();
+    int numClasses = current->outputDim();
+    thread_local std::vector<float> logits;
+    logits.resize(numClasses);
+    current->forward(featureArr.data(), logits.data());
 
-    // 5. Argmax
+    // 2. Argmax
     int argmax = 0;
     float best = logits[0];
-    for (int i = 1; i < NUM_CLASSES; ++i) {
+    for (int i = 1; i < numClasses; ++i) {
         if (logits[i] > best) {
             best = logits[i];
             argmax = i;
@@ -934,72 +1413,82 @@ std::vector<float> SignRecognizer::extractAdvancedMatrixFeatures(const std::vect
     return features;
 }
 
-std::vector<float> SignRecognizer::advancedMatrixNeuralNetwork(const std::vector<float>& features) {
-    if (features.size() != 1260) {
-        return std::vector<float>(5, 0.0f);
-    }
-    
+void SignRecognizer::buildAdvancedMatrixModel() {
     // Xavier 초기화 시뮬레이션용 시드
-    static int seed = 42;
+    int seed = 42;
     auto random = [&seed]() { 
         seed = (seed * 1103515245 + 12345) & 0x7fffffff;
         return (float)seed / 0x7fffffff - 0.5f; 
     };
     
-    // Layer 1: 1260 → 1024
-    std::vector<float> layer1(1024, 0.0f);
-    for (int i = 0; i < 1024; i++) {
-        float sum = random() * 0.01f; // bias
-        for (int j = 0; j < 1260; j++) {
-            float weight = random() * std::sqrt(6.0f / (1260 + 1024));
-            sum += features[j] * weight;
-        }
-        layer1[i] = std::max(0.0f, sum); // ReLU
-    }
+    // 1260 → 1024 → 512 → 256 → 128 → 5
+    const int dims[] = {1260, 1024, 512, 256, 128, 5};
+    advancedModel.layers.clear();
     
-    // Layer 2: 1024 → 512
-    std::vector<float> layer2(512, 0.0f);
-    for (int i = 0; i < 512; i++) {
-        float sum = random() * 0.01f;
-        for (int j = 0; j < 1024; j++) {
-            float weight = random() * std::sqrt(6.0f / (1024 + 512));
-            sum += layer1[j] * weight;
+    for (int l = 0; l < 5; l++) {
+        int inputs = dims[l];
+        int outputs = dims[l + 1];
+        float limit = std::sqrt(6.0f / (inputs + outputs));
+        
+        std::vector<float> weights(static_cast<size_t>(outputs) * inputs);
+        std::vector<float> biases(outputs);
+        for (int i = 0; i < outputs; i++) {
+            biases[i] = random() * 0.01f;
+            for (int j = 0; j < inputs; j++) {
+                weights[static_cast<size_t>(i) * inputs + j] = random() * limit;
+            }
         }
-        layer2[i] = std::max(0.0f, sum);
+        advancedModel.addLayer(weights.data(), biases.data(), outputs, inputs);
     }
-    
-    // Layer 3: 512 → 256
-    std::vector<float> layer3(256, 0.0f);
-    for (int i = 0; i < 256; i++) {
-        float sum = random() * 0.01f;
-        for (int j = 0; j < 512; j++) {
-            float weight = random() * std::sqrt(6.0f / (512 + 256));
-            sum += layer2[j] * weight;
-        }
-        layer3[i] = std::max(0.0f, sum);
+
+    // 기본은 fp32 그대로, 설정했을 때만 가지치기 후 16비트로 (fp32 약 5.8MB, fp16/bf16은 절반)
+    if (advancedSparsity > 0.0f) advancedModel.pruneByMagnitude(advancedSparsity);
+    if (advancedPrecision != WeightPrecision::F32) advancedModel.setWeightPrecision(advancedPrecision);
+}
+
+void SignRecognizer::setAdvancedModelPrecision(int precision) {
+    advancedPrecision = static_cast<WeightPrecision>(std::max(0, std::min(precision, 2)));
+    if (!advancedModel.empty()) buildAdvancedMatrixModel();
+}
+
+void SignRecognizer::pruneAdvancedModel(float sparsity) {
+    advancedSparsity = std::max(0.0f, sparsity);
+    if (!advancedModel.empty()) buildAdvancedMatrixModel();
+}
+
+size_t SignRecognizer::getAdvancedModelBytes() {
+    if (advancedModel.empty()) buildAdvancedMatrixModel();
+    return advancedModel.byteSize();
+}
+
+void SignRecognizer::setIntraOpThreads(int threads) {
+    if (threads > 1 && !intraOpPool) intraOpPool = ThreadPool::shared();
+    intraOpThreads = intraOpPool ? intraOpPool->participantsFor(std::max(1, threads)) : 1;
+    if (intraOpThreads <= 1) intraOpPool.reset();
+    advancedModel.intraOpPool = intraOpPool.get();
+    advancedModel.intraOpThreads = intraOpThreads;
+    SIGN_LOG_INFO("intra-op threads: %d", intraOpThreads);
+}
+
+int SignRecognizer::getIntraOpThreads() const {
+    return intraOpThreads;
+}
+
+std::vector<float> SignRecognizer::advancedMatrixNeuralNetwork(const std::vector<float>& features) {
+    if (features.size() != 1260) {
+        return std::vector<float>(5, 0.0f);
     }
     
-    // Layer 4: 256 → 128
-    std::vector<float> layer4(128, 0.0f);
-    for (int i = 0; i < 128; i++) {
-        float sum = random() * 0.01f;
-        for (int j = 0; j < 256; j++) {
-            float weight = random() * std::sqrt(6.0f / (256 + 128));
-            sum += layer3[j] * weight;
-        }
-        layer4[i] = std::max(0.0f, sum);
+    if (advancedModel.empty()) {
+        Metrics::add(Metric::DeepModelCacheMisses);
+        buildAdvancedMatrixModel();
+    } else {
+        Metrics::add(Metric::DeepModelCacheHits);
     }
     
-    // Output Layer: 128 → 5
-    std::vector<float> output(5, 0.0f);
-    for (int i = 0; i < 5; i++) {
-        float sum = random() * 0.01f;
-        for (int j = 0; j < 128; j++) {
-            float weight = random() * std::sqrt(6.0f / (128 + 5));
-            sum += layer4[j] * weight;
-        }
-        output[i] = sum; // Linear output
-    }
+    // 레이어별로 밀집 GEMV 또는 블록 희소 GEMV 실행 (ReLU, 마지막 레이어는 선형)
+    std::vector<float> output(advancedModel.outputDim(), 0.0f);
+    advancedModel.forward(features.data(), output.data());
     
     return output;
-}
\ No newline at end of file
+}
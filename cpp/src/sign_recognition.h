@@ -1,12 +1,24 @@
 #ifndef SIGN_RECOGNITION_H
 #define SIGN_RECOGNITION_H
 
-#include <emscripten/bind.h>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <cmath>
 #include <algorithm>
-#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include "mlp_model.h"
+#include "autotuner.h"
+#include "rcu_slot.h"
+#include "hog_descriptor.h"
+#include "hand_collider.h"
+#include "particle_grid.h"
+#include "clahe.h"
+#include "crop_align.h"
+#include "thread_pool.h"
 
 // 손 랜드마크 구조체
 struct HandLandmark {
@@ -41,9 +53,26 @@ public:
     std::string recognizeBatch(float* landmarks, int frameCount, int landmarksPerFrame);
     
     // === WASM이 빛나는 영역들 ===
-    // 1. 이미지 필터링 (가우시안 블러, 엣지 검출 등)
+    // 1. 이미지 필터링 (RGBA 제자리)
+    // filterType 0: 5×5 가우시안 블러, 1: CLAHE 저조도 보정(휘도만), 2: 평균 휘도가 낮을 때만 CLAHE
     void processImageData(uint8_t* imageData, int width, int height, int filterType);
+
+    // filterType 2가 CLAHE를 적용할 평균 휘도 상한 (0–255, 기본 70)
+    void setLowLightLuma(float meanLuma);
     
+    // 1-1. HOG 특징 (손/얼굴 영역의 외형 특징)
+    // RGBA 이미지의 (x, y, cropWidth, cropHeight) 영역 → out, 특징 길이 반환 (영역이 너무 작으면 0)
+    int computeHog(const uint8_t* imageData, int width, int height, int x, int y, int cropWidth, int cropHeight,
+                   float* out);
+    int getHogSize(int cropWidth, int cropHeight) const;
+
+    // 1-2. 랜드마크 정렬 영역 (똑바로 세우고 크기를 맞춘 size × size RGBA → out)
+    // 손: 정규화 랜드마크 42/63개 float의 손목 → 중지 MCP 축, 얼굴: 정규화 좌표의 두 눈 중심
+    bool alignHandCrop(const uint8_t* imageData, int width, int height, const float* landmarks, int count, int size,
+                       uint8_t* out);
+    bool alignFaceCrop(const uint8_t* imageData, int width, int height, float leftEyeX, float leftEyeY,
+                       float rightEyeX, float rightEyeY, int size, uint8_t* out);
+
     // 2. 대용량 행렬 연산 (1000x1000 이상)
     void matrixMultiplyLarge(float* matA, float* matB, float* result, int size);
     
@@ -54,8 +83,28 @@ public:
     void sha256Hash(uint8_t* input, int length, uint8_t* output);
     
     // 5. 게임 물리 시뮬레이션 (충돌 검사, 파티클 등)
+    // 모든 파티클을 먼저 적분한 뒤, 거리 1 미만인 쌍의 반발력을 균일 격자(particle_grid.h)로 찾아 적용합니다.
     void simulateParticles(float* positions, float* velocities, int particleCount, float deltaTime);
+
+    // 5-1. 파티클이 부딪힐 손 (랜드마크 42/63개 float, 파티클과 같은 좌표계, 뼈 캡슐 반지름)
+    // 손이 바뀔 때마다 호출하면 뼈 캡슐 BVH를 다시 만들고, 다음 simulateParticles부터 충돌합니다.
+    bool setParticleHand(const float* landmarks, int count, float radius);
+    void clearParticleHand();
     
+    // 심층 모델(1260→1024→…) 한 프레임 추론, 이미지 필터, 대용량 행렬 곱에 쓰는 스레드 수 (호출 스레드 포함, 기본 1)
+    // 큰 레이어는 출력 행으로, 이미지는 행 띠로, 행렬 곱은 행 블록으로 나눠 공용 작업 훔치기 풀에서 계산합니다.
+    // wasm은 THREADS=1 빌드에서만 적용되며 PTHREAD_POOL_SIZE 안에서 스레드를 만듭니다.
+    // 공용 풀의 크기는 바꾸지 않고 이 객체가 한 번에 쓰는 참여자 수만 정하므로, 풀 크기를 넘으면 풀 크기로 제한됩니다.
+    void setIntraOpThreads(int threads);
+    int getIntraOpThreads() const;
+
+    // 심층 모델 가중치 형식 (0 = fp32 기본, 1 = fp16, 2 = bf16)과 블록 가지치기 비율 (0–1, 기본 0)
+    // 가중치를 다시 만들어 가지치기 → 형식 변환 순으로 적용하므로 호출 순서와 무관하게 같은 모델이 됩니다.
+    void setAdvancedModelPrecision(int precision);
+    void pruneAdvancedModel(float sparsity);
+    // 현재 설정의 심층 모델 가중치 바이트 (아직 없으면 먼저 만듦)
+    size_t getAdvancedModelBytes();
+
     // 임계값 설정
     void setDetectionThreshold(float threshold);
     void setRecognitionThreshold(float threshold);
@@ -64,6 +113,9 @@ public:
     std::string getVersion() const;
 
 private:
+    // 단위 테스트가 융합 Layer 1과 비융합 경로(extractComplexFeatures → neuralNetworkInference)를 비교할 때 사용
+    friend struct SignRecognizerTestAccess;
+
     // 손가락이 펴져있는지 확인
     bool isFingerExtended(const HandLandmark& tip, const HandLandmark& pip, const HandLandmark& mcp) const;
     
@@ -85,6 +137,13 @@ private:
     
     // 가상 신경망 추론
     std::vector<float> neuralNetworkInference(const std::vector<float>& features);
+
+    // 특징 추출 + Layer 1(210 → 128) 융합: 특징을 계산하는 즉시 Layer 1 누산기에 곱해 넣고
+    // 표준화 통계는 Welford로 한 번에 구해 마지막에 보정 (특징 벡터를 만들지 않음), hidden은 128개
+    bool fusedFeatureLayer1(const std::vector<HandLandmark>& landmarks, float* hidden);
+
+    // Layer 2~4 (128 → 64 → 32 → 5)
+    std::vector<float> neuralNetworkTail(const float* layer1);
     
     // 대용량 행렬 곱셈 신경망 추론 (1260→1024→512→256→128→5)
     std::vector<float> advancedMatrixNeuralNetwork(const std::vector<float>& features);
@@ -114,9 +173,34 @@ private:
     // 각도 계산
     float calculateAngle(const HandLandmark& a, const HandLandmark& b, const HandLandmark& c) const;
     
+    // 대용량 신경망 가중치 생성 (Xavier 초기화, 최초 사용 시 한 번)
+    void buildAdvancedMatrixModel();
+    
     // 가중치 캐시 (사전 계산된 ML 가중치들)
     static std::vector<std::vector<float>> neuralWeights;
     static std::vector<float> neuralBiases;
+    static std::vector<float> neuralLayer1ColumnSums;  // Layer 1 출력별 가중치 합 (융합 경로의 평균 보정)
+    
+    // 1260→1024→512→256→128→5 신경망 (SIMD 패킹, 가지치기 시 희소 커널)
+    MlpModel advancedModel;
+    WeightPrecision advancedPrecision;
+    float advancedSparsity;
+
+    // 공용 스레드 풀 (없으면 단일 스레드, SignRecognition과 같은 풀)과 이 객체가 쓰는 참여자 수
+    std::shared_ptr<ThreadPool> intraOpPool;
+    int intraOpThreads;
+
+    // HOG 작업 버퍼 (영역 크기가 같으면 재사용)
+    HogDescriptor hog;
+
+    // CLAHE 타일 히스토그램/LUT 버퍼 (영상 크기가 같으면 재사용)
+    ClaheFilter clahe;
+
+    // 파티클-손 충돌체 (setParticleHand 전에는 비활성)
+    HandCollider handCollider;
+
+    // 파티클 간 상호작용 격자 (파티클 수가 같으면 버퍼 재사용)
+    ParticleGrid particleGrid;
     
     float detectionThreshold;
     float recognitionThreshold;
@@ -135,7 +219,70 @@ public:
     // Scaler 설정 함수 (선언만)
     void setScaler(const std::vector<float>& meanArr, const std::vector<float>& scaleArr);
 
+    // NPZ(w1/b1 ... w3/b3) 가중치 로드 후 SIMD 레이아웃으로 패킹
+    // 실패하면 기존 모델을 유지하고 false 반환
+    bool loadModel(const std::string& path);
+    bool loadModelFromBuffer(uintptr_t bufferPtr, int size);
+
+    // 백그라운드 스레드에서 로드/패킹 후 원자적으로 교체 (RCU)
+    // 처리 중인 프레임은 이전 모델로 끝나고, 이전 모델은 읽는 쪽이 없어지면 해제됩니다.
+    // 버퍼는 호출 중에 복사되므로 반환 직후 해제해도 됩니다.
+    bool loadModelAsync(uintptr_t bufferPtr, int size);
+    bool isModelSwapPending() const;
+
+    // 모델이 교체될 때마다 1씩 증가
+    int getModelGeneration() const;
+
+    // 마지막 로드 실패 사유
+    std::string getLastError() const;
+
+    // 여러 프레임 일괄 예측 (GEMM 경로)
+    // featuresPtr: frameCount × 126 float, classesPtr: frameCount개 int32 출력
+    int predictBatch(uintptr_t featuresPtr, int frameCount, uintptr_t classesPtr);
+
+    // 여러 프레임의 클래스 logit 출력 (CTC 빔 탐색 디코더 입력)
+    // logitsPtr: frameCount × 클래스 수 float, 클래스 수 반환
+    int predictBatchLogits(uintptr_t featuresPtr, int frameCount, uintptr_t logitsPtr);
+
+    // 크기 기반 가지치기 후 레이어별 밀도에 따라 밀집/블록 희소 커널 선택
+    void pruneModel(float sparsity);
+
+    // 현재 모델 형태로 커널 변형과 배치 추론 참여자 수(setThreads 값 이하)를 벤치마크하고 프로파일 문자열 반환
+    // (JS에서 저장해 두었다가 다음 세션에 loadTuneProfile로 적용, threads=가 있으면 setThreads도 적용)
+    std::string autotune();
+    bool loadTuneProfile(const std::string& profile);
+
+    // 가중치 정밀도 변경 (0: fp32, 1: fp16, 2: bf16)
+    // featuresPtr의 frameCount개 프레임(× 126 float, 0이면 생략)으로 변환 전 모델과 비교한
+    // argmax 일치율/최대 logit 오차와 가중치 바이트 수를 JSON 문자열로 반환
+    std::string setWeightPrecision(int precision, uintptr_t featuresPtr, int frameCount);
+
+    // layerIndex번째 레이어를 저랭크 분해 (W ≈ U·V, low_rank.h 참고)
+    // featuresPtr: frameCount × 126 float 보정 프레임, labelsPtr: frameCount개 int32 정답 (0이면 원래 모델과의 일치율)
+    // 목표 정확도를 만족하는 가장 작은 랭크로 교체하고 랭크별 정확도/바이트/추론 시간을 JSON으로 반환
+    // 분해된 레이어는 두 레이어가 되어 뒤쪽 레이어 번호가 하나씩 밀립니다. 실패하면 빈 문자열 (getLastError 참고)
+    std::string compressLowRank(int layerIndex, float targetAccuracy, uintptr_t featuresPtr, uintptr_t labelsPtr,
+                                int frameCount);
+
+    // 배치 추론(predictBatch, predictBatchLogits)에 쓰는 스레드 수 (호출 스레드 포함, 기본 1)
+    // 배치를 타일 단위로 나눠 공용 작업 훔치기 풀에서 계산합니다 (SignRecognizer와 같은 풀).
+    // 풀 크기는 그대로 두고 이 객체의 참여자 수만 정하므로 다른 객체의 설정과 충돌하지 않습니다.
+    void setThreads(int threads);
+    int getThreads() const;
+
 private:
+    static MlpModel* createBuiltinModel();
+
+    // 로드한 모델 검증 후 게시 (현재 튜닝 설정 유지)
+    bool publishLoadedModel(MlpModel* loaded);
+    void publishModel(MlpModel* next);
+
+    // 배치 추론 참여자 수 변경 (poolMutex를 잡은 채 호출)
+    // 놓은 풀을 돌려주므로 호출자는 새 모델을 게시한 뒤에 해제해야 함 (이전 모델의 읽기가 풀을 쓰는 중일 수 있음)
+    std::shared_ptr<ThreadPool> setBatchThreadsLocked(int threads);
+
+    void setLastError(const std::string& error);
+
     static constexpr int D_IN = 126;
     static constexpr int H1 = 128;
     static constexpr int H2 = 64;
@@ -143,6 +290,21 @@ private:
 
     std::vector<float> mean;
     std::vector<float> scale;
+
+    RcuSlot<MlpModel> model;
+    std::shared_ptr<ThreadPool> threadPool;
+    int batchThreads;  // 배치 추론 참여자 수 (threadPool이 있을 때만 1보다 큼)
+    // 모델 변경(복사 → 수정 → 게시)과 로드 게시를 직렬화 (잠금 순서: writerMutex → poolMutex)
+    // 복사본은 항상 가장 최근에 게시된 모델에서 만들어지므로 동시 로드 결과를 덮어쓰지 않음
+    std::mutex writerMutex;
+    // threadPool/batchThreads/scaler 교체와 모델 게시를 직렬화 (게시되는 모델은 항상 살아 있는 풀과 최신 scaler를 가짐)
+    mutable std::mutex poolMutex;
+    std::atomic<int> modelGeneration;
+    std::atomic<bool> swapPending;
+    std::thread swapThread;
+
+    mutable std::mutex errorMutex;
+    std::string lastError;
 };
 
 #endif // SIGN_RECOGNITION_H
@@ -0,0 +1,234 @@
+#include "stream_table.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+constexpr uint32_t INDEX_MASK = (1u << StreamTable::INDEX_BITS) - 1;
+constexpr uint16_t GENERATION_MASK = 0xFFF;   // 32 - INDEX_BITS
+constexpr int SLAB_SHIFT = 6;                 // log2(SLAB_STREAMS)
+constexpr size_t MAX_SLABS = StreamTable::MAX_STREAMS / StreamTable::SLAB_STREAMS;
+constexpr float TWO_PI = 6.28318530718f;
+constexpr double DEFAULT_FRAME_SECONDS = 1.0 / 30.0;
+
+static_assert((1 << SLAB_SHIFT) == StreamTable::SLAB_STREAMS, "SLAB_SHIFT mismatch");
+static_assert(StreamTable::LANDMARK_STRIDE % SIMD_WIDTH == 0, "landmark stride must be SIMD aligned");
+static_assert(StreamTable::MAX_CLASSES % SIMD_WIDTH == 0, "class count must be SIMD aligned");
+
+inline StreamHandle makeHandle(uint32_t index, uint16_t generation) {
+    return (static_cast<uint32_t>(generation) << StreamTable::INDEX_BITS) | index;
+}
+
+// One-Euro 지수 평활 계수: r / (r + 1), r = 2π · cutoff · dt
+inline float smoothingFactor(float cutoff, float dt) {
+    float r = TWO_PI * cutoff * dt;
+    return r / (r + 1.0f);
+}
+
+} // namespace
+
+StreamTable::StreamTable(const StreamConfig& config)
+    : settings(config), slabs(MAX_SLABS), slabCount(0), liveCount(0), nextTrack(0) {}
+
+StreamTable::Slab* StreamTable::resolve(StreamHandle handle, int& lane) const {
+    const uint32_t index = handle & INDEX_MASK;
+    const uint16_t generation = static_cast<uint16_t>(handle >> INDEX_BITS);
+    const size_t slabIndex = index >> SLAB_SHIFT;
+    if (generation == 0 || slabIndex >= MAX_SLABS) return nullptr;
+    Slab* slab = slabs[slabIndex].get();
+    lane = static_cast<int>(index & (SLAB_STREAMS - 1));
+    if (slab == nullptr || !slab->live[lane] || slab->generation[lane] != generation) return nullptr;
+    return slab;
+}
+
+void StreamTable::resetLane(Slab& slab, int lane, double nowMs) {
+    slab.hasHand[lane] = 0;
+    slab.lastSeenMs[lane] = nowMs;
+    slab.filterTimeMs[lane] = nowMs;
+    slab.track[lane] = -1;
+    slab.lastLabel[lane] = -1;
+    slab.lastConfidence[lane] = 0.0f;
+    slab.historyHead[lane] = 0;
+    slab.historyCount[lane] = 0;
+    std::memset(slab.scores[lane], 0, sizeof(slab.scores[lane]));
+}
+
+StreamHandle StreamTable::open(double nowMs) {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    if (freeSlots.empty()) {
+        if (slabCount == MAX_SLABS) return INVALID_STREAM;
+        slabs[slabCount].reset(new Slab());
+        // 낮은 번호부터 꺼내도록 역순으로 넣음
+        const uint32_t base = static_cast<uint32_t>(slabCount) * SLAB_STREAMS;
+        for (int lane = SLAB_STREAMS - 1; lane >= 0; lane--) {
+            slabs[slabCount]->generation[lane] = 1;
+            freeSlots.push_back(base + lane);
+        }
+        slabCount++;
+    }
+
+    const uint32_t index = freeSlots.back();
+    freeSlots.pop_back();
+    Slab& slab = *slabs[index >> SLAB_SHIFT];
+    const int lane = static_cast<int>(index & (SLAB_STREAMS - 1));
+    resetLane(slab, lane, nowMs);
+    slab.live[lane] = 1;
+    liveCount++;
+    return makeHandle(index, slab.generation[lane]);
+}
+
+void StreamTable::closeLane(uint32_t index) {
+    Slab& slab = *slabs[index >> SLAB_SHIFT];
+    const int lane = static_cast<int>(index & (SLAB_STREAMS - 1));
+    slab.live[lane] = 0;
+    // 세대를 바로 올려 옛 핸들을 무효화 (12비트에서 돌면 0은 건너뜀)
+    uint16_t generation = static_cast<uint16_t>((slab.generation[lane] + 1) & GENERATION_MASK);
+    slab.generation[lane] = generation == 0 ? 1 : generation;
+    freeSlots.push_back(index);
+    liveCount--;
+}
+
+bool StreamTable::close(StreamHandle handle) {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    int lane = 0;
+    if (resolve(handle, lane) == nullptr) return false;
+    closeLane(handle & INDEX_MASK);
+    return true;
+}
+
+bool StreamTable::isValid(StreamHandle handle) const {
+    int lane = 0;
+    return resolve(handle, lane) != nullptr;
+}
+
+bool StreamTable::pushLandmarks(StreamHandle handle, const float* landmarks, int count, double timestampMs,
+                                float* filtered) {
+    int lane = 0;
+    Slab* slab = resolve(handle, lane);
+    if (slab == nullptr) return false;
+    slab->lastSeenMs[lane] = std::max(slab->lastSeenMs[lane], timestampMs);
+
+    if (landmarks == nullptr || count == 0) {
+        slab->hasHand[lane] = 0;
+        slab->track[lane] = -1;
+        return true;
+    }
+    const int components = count == 63 ? 3 : (count == LANDMARK_VALUES ? 2 : 0);
+    if (components == 0) return false;
+
+    alignas(32) float input[LANDMARK_STRIDE] = {};
+    for (int i = 0; i < LANDMARK_VALUES / 2; i++) {
+        input[i * 2] = landmarks[i * components];
+        input[i * 2 + 1] = landmarks[i * components + 1];
+    }
+
+    float* state = slab->filtered[lane];
+    float* velocity = slab->derivative[lane];
+    if (!slab->hasHand[lane]) {
+        // 새 손: 필터를 현재 값으로 초기화하고 추적 id 부여
+        std::memcpy(state, input, sizeof(input));
+        std::memset(velocity, 0, sizeof(slab->derivative[lane]));
+        slab->hasHand[lane] = 1;
+        slab->track[lane] = nextTrack.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        double seconds = (timestampMs - slab->filterTimeMs[lane]) * 1e-3;
+        const float dt = static_cast<float>(seconds > 0.0 ? seconds : DEFAULT_FRAME_SECONDS);
+        const __m256 invDt = _mm256_set1_ps(1.0f / dt);
+        const __m256 alphaDerivative = _mm256_set1_ps(smoothingFactor(settings.derivativeCutoff, dt));
+        const __m256 minCutoff = _mm256_set1_ps(settings.minCutoff);
+        const __m256 beta = _mm256_set1_ps(settings.beta);
+        const __m256 rateScale = _mm256_set1_ps(TWO_PI * dt);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+        // 좌표 42개(+패딩)를 8개씩: 속도 평활 → 속도에 맞춘 차단 주파수 → 값 평활
+        for (int i = 0; i < LANDMARK_STRIDE; i += SIMD_WIDTH) {
+            __m256 x = _mm256_load_ps(input + i);
+            __m256 previous = _mm256_load_ps(state + i);
+            __m256 d = _mm256_load_ps(velocity + i);
+            __m256 dx = _mm256_mul_ps(_mm256_sub_ps(x, previous), invDt);
+            d = _mm256_add_ps(d, _mm256_mul_ps(alphaDerivative, _mm256_sub_ps(dx, d)));
+            __m256 cutoff = _mm256_add_ps(minCutoff, _mm256_mul_ps(beta, _mm256_and_ps(d, absMask)));
+            __m256 r = _mm256_mul_ps(rateScale, cutoff);
+            __m256 alpha = _mm256_div_ps(r, _mm256_add_ps(r, one));
+            _mm256_store_ps(state + i, _mm256_add_ps(previous, _mm256_mul_ps(alpha, _mm256_sub_ps(x, previous))));
+            _mm256_store_ps(velocity + i, d);
+        }
+    }
+    slab->filterTimeMs[lane] = timestampMs;
+
+    const int head = slab->historyHead[lane];
+    std::memcpy(slab->history[lane][head], state, sizeof(float) * LANDMARK_STRIDE);
+    slab->historyHead[lane] = (head + 1) % HISTORY_FRAMES;
+    slab->historyCount[lane] = std::min(slab->historyCount[lane] + 1, HISTORY_FRAMES);
+    if (filtered != nullptr) std::memcpy(filtered, state, sizeof(float) * LANDMARK_VALUES);
+    return true;
+}
+
+int StreamTable::pushResult(StreamHandle handle, int label, float confidence) {
+    int lane = 0;
+    Slab* slab = resolve(handle, lane);
+    if (slab == nullptr || label < 0 || label >= MAX_CLASSES) return -1;
+    slab->lastLabel[lane] = label;
+    slab->lastConfidence[lane] = confidence;
+
+    // 점수 = decay · 점수 + (1 − decay) · confidence · onehot(label)
+    float* scores = slab->scores[lane];
+    const __m256 decay = _mm256_set1_ps(settings.scoreDecay);
+    for (int c = 0; c < MAX_CLASSES; c += SIMD_WIDTH) {
+        _mm256_store_ps(scores + c, _mm256_mul_ps(decay, _mm256_load_ps(scores + c)));
+    }
+    scores[label] += (1.0f - settings.scoreDecay) * confidence;
+
+    int best = 0;
+    for (int c = 1; c < MAX_CLASSES; c++) {
+        if (scores[c] > scores[best]) best = c;
+    }
+    return best;
+}
+
+int StreamTable::copyHistory(StreamHandle handle, float* out, int maxFrames) const {
+    int lane = 0;
+    const Slab* slab = resolve(handle, lane);
+    if (slab == nullptr || out == nullptr || maxFrames <= 0) return 0;
+    const int frames = std::min(slab->historyCount[lane], maxFrames);
+    const int first = slab->historyHead[lane] - frames + HISTORY_FRAMES;
+    for (int f = 0; f < frames; f++) {
+        std::memcpy(out + static_cast<size_t>(f) * LANDMARK_VALUES,
+                    slab->history[lane][(first + f) % HISTORY_FRAMES], sizeof(float) * LANDMARK_VALUES);
+    }
+    return frames;
+}
+
+bool StreamTable::lastResult(StreamHandle handle, int& label, float& confidence) const {
+    int lane = 0;
+    const Slab* slab = resolve(handle, lane);
+    if (slab == nullptr) return false;
+    label = slab->lastLabel[lane];
+    confidence = slab->lastConfidence[lane];
+    return true;
+}
+
+int StreamTable::trackId(StreamHandle handle) const {
+    int lane = 0;
+    const Slab* slab = resolve(handle, lane);
+    return slab == nullptr ? -1 : slab->track[lane];
+}
+
+int StreamTable::evictIdle(double nowMs) {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    const double deadline = nowMs - settings.idleTimeoutMs;
+    int evicted = 0;
+    for (size_t s = 0; s < slabCount; s++) {
+        const Slab& slab = *slabs[s];
+        for (int lane = 0; lane < SLAB_STREAMS; lane++) {
+            if (slab.live[lane] && slab.lastSeenMs[lane] < deadline) {
+                closeLane(static_cast<uint32_t>(s * SLAB_STREAMS + lane));
+                evicted++;
+            }
+        }
+    }
+    return evicted;
+}
@@ -0,0 +1,106 @@
+#ifndef STREAM_TABLE_H
+#define STREAM_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "mlp_model.h"
+
+// 스트림 핸들: 하위 20비트 슬롯 번호 + 상위 12비트 세대 (0은 무효 핸들)
+// 슬롯을 재사용할 때마다 세대가 바뀌므로, 닫힌 스트림의 옛 핸들은 조회에서 거부됩니다.
+using StreamHandle = uint32_t;
+constexpr StreamHandle INVALID_STREAM = 0;
+
+// 스트림별 상태 설정
+struct StreamConfig {
+    float minCutoff = 1.0f;          // One-Euro 최소 차단 주파수 (Hz)
+    float beta = 0.007f;             // 속도에 따른 차단 주파수 증가율
+    float derivativeCutoff = 1.0f;   // 속도 추정 차단 주파수 (Hz)
+    float scoreDecay = 0.8f;         // 클래스 점수 지수 평활 감쇠 (0–1)
+    double idleTimeoutMs = 5000.0;   // evictIdle 기준 (마지막 프레임 이후 경과 시간)
+};
+
+// 다중 카메라 서버용 스트림 상태 테이블
+// 스트림마다 랜드마크 기록 링, One-Euro 필터 상태, 마지막 인식 결과, 클래스 점수 누적, 손 추적 id를 둡니다.
+// 64개 스트림 단위 슬랩에 SoA로 배치하고 슬랩은 해제하지 않으므로, 핸들 조회는 슬랩/칸 계산과
+// 세대 비교뿐이며 (O(1)) 상태 주소도 스트림이 열려 있는 동안 바뀌지 않습니다.
+// 유휴 판정에 쓰는 마지막 프레임 시각과 세대는 별도 배열이라 evictIdle은 그 배열만 훑습니다.
+// open/close/evictIdle은 내부 mutex로 직렬화되고, 한 스트림의 프레임 처리는 한 스레드에서 하며
+// evictIdle은 해당 스트림의 프레임 처리와 겹치지 않게 호출해야 합니다 (서로 다른 스트림은 동시 처리 가능).
+class StreamTable {
+public:
+    static constexpr int SLAB_STREAMS = 64;
+    static constexpr int HISTORY_FRAMES = 16;
+    static constexpr int LANDMARK_VALUES = 42;   // 21 × (x, y)
+    static constexpr int LANDMARK_STRIDE = 48;   // SIMD 폭 배수
+    static constexpr int MAX_CLASSES = 16;
+    static constexpr int INDEX_BITS = 20;
+    static constexpr int MAX_STREAMS = 1 << INDEX_BITS;
+
+    explicit StreamTable(const StreamConfig& config = StreamConfig());
+
+    // 새 스트림, 빈 슬롯이 없고 MAX_STREAMS에 도달하면 INVALID_STREAM
+    StreamHandle open(double nowMs);
+    // 닫았으면 true (이미 닫혔거나 옛 핸들이면 false)
+    bool close(StreamHandle handle);
+    bool isValid(StreamHandle handle) const;
+
+    // 랜드마크 한 프레임 (42개 x, y 또는 63개 x, y, z 중 x, y 사용)을 One-Euro로 평활해 기록 링에 추가
+    // filtered가 있으면 평활 결과 42개를 기록, 손이 없는 프레임은 landmarks = nullptr 또는 count = 0
+    // (필터를 초기화하고 다음 손은 새 추적 id를 받음)
+    bool pushLandmarks(StreamHandle handle, const float* landmarks, int count, double timestampMs, float* filtered);
+
+    // 인식 결과를 클래스 점수에 누적하고 평활된 클래스를 반환 (실패 시 -1)
+    int pushResult(StreamHandle handle, int label, float confidence);
+
+    // 최근 프레임 기록을 오래된 순으로 out(maxFrames × 42)에 복사, 복사한 프레임 수 반환
+    int copyHistory(StreamHandle handle, float* out, int maxFrames) const;
+
+    // 마지막 인식 결과 (없으면 label = -1), 실패 시 false
+    bool lastResult(StreamHandle handle, int& label, float& confidence) const;
+    // 현재 손 추적 id (손이 없으면 -1, 핸들이 무효면 -1)
+    int trackId(StreamHandle handle) const;
+
+    // 마지막 프레임 이후 idleTimeoutMs가 지난 스트림을 닫고 개수 반환
+    int evictIdle(double nowMs);
+
+    int size() const { return liveCount; }
+    int capacity() const { return static_cast<int>(slabCount) * SLAB_STREAMS; }
+    const StreamConfig& config() const { return settings; }
+
+private:
+    // 슬랩 하나의 스트림 64개 (SoA, 프레임마다 같이 쓰는 필터/기록은 스트림별로 연속)
+    struct alignas(32) Slab {
+        uint16_t generation[SLAB_STREAMS];
+        uint8_t live[SLAB_STREAMS];
+        uint8_t hasHand[SLAB_STREAMS];
+        double lastSeenMs[SLAB_STREAMS];
+        double filterTimeMs[SLAB_STREAMS];
+        int32_t track[SLAB_STREAMS];
+        int32_t lastLabel[SLAB_STREAMS];
+        float lastConfidence[SLAB_STREAMS];
+        int32_t historyHead[SLAB_STREAMS];
+        int32_t historyCount[SLAB_STREAMS];
+        float filtered[SLAB_STREAMS][LANDMARK_STRIDE];
+        float derivative[SLAB_STREAMS][LANDMARK_STRIDE];
+        float scores[SLAB_STREAMS][MAX_CLASSES];
+        float history[SLAB_STREAMS][HISTORY_FRAMES][LANDMARK_STRIDE];
+    };
+
+    // 핸들 → (슬랩, 칸), 무효면 nullptr
+    Slab* resolve(StreamHandle handle, int& lane) const;
+    void resetLane(Slab& slab, int lane, double nowMs);
+    void closeLane(uint32_t index);
+
+    StreamConfig settings;
+    std::vector<std::unique_ptr<Slab>> slabs;  // MAX_STREAMS / 64칸을 미리 잡아 두어 조회 중 재할당 없음
+    size_t slabCount;
+    std::vector<uint32_t> freeSlots;
+    int liveCount;
+    std::atomic<int32_t> nextTrack;   // 스트림 사이에 겹치지 않는 손 추적 id
+    mutable std::mutex tableMutex;
+};
+
+#endif // STREAM_TABLE_H
@@ -0,0 +1,488 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+#if defined(__SSE2__) && !defined(__EMSCRIPTEN__)
+#include <immintrin.h>
+#endif
+#if SIGN_HAS_THREADS && defined(__EMSCRIPTEN__)
+#include <emscripten/threading.h>
+#elif SIGN_HAS_THREADS && defined(__linux__)
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#endif
+
+namespace {
+
+// 새 작업을 기다리며 스핀하는 횟수 (약 수십 µs), 이후에는 futex로 잠듦
+constexpr int SPIN_LIMIT = 20000;
+
+// 이 횟수를 넘기면 스핀 사이에 양보 (코어보다 스레드가 많을 때 실제 작업 스레드가 돌 수 있도록)
+constexpr int SPIN_BEFORE_YIELD = 200;
+
+// 이 횟수만큼 일을 못 찾으면 다른 참여자의 우편함도 훔침 (지정 참여자가 깨어날 시간을 줌)
+constexpr int SPIN_BEFORE_MAILBOX_STEAL = 2000;
+
+// 자동 조각 크기: 참여자당 이 개수 정도의 조각이 나오도록
+constexpr int CHUNKS_PER_PARTICIPANT = 8;
+
+// 하드웨어 스레드 수를 알 수 없을 때의 공용 풀 크기
+// wasm은 PTHREAD_POOL_SIZE=4(모델 교체 1개 + 작업자 3개) 안에서 작업자를 만들어야 하므로 같은 값을 씀
+constexpr int FALLBACK_THREADS = 4;
+
+inline void cpuRelax() {
+#if defined(__SSE2__) && !defined(__EMSCRIPTEN__)
+    _mm_pause();
+#endif
+}
+
+inline void backoff(int spins) {
+    if (spins < SPIN_BEFORE_YIELD) {
+        cpuRelax();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+// setThreadLimit으로 정한 참여자 수 상한 (0이면 하드웨어 기준)
+std::atomic<int> threadLimit{0};
+
+// setPinWorkers로 정한 공용 풀의 코어 고정 여부
+std::atomic<bool> pinSharedWorkers{false};
+
+// 참여자 수 상한: 설정값, 없으면 하드웨어 스레드 수 (wasm이나 알 수 없으면 FALLBACK_THREADS)
+inline int hardwareThreads() {
+    int limit = threadLimit.load(std::memory_order_relaxed);
+    if (limit > 0) return std::min(limit, ThreadPool::MAX_PARTICIPANTS);
+#if defined(__EMSCRIPTEN__)
+    return FALLBACK_THREADS;
+#else
+    unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? std::min(static_cast<int>(count), ThreadPool::MAX_PARTICIPANTS) : FALLBACK_THREADS;
+#endif
+}
+
+// *word가 아직 expected이면 깨울 때까지 잠듦 (가짜 깨어남 허용)
+// futex가 없는 플랫폼은 전역 조건 변수로 대신합니다.
+#if SIGN_HAS_THREADS && defined(__EMSCRIPTEN__)
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    emscripten_futex_wait(reinterpret_cast<volatile void*>(word), expected, 1e30);
+}
+void futexWake(std::atomic<uint32_t>* word, int count) {
+    emscripten_futex_wake(reinterpret_cast<volatile void*>(word), count);
+}
+#elif SIGN_HAS_THREADS && defined(__linux__)
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+void futexWake(std::atomic<uint32_t>* word, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#else
+std::mutex parkMutex;
+std::condition_variable parkCondition;
+
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    std::unique_lock<std::mutex> lock(parkMutex);
+    parkCondition.wait(lock, [&]() { return word->load() != expected; });
+}
+void futexWake(std::atomic<uint32_t>*, int) {
+    { std::lock_guard<std::mutex> lock(parkMutex); }
+    parkCondition.notify_all();
+}
+#endif
+
+// 스레드가 참여 중인 풀과 참여자 번호
+struct ParticipantContext {
+    const ThreadPool* pool = nullptr;
+    int index = -1;
+};
+thread_local ParticipantContext currentContext;
+
+// 훔칠 대상을 고르는 스레드별 난수
+inline uint32_t nextRandom() {
+    thread_local uint32_t state =
+        0x9e3779b9u ^ static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// 분할 조각 작업의 storage 내용
+struct RangeChunk {
+    void* job;
+    int begin;
+    int end;
+    int slot;  // RangeJob::chunks 안의 칸 (끝나면 비움)
+};
+
+// 비어 있는 칸 하나를 잡아 번호를 돌려줌 (이미 limit개가 쓰이는 중이면 -1)
+inline int acquireSlot(std::atomic<uint64_t>& used, int limit) {
+    uint64_t current = used.load(std::memory_order_relaxed);
+    for (;;) {
+        int slot = 0;
+        while (slot < limit && (current & (uint64_t(1) << slot)) != 0) slot++;
+        if (slot == limit) return -1;
+        if (used.compare_exchange_weak(current, current | (uint64_t(1) << slot), std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+            return slot;
+        }
+    }
+}
+
+} // namespace
+
+// === Chase–Lev 덱 (Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models") ===
+
+bool WorkDeque::push(PoolTask* task) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY) return false;
+    buffer[b & (CAPACITY - 1)].store(task, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+PoolTask* WorkDeque::pop() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    PoolTask* task = buffer[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (t == b) {
+        // 마지막 하나: 훔치는 쪽과 top CAS로 경쟁
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+PoolTask* WorkDeque::steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+
+    PoolTask* task = buffer[t & (CAPACITY - 1)].load(std::memory_order_acquire);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+int64_t WorkDeque::size() const {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_relaxed);
+    return std::max<int64_t>(b - t, 0);
+}
+
+// === 풀 ===
+
+ThreadPool::ThreadPool(int threads, bool pinWorkers)
+    : participants(SIGN_HAS_THREADS ? std::max(1, std::min(threads, hardwareThreads())) : 1),
+      pinnedWorkers(pinWorkers),
+      stopping(false),
+      epoch(0),
+      sleepers(0) {
+    slots.reserve(participants);
+    for (int p = 0; p < participants; p++) slots.emplace_back(new Participant());
+
+#if SIGN_HAS_THREADS
+    workers.reserve(participants - 1);
+    for (int p = 1; p < participants; p++) {
+        workers.emplace_back([this, p]() { workerLoop(p); });
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+        if (pinWorkers) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(p % hardwareThreads(), &cpus);
+            pthread_setaffinity_np(workers.back().native_handle(), sizeof(cpus), &cpus);
+        }
+#endif
+    }
+#endif
+    (void)pinWorkers;
+}
+
+ThreadPool::~ThreadPool() {
+    stopping.store(true);
+    epoch.fetch_add(1);
+    futexWake(&epoch, INT_MAX);
+    for (auto& worker : workers) worker.join();
+}
+
+void ThreadPool::setThreadLimit(int limit) {
+    threadLimit.store(std::max(0, limit), std::memory_order_relaxed);
+}
+
+void ThreadPool::setPinWorkers(bool pin) {
+    pinSharedWorkers.store(pin, std::memory_order_relaxed);
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::shared() {
+    static std::mutex sharedMutex;
+    static std::weak_ptr<ThreadPool> sharedPool;
+
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    std::shared_ptr<ThreadPool> pool = sharedPool.lock();
+    if (!pool) {
+        pool = std::make_shared<ThreadPool>(hardwareThreads(), pinSharedWorkers.load(std::memory_order_relaxed));
+        sharedPool = pool;
+    }
+    return pool;
+}
+
+int ThreadPool::currentParticipant() const {
+    if (participants == 1) return -1;
+    return currentContext.pool == this ? currentContext.index : -1;
+}
+
+int ThreadPool::enter(bool& acquired) {
+    acquired = false;
+    if (participants == 1) return -1;
+    if (currentContext.pool == this) return currentContext.index;
+    if (currentContext.pool != nullptr || !callerMutex.try_lock()) return -1;
+
+    acquired = true;
+    currentContext.pool = this;
+    currentContext.index = 0;
+    return 0;
+}
+
+void ThreadPool::leave(bool acquired) {
+    if (!acquired) return;
+    currentContext = ParticipantContext();
+    callerMutex.unlock();
+}
+
+void ThreadPool::submit(int participant, PoolTask* task) {
+    if (!slots[participant]->deque.push(task)) {
+        execute(task);
+        return;
+    }
+    notify(false);
+}
+
+void ThreadPool::execute(PoolTask* task) {
+    // 조각 작업은 실행이 끝나면 칸을 비워 곧바로 재사용될 수 있고, 완료를 알리면 호출자가 작업 메모리를
+    // 해제할 수 있으므로 필요한 값은 실행 전에 읽음
+    std::atomic<int>* pending = task->pending;
+    bool heap = task->heap;
+    task->run(task);
+    if (heap) delete task;
+    pending->fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::notify(bool all) {
+    // 잠들기 직전의 작업자는 sleepers를 올린 뒤 덱을 다시 확인하므로, 둘 중 하나는 반드시 상대를 봄
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) == 0) return;
+    epoch.fetch_add(1, std::memory_order_release);
+    futexWake(&epoch, all ? INT_MAX : 1);
+}
+
+PoolTask* ThreadPool::findTask(int participant, bool stealMailboxes) {
+    Participant& self = *slots[participant];
+    PoolTask* task = self.mailbox.exchange(nullptr, std::memory_order_acquire);
+    if (task == nullptr) task = self.deque.pop();
+    if (task != nullptr) return task;
+
+    int start = static_cast<int>(nextRandom() % participants);
+    for (int i = 0; i < participants; i++) {
+        int victim = (start + i) % participants;
+        if (victim == participant) continue;
+        if ((task = slots[victim]->deque.steal()) != nullptr) return task;
+    }
+    if (stealMailboxes) {
+        for (int i = 0; i < participants; i++) {
+            int victim = (start + i) % participants;
+            if (victim == participant || slots[victim]->mailbox.load(std::memory_order_relaxed) == nullptr) continue;
+            if ((task = slots[victim]->mailbox.exchange(nullptr, std::memory_order_acquire)) != nullptr) return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::helpUntilDone(int participant, std::atomic<int>& pending) {
+    for (int spins = 0; pending.load(std::memory_order_acquire) != 0;) {
+        PoolTask* task = findTask(participant, spins >= SPIN_BEFORE_MAILBOX_STEAL);
+        if (task != nullptr) {
+            execute(task);
+            spins = 0;
+        } else {
+            backoff(spins++);
+        }
+    }
+}
+
+void ThreadPool::workerLoop(int participant) {
+    currentContext.pool = this;
+    currentContext.index = participant;
+
+    for (int spins = 0;;) {
+        if (stopping.load(std::memory_order_acquire)) return;
+
+        PoolTask* task = findTask(participant, spins >= SPIN_BEFORE_MAILBOX_STEAL);
+        if (task != nullptr) {
+            execute(task);
+            spins = 0;
+            continue;
+        }
+        if (++spins < SPIN_LIMIT) {
+            backoff(spins);
+            continue;
+        }
+
+        // 잠들기: sleepers를 올린 뒤 한 번 더 확인 (notify와 짝)
+        uint32_t seen = epoch.load(std::memory_order_acquire);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        task = findTask(participant, true);
+        if (task == nullptr && !stopping.load(std::memory_order_acquire)) futexWait(&epoch, seen);
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        if (task != nullptr) execute(task);
+        spins = 0;
+    }
+}
+
+void ThreadPool::runIndexed(int tasks, IndexFn fn, void* context, int width) {
+    if (tasks <= 0) return;
+
+    bool acquired;
+    int self = tasks > 1 && width > 1 ? enter(acquired) : -1;
+    if (self < 0) {
+        for (int t = 0; t < tasks; t++) fn(context, t);
+        return;
+    }
+
+    // 몫 하나 = 작업 first, first + step, ... (참여자 하나가 차례로 실행)
+    struct IndexedShare {
+        IndexFn fn;
+        void* context;
+        int first;
+        int step;
+        int tasks;
+    };
+    auto runShare = [](PoolTask* task) {
+        const IndexedShare* share = reinterpret_cast<const IndexedShare*>(task->storage);
+        for (int t = share->first; t < share->tasks; t += share->step) share->fn(share->context, t);
+    };
+
+    // 다른 참여자 몫은 우편함(비어 있지 않으면 자기 덱)에 넣고, 자기 몫은 바로 실행
+    // 중첩 호출에서 self ≥ width이면 self % width 몫을 직접 맡음
+    const int own = self % width;
+    std::atomic<int> pending(0);
+    PoolTask posted[MAX_PARTICIPANTS];
+    for (int target = 0; target < width && target < tasks; target++) {
+        if (target == own) continue;
+
+        PoolTask& task = posted[target];
+        new (task.storage) IndexedShare{fn, context, target, width, tasks};
+        task.run = runShare;
+        task.pending = &pending;
+        pending.fetch_add(1, std::memory_order_relaxed);
+
+        PoolTask* empty = nullptr;
+        if (!slots[target]->mailbox.compare_exchange_strong(empty, &task, std::memory_order_release)) {
+            if (!slots[self]->deque.push(&task)) execute(&task);
+        }
+    }
+    notify(true);
+
+    for (int t = own; t < tasks; t += width) fn(context, t);
+    helpUntilDone(self, pending);
+    leave(acquired);
+}
+
+void ThreadPool::runRange(int begin, int end, int grain, RangeFn fn, void* context, int width) {
+    if (begin >= end) return;
+
+    const int count = end - begin;
+    if (grain <= 0) grain = std::max(1, count / (width * CHUNKS_PER_PARTICIPANT));
+
+    bool acquired;
+    int self = count > grain && width > 1 ? enter(acquired) : -1;
+    if (self < 0) {
+        fn(context, begin, end);
+        return;
+    }
+
+    RangeJob job;
+    job.pool = this;
+    job.invoke = fn;
+    job.context = context;
+    job.grain = grain;
+    job.maxChunks = width - 1;
+    job.pending.store(0, std::memory_order_relaxed);
+    job.usedChunks.store(0, std::memory_order_relaxed);
+
+    executeRange(job, self, begin, end);
+    helpUntilDone(self, job.pending);
+    leave(acquired);
+}
+
+void ThreadPool::executeRange(RangeJob& job, int participant, int begin, int end) {
+    WorkDeque& deque = job.pool->slots[participant]->deque;
+
+    while (begin < end) {
+        // 덱이 비어 있으면(다른 참여자가 훔쳐 갔거나 처음이면) 뒤쪽 절반을 내놓음
+        // 칸이 모두 쓰이는 중이면(참여자 상한) 나누지 않고 계속 실행
+        if (end - begin > job.grain && deque.size() == 0) {
+            int slot = acquireSlot(job.usedChunks, job.maxChunks);
+            if (slot >= 0) {
+                int middle = begin + (end - begin) / 2;
+                PoolTask& chunk = job.chunks[slot];
+                new (chunk.storage) RangeChunk{&job, middle, end, slot};
+                chunk.run = &ThreadPool::runChunk;
+                chunk.pending = &job.pending;
+                job.pending.fetch_add(1, std::memory_order_relaxed);
+                job.pool->submit(participant, &chunk);
+                end = middle;
+                continue;
+            }
+        }
+
+        int stop = std::min(end, begin + job.grain);
+        job.invoke(job.context, begin, stop);
+        begin = stop;
+    }
+}
+
+void ThreadPool::runChunk(PoolTask* task) {
+    const RangeChunk* chunk = reinterpret_cast<const RangeChunk*>(task->storage);
+    RangeJob& job = *static_cast<RangeJob*>(chunk->job);
+    executeRange(job, job.pool->currentParticipant(), chunk->begin, chunk->end);
+    job.usedChunks.fetch_and(~(uint64_t(1) << chunk->slot), std::memory_order_release);
+}
+
+// === 작업 그룹 ===
+
+TaskGroup::TaskGroup(ThreadPool* pool, int maxParticipants)
+    : pool(pool),
+      participant(-1),
+      acquired(false),
+      limit(pool != nullptr ? pool->participantsFor(maxParticipants) : 1),
+      pending(0) {
+    if (pool != nullptr && limit > 1) participant = pool->enter(acquired);
+}
+
+TaskGroup::~TaskGroup() {
+    wait();
+    if (pool != nullptr) pool->leave(acquired);
+}
+
+void TaskGroup::wait() {
+    if (participant >= 0) pool->helpUntilDone(participant, pending);
+}
@@ -0,0 +1,229 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "threading.h"
+
+// 풀에서 실행되는 작업 하나
+// 작은 호출 객체는 storage에 직접 담고, parallelFor의 작업은 호출자 스택의 고정 배열에 두어 할당하지 않습니다.
+struct PoolTask {
+    static constexpr size_t STORAGE_BYTES = 48;
+
+    void (*run)(PoolTask* task) = nullptr;
+    std::atomic<int>* pending = nullptr;  // 실행이 끝나면 1 감소 (그룹/parallelFor 완료 카운터)
+    bool heap = false;                    // true면 실행한 스레드가 delete
+    alignas(16) unsigned char storage[STORAGE_BYTES];
+};
+
+// Chase–Lev 작업 훔치기 덱
+// 소유자만 bottom 쪽에서 push/pop(LIFO, 캐시에 남은 최근 작업 우선)하고,
+// 다른 참여자는 top 쪽에서 CAS 하나로 훔칩니다(FIFO, 큰 범위 조각 우선).
+class WorkDeque {
+public:
+    static constexpr int64_t CAPACITY = 1024;
+
+    // 가득 차면 false (호출자가 바로 실행)
+    bool push(PoolTask* task);
+    PoolTask* pop();
+    PoolTask* steal();
+
+    // 대략적인 길이 (소유자가 분할 여부를 판단할 때만 사용)
+    int64_t size() const;
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom{0};
+    std::atomic<PoolTask*> buffer[CAPACITY] = {};
+};
+
+// 엔진 공용 작업 훔치기 스레드 풀
+// - 참여자마다 Chase–Lev 덱을 두고, 일이 없는 참여자는 임의의 다른 덱에서 훔칩니다.
+// - 호출 스레드(풀 밖 스레드)가 참여자 0이 되어 함께 일하고, 작업자 size() - 1개가 상주합니다.
+// - 유휴 작업자는 잠시 스핀한 뒤 futex(Linux, Emscripten pthreads)로 잠들어 CPU를 쓰지 않습니다.
+// - 스레드가 없는 빌드(SIGN_HAS_THREADS == 0)나 다른 스레드가 참여자 0을 쓰는 중이면 호출 스레드에서 순서대로 실행합니다.
+// - 작업 안에서 다시 parallelFor/TaskGroup을 호출해도 되며, 기다리는 동안 다른 작업을 돕습니다.
+// - 호출마다 maxParticipants로 동시에 일하는 참여자 수를 제한할 수 있습니다 (0이면 풀 전체).
+class ThreadPool {
+public:
+    // 참여자 수 상한 (parallelFor의 조각 배열을 스택에 고정 크기로 두기 위함)
+    static constexpr int MAX_PARTICIPANTS = 64;
+
+    // threads: 호출 스레드를 포함한 참여자 수 (하드웨어 스레드 수와 MAX_PARTICIPANTS를 넘지 않음)
+    // pinWorkers: 네이티브 Linux에서 작업자 p를 코어 p에 고정
+    explicit ThreadPool(int threads, bool pinWorkers = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return participants; }
+    bool pinned() const { return pinnedWorkers; }
+
+    // 프로세스에 하나뿐인 공용 풀 (없으면 만들고, 마지막 소유자가 놓으면 해제)
+    // 인식기/배치 추론/영상 처리가 각자 스레드를 만들지 않고 하나의 풀을 나눠 씁니다.
+    // 크기는 만들 때 한 번 정해지며(setThreadLimit 값, 없으면 하드웨어 스레드 수), 사용자별 스레드 수는
+    // 풀 크기가 아니라 호출마다 넘기는 maxParticipants로 정합니다.
+    static std::shared_ptr<ThreadPool> shared();
+
+    // 참여자 수 상한 (0이면 하드웨어 스레드 수), 이후에 만드는 풀부터 적용
+    // 코어가 적은 환경에서 병렬 경로를 테스트/재현할 때 사용합니다.
+    static void setThreadLimit(int limit);
+
+    // 공용 풀의 작업자 코어 고정 여부, 이후에 만드는 공용 풀부터 적용
+    static void setPinWorkers(bool pin);
+
+    // maxParticipants를 이 풀에서 실제로 쓰일 참여자 수로 (0 이하면 size())
+    int participantsFor(int maxParticipants) const {
+        return maxParticipants > 0 && maxParticipants < participants ? maxParticipants : participants;
+    }
+
+    // fn(task)를 task = 0 .. tasks-1에 대해 실행하고 모두 끝날 때까지 대기
+    // 작업 t는 참여자 t % n(n = participantsFor(maxParticipants))의 몫이며, 같은 몫의 작업은 그 참여자의
+    // 우편함에 하나로 묶여 놓이므로 레이어를 출력 행으로 나누면 같은 가중치 조각이 매 프레임 같은 코어에서
+    // 처리됩니다 (그 참여자가 바쁘면 다른 참여자가 몫 전체를 훔침).
+    template <typename Fn>
+    void parallelFor(int tasks, Fn& fn, int maxParticipants = 0) {
+        runIndexed(tasks, &invokeIndex<Fn>, &fn, participantsFor(maxParticipants));
+    }
+
+    // fn(begin, end)를 [begin, end)를 나눈 조각들에 대해 실행하고 모두 끝날 때까지 대기
+    // grain: 조각의 최대 길이 (0이면 범위 / (참여자 × 8))
+    // 조각은 게으른 이진 분할로 만들어집니다: 자기 덱이 비었을 때만(즉 다른 참여자가 훔쳐 갔을 때만)
+    // 남은 범위의 뒤쪽 절반을 덱에 내놓으므로, 한가한 참여자가 없으면 분할 비용이 거의 없습니다.
+    // 내놓았지만 끝나지 않은 조각은 참여자 수 − 1개를 넘지 않으므로 동시에 일하는 스레드도 그 안에 머뭅니다.
+    template <typename Fn>
+    void parallelFor(int begin, int end, int grain, Fn& fn, int maxParticipants = 0) {
+        runRange(begin, end, grain, &invokeRange<Fn>, &fn, participantsFor(maxParticipants));
+    }
+
+private:
+    friend class TaskGroup;
+
+    using IndexFn = void (*)(void* context, int task);
+    using RangeFn = void (*)(void* context, int begin, int end);
+
+    struct RangeJob {
+        ThreadPool* pool;
+        RangeFn invoke;
+        void* context;
+        int grain;
+        int maxChunks;                       // 동시에 내놓을 수 있는 조각 수 (참여자 수 − 1)
+        std::atomic<int> pending;
+        std::atomic<uint64_t> usedChunks;    // chunks 중 사용 중인 칸 (조각이 끝나면 비워 재사용)
+        PoolTask chunks[MAX_PARTICIPANTS - 1];
+    };
+
+    // 참여자마다 하나: 덱 + 지정 작업 우편함 (서로 다른 캐시 라인)
+    struct Participant {
+        WorkDeque deque;
+        alignas(CACHE_LINE_SIZE) std::atomic<PoolTask*> mailbox{nullptr};
+    };
+
+    template <typename Fn>
+    static void invokeIndex(void* context, int task) {
+        (*static_cast<Fn*>(context))(task);
+    }
+
+    template <typename Fn>
+    static void invokeRange(void* context, int begin, int end) {
+        (*static_cast<Fn*>(context))(begin, end);
+    }
+
+    void runIndexed(int tasks, IndexFn fn, void* context, int width);
+    void runRange(int begin, int end, int grain, RangeFn fn, void* context, int width);
+    static void executeRange(RangeJob& job, int participant, int begin, int end);
+    static void runChunk(PoolTask* task);
+
+    // 현재 스레드의 참여자 번호 (참여 중이 아니면 -1)
+    int currentParticipant() const;
+
+    // 현재 스레드의 참여자 번호 (풀 밖 스레드는 참여자 0을 점유, 실패하면 -1)
+    int enter(bool& acquired);
+    void leave(bool acquired);
+
+    void submit(int participant, PoolTask* task);
+    void execute(PoolTask* task);
+    PoolTask* findTask(int participant, bool stealMailboxes);
+    void helpUntilDone(int participant, std::atomic<int>& pending);
+    void notify(bool all);
+    void workerLoop(int participant);
+
+    int participants;
+    bool pinnedWorkers;
+    std::vector<std::unique_ptr<Participant>> slots;
+    std::vector<std::thread> workers;
+    std::mutex callerMutex;  // 풀 밖 스레드 하나만 참여자 0이 됨
+    std::atomic<bool> stopping;
+
+    // 유휴 작업자 재우기: 작업을 넣은 쪽은 잠든 작업자가 있을 때만 epoch를 올리고 깨움
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch;
+    alignas(CACHE_LINE_SIZE) std::atomic<int> sleepers;
+};
+
+// 독립 작업 묶음: run()으로 넣고 wait()로 모두 끝나기를 기다림 (소멸자도 기다림)
+// 그룹을 만든 스레드가 참여자가 되며, 그룹의 작업 안에서도 run()을 호출할 수 있습니다.
+// pool이 nullptr이거나 참여할 수 없으면 run()이 즉시 실행합니다.
+// maxParticipants(0이면 풀 전체)를 주면 대기 중인 작업이 그 수 − 1개일 때 run()이 즉시 실행하므로,
+// 그룹의 작업을 동시에 실행하는 스레드가 그 수를 넘지 않습니다.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool* pool, int maxParticipants = 0);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename Fn>
+    void run(Fn&& fn) {
+        using Stored = typename std::decay<Fn>::type;
+        static_assert(sizeof(Stored) <= PoolTask::STORAGE_BYTES && alignof(Stored) <= 16,
+                      "task closure is too large; capture by reference");
+        int current = pool != nullptr ? pool->currentParticipant() : -1;
+        if (current < 0 || !reserve()) {
+            fn();
+            return;
+        }
+        PoolTask* task = new PoolTask();
+        new (task->storage) Stored(std::forward<Fn>(fn));
+        task->run = &invokeStored<Stored>;
+        task->pending = &pending;
+        task->heap = true;
+        pool->submit(current, task);
+    }
+
+    void wait();
+
+private:
+    // 대기 중인 작업 칸 하나를 잡음 (이미 limit − 1개면 false)
+    bool reserve() {
+        int outstanding = pending.load(std::memory_order_relaxed);
+        do {
+            if (outstanding >= limit - 1) return false;
+        } while (!pending.compare_exchange_weak(outstanding, outstanding + 1, std::memory_order_relaxed));
+        return true;
+    }
+
+    template <typename Stored>
+    static void invokeStored(PoolTask* task) {
+        Stored* fn = reinterpret_cast<Stored*>(task->storage);
+        (*fn)();
+        fn->~Stored();
+    }
+
+    ThreadPool* pool;
+    int participant;
+    bool acquired;
+    int limit;
+    std::atomic<int> pending;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,16 @@
+#ifndef THREADING_H
+#define THREADING_H
+
+// 스레드 사용 가능 여부
+// Emscripten은 -pthread(make THREADS=1)로 빌드했을 때만 std::thread를 지원하며,
+// 그 외에는 백그라운드 작업을 호출 스레드에서 동기적으로 수행합니다.
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define SIGN_HAS_THREADS 0
+#else
+#define SIGN_HAS_THREADS 1
+#endif
+
+// false sharing 방지를 위한 캐시 라인 크기
+constexpr int CACHE_LINE_SIZE = 64;
+
+#endif // THREADING_H
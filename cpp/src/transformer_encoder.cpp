@@ -0,0 +1,406 @@
+#include "transformer_encoder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+#include "output_head.h"
+
+namespace {
+
+constexpr float LAYER_NORM_EPSILON = 1e-5f;
+
+inline float horizontalSum(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    lo = _mm_add_ps(lo, hi);
+    __m128 shuf = _mm_movehdup_ps(lo);
+    __m128 sums = _mm_add_ps(lo, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+// 8개 벡터 각각의 합을 한 벡터로 (hadd 세 단계)
+inline __m256 transposeSum8(const __m256* v) {
+    __m256 t0 = _mm256_hadd_ps(v[0], v[1]);
+    __m256 t1 = _mm256_hadd_ps(v[2], v[3]);
+    __m256 t2 = _mm256_hadd_ps(v[4], v[5]);
+    __m256 t3 = _mm256_hadd_ps(v[6], v[7]);
+    __m256 u0 = _mm256_hadd_ps(t0, t1);
+    __m256 u1 = _mm256_hadd_ps(t2, t3);
+    return _mm256_add_ps(_mm256_permute2f128_ps(u0, u1, 0x20), _mm256_permute2f128_ps(u0, u1, 0x31));
+}
+
+// 층 정규화: out = (x − μ) / σ · gain + bias (dim은 8의 배수)
+void layerNorm(const float* x, const float* gain, const float* bias, int dim, float* out) {
+    __m256 sum = _mm256_setzero_ps();
+    for (int i = 0; i < dim; i += SIMD_WIDTH) sum = _mm256_add_ps(sum, _mm256_load_ps(x + i));
+    const __m256 mean = _mm256_set1_ps(horizontalSum(sum) / dim);
+    __m256 squares = _mm256_setzero_ps();
+    for (int i = 0; i < dim; i += SIMD_WIDTH) {
+        __m256 centered = _mm256_sub_ps(_mm256_load_ps(x + i), mean);
+        squares = _mm256_add_ps(squares, _mm256_mul_ps(centered, centered));
+    }
+    const __m256 invStd = _mm256_set1_ps(1.0f / std::sqrt(horizontalSum(squares) / dim + LAYER_NORM_EPSILON));
+    for (int i = 0; i < dim; i += SIMD_WIDTH) {
+        __m256 centered = _mm256_sub_ps(_mm256_load_ps(x + i), mean);
+        __m256 scaled = _mm256_mul_ps(_mm256_mul_ps(centered, invStd), _mm256_loadu_ps(gain + i));
+        _mm256_store_ps(out + i, _mm256_add_ps(scaled, _mm256_loadu_ps(bias + i)));
+    }
+}
+
+// x += y (dim은 8의 배수)
+void addInPlace(float* x, const float* y, int dim) {
+    for (int i = 0; i < dim; i += SIMD_WIDTH) {
+        _mm256_store_ps(x + i, _mm256_add_ps(_mm256_load_ps(x + i), _mm256_load_ps(y + i)));
+    }
+}
+
+// 질의 하나, 헤드 하나의 주의 (headDim은 8의 배수)
+// score_j = q·k_j · scale − slope · distance_j → softmax → out = Σ p_j v_j
+// 키 8개의 내적을 누적 벡터 8개로 동시에 계산하고 hadd로 모아 점수 8개를 한 번에 씀
+void attendHead(const float* q, const float* keys, const float* values, int rowStride, int rows,
+                const float* distance, float slope, float scale, int headDim, float* scores, float* out) {
+    const __m256 scaleVec = _mm256_set1_ps(scale);
+    const __m256 slopeVec = _mm256_set1_ps(slope);
+    int j = 0;
+    for (; j + SIMD_WIDTH <= rows; j += SIMD_WIDTH) {
+        __m256 acc[SIMD_WIDTH];
+        for (int r = 0; r < SIMD_WIDTH; r++) acc[r] = _mm256_setzero_ps();
+        for (int c = 0; c < headDim; c += SIMD_WIDTH) {
+            const __m256 qv = _mm256_loadu_ps(q + c);
+            for (int r = 0; r < SIMD_WIDTH; r++) {
+                const float* key = keys + static_cast<size_t>(j + r) * rowStride + c;
+                acc[r] = _mm256_add_ps(acc[r], _mm256_mul_ps(qv, _mm256_loadu_ps(key)));
+            }
+        }
+        __m256 s = _mm256_mul_ps(transposeSum8(acc), scaleVec);
+        s = _mm256_sub_ps(s, _mm256_mul_ps(slopeVec, _mm256_loadu_ps(distance + j)));
+        _mm256_storeu_ps(scores + j, s);
+    }
+    for (; j < rows; j++) {
+        __m256 acc = _mm256_setzero_ps();
+        const float* key = keys + static_cast<size_t>(j) * rowStride;
+        for (int c = 0; c < headDim; c += SIMD_WIDTH) {
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(q + c), _mm256_loadu_ps(key + c)));
+        }
+        scores[j] = horizontalSum(acc) * scale - slope * distance[j];
+    }
+
+    float best = scores[0];
+    for (int r = 1; r < rows; r++) best = std::max(best, scores[r]);
+    const float inv = 1.0f / expShiftSum(scores, rows, best, scores);
+
+    for (int c = 0; c < headDim; c += SIMD_WIDTH) _mm256_storeu_ps(out + c, _mm256_setzero_ps());
+    for (int r = 0; r < rows; r++) {
+        const __m256 p = _mm256_set1_ps(scores[r] * inv);
+        const float* value = values + static_cast<size_t>(r) * rowStride;
+        for (int c = 0; c < headDim; c += SIMD_WIDTH) {
+            _mm256_storeu_ps(out + c, _mm256_add_ps(_mm256_loadu_ps(out + c),
+                                                    _mm256_mul_ps(p, _mm256_loadu_ps(value + c))));
+        }
+    }
+}
+
+// 행 우선 [outputs][inputs] 가중치 배열 확인 후 패킹
+bool packArray(const std::map<std::string, NpyArray>& arrays, const std::string& name, int outputs, int inputs,
+               DenseLayer& layer, std::string& error) {
+    auto w = arrays.find(name + "_w");
+    auto b = arrays.find(name + "_b");
+    if (w == arrays.end() || b == arrays.end()) {
+        error = "missing " + name + "_w/" + name + "_b";
+        return false;
+    }
+    if (w->second.shape.size() != 2 || w->second.shape[0] != outputs || w->second.shape[1] != inputs ||
+        static_cast<int>(b->second.size()) != outputs) {
+        error = name + " shape mismatch";
+        return false;
+    }
+    std::vector<float> weights = w->second.toFloat();
+    std::vector<float> bias = b->second.toFloat();
+    layer.pack(weights.data(), bias.data(), outputs, inputs);
+    return true;
+}
+
+bool loadNorm(const std::map<std::string, NpyArray>& arrays, const std::string& name, int dim,
+              std::vector<float>& gain, std::vector<float>& bias, std::string& error) {
+    auto g = arrays.find(name + "_g");
+    auto b = arrays.find(name + "_b");
+    if (g == arrays.end() || b == arrays.end() || static_cast<int>(g->second.size()) != dim ||
+        static_cast<int>(b->second.size()) != dim) {
+        error = "missing or mismatched " + name + "_g/" + name + "_b";
+        return false;
+    }
+    gain = g->second.toFloat();
+    bias = b->second.toFloat();
+    return true;
+}
+
+// [-limit, limit) 균등 난수 (LCG)
+void fillRandom(std::vector<float>& values, size_t count, float limit, uint32_t& seed) {
+    values.resize(count);
+    for (float& v : values) {
+        seed = seed * 1664525u + 1013904223u;
+        v = (static_cast<float>(seed >> 8) / 16777216.0f * 2.0f - 1.0f) * limit;
+    }
+}
+
+void randomLayer(DenseLayer& layer, int outputs, int inputs, uint32_t& seed) {
+    std::vector<float> weights, bias;
+    fillRandom(weights, static_cast<size_t>(outputs) * inputs, std::sqrt(6.0f / (inputs + outputs)), seed);
+    fillRandom(bias, outputs, 0.01f, seed);
+    layer.pack(weights.data(), bias.data(), outputs, inputs);
+}
+
+} // namespace
+
+TransformerEncoder::TransformerEncoder() : bufferRows(0) {}
+
+bool TransformerEncoder::validateConfig(std::string& error) const {
+    const TransformerConfig& c = settings;
+    if (c.inputDim <= 0 || c.heads <= 0 || c.layers <= 0 || c.window <= 0 || c.classes <= 0) {
+        error = "invalid transformer dimensions";
+        return false;
+    }
+    if (c.modelDim % (c.heads * SIMD_WIDTH) != 0 || c.ffDim % SIMD_WIDTH != 0) {
+        error = "modelDim must be a multiple of heads x 8 and ffDim a multiple of 8";
+        return false;
+    }
+    return true;
+}
+
+bool TransformerEncoder::loadFromArrays(const std::map<std::string, NpyArray>& arrays, int heads, int window,
+                                        std::string& error) {
+    auto embedWeights = arrays.find("embed_w");
+    if (embedWeights == arrays.end() || embedWeights->second.shape.size() != 2) {
+        error = "missing embed_w";
+        return false;
+    }
+    auto ff1Weights = arrays.find("l0_ff1_w");
+    auto headWeights = arrays.find("head_w");
+    if (ff1Weights == arrays.end() || headWeights == arrays.end() || ff1Weights->second.shape.empty() ||
+        headWeights->second.shape.empty()) {
+        error = "missing l0_ff1_w or head_w";
+        return false;
+    }
+
+    TransformerConfig loaded;
+    loaded.modelDim = embedWeights->second.shape[0];
+    loaded.inputDim = embedWeights->second.shape[1];
+    loaded.heads = heads;
+    loaded.window = window;
+    loaded.ffDim = ff1Weights->second.shape[0];
+    loaded.classes = headWeights->second.shape[0];
+    loaded.layers = 0;
+    while (arrays.count("l" + std::to_string(loaded.layers) + "_qkv_w")) loaded.layers++;
+
+    // 검증이 끝날 때까지 기존 모델 유지
+    TransformerEncoder next;
+    next.settings = loaded;
+    if (!next.validateConfig(error)) return false;
+    const int d = loaded.modelDim;
+    if (!packArray(arrays, "embed", d, loaded.inputDim, next.embed, error)) return false;
+    next.blocks.resize(loaded.layers);
+    for (int l = 0; l < loaded.layers; l++) {
+        const std::string prefix = "l" + std::to_string(l) + "_";
+        Block& block = next.blocks[l];
+        if (!loadNorm(arrays, prefix + "ln1", d, block.norm1Gain, block.norm1Bias, error) ||
+            !packArray(arrays, prefix + "qkv", 3 * d, d, block.qkv, error) ||
+            !packArray(arrays, prefix + "out", d, d, block.out, error) ||
+            !loadNorm(arrays, prefix + "ln2", d, block.norm2Gain, block.norm2Bias, error) ||
+            !packArray(arrays, prefix + "ff1", loaded.ffDim, d, block.ff1, error) ||
+            !packArray(arrays, prefix + "ff2", d, loaded.ffDim, block.ff2, error)) {
+            return false;
+        }
+    }
+    if (!loadNorm(arrays, "final_ln", d, next.finalGain, next.finalBias, error) ||
+        !packArray(arrays, "head", loaded.classes, d, next.head, error)) {
+        return false;
+    }
+
+    settings = next.settings;
+    embed = std::move(next.embed);
+    blocks = std::move(next.blocks);
+    finalGain = std::move(next.finalGain);
+    finalBias = std::move(next.finalBias);
+    head = std::move(next.head);
+    // 헤드 h의 기울기 2^(−8(h+1)/H)
+    slopes.resize(heads);
+    for (int h = 0; h < heads; h++) slopes[h] = std::pow(2.0f, -8.0f * (h + 1) / heads);
+    bufferRows = 0;
+    return true;
+}
+
+bool TransformerEncoder::loadFromNpzBuffer(const uint8_t* data, size_t size, int heads, int window,
+                                           std::string& error) {
+    std::map<std::string, NpyArray> arrays;
+    if (!NpzReader::parse(data, size, arrays, error)) return false;
+    return loadFromArrays(arrays, heads, window, error);
+}
+
+bool TransformerEncoder::initializeRandom(const TransformerConfig& config, uint32_t seed, std::string& error) {
+    TransformerConfig previous = settings;
+    settings = config;
+    if (!validateConfig(error)) {
+        settings = previous;
+        return false;
+    }
+    const int d = config.modelDim;
+    randomLayer(embed, d, config.inputDim, seed);
+    blocks.assign(config.layers, Block());
+    for (Block& block : blocks) {
+        block.norm1Gain.assign(d, 1.0f);
+        block.norm1Bias.assign(d, 0.0f);
+        block.norm2Gain.assign(d, 1.0f);
+        block.norm2Bias.assign(d, 0.0f);
+        randomLayer(block.qkv, 3 * d, d, seed);
+        randomLayer(block.out, d, d, seed);
+        randomLayer(block.ff1, config.ffDim, d, seed);
+        randomLayer(block.ff2, d, config.ffDim, seed);
+    }
+    finalGain.assign(d, 1.0f);
+    finalBias.assign(d, 0.0f);
+    randomLayer(head, config.classes, d, seed);
+    slopes.resize(config.heads);
+    for (int h = 0; h < config.heads; h++) slopes[h] = std::pow(2.0f, -8.0f * (h + 1) / config.heads);
+    bufferRows = 0;
+    return true;
+}
+
+TransformerState TransformerEncoder::createState() const {
+    TransformerState state;
+    const size_t rows = static_cast<size_t>(settings.window) * settings.modelDim;
+    state.keys.assign(blocks.size(), AlignedFloatVector(rows, 0.0f));
+    state.values.assign(blocks.size(), AlignedFloatVector(rows, 0.0f));
+    return state;
+}
+
+void TransformerEncoder::prepareBuffers(int rows) {
+    if (rows <= bufferRows) return;
+    const size_t n = static_cast<size_t>(rows);
+    const int d = settings.modelDim;
+    input.assign(n * embed.stride, 0.0f);
+    hidden.assign(n * d, 0.0f);
+    normed.assign(n * d, 0.0f);
+    qkvRows.assign(n * 3 * d, 0.0f);
+    attention.assign(n * d, 0.0f);
+    projected.assign(n * d, 0.0f);
+    feedForward.assign(n * settings.ffDim, 0.0f);
+    logitRows.assign(n * padToSimd(settings.classes), 0.0f);
+    const size_t span = std::max(rows, settings.window);
+    scores.assign(span, 0.0f);
+    distances.assign(span, 0.0f);
+    bufferRows = rows;
+}
+
+template <typename Attend>
+void TransformerEncoder::encodeRows(const float* features, int rows, float* logits, Attend&& attend) {
+    const int d = settings.modelDim;
+    const int ff = settings.ffDim;
+    const int classes = settings.classes;
+    const int classStride = padToSimd(classes);
+    prepareBuffers(rows);
+
+    for (int r = 0; r < rows; r++) {
+        std::memcpy(&input[static_cast<size_t>(r) * embed.stride], features + static_cast<size_t>(r) * settings.inputDim,
+                    sizeof(float) * settings.inputDim);
+    }
+    embed.forwardBatch(input.data(), embed.stride, hidden.data(), d, rows, false);
+
+    for (size_t l = 0; l < blocks.size(); l++) {
+        const Block& block = blocks[l];
+        for (int r = 0; r < rows; r++) {
+            layerNorm(&hidden[static_cast<size_t>(r) * d], block.norm1Gain.data(), block.norm1Bias.data(), d,
+                      &normed[static_cast<size_t>(r) * d]);
+        }
+        block.qkv.forwardBatch(normed.data(), d, qkvRows.data(), 3 * d, rows, false);
+        attend(static_cast<int>(l), qkvRows.data(), attention.data());
+        block.out.forwardBatch(attention.data(), d, projected.data(), d, rows, false);
+        addInPlace(hidden.data(), projected.data(), rows * d);
+
+        for (int r = 0; r < rows; r++) {
+            layerNorm(&hidden[static_cast<size_t>(r) * d], block.norm2Gain.data(), block.norm2Bias.data(), d,
+                      &normed[static_cast<size_t>(r) * d]);
+        }
+        block.ff1.forwardBatch(normed.data(), d, feedForward.data(), ff, rows, true);
+        block.ff2.forwardBatch(feedForward.data(), ff, projected.data(), d, rows, false);
+        addInPlace(hidden.data(), projected.data(), rows * d);
+    }
+
+    for (int r = 0; r < rows; r++) {
+        layerNorm(&hidden[static_cast<size_t>(r) * d], finalGain.data(), finalBias.data(), d,
+                  &normed[static_cast<size_t>(r) * d]);
+    }
+    head.forwardBatch(normed.data(), d, logitRows.data(), classStride, rows, false);
+    if (logits != nullptr) {
+        for (int r = 0; r < rows; r++) {
+            std::memcpy(logits + static_cast<size_t>(r) * classes, &logitRows[static_cast<size_t>(r) * classStride],
+                        sizeof(float) * classes);
+        }
+    }
+}
+
+void TransformerEncoder::stepBatch(TransformerState* const* states, const float* features, int count, float* logits) {
+    if (empty() || count <= 0) return;
+    const int d = settings.modelDim;
+    const int heads = settings.heads;
+    const int headDim = d / heads;
+    const int window = settings.window;
+    const float scale = 1.0f / std::sqrt(static_cast<float>(headDim));
+
+    encodeRows(features, count, logits, [&](int layer, const float* qkv, float* out) {
+        for (int r = 0; r < count; r++) {
+            TransformerState& state = *states[r];
+            const float* row = qkv + static_cast<size_t>(r) * 3 * d;
+            const int slot = static_cast<int>(state.position % window);
+            float* keys = state.keys[layer].data();
+            float* values = state.values[layer].data();
+            std::memcpy(keys + static_cast<size_t>(slot) * d, row + d, sizeof(float) * d);
+            std::memcpy(values + static_cast<size_t>(slot) * d, row + 2 * d, sizeof(float) * d);
+
+            // 링의 채워진 칸 [0, filled)와 새 프레임으로부터의 거리
+            const int filled = static_cast<int>(std::min<int64_t>(state.position + 1, window));
+            for (int s = 0; s < filled; s++) distances[s] = static_cast<float>((slot - s + window) % window);
+            for (int h = 0; h < heads; h++) {
+                attendHead(row + h * headDim, keys + h * headDim, values + h * headDim, d, filled, distances.data(),
+                           slopes[h], scale, headDim, scores.data(), out + static_cast<size_t>(r) * d + h * headDim);
+            }
+        }
+    });
+    for (int r = 0; r < count; r++) states[r]->position++;
+}
+
+int TransformerEncoder::step(TransformerState& state, const float* features, float* logits) {
+    if (empty()) return -1;
+    TransformerState* states[1] = {&state};
+    stepBatch(states, features, 1, nullptr);
+    const float* row = logitRows.data();
+    if (logits != nullptr) std::memcpy(logits, row, sizeof(float) * settings.classes);
+    return static_cast<int>(std::max_element(row, row + settings.classes) - row);
+}
+
+void TransformerEncoder::encodeSequence(const float* features, int frames, float* logits) {
+    if (empty() || frames <= 0) return;
+    const int d = settings.modelDim;
+    const int heads = settings.heads;
+    const int headDim = d / heads;
+    const int window = settings.window;
+    const float scale = 1.0f / std::sqrt(static_cast<float>(headDim));
+
+    encodeRows(features, frames, logits, [&](int, const float* qkv, float* out) {
+        const size_t rowStride = static_cast<size_t>(3) * d;
+        for (int t = 0; t < frames; t++) {
+            const int first = std::max(0, t - window + 1);
+            const int rows = t - first + 1;
+            for (int j = 0; j < rows; j++) distances[j] = static_cast<float>(t - first - j);
+            const float* query = qkv + t * rowStride;
+            const float* keys = qkv + first * rowStride + d;
+            const float* values = qkv + first * rowStride + 2 * d;
+            for (int h = 0; h < heads; h++) {
+                attendHead(query + h * headDim, keys + h * headDim, values + h * headDim, 3 * d, rows,
+                           distances.data(), slopes[h], scale, headDim, scores.data(),
+                           out + static_cast<size_t>(t) * d + h * headDim);
+            }
+        }
+    });
+}
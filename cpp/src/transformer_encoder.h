@@ -0,0 +1,109 @@
+#ifndef TRANSFORMER_ENCODER_H
+#define TRANSFORMER_ENCODER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "mlp_model.h"
+#include "npz_reader.h"
+
+// 트랜스포머 인코더 구성
+struct TransformerConfig {
+    int inputDim = 126;   // 프레임 특징 (왼손 63 + 오른손 63)
+    int modelDim = 64;    // heads × 8의 배수
+    int heads = 4;
+    int ffDim = 128;      // 8의 배수
+    int layers = 2;
+    int window = 32;      // 주의 범위 T (현재 프레임 포함 최근 T프레임)
+    int classes = 4;
+};
+
+// 스트림 하나의 스트리밍 상태: 레이어별 키/값 링 버퍼 (window × modelDim 행)
+// 모델 객체와 분리되어 있어 스트림마다 하나씩 두고 같은 인코더로 처리합니다.
+struct TransformerState {
+    std::vector<AlignedFloatVector> keys;
+    std::vector<AlignedFloatVector> values;
+    int64_t position = 0;   // 지금까지 넣은 프레임 수
+
+    void reset() { position = 0; }
+};
+
+// 랜드마크 특징 시퀀스용 사전 정규화(pre-LN) 트랜스포머 인코더
+// 입력 투영 → [LN → 다중 헤드 주의 → 잔차, LN → FFN(ReLU) → 잔차] × layers → LN → 분류층
+// 위치 정보는 헤드별 기울기의 거리 비례 감점(ALiBi)으로 주므로 절대 위치 임베딩이 없고,
+// 캐시된 키/값은 창이 밀려도 그대로 유효합니다.
+// 각 프레임은 레이어마다 자신을 포함한 최근 window프레임에만 주의하는 인과적 창 주의이며,
+// step()은 새 프레임의 Q/K/V만 계산해 링에 넣으므로 프레임당 비용이 O(d² + T·d)입니다.
+// 투영/FFN/분류층은 SignRecognition과 같은 DenseLayer 커널(여러 행이면 GEMM)을 쓰고,
+// 주의 점수는 키 8개를 한 번에 내적해 hadd로 모으며 softmax는 융합 exp/합(output_head.h)을 씁니다.
+// 작업 버퍼를 객체에 두므로 한 객체는 한 스레드에서 사용합니다.
+class TransformerEncoder {
+public:
+    TransformerEncoder();
+
+    // NPZ 배열 로드 (heads, window는 모양으로 알 수 없어 따로 지정)
+    // embed_w/b, l{i}_ln1_g/b, l{i}_qkv_w/b ([3d][d], Q·K·V 순), l{i}_out_w/b, l{i}_ln2_g/b,
+    // l{i}_ff1_w/b, l{i}_ff2_w/b, final_ln_g/b, head_w/b
+    bool loadFromArrays(const std::map<std::string, NpyArray>& arrays, int heads, int window, std::string& error);
+    bool loadFromNpzBuffer(const uint8_t* data, size_t size, int heads, int window, std::string& error);
+
+    // 재현 가능한 난수 가중치 (벤치마크/구조 확인용)
+    bool initializeRandom(const TransformerConfig& config, uint32_t seed, std::string& error);
+
+    bool empty() const { return blocks.empty(); }
+    const TransformerConfig& config() const { return settings; }
+
+    // 빈 상태 생성 (링 버퍼 할당)
+    TransformerState createState() const;
+
+    // 스트림 하나에 한 프레임 추가, logits(classes개, nullptr 가능) 기록 후 최대 클래스 반환
+    int step(TransformerState& state, const float* features, float* logits);
+
+    // 서로 다른 스트림 count개에 한 프레임씩 추가 (투영/FFN은 한 번의 GEMM, step과 float 오차 범위 안에서 같음)
+    // features: count × inputDim, logits: count × classes
+    void stepBatch(TransformerState* const* states, const float* features, int count, float* logits);
+
+    // 빈 상태에서 시작한 frames개 시퀀스 전체를 한꺼번에 계산
+    // (step을 frames번 부른 결과와 float 오차 범위 안에서 같음, 누적 순서가 달라 비트 단위로는 다를 수 있음)
+    // features: frames × inputDim, logits: frames × classes
+    void encodeSequence(const float* features, int frames, float* logits);
+
+private:
+    struct Block {
+        std::vector<float> norm1Gain, norm1Bias;
+        DenseLayer qkv;   // d → 3d
+        DenseLayer out;   // d → d
+        std::vector<float> norm2Gain, norm2Bias;
+        DenseLayer ff1;   // d → ff (ReLU)
+        DenseLayer ff2;   // ff → d
+    };
+
+    // 행 rows개를 전 레이어에 통과, attend(block, qkv, attention)가 주의 결과를 채움
+    template <typename Attend>
+    void encodeRows(const float* features, int rows, float* logits, Attend&& attend);
+    void prepareBuffers(int rows);
+    bool validateConfig(std::string& error) const;
+
+    TransformerConfig settings;
+    DenseLayer embed;
+    std::vector<Block> blocks;
+    std::vector<float> finalGain, finalBias;
+    DenseLayer head;
+    std::vector<float> slopes;   // 헤드별 ALiBi 기울기
+
+    // 작업 버퍼 (행 × 패딩 폭)
+    int bufferRows;
+    AlignedFloatVector input;
+    AlignedFloatVector hidden;
+    AlignedFloatVector normed;
+    AlignedFloatVector qkvRows;
+    AlignedFloatVector attention;
+    AlignedFloatVector projected;
+    AlignedFloatVector feedForward;
+    AlignedFloatVector logitRows;
+    AlignedFloatVector scores;
+    AlignedFloatVector distances;
+};
+
+#endif // TRANSFORMER_ENCODER_H
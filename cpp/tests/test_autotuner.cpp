@@ -0,0 +1,111 @@
+#include <cstdio>
+#include "autotuner.h"
+#include "sign_recognition.h"
+#include "test_framework.h"
+#include "test_support.h"
+#include "thread_pool.h"
+
+namespace {
+
+MlpModel smallModel() {
+    MlpModel model;
+    std::vector<float> w1 = randomValues(32 * 20, 1), b1 = randomValues(32, 2, 0.1f);
+    std::vector<float> w2 = randomValues(4 * 32, 3), b2 = randomValues(4, 4, 0.1f);
+    model.addLayer(w1.data(), b1.data(), 32, 20);
+    model.addLayer(w2.data(), b2.data(), 4, 32);
+    return model;
+}
+
+} // namespace
+
+TEST(tuneProfileRoundTrips) {
+    TuneProfile profile;
+    profile.shape = "20x32x4";
+    profile.config.gemmKernel = GemmKernel::Rows4Frames3;
+    profile.config.sparseFrameTile = 8;
+    profile.config.batchTile = 16;
+    profile.formats = {LayerFormat::BlockSparse, LayerFormat::Dense};
+    profile.threads = 3;
+
+    TuneProfile parsed;
+    CHECK(Autotuner::parse(Autotuner::serialize(profile), parsed));
+    CHECK(parsed.threads == 3);
+    CHECK(parsed.shape == profile.shape);
+    CHECK(parsed.config.gemmKernel == GemmKernel::Rows4Frames3);
+    CHECK(parsed.config.sparseFrameTile == 8);
+    CHECK(parsed.config.batchTile == 16);
+    CHECK(parsed.formats == profile.formats);
+
+    CHECK(Autotuner::parse("signtune v1 shape=20x32x4 formats=DD", parsed) && parsed.threads == 0);   // 이전 프로파일
+    CHECK(!Autotuner::parse("", parsed));
+    CHECK(!Autotuner::parse("signtune v9 shape=1x2", parsed));
+
+    const std::string path = "/tmp/sign_wasm_tune_test.txt";
+    CHECK(Autotuner::saveFile(path, profile));
+    TuneProfile loaded;
+    CHECK(Autotuner::loadFile(path, loaded));
+    CHECK(loaded.formats == profile.formats && loaded.shape == profile.shape);
+    std::remove(path.c_str());
+}
+
+TEST(applyChecksModelShape) {
+    MlpModel model = smallModel();
+    TuneProfile profile;
+    profile.shape = model.shapeSignature();
+    profile.config.batchTile = 8;
+    profile.formats = {LayerFormat::BlockSparse, LayerFormat::Dense};
+    CHECK(Autotuner::apply(profile, model));
+    CHECK(model.kernelConfig.batchTile == 8);
+    CHECK(model.layers[0].format == LayerFormat::BlockSparse);
+
+    profile.shape = "126x128x64x4";
+    MlpModel other = smallModel();
+    CHECK(!Autotuner::apply(profile, other));
+    CHECK(other.layers[0].format == LayerFormat::Dense);
+}
+
+TEST(tuneKeepsModelOutputs) {
+    MlpModel model = smallModel();
+    const int batch = 19;
+    std::vector<float> input = randomValues(static_cast<size_t>(batch) * 20, 7);
+    std::vector<float> before(static_cast<size_t>(batch) * 4), after(before.size());
+    model.forwardBatch(input.data(), before.data(), batch);
+
+    TuneProfile profile = Autotuner::tune(model, 16);
+    CHECK(profile.shape == model.shapeSignature());
+    CHECK(profile.formats.size() == model.layers.size());
+    model.forwardBatch(input.data(), after.data(), batch);
+    CHECK(maxAbsDiff(before.data(), after.data(), before.size()) < 1e-4f);
+}
+
+TEST(tuneBenchmarksThreadsThroughIntraOpPool) {
+    ThreadPool::setThreadLimit(4);
+    {
+        ThreadPool pool(4);
+        MlpModel model = smallModel();
+        CHECK(Autotuner::tune(model, 16).threads == 0);   // 풀이 없으면 측정하지 않음
+
+        model.intraOpPool = &pool;
+        model.intraOpThreads = 3;
+        TuneProfile profile = Autotuner::tune(model, 16);
+        CHECK(profile.threads >= 1 && profile.threads <= 3);   // 현재 상한 이하에서만 고름
+        CHECK(model.intraOpThreads == profile.threads);
+
+        profile.threads = 2;
+        CHECK(Autotuner::apply(profile, model));
+        CHECK(model.intraOpThreads == 2);
+
+        SignRecognition recognition;
+        recognition.setThreads(4);
+        TuneProfile tuned;
+        CHECK(Autotuner::parse(recognition.autotune(), tuned));
+        CHECK(tuned.threads >= 1 && tuned.threads <= 4);
+        CHECK(recognition.getThreads() == tuned.threads);
+
+        tuned.threads = 2;
+        CHECK(recognition.loadTuneProfile(Autotuner::serialize(tuned)));
+        CHECK(recognition.getThreads() == 2);
+        recognition.setThreads(1);
+    }
+    ThreadPool::setThreadLimit(0);
+}
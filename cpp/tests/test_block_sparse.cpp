@@ -0,0 +1,126 @@
+#include <algorithm>
+#include "mlp_model.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 0인 8×1 블록 개수 (행 우선 가중치 기준)
+int countZeroBlocks(const DenseLayer& layer) {
+    std::vector<float> rowMajor;
+    layer.unpack(rowMajor);
+    int zero = 0;
+    for (int rb = 0; rb * SPARSE_BLOCK_ROWS < layer.outDim; rb++) {
+        for (int c = 0; c < layer.inDim; c++) {
+            bool allZero = true;
+            for (int r = rb * SPARSE_BLOCK_ROWS; r < std::min(layer.outDim, (rb + 1) * SPARSE_BLOCK_ROWS); r++) {
+                allZero = allZero && rowMajor[static_cast<size_t>(r) * layer.inDim + c] == 0.0f;
+            }
+            zero += allZero;
+        }
+    }
+    return zero;
+}
+
+DenseLayer randomLayer(int outputs, int inputs, uint32_t seed) {
+    std::vector<float> weights = randomValues(static_cast<size_t>(outputs) * inputs, seed);
+    std::vector<float> bias = randomValues(outputs, seed + 1, 0.1f);
+    DenseLayer layer;
+    layer.pack(weights.data(), bias.data(), outputs, inputs);
+    return layer;
+}
+
+} // namespace
+
+TEST(pruneRemovesExactCountWithTiedNorms) {
+    // 모든 블록의 노름이 같아도 요청한 비율만큼만 0이 되어야 함
+    std::vector<float> weights(16 * 32, 0.5f);
+    std::vector<float> bias(16, 0.0f);
+    DenseLayer layer;
+    layer.pack(weights.data(), bias.data(), 16, 32);
+    layer.pruneByMagnitude(0.25f);
+    CHECK(countZeroBlocks(layer) == 16);   // 64블록의 25%
+
+    // 양자화된 값 두 종류: 작은 쪽 블록(절반)보다 적게 요청하면 정확히 그만큼만
+    for (int r = 0; r < 16; r++) {
+        for (int c = 0; c < 32; c++) weights[r * 32 + c] = (c % 2 == 0) ? 0.25f : 1.0f;
+    }
+    layer.pack(weights.data(), bias.data(), 16, 32);
+    layer.pruneByMagnitude(0.1f);
+    CHECK(countZeroBlocks(layer) == 6);    // floor(0.1 × 64)
+}
+
+TEST(pruneKeepsLargestBlocks) {
+    DenseLayer layer = randomLayer(24, 40, 11);
+    std::vector<float> before;
+    layer.unpack(before);
+    layer.pruneByMagnitude(0.5f);
+    std::vector<float> after;
+    layer.unpack(after);
+
+    // 남은 블록의 최소 노름 ≥ 지워진 블록의 최대 노름
+    float keptMin = 1e30f;
+    float prunedMax = 0.0f;
+    for (int rb = 0; rb < 3; rb++) {
+        for (int c = 0; c < 40; c++) {
+            float norm = 0.0f;
+            for (int r = rb * 8; r < rb * 8 + 8; r++) norm += before[r * 40 + c] * before[r * 40 + c];
+            bool kept = after[rb * 8 * 40 + c] != 0.0f;
+            if (kept) keptMin = std::min(keptMin, norm);
+            else prunedMax = std::max(prunedMax, norm);
+        }
+    }
+    CHECK(countZeroBlocks(layer) == 60);
+    CHECK(keptMin >= prunedMax);
+}
+
+TEST(blockSparseMatchesDenseKernels) {
+    DenseLayer sparse = randomLayer(40, 70, 21);
+    sparse.pruneByMagnitude(0.75f);
+    CHECK(sparse.format == LayerFormat::BlockSparse);
+    CHECK_NEAR(sparse.measureDensity(), 0.25f, 0.01f);
+
+    DenseLayer dense = sparse;
+    dense.setFormat(LayerFormat::Dense);
+    CHECK(dense.format == LayerFormat::Dense);
+
+    const int batch = 13;
+    AlignedFloatVector input(static_cast<size_t>(batch) * dense.stride, 0.0f);
+    std::vector<float> values = randomValues(static_cast<size_t>(batch) * 70, 5);
+    for (int f = 0; f < batch; f++) {
+        for (int i = 0; i < 70; i++) input[static_cast<size_t>(f) * dense.stride + i] = values[f * 70 + i];
+    }
+
+    AlignedFloatVector expected(40), actual(40);
+    dense.forward(input.data(), expected.data(), true);
+    sparse.forward(input.data(), actual.data(), true);
+    CHECK(maxAbsDiff(expected.data(), actual.data(), 40) < 1e-5f);
+
+    AlignedFloatVector denseBatch(static_cast<size_t>(batch) * 40), sparseBatch(static_cast<size_t>(batch) * 40);
+    KernelConfig config;
+    for (int tile : {4, 8}) {
+        config.sparseFrameTile = tile;
+        dense.forwardBatch(input.data(), dense.stride, denseBatch.data(), 40, batch, false, config);
+        sparse.forwardBatch(input.data(), dense.stride, sparseBatch.data(), 40, batch, false, config);
+        CHECK(maxAbsDiff(denseBatch.data(), sparseBatch.data(), denseBatch.size()) < 1e-5f);
+    }
+}
+
+TEST(prunedModelBatchMatchesSingleFrame) {
+    MlpModel model;
+    std::vector<float> w1 = randomValues(64 * 126, 1), b1 = randomValues(64, 2, 0.1f);
+    std::vector<float> w2 = randomValues(5 * 64, 3), b2 = randomValues(5, 4, 0.1f);
+    model.addLayer(w1.data(), b1.data(), 64, 126);
+    model.addLayer(w2.data(), b2.data(), 5, 64);
+    model.pruneByMagnitude(0.8f);
+    CHECK(model.layers[0].format == LayerFormat::BlockSparse);
+
+    const int batch = 37;
+    std::vector<float> input = randomValues(static_cast<size_t>(batch) * 126, 9);
+    std::vector<float> batched(static_cast<size_t>(batch) * 5), single(5);
+    model.forwardBatch(input.data(), batched.data(), batch);
+    for (int f = 0; f < batch; f++) {
+        model.forward(&input[static_cast<size_t>(f) * 126], single.data());
+        CHECK(maxAbsDiff(single.data(), &batched[static_cast<size_t>(f) * 5], 5) < 1e-4f);
+    }
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "clahe.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+int referenceLuma(const uint8_t* p) {
+    return (77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8;
+}
+
+// 타일 중심 사이 선형 보간 (가장자리 중심 바깥은 한 타일)
+void referenceTiles(const std::vector<int>& bounds, int position, int& first, int& second, float& weight) {
+    const int tiles = static_cast<int>(bounds.size()) - 1;
+    auto center = [&](int t) { return 0.5f * (bounds[t] + bounds[t + 1] - 1); };
+    first = second = 0;
+    weight = 0.0f;
+    if (position <= center(0)) return;
+    if (position >= center(tiles - 1)) {
+        first = second = tiles - 1;
+        return;
+    }
+    while (center(first + 1) <= position) first++;
+    second = first + 1;
+    weight = (position - center(first)) / (center(second) - center(first));
+}
+
+// 스칼라 CLAHE: 타일 히스토그램 → 클립/재분배 → 누적 LUT → 쌍선형 보간 → 휘도 변화량을 R/G/B에 더함
+void referenceClahe(uint8_t* rgba, int width, int height, const ClaheConfig& config) {
+    const int tilesX = std::max(1, std::min(config.tilesX, width));
+    const int tilesY = std::max(1, std::min(config.tilesY, height));
+    std::vector<int> boundsX(tilesX + 1), boundsY(tilesY + 1);
+    for (int t = 0; t <= tilesX; t++) boundsX[t] = static_cast<int>(static_cast<int64_t>(t) * width / tilesX);
+    for (int t = 0; t <= tilesY; t++) boundsY[t] = static_cast<int>(static_cast<int64_t>(t) * height / tilesY);
+
+    std::vector<float> luts(static_cast<size_t>(tilesX) * tilesY * 256);
+    for (int ty = 0; ty < tilesY; ty++) {
+        for (int tx = 0; tx < tilesX; tx++) {
+            std::vector<uint32_t> h(256, 0);
+            for (int y = boundsY[ty]; y < boundsY[ty + 1]; y++) {
+                for (int x = boundsX[tx]; x < boundsX[tx + 1]; x++) h[referenceLuma(rgba + (y * width + x) * 4)]++;
+            }
+            const int pixels = (boundsX[tx + 1] - boundsX[tx]) * (boundsY[ty + 1] - boundsY[ty]);
+            float* lut = &luts[(static_cast<size_t>(ty) * tilesX + tx) * 256];
+            const uint32_t clip = std::max(1u, static_cast<uint32_t>(config.clipLimit * pixels / 256));
+            uint32_t excess = 0;
+            for (uint32_t& count : h) {
+                if (count > clip) {
+                    excess += count - clip;
+                    count = clip;
+                }
+            }
+            uint32_t residual = excess % 256;
+            for (uint32_t& count : h) count += excess / 256;
+            const int step = residual > 0 ? std::max(1, 256 / static_cast<int>(residual)) : 256;
+            for (int i = 0; i < 256 && residual > 0; i += step, residual--) h[i]++;
+            uint32_t cumulative = 0;
+            for (int i = 0; i < 256; i++) {
+                cumulative += h[i];
+                lut[i] = cumulative * (255.0f / pixels);
+            }
+        }
+    }
+
+    for (int y = 0; y < height; y++) {
+        int ty0, ty1;
+        float wy;
+        referenceTiles(boundsY, y, ty0, ty1, wy);
+        for (int x = 0; x < width; x++) {
+            int tx0, tx1;
+            float wx;
+            referenceTiles(boundsX, x, tx0, tx1, wx);
+            uint8_t* p = rgba + (y * width + x) * 4;
+            const int luma = referenceLuma(p);
+            auto at = [&](int ty, int tx) { return luts[(static_cast<size_t>(ty) * tilesX + tx) * 256 + luma]; };
+            float upper = at(ty0, tx0) + wx * (at(ty0, tx1) - at(ty0, tx0));
+            float lower = at(ty1, tx0) + wx * (at(ty1, tx1) - at(ty1, tx0));
+            int delta = static_cast<int>(std::lrintf(upper + wy * (lower - upper))) - luma;
+            for (int c = 0; c < 3; c++) p[c] = static_cast<uint8_t>(std::min(255, std::max(0, p[c] + delta)));
+        }
+    }
+}
+
+// 어두운 그라디언트 + 잡음 (휘도 대략 10–90, 불투명도는 픽셀마다 다름)
+std::vector<uint8_t> darkImage(int width, int height, uint32_t seed) {
+    std::vector<float> noise = randomValues(static_cast<size_t>(width) * height, seed, 12.0f);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float base = 15.0f + 60.0f * x / width + 20.0f * y / height + noise[y * width + x];
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, base + 12.0f)));
+            p[1] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, base)));
+            p[2] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, base - 8.0f)));
+            p[3] = static_cast<uint8_t>((x * 7 + y * 13) & 0xFF);
+        }
+    }
+    return rgba;
+}
+
+} // namespace
+
+TEST(claheMatchesScalarReference) {
+    // 너비 101: 8픽셀 SIMD 경로와 나머지 스칼라 경로, 고르지 않은 타일 경계를 함께 확인
+    const int width = 101, height = 67;
+    std::vector<uint8_t> image = darkImage(width, height, 5);
+    std::vector<uint8_t> expected = image;
+    referenceClahe(expected.data(), width, height, ClaheConfig());
+
+    ClaheFilter filter;
+    CHECK(filter.apply(image.data(), width, height, false, nullptr));
+
+    // SIMD 경로와 스칼라 나머지가 같은 반올림을 쓰므로 정확히 일치
+    CHECK(image == expected);
+
+    // 같은 크기 재사용 시 결과가 같음 (버퍼 초기화 확인)
+    std::vector<uint8_t> again = darkImage(width, height, 5);
+    CHECK(filter.apply(again.data(), width, height, false, nullptr));
+    CHECK(again == image);
+}
+
+TEST(claheKeepsChromaAndAlpha) {
+    const int width = 64, height = 48;
+    std::vector<uint8_t> original = darkImage(width, height, 9);
+    std::vector<uint8_t> image = original;
+    ClaheFilter filter;
+    CHECK(filter.apply(image.data(), width, height, false, nullptr));
+
+    int brightened = 0;
+    for (size_t i = 0; i < image.size(); i += 4) {
+        CHECK(image[i + 3] == original[i + 3]);
+        // 포화하지 않은 픽셀은 R/G/B가 같은 양만큼 이동
+        if (image[i] < 255 && image[i + 2] > 0 && original[i + 2] > 0) {
+            CHECK(image[i] - image[i + 1] == original[i] - original[i + 1]);
+            CHECK(image[i + 1] - image[i + 2] == original[i + 1] - original[i + 2]);
+        }
+        brightened += image[i + 1] > original[i + 1];
+    }
+    // 어두운 영상은 대부분 밝아짐
+    CHECK(brightened > width * height / 2);
+}
+
+TEST(claheAutoModeSkipsBrightFrames) {
+    const int width = 40, height = 30;
+    std::vector<uint8_t> bright(static_cast<size_t>(width) * height * 4, 200);
+    std::vector<uint8_t> before = bright;
+    ClaheFilter filter;
+    CHECK(!filter.apply(bright.data(), width, height, true, nullptr));
+    CHECK(bright == before);
+    CHECK_NEAR(filter.lastMeanLuma(), 200.0f, 1e-3f);
+
+    // 기준을 넘기면 같은 영상도 적용
+    filter.setDarkMeanLuma(255.0f);
+    CHECK(filter.apply(bright.data(), width, height, true, nullptr));
+
+    std::vector<uint8_t> dark = darkImage(width, height, 3);
+    CHECK(filter.apply(dark.data(), width, height, true, nullptr));
+    CHECK(filter.lastMeanLuma() < 70.0f);
+    CHECK(!filter.apply(nullptr, width, height, false, nullptr));
+    CHECK(!filter.apply(dark.data(), 0, height, false, nullptr));
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "crop_align.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 좌표마다 다른 값을 갖는 RGBA 패턴 (보간 결과를 확인하기 쉽도록 부드러운 변화 + 잡음)
+std::vector<uint8_t> patternImage(int width, int height, uint32_t seed) {
+    std::vector<float> noise = randomValues(static_cast<size_t>(width) * height, seed, 20.0f);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+            float n = noise[y * width + x];
+            p[0] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, 200.0f * x / width + n + 20.0f)));
+            p[1] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, 200.0f * y / height - n + 20.0f)));
+            p[2] = static_cast<uint8_t>((x * 5 + y * 3) & 0xFF);
+            p[3] = static_cast<uint8_t>(255 - ((x + y) & 0x3F));
+        }
+    }
+    return rgba;
+}
+
+// 출력 픽셀 중심의 역변환 + 가장자리 복제 쌍선형 보간 (double)
+std::vector<uint8_t> referenceWarp(const std::vector<uint8_t>& rgba, int width, int height,
+                                   const SimilarityTransform& t, int size) {
+    std::vector<uint8_t> out(static_cast<size_t>(size) * size * 4);
+    const double scale2 = static_cast<double>(t.a) * t.a + static_cast<double>(t.b) * t.b;
+    auto pixel = [&](int x, int y, int c) {
+        x = std::min(std::max(x, 0), width - 1);
+        y = std::min(std::max(y, 0), height - 1);
+        return static_cast<double>(rgba[(static_cast<size_t>(y) * width + x) * 4 + c]);
+    };
+    for (int v = 0; v < size; v++) {
+        for (int u = 0; u < size; u++) {
+            double du = u + 0.5 - t.tx, dv = v + 0.5 - t.ty;
+            double x = (t.a * du + t.b * dv) / scale2 - 0.5;
+            double y = (-t.b * du + t.a * dv) / scale2 - 0.5;
+            int x0 = static_cast<int>(std::floor(x)), y0 = static_cast<int>(std::floor(y));
+            double wx = x - x0, wy = y - y0;
+            for (int c = 0; c < 4; c++) {
+                double upper = pixel(x0, y0, c) + wx * (pixel(x0 + 1, y0, c) - pixel(x0, y0, c));
+                double lower = pixel(x0, y0 + 1, c) + wx * (pixel(x0 + 1, y0 + 1, c) - pixel(x0, y0 + 1, c));
+                out[(static_cast<size_t>(v) * size + u) * 4 + c] =
+                    static_cast<uint8_t>(upper + wy * (lower - upper) + 0.5);
+            }
+        }
+    }
+    return out;
+}
+
+int maxByteDiff(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    int worst = 0;
+    for (size_t i = 0; i < a.size(); i++) worst = std::max(worst, std::abs(a[i] - b[i]));
+    return worst;
+}
+
+// 원 모양 표식 (정규화 중심, 반지름 픽셀)
+void paintDisc(std::vector<uint8_t>& rgba, int width, int height, float cx, float cy, int radius, uint8_t r,
+               uint8_t g, uint8_t b) {
+    const int px = static_cast<int>(cx * width), py = static_cast<int>(cy * height);
+    for (int y = std::max(0, py - radius); y <= std::min(height - 1, py + radius); y++) {
+        for (int x = std::max(0, px - radius); x <= std::min(width - 1, px + radius); x++) {
+            if ((x - px) * (x - px) + (y - py) * (y - py) > radius * radius) continue;
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = r;
+            p[1] = g;
+            p[2] = b;
+        }
+    }
+}
+
+const uint8_t* cropPixel(const std::vector<uint8_t>& crop, int size, float u, float v) {
+    return &crop[(static_cast<size_t>(v * size) * size + static_cast<size_t>(u * size)) * 4];
+}
+
+} // namespace
+
+TEST(estimateSimilarityRecoversKnownTransform) {
+    const float angle = 0.6f, scale = 1.7f;
+    SimilarityTransform truth;
+    truth.a = scale * std::cos(angle);
+    truth.b = scale * std::sin(angle);
+    truth.tx = 12.5f;
+    truth.ty = -4.0f;
+
+    std::vector<float> source = randomValues(2 * 9, 17, 50.0f);
+    std::vector<float> target(source.size());
+    for (size_t i = 0; i < source.size(); i += 2) {
+        target[i] = truth.a * source[i] - truth.b * source[i + 1] + truth.tx;
+        target[i + 1] = truth.b * source[i] + truth.a * source[i + 1] + truth.ty;
+    }
+
+    SimilarityTransform estimated;
+    CHECK(estimateSimilarity(source.data(), target.data(), 9, estimated));
+    CHECK_NEAR(estimated.a, truth.a, 1e-4f);
+    CHECK_NEAR(estimated.b, truth.b, 1e-4f);
+    CHECK_NEAR(estimated.tx, truth.tx, 1e-3f);
+    CHECK_NEAR(estimated.ty, truth.ty, 1e-3f);
+
+    // 두 점은 정확히 맞음
+    CHECK(estimateSimilarity(source.data(), target.data(), 2, estimated));
+    for (int i = 0; i < 2; i++) {
+        CHECK_NEAR(estimated.a * source[i * 2] - estimated.b * source[i * 2 + 1] + estimated.tx, target[i * 2], 1e-3f);
+        CHECK_NEAR(estimated.b * source[i * 2] + estimated.a * source[i * 2 + 1] + estimated.ty, target[i * 2 + 1],
+                   1e-3f);
+    }
+
+    // 점이 한 곳에 모이거나 부족하면 실패
+    const float same[6] = {3.0f, 4.0f, 3.0f, 4.0f, 3.0f, 4.0f};
+    CHECK(!estimateSimilarity(same, target.data(), 3, estimated));
+    CHECK(!estimateSimilarity(source.data(), target.data(), 1, estimated));
+}
+
+TEST(warpSimilarityMatchesBilinearReference) {
+    const int width = 90, height = 70;
+    std::vector<uint8_t> image = patternImage(width, height, 4);
+
+    // 항등 변환은 그대로 복사
+    SimilarityTransform identity;
+    std::vector<uint8_t> copy(static_cast<size_t>(64) * 64 * 4);
+    warpSimilarity(image.data(), width, height, identity, 64, copy.data());
+    for (int y = 0; y < 64; y++) {
+        CHECK(std::equal(copy.begin() + y * 64 * 4, copy.begin() + (y + 1) * 64 * 4,
+                         image.begin() + static_cast<size_t>(y) * width * 4));
+    }
+
+    // 회전 + 축소 + 영상 밖 영역 (size 45: SIMD 8픽셀 경로와 나머지 경로 모두)
+    SimilarityTransform rotated;
+    rotated.a = 0.55f * std::cos(0.4f);
+    rotated.b = 0.55f * std::sin(0.4f);
+    rotated.tx = -3.0f;
+    rotated.ty = -8.0f;
+    const int size = 45;
+    std::vector<uint8_t> warped(static_cast<size_t>(size) * size * 4);
+    warpSimilarity(image.data(), width, height, rotated, size, warped.data());
+    CHECK(maxByteDiff(warped, referenceWarp(image, width, height, rotated, size)) <= 1);
+}
+
+TEST(alignHandCropPlacesWristAndKnuckleOnTemplate) {
+    const int width = 160, height = 120;
+    std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4, 128);
+    // 손목(0)은 오른쪽 위, 중지 MCP(9)는 왼쪽 아래: 정렬하면 손목이 아래, MCP가 가운데 위로
+    std::vector<float> landmarks(63, 0.0f);
+    landmarks[0] = 0.7f;
+    landmarks[1] = 0.3f;
+    landmarks[27] = 0.4f;
+    landmarks[28] = 0.6f;
+    paintDisc(image, width, height, 0.7f, 0.3f, 6, 250, 10, 10);
+    paintDisc(image, width, height, 0.4f, 0.6f, 6, 10, 10, 250);
+
+    const int size = 64;
+    std::vector<uint8_t> crop(static_cast<size_t>(size) * size * 4);
+    CHECK(alignHandCrop(image.data(), width, height, landmarks.data(), 63, size, crop.data()));
+    const uint8_t* wrist = cropPixel(crop, size, 0.5f, 0.88f);
+    const uint8_t* knuckle = cropPixel(crop, size, 0.5f, 0.52f);
+    CHECK(wrist[0] > 200 && wrist[2] < 60);
+    CHECK(knuckle[2] > 200 && knuckle[0] < 60);
+
+    // 42개(x, y) 입력도 같은 결과
+    std::vector<float> flat(42);
+    for (int i = 0; i < 21; i++) {
+        flat[i * 2] = landmarks[i * 3];
+        flat[i * 2 + 1] = landmarks[i * 3 + 1];
+    }
+    std::vector<uint8_t> flatCrop(crop.size());
+    CHECK(alignHandCrop(image.data(), width, height, flat.data(), 42, size, flatCrop.data()));
+    CHECK(flatCrop == crop);
+
+    CHECK(!alignHandCrop(image.data(), width, height, landmarks.data(), 40, size, crop.data()));
+    landmarks[27] = landmarks[0];
+    landmarks[28] = landmarks[1];
+    CHECK(!alignHandCrop(image.data(), width, height, landmarks.data(), 63, size, crop.data()));
+}
+
+TEST(alignFaceCropLevelsTheEyes) {
+    const int width = 200, height = 150;
+    std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4, 100);
+    // 기울어진 두 눈
+    paintDisc(image, width, height, 0.35f, 0.45f, 5, 250, 250, 10);
+    paintDisc(image, width, height, 0.6f, 0.35f, 5, 10, 250, 250);
+
+    const int size = 112;
+    std::vector<uint8_t> crop(static_cast<size_t>(size) * size * 4);
+    CHECK(alignFaceCrop(image.data(), width, height, 0.35f, 0.45f, 0.6f, 0.35f, size, crop.data()));
+    const uint8_t* left = cropPixel(crop, size, 0.342f, 0.461f);
+    const uint8_t* right = cropPixel(crop, size, 0.658f, 0.461f);
+    CHECK(left[0] > 200 && left[2] < 60);
+    CHECK(right[2] > 200 && right[0] < 60);
+    CHECK(!alignFaceCrop(nullptr, width, height, 0.35f, 0.45f, 0.6f, 0.35f, size, crop.data()));
+}
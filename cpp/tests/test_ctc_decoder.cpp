@@ -0,0 +1,125 @@
+#include <cmath>
+#include <map>
+#include "ctc_decoder.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 프레임마다 한 클래스가 확실한 log 확률
+std::vector<float> confidentFrames(const std::vector<int>& argmax, int classes) {
+    std::vector<float> logProbs(argmax.size() * classes, std::log(0.02f));
+    for (size_t t = 0; t < argmax.size(); t++) logProbs[t * classes + argmax[t]] = std::log(1.0f - 0.02f * (classes - 1));
+    return logProbs;
+}
+
+} // namespace
+
+TEST(ctcCollapsesRepeatsAndBlanks) {
+    const int classes = 3;
+    CtcBeamDecoder decoder(classes);
+    std::vector<float> frames = confidentFrames({1, 1, 0, 2, 2, 0, 2, 0, 0, 1}, classes);
+    decoder.pushLogProbs(frames.data(), 10);
+    std::vector<int> labels;
+    decoder.bestPath(labels);
+    CHECK((labels == std::vector<int>{1, 2, 2, 1}));
+    CHECK(decoder.bestPathJson() == "{\"labels\":[1,2,2,1],\"committed\":0}");
+
+    decoder.reset();
+    decoder.bestPath(labels);
+    CHECK(labels.empty());
+}
+
+TEST(ctcWideBeamMatchesExhaustiveSearch) {
+    // 모든 정렬(3^5)의 확률을 축약 라벨 열별로 합한 최대 가설과 같아야 함
+    const int classes = 3, frames = 5;
+    CtcDecoderConfig config;
+    config.beamWidth = 256;
+    config.classPruneLogProb = -1e9f;
+    config.maxCandidates = classes;
+    config.lmWeight = 0.0f;
+
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        std::vector<float> logits = randomValues(frames * classes, seed, 3.0f);
+        std::vector<float> probs(logits.size());
+        for (int t = 0; t < frames; t++) {
+            float sum = 0.0f;
+            for (int c = 0; c < classes; c++) sum += std::exp(logits[t * classes + c]);
+            for (int c = 0; c < classes; c++) probs[t * classes + c] = std::exp(logits[t * classes + c]) / sum;
+        }
+
+        std::map<std::vector<int>, double> totals;
+        int alignments = 1;
+        for (int t = 0; t < frames; t++) alignments *= classes;
+        for (int a = 0; a < alignments; a++) {
+            double p = 1.0;
+            std::vector<int> collapsed;
+            int previous = -1;
+            for (int t = 0, code = a; t < frames; t++, code /= classes) {
+                int c = code % classes;
+                p *= probs[t * classes + c];
+                if (c != 0 && c != previous) collapsed.push_back(c);
+                previous = c;
+            }
+            totals[collapsed] += p;
+        }
+        auto best = totals.begin();
+        for (auto it = totals.begin(); it != totals.end(); ++it) {
+            if (it->second > best->second) best = it;
+        }
+
+        CtcBeamDecoder decoder(classes, config);
+        decoder.pushLogits(logits.data(), frames);
+        std::vector<int> labels;
+        decoder.bestPath(labels);
+        CHECK(labels == best->first);
+        CHECK(decoder.bestScore() == 0.0f);   // 점수는 최고 가설 기준으로 정규화
+    }
+}
+
+TEST(ctcLexiconAndBigramConstrainOutput) {
+    const int classes = 4;
+    std::vector<float> frames = confidentFrames({2, 0, 3, 0, 2}, classes);
+
+    CtcBeamDecoder restricted(classes);
+    restricted.setLexicon({0, 1, 3});
+    restricted.pushLogProbs(frames.data(), 5);
+    std::vector<int> labels;
+    restricted.bestPath(labels);
+    for (int label : labels) CHECK(label != 2);
+
+    CtcBeamDecoder withBigram(classes);
+    std::vector<float> bigram(static_cast<size_t>(classes + 1) * classes, 1.0f / classes);
+    CHECK(!withBigram.setBigram(bigram.data(), classes * classes));
+    CHECK(withBigram.setBigram(bigram.data(), static_cast<int>(bigram.size())));
+    withBigram.pushLogProbs(frames.data(), 5);
+    withBigram.bestPath(labels);   // 균등 바이그램은 결과를 바꾸지 않음
+    CHECK((labels == std::vector<int>{2, 3, 2}));
+    CHECK(withBigram.setBigram(nullptr, 0));
+}
+
+TEST(ctcStreamingMatchesBatchAndCommits) {
+    const int classes = 5;
+    std::vector<int> argmax;
+    for (int i = 0; i < 400; i++) argmax.push_back((i % 4 == 3) ? 0 : 1 + (i / 4) % 4);
+    std::vector<float> frames = confidentFrames(argmax, classes);
+
+    CtcBeamDecoder batch(classes), streaming(classes);
+    batch.pushLogProbs(frames.data(), static_cast<int>(argmax.size()));
+    for (size_t t = 0; t < argmax.size(); t++) streaming.pushLogProbs(&frames[t * classes]);
+
+    std::vector<int> a, b;
+    batch.bestPath(a);
+    streaming.bestPath(b);
+    CHECK(a == b);
+    CHECK(a.size() == 100);
+
+    // 빔이 하나면 모든 빔이 항상 합의하므로 접두사가 확정 출력으로 옮겨지고 결과는 같음
+    CtcDecoderConfig greedy;
+    greedy.beamWidth = 1;
+    CtcBeamDecoder single(classes, greedy);
+    single.pushLogProbs(frames.data(), static_cast<int>(argmax.size()));
+    single.bestPath(b);
+    CHECK(a == b);
+    CHECK(single.committedLength() >= 90);
+}
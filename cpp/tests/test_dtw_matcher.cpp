@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cmath>
+#include "dtw_matcher.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 부드러운 무작위 궤적 (frames × dims)
+std::vector<float> randomWalk(int frames, int dims, uint32_t seed) {
+    std::vector<float> steps = randomValues(static_cast<size_t>(frames) * dims, seed, 0.2f);
+    std::vector<float> walk(steps.size());
+    for (int f = 0; f < frames; f++) {
+        for (int d = 0; d < dims; d++) {
+            float previous = f > 0 ? walk[static_cast<size_t>(f - 1) * dims + d] : 0.0f;
+            walk[static_cast<size_t>(f) * dims + d] = previous + steps[static_cast<size_t>(f) * dims + d];
+        }
+    }
+    return walk;
+}
+
+// 가지치기 없는 기준 구현: 같은 선형 리샘플링 + Sakoe–Chiba 띠 DTW
+std::vector<double> resampleReference(const std::vector<float>& frames, int frameCount, int dims, int length) {
+    std::vector<double> out(static_cast<size_t>(length) * dims);
+    const float step = static_cast<float>(frameCount - 1) / (length - 1);
+    for (int i = 0; i < length; i++) {
+        float position = i * step;
+        int f0 = std::min(static_cast<int>(position), frameCount - 2);
+        float t = position - f0;
+        for (int d = 0; d < dims; d++) {
+            float a = frames[static_cast<size_t>(f0) * dims + d];
+            float b = frames[static_cast<size_t>(f0 + 1) * dims + d];
+            out[static_cast<size_t>(i) * dims + d] = a + (b - a) * t;
+        }
+    }
+    return out;
+}
+
+double dtwReference(const std::vector<double>& a, const std::vector<double>& b, int dims, int length, int band) {
+    const double inf = 1e300;
+    std::vector<double> cost(static_cast<size_t>(length) * length, inf);
+    for (int i = 0; i < length; i++) {
+        for (int j = std::max(0, i - band); j <= std::min(length - 1, i + band); j++) {
+            double d = 0.0;
+            for (int k = 0; k < dims; k++) {
+                double diff = a[static_cast<size_t>(i) * dims + k] - b[static_cast<size_t>(j) * dims + k];
+                d += diff * diff;
+            }
+            double best = (i == 0 && j == 0) ? 0.0 : inf;
+            if (i > 0) best = std::min(best, cost[static_cast<size_t>(i - 1) * length + j]);
+            if (j > 0) best = std::min(best, cost[static_cast<size_t>(i) * length + j - 1]);
+            if (i > 0 && j > 0) best = std::min(best, cost[static_cast<size_t>(i - 1) * length + j - 1]);
+            cost[static_cast<size_t>(i) * length + j] = best + d;
+        }
+    }
+    return std::sqrt(cost.back() / length);
+}
+
+} // namespace
+
+TEST(dtwPrunedSearchMatchesExhaustiveDtw) {
+    const int dims = 10, length = 24, band = 3;
+    DtwMatcher matcher(dims, length, band);
+    std::vector<std::vector<double>> library;
+    for (int t = 0; t < 300; t++) {
+        int frames = 12 + t % 20;
+        std::vector<float> walk = randomWalk(frames, dims, 100 + t);
+        CHECK(matcher.addTemplate(walk.data(), frames, t % 7));
+        library.push_back(resampleReference(walk, frames, dims, length));
+    }
+    CHECK(matcher.templateCount() == 300);
+
+    int pruned = 0;
+    for (uint32_t q = 0; q < 10; q++) {
+        int frames = 15 + q;
+        std::vector<float> query = randomWalk(frames, dims, 9000 + q);
+        std::vector<double> resampled = resampleReference(query, frames, dims, length);
+
+        std::vector<std::pair<double, int>> expected;
+        for (int t = 0; t < 300; t++) expected.push_back({dtwReference(resampled, library[t], dims, length, band), t});
+        std::sort(expected.begin(), expected.end());
+
+        DtwMatch results[3];
+        CHECK(matcher.match(query.data(), frames, results, 3) == 3);
+        for (int r = 0; r < 3; r++) {
+            CHECK(results[r].templateIndex == expected[r].second);
+            CHECK(results[r].label == expected[r].second % 7);
+            CHECK_NEAR(results[r].distance, expected[r].first, 1e-3 * expected[r].first + 1e-5);
+        }
+        const DtwStats& stats = matcher.stats();
+        CHECK(stats.templates == 300);
+        CHECK(stats.prunedKim + stats.prunedKeogh + stats.prunedReverse + stats.prunedImproved + stats.abandoned +
+                  stats.fullDtw == 300);
+        pruned += 300 - stats.fullDtw;
+    }
+    CHECK(pruned > 1500);   // 대부분은 끝까지 DTW를 계산하지 않음
+}
+
+TEST(dtwFindsSelfAndHonorsMaxDistance) {
+    const int dims = 6;
+    DtwMatcher matcher(dims);
+    std::vector<float> a = randomWalk(20, dims, 1), b = randomWalk(30, dims, 2);
+    std::vector<float> single(dims, 0.0f);
+    CHECK(!matcher.addTemplate(single.data(), 1, 0));
+    CHECK(matcher.addTemplate(a.data(), 20, 4));
+    CHECK(matcher.addTemplate(b.data(), 30, 5));
+
+    DtwMatch match;
+    CHECK(matcher.match(b.data(), 30, &match, 1) == 1);
+    CHECK(match.label == 5 && match.templateIndex == 1);
+    CHECK(match.distance < 1e-5f);
+
+    std::vector<float> far = randomWalk(25, dims, 3);
+    for (float& v : far) v += 50.0f;
+    CHECK(matcher.match(far.data(), 25, &match, 1, 1.0f) == 0);
+    CHECK(matcher.matchJson(far.data(), 25, 1.0f).find("\"label\":-1") != std::string::npos);
+
+    matcher.clear();
+    CHECK(matcher.templateCount() == 0);
+    CHECK(matcher.match(b.data(), 30, &match, 1) == 0);
+}
@@ -0,0 +1,42 @@
+#ifndef TEST_FRAMEWORK_H
+#define TEST_FRAMEWORK_H
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// 최소 단위 테스트 도구 (외부 의존성 없음, -fno-exceptions에서도 동작)
+// TEST(이름)으로 등록하고 CHECK/CHECK_NEAR로 검사합니다. 실패해도 같은 테스트의 다음 검사를 계속합니다.
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& testRegistry();
+void reportFailure(const char* file, int line, const std::string& message);
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*run)()) { testRegistry().push_back({name, run}); }
+};
+
+#define TEST(name)                                                  \
+    static void name();                                             \
+    static TestRegistrar name##Registrar(#name, name);              \
+    static void name()
+
+#define CHECK(condition)                                            \
+    do {                                                            \
+        if (!(condition)) reportFailure(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                                    \
+    do {                                                                                           \
+        double checkActual = static_cast<double>(actual);                                          \
+        double checkExpected = static_cast<double>(expected);                                      \
+        if (!(std::fabs(checkActual - checkExpected) <= static_cast<double>(tolerance))) {          \
+            reportFailure(__FILE__, __LINE__, std::string(#actual " = ") + std::to_string(checkActual) + \
+                                                  ", expected " + std::to_string(checkExpected));  \
+        }                                                                                          \
+    } while (0)
+
+#endif // TEST_FRAMEWORK_H
@@ -0,0 +1,144 @@
+#include <cmath>
+#include "gesture_segmenter.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+constexpr double FRAME_MS = 1000.0 / 30.0;
+
+// 손목 (x, y)에 놓인 고정 자세 손 (손목–중지 기저부 거리 0.1)
+void handAt(float x, float y, float* out) {
+    for (int i = 0; i < 21; i++) {
+        float angle = 0.25f * i;
+        float radius = i == 0 ? 0.0f : (i == 9 ? 0.1f : 0.05f + 0.004f * i);
+        out[i * 2] = x + radius * std::sin(angle);
+        out[i * 2 + 1] = y - radius * std::cos(angle);
+    }
+    out[9 * 2] = x;
+    out[9 * 2 + 1] = y - 0.1f;
+}
+
+struct Events {
+    int starts = 0, ends = 0, cancels = 0;
+    void count(SegmentEvent event) {
+        starts += event == SegmentEvent::Start;
+        ends += event == SegmentEvent::End;
+        cancels += event == SegmentEvent::Cancel;
+    }
+};
+
+} // namespace
+
+TEST(runningWindowMatchesDirectStatistics) {
+    RunningWindow window(5);
+    std::vector<float> values = randomValues(200, 3, 4.0f);
+    for (size_t i = 0; i < values.size(); i++) {
+        window.push(values[i] + 100.0f);
+        size_t first = i >= 4 ? i - 4 : 0;
+        double mean = 0.0, squares = 0.0;
+        for (size_t j = first; j <= i; j++) mean += values[j] + 100.0;
+        mean /= static_cast<double>(i - first + 1);
+        for (size_t j = first; j <= i; j++) squares += (values[j] + 100.0 - mean) * (values[j] + 100.0 - mean);
+        CHECK(window.count() == static_cast<int>(i - first + 1));
+        CHECK_NEAR(window.mean(), mean, 1e-3);
+        CHECK_NEAR(window.variance(), squares / (i - first + 1), 2e-3);
+    }
+    CHECK(window.full());
+    window.clear();
+    CHECK(window.count() == 0);
+}
+
+TEST(segmenterFindsStartAndEndOfMovement) {
+    GestureSegmenter segmenter;
+    Events events;
+    float hand[42];
+    float x = 0.3f;
+    for (int f = 0; f < 120; f++) {
+        if (f >= 30 && f < 60) x += 0.01f;   // 30 fps에서 초당 손 크기 3배 이동
+        handAt(x, 0.6f, hand);
+        SegmentEvent event = segmenter.push(hand, 42, f * FRAME_MS);
+        events.count(event);
+        if (event == SegmentEvent::Start) CHECK(f >= 32 && f <= 36);
+    }
+    CHECK(events.starts == 1 && events.ends == 1 && events.cancels == 0);
+    CHECK(!segmenter.active());
+    const GestureSegment& segment = segmenter.currentSegment();
+    CHECK(segment.startFrame >= 30 && segment.startFrame <= 34);
+    CHECK(segment.endFrame >= 60 && segment.endFrame <= 68);
+    CHECK_NEAR(segment.peakSpeed, 3.0f, 0.05f);
+    CHECK(segmenter.segmentJson().find("\"active\":false") != std::string::npos);
+}
+
+TEST(segmenterCancelsShortBurstsAndEndsOnHandLoss) {
+    GestureSegmenter segmenter;
+    Events events;
+    float hand[42];
+    float x = 0.3f;
+    int f = 0;
+    for (; f < 60; f++) {
+        if (f >= 30 && f < 33) x += 0.01f;   // 3프레임짜리 흔들림 → 200ms 미만
+        handAt(x, 0.6f, hand);
+        events.count(segmenter.push(hand, 42, f * FRAME_MS));
+    }
+    CHECK(events.starts == 1 && events.cancels == 1 && events.ends == 0);
+
+    // 움직이는 도중 손이 사라지면 absentFrames 뒤에 마지막으로 보인 프레임에서 끝남
+    events = Events();
+    int lastSeen = 0;
+    for (; f < 140; f++) {
+        if (f < 100) {
+            x += 0.01f;
+            handAt(x, 0.6f, hand);
+            lastSeen = f;
+            events.count(segmenter.push(hand, 42, f * FRAME_MS));
+        } else {
+            events.count(segmenter.push(nullptr, 0, f * FRAME_MS));
+        }
+    }
+    CHECK(events.starts == 1 && events.ends == 1);
+    CHECK(segmenter.currentSegment().endFrame == lastSeen);
+}
+
+TEST(segmenterDoesNotCountReturnFrameTowardOffset) {
+    // 짧게 사라졌다가 돌아온 첫 프레임은 속도 창이 비어 있으므로 종료 조건에 들어가면 안 됨
+    SegmenterConfig config;
+    config.offsetFrames = 1;
+    GestureSegmenter segmenter(config);
+    Events events;
+    float hand[42];
+    float x = 0.1f;
+    int f = 0;
+    for (; f < 20; f++) {
+        x += 0.01f;
+        handAt(x, 0.6f, hand);
+        events.count(segmenter.push(hand, 42, f * FRAME_MS));
+    }
+    CHECK(events.starts == 1 && segmenter.active());
+
+    for (int k = 0; k < config.absentFrames - 1; k++, f++) {
+        events.count(segmenter.push(nullptr, 0, f * FRAME_MS));
+    }
+    for (int k = 0; k < 10; k++, f++) {
+        x += 0.01f;
+        handAt(x, 0.6f, hand);
+        events.count(segmenter.push(hand, 42, f * FRAME_MS));
+    }
+    CHECK(events.ends == 0 && segmenter.active());
+}
+
+TEST(segmenterSplitsOverlongSegments) {
+    SegmenterConfig config;
+    config.maxSegmentMs = 1000.0;
+    GestureSegmenter segmenter(config);
+    Events events;
+    float hand[42];
+    for (int f = 0; f < 100; f++) {
+        handAt(0.1f + 0.01f * f, 0.6f, hand);
+        events.count(segmenter.push(hand, 42, f * FRAME_MS));
+    }
+    CHECK(events.ends >= 2);
+    CHECK(events.starts >= events.ends);
+    const GestureSegment& segment = segmenter.currentSegment();
+    CHECK(segment.endMs - segment.startMs <= 1000.0 + FRAME_MS || segmenter.active());
+}
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+#include "gru_engine.h"
+#include "half_float.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 입력 10차원(패딩 경로), 은닉 16, 2레이어, 출력 MLP 16 → 12 → 4
+constexpr int INPUTS = 10;
+constexpr int HIDDEN = 16;
+constexpr int LAYERS = 2;
+constexpr int HEAD_HIDDEN = 12;
+constexpr int CLASSES = 4;
+
+struct GruWeights {
+    std::map<std::string, std::vector<float>> values;
+    std::map<std::string, std::vector<int>> shapes;
+
+    void add(const std::string& name, std::vector<int> shape, uint32_t seed, float scale) {
+        size_t count = 1;
+        for (int dim : shape) count *= dim;
+        values[name] = randomValues(count, seed, scale);
+        shapes[name] = shape;
+    }
+};
+
+GruWeights randomGru(uint32_t seed) {
+    GruWeights w;
+    for (int k = 0; k < LAYERS; k++) {
+        const std::string suffix = "_l" + std::to_string(k);
+        const int inputs = k == 0 ? INPUTS : HIDDEN;
+        w.add("weight_ih" + suffix, {3 * HIDDEN, inputs}, seed++, 0.5f);
+        w.add("weight_hh" + suffix, {3 * HIDDEN, HIDDEN}, seed++, 0.4f);
+        w.add("bias_ih" + suffix, {3 * HIDDEN}, seed++, 0.2f);
+        w.add("bias_hh" + suffix, {3 * HIDDEN}, seed++, 0.2f);
+    }
+    w.add("w1", {HEAD_HIDDEN, HIDDEN}, seed++, 0.5f);
+    w.add("b1", {HEAD_HIDDEN}, seed++, 0.1f);
+    w.add("w2", {CLASSES, HEAD_HIDDEN}, seed++, 0.5f);
+    w.add("b2", {CLASSES}, seed++, 0.1f);
+    return w;
+}
+
+// halfWeights면 GRU 가중치 행렬을 '<f2'로 저장 (바이어스와 출력층은 fp32)
+std::vector<uint8_t> toNpz(const GruWeights& w, bool halfWeights) {
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> entries;
+    for (const auto& entry : w.values) {
+        const std::vector<int>& shape = w.shapes.at(entry.first);
+        if (halfWeights && entry.first.compare(0, 7, "weight_") == 0) {
+            std::vector<uint16_t> half(entry.second.size());
+            for (size_t i = 0; i < half.size(); i++) half[i] = floatToHalf(entry.second[i]);
+            const std::string tuple = "(" + std::to_string(shape[0]) + ", " + std::to_string(shape[1]) + ")";
+            entries.emplace_back(entry.first, makeNpy("<f2", tuple, half.data(), half.size() * sizeof(uint16_t)));
+        } else {
+            entries.emplace_back(entry.first, makeNpyF32(shape, entry.second));
+        }
+    }
+    return makeNpz(entries);
+}
+
+// PyTorch nn.GRU 식 그대로 (double, 정확한 σ/tanh)
+struct ReferenceGru {
+    const GruWeights& w;
+    std::vector<std::vector<double>> hidden;
+
+    explicit ReferenceGru(const GruWeights& weights)
+        : w(weights), hidden(LAYERS, std::vector<double>(HIDDEN, 0.0)) {}
+
+    static double sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+
+    std::vector<double> gates(const std::string& weight, const std::string& bias, const std::vector<double>& x) const {
+        const std::vector<float>& m = w.values.at(weight);
+        const std::vector<float>& b = w.values.at(bias);
+        std::vector<double> y(b.begin(), b.end());
+        for (size_t o = 0; o < y.size(); o++) {
+            for (size_t i = 0; i < x.size(); i++) y[o] += static_cast<double>(m[o * x.size() + i]) * x[i];
+        }
+        return y;
+    }
+
+    std::vector<double> step(const float* features) {
+        std::vector<double> x(features, features + INPUTS);
+        for (int k = 0; k < LAYERS; k++) {
+            const std::string suffix = "_l" + std::to_string(k);
+            std::vector<double> gi = gates("weight_ih" + suffix, "bias_ih" + suffix, x);
+            std::vector<double> gh = gates("weight_hh" + suffix, "bias_hh" + suffix, hidden[k]);
+            for (int i = 0; i < HIDDEN; i++) {
+                double r = sigmoid(gi[i] + gh[i]);
+                double z = sigmoid(gi[HIDDEN + i] + gh[HIDDEN + i]);
+                double n = std::tanh(gi[2 * HIDDEN + i] + r * gh[2 * HIDDEN + i]);
+                hidden[k][i] = (1.0 - z) * n + z * hidden[k][i];
+            }
+            x = hidden[k];
+        }
+        std::vector<double> inner = gates("w1", "b1", x);
+        for (double& v : inner) v = std::max(0.0, v);
+        return gates("w2", "b2", inner);
+    }
+};
+
+bool loadGru(GruEngine& engine, const GruWeights& weights, bool halfWeights = false) {
+    std::vector<uint8_t> npz = toNpz(weights, halfWeights);
+    std::string error;
+    return engine.loadFromNpzBuffer(npz.data(), npz.size(), error);
+}
+
+} // namespace
+
+TEST(gruMatchesScalarReference) {
+    const GruWeights weights = randomGru(10);
+    GruEngine engine;
+    CHECK(loadGru(engine, weights));
+    CHECK(engine.inputSize() == INPUTS && engine.hiddenSize() == HIDDEN);
+    CHECK(engine.layerCount() == LAYERS && engine.classes() == CLASSES);
+
+    const int frames = 12;
+    std::vector<float> features = randomValues(static_cast<size_t>(frames) * INPUTS, 11, 1.5f);
+    ReferenceGru reference(weights);
+    GruState state = engine.createState();
+    CHECK(state.hidden.size() == static_cast<size_t>(LAYERS) * HIDDEN);
+    for (int t = 0; t < frames; t++) {
+        std::vector<double> expected = reference.step(&features[static_cast<size_t>(t) * INPUTS]);
+        float logits[CLASSES];
+        int best = engine.step(state, &features[static_cast<size_t>(t) * INPUTS], logits);
+        CHECK(best == static_cast<int>(std::max_element(logits, logits + CLASSES) - logits));
+        for (int c = 0; c < CLASSES; c++) CHECK_NEAR(logits[c], static_cast<float>(expected[c]), 1e-4f);
+    }
+    for (int k = 0; k < LAYERS; k++) {
+        for (int i = 0; i < HIDDEN; i++) {
+            CHECK_NEAR(state.hidden[k * HIDDEN + i], static_cast<float>(reference.hidden[k][i]), 1e-4f);
+        }
+    }
+}
+
+TEST(gruRunSequenceMatchesStepByStep) {
+    const GruWeights weights = randomGru(20);
+    GruEngine engine;
+    CHECK(loadGru(engine, weights));
+
+    const int frames = 9;
+    std::vector<float> features = randomValues(static_cast<size_t>(frames) * INPUTS, 21, 1.0f);
+    GruState stepped = engine.createState();
+    float expected[CLASSES];
+    for (int t = 0; t < frames; t++) engine.step(stepped, &features[static_cast<size_t>(t) * INPUTS], expected);
+
+    GruState sequence = engine.createState();
+    float logits[CLASSES];
+    int best = engine.runSequence(sequence, features.data(), frames, logits);
+    CHECK(best == static_cast<int>(std::max_element(expected, expected + CLASSES) - expected));
+    for (int c = 0; c < CLASSES; c++) CHECK_NEAR(logits[c], expected[c], 1e-5f);
+    for (size_t i = 0; i < stepped.hidden.size(); i++) CHECK_NEAR(sequence.hidden[i], stepped.hidden[i], 1e-5f);
+
+    // 상태를 이어서 쓰면 시퀀스를 나눠 넣어도 같음
+    GruState split = engine.createState();
+    engine.runSequence(split, features.data(), 4, nullptr);
+    engine.runSequence(split, &features[static_cast<size_t>(4) * INPUTS], frames - 4, logits);
+    for (int c = 0; c < CLASSES; c++) CHECK_NEAR(logits[c], expected[c], 1e-5f);
+
+    split.reset();
+    CHECK(std::all_of(split.hidden.begin(), split.hidden.end(), [](float v) { return v == 0.0f; }));
+}
+
+TEST(gruStepBatchMatchesSingleStreams) {
+    const GruWeights weights = randomGru(30);
+    GruEngine batched, single;
+    CHECK(loadGru(batched, weights));
+    CHECK(loadGru(single, weights));
+
+    const int streams = 5;
+    std::vector<GruState> batchStates, singleStates;
+    std::vector<GruState*> pointers;
+    for (int s = 0; s < streams; s++) {
+        batchStates.push_back(batched.createState());
+        singleStates.push_back(single.createState());
+    }
+    for (int s = 0; s < streams; s++) pointers.push_back(&batchStates[s]);
+
+    for (int frame = 0; frame < 6; frame++) {
+        std::vector<float> features = randomValues(static_cast<size_t>(streams) * INPUTS, 40 + frame, 1.0f);
+        std::vector<float> logits(static_cast<size_t>(streams) * CLASSES);
+        batched.stepBatch(pointers.data(), features.data(), streams, logits.data());
+        for (int s = 0; s < streams; s++) {
+            float expected[CLASSES];
+            single.step(singleStates[s], &features[static_cast<size_t>(s) * INPUTS], expected);
+            for (int c = 0; c < CLASSES; c++) CHECK_NEAR(logits[s * CLASSES + c], expected[c], 1e-5f);
+        }
+    }
+    for (int s = 0; s < streams; s++) {
+        for (size_t i = 0; i < batchStates[s].hidden.size(); i++) {
+            CHECK_NEAR(batchStates[s].hidden[i], singleStates[s].hidden[i], 1e-5f);
+        }
+    }
+}
+
+TEST(gruHalfWeightsTrackFloatWeights) {
+    const GruWeights weights = randomGru(50);
+    GruEngine full, half;
+    CHECK(loadGru(full, weights));
+    CHECK(loadGru(half, weights, true));
+
+    std::vector<float> features = randomValues(static_cast<size_t>(8) * INPUTS, 51, 1.0f);
+    GruState fullState = full.createState(), halfState = half.createState();
+    float fullLogits[CLASSES], halfLogits[CLASSES];
+    full.runSequence(fullState, features.data(), 8, fullLogits);
+    half.runSequence(halfState, features.data(), 8, halfLogits);
+    for (int c = 0; c < CLASSES; c++) CHECK_NEAR(halfLogits[c], fullLogits[c], 2e-2f);
+}
+
+TEST(gruRejectsInconsistentArrays) {
+    GruEngine engine;
+    std::string error;
+
+    // 은닉 12는 8의 배수가 아님
+    GruWeights odd;
+    odd.add("weight_ih_l0", {36, INPUTS}, 1, 0.5f);
+    odd.add("weight_hh_l0", {36, 12}, 2, 0.5f);
+    odd.add("bias_ih_l0", {36}, 3, 0.1f);
+    odd.add("bias_hh_l0", {36}, 4, 0.1f);
+    odd.add("w1", {CLASSES, 12}, 5, 0.5f);
+    odd.add("b1", {CLASSES}, 6, 0.1f);
+    std::vector<uint8_t> npz = toNpz(odd, false);
+    CHECK(!engine.loadFromNpzBuffer(npz.data(), npz.size(), error));
+    CHECK(!error.empty());
+    CHECK(engine.empty());
+
+    GruWeights missing = randomGru(60);
+    missing.values.erase("bias_hh_l1");
+    npz = toNpz(missing, false);
+    CHECK(!engine.loadFromNpzBuffer(npz.data(), npz.size(), error));
+
+    // 출력층 입력이 은닉 크기와 다름
+    GruWeights head = randomGru(70);
+    head.add("w1", {HEAD_HIDDEN, 8}, 71, 0.5f);
+    npz = toNpz(head, false);
+    CHECK(!engine.loadFromNpzBuffer(npz.data(), npz.size(), error));
+    CHECK(engine.empty());
+
+    GruState state = engine.createState();
+    float features[INPUTS] = {};
+    CHECK(engine.step(state, features, nullptr) == -1);
+    CHECK(engine.runSequence(state, features, 1, nullptr) == -1);
+}
@@ -0,0 +1,101 @@
+#include <cmath>
+#include "half_float.h"
+#include "mlp_model.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+TEST(halfSubnormalsSurviveFastMath) {
+    // 이 테스트는 프로젝트 플래그(-ffast-math, DAZ/FTZ)로 빌드됨
+    CHECK(halfToFloat(0x0001) == std::ldexp(1.0f, -24));
+    CHECK(halfToFloat(0x8001) == -std::ldexp(1.0f, -24));
+    CHECK(halfToFloat(0x03FF) == std::ldexp(1023.0f, -24));
+    CHECK(halfToFloat(0x0200) == std::ldexp(1.0f, -15));
+
+    alignas(32) uint16_t bits[8] = {0x0001, 0x8001, 0x03FF, 0x0200, 0x0000, 0x8000, 0x0400, 0x3C00};
+    alignas(32) float widened[8];
+    _mm256_store_ps(widened, widenHalf8(bits));
+    for (int i = 0; i < 8; i++) CHECK(widened[i] == halfToFloat(bits[i]));
+    CHECK(widened[0] > 0.0f);
+}
+
+TEST(halfConversionsRoundTripEveryValue) {
+    int mismatches = 0;
+    int widenMismatches = 0;
+    alignas(32) uint16_t block[8];
+    alignas(32) float widened[8];
+    for (uint32_t h = 0; h < 0x10000; h++) {
+        uint16_t bits = static_cast<uint16_t>(h);
+        float value = halfToFloat(bits);
+        // -ffast-math에서는 isnan을 믿을 수 없으므로 비트로 판정 (NaN은 quiet NaN으로 정규화됨)
+        bool isNan = (bits & 0x7c00) == 0x7c00 && (bits & 0x3ff) != 0;
+        uint16_t back = floatToHalf(value);
+        if (isNan) {
+            mismatches += (back & 0x7e00) != 0x7e00;
+        } else {
+            mismatches += back != bits;
+        }
+
+        block[h & 7] = bits;
+        if ((h & 7) == 7) {
+            _mm256_store_ps(widened, widenHalf8(block));
+            for (int i = 0; i < 8; i++) {
+                uint32_t expected = floatBits(halfToFloat(block[i]));
+                widenMismatches += floatBits(widened[i]) != expected;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(widenMismatches == 0);
+}
+
+TEST(halfRoundingIsNearestEven) {
+    CHECK(floatToHalf(1.0f) == 0x3C00);
+    CHECK(floatToHalf(65504.0f) == 0x7BFF);
+    CHECK(floatToHalf(65520.0f) == 0x7C00);                      // 반올림하면 inf
+    CHECK(floatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);  // 정확히 중간 → 짝수
+    CHECK(floatToHalf(1.0f + 3 * std::ldexp(1.0f, -11)) == 0x3C02);
+    CHECK(floatToHalf(std::ldexp(1.0f, -25)) == 0x0000);          // 최소 비정규 수의 절반 → 0 (짝수)
+    CHECK(floatToHalf(std::ldexp(3.0f, -25)) == 0x0002);
+
+    CHECK(floatToBf16(1.0f) == 0x3F80);
+    CHECK(bf16ToFloat(0x3F80) == 1.0f);
+    CHECK(floatToBf16(bitsToFloat(0x3F808000)) == 0x3F80);        // 중간 → 짝수
+    CHECK(floatToBf16(bitsToFloat(0x3F818000)) == 0x3F82);
+    CHECK((floatToBf16(bitsToFloat(0x7f800001)) & 0x7fc0) == 0x7fc0);   // NaN은 quiet NaN으로 유지
+}
+
+TEST(halfPrecisionLayersTrackFloatLayer) {
+    const int outputs = 36, inputs = 50, batch = 11;
+    std::vector<float> weights = randomValues(static_cast<size_t>(outputs) * inputs, 3);
+    std::vector<float> bias = randomValues(outputs, 4, 0.1f);
+    weights[5] = std::ldexp(3.0f, -20);   // fp16 비정규 수 범위의 가중치
+
+    DenseLayer reference;
+    reference.pack(weights.data(), bias.data(), outputs, inputs);
+    AlignedFloatVector input(static_cast<size_t>(batch) * reference.stride, 0.0f);
+    std::vector<float> values = randomValues(static_cast<size_t>(batch) * inputs, 8);
+    for (int f = 0; f < batch; f++) {
+        for (int i = 0; i < inputs; i++) input[static_cast<size_t>(f) * reference.stride + i] = values[f * inputs + i];
+    }
+    AlignedFloatVector expected(static_cast<size_t>(batch) * outputs);
+    reference.forwardBatch(input.data(), reference.stride, expected.data(), outputs, batch, false);
+
+    for (WeightPrecision precision : {WeightPrecision::F16, WeightPrecision::BF16}) {
+        DenseLayer layer = reference;
+        layer.setPrecision(precision);
+        CHECK(layer.byteSize() < reference.byteSize());
+
+        std::vector<float> restored;
+        layer.unpack(restored);
+        if (precision == WeightPrecision::F16) CHECK(restored[5] == weights[5]);   // 비정규 수 보존
+
+        AlignedFloatVector actual(expected.size());
+        layer.forwardBatch(input.data(), layer.stride, actual.data(), outputs, batch, false);
+        float tolerance = precision == WeightPrecision::F16 ? 5e-3f : 5e-2f;
+        CHECK(maxAbsDiff(expected.data(), actual.data(), expected.size()) < tolerance);
+
+        AlignedFloatVector single(outputs);
+        layer.forward(input.data(), single.data(), false);
+        CHECK(maxAbsDiff(single.data(), actual.data(), outputs) < 1e-5f);
+    }
+}
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "hand_collider.h"
+#include "particle_grid.h"
+#include "sign_recognition.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 손바닥 + 손가락 5개가 부채꼴로 펼쳐진 손 (21 × 3, 단위 좌표)
+std::vector<float> fanHand() {
+    std::vector<float> points(HandCollider::LANDMARKS * 3, 0.0f);
+    points[0] = 0.5f;
+    points[1] = 0.2f;
+    points[2] = 0.0f;
+    for (int finger = 0; finger < 5; finger++) {
+        float angle = -0.8f + 0.4f * finger;
+        for (int joint = 1; joint <= 4; joint++) {
+            int index = finger * 4 + joint;
+            float reach = 0.08f * joint + 0.05f;
+            points[index * 3] = 0.5f + reach * std::sin(angle);
+            points[index * 3 + 1] = 0.2f + reach * std::cos(angle);
+            points[index * 3 + 2] = 0.01f * joint;
+        }
+    }
+    return points;
+}
+
+// 선형 탐색 기준: 가장 깊이 파고든 캡슐 표면으로 밀어내고 들어오는 속도 성분 반사
+bool collideBruteForce(const std::vector<float>& hand, float radius, float* position, float* velocity,
+                       float restitution) {
+    float bestDepth = 0.0f, bestDistance = 0.0f;
+    float closest[3] = {0.0f, 0.0f, 0.0f};
+    for (int child = 1; child < HandCollider::LANDMARKS; child++) {
+        int parent = child % 4 == 1 ? 0 : child - 1;
+        const float* a = &hand[parent * 3];
+        const float* b = &hand[child * 3];
+        float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        float ap[3] = {position[0] - a[0], position[1] - a[1], position[2] - a[2]};
+        float length2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+        float t = length2 > 1e-12f ? (ap[0] * ab[0] + ap[1] * ab[1] + ap[2] * ab[2]) / length2 : 0.0f;
+        t = std::min(std::max(t, 0.0f), 1.0f);
+        float c[3] = {a[0] + t * ab[0], a[1] + t * ab[1], a[2] + t * ab[2]};
+        float d[3] = {position[0] - c[0], position[1] - c[1], position[2] - c[2]};
+        float distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        if (distance >= radius || radius - distance <= bestDepth) continue;
+        bestDepth = radius - distance;
+        bestDistance = distance;
+        std::copy(c, c + 3, closest);
+    }
+    if (bestDepth <= 0.0f) return false;
+
+    float n[3] = {0.0f, 1.0f, 0.0f};
+    if (bestDistance > 1e-6f) {
+        for (int k = 0; k < 3; k++) n[k] = (position[k] - closest[k]) / bestDistance;
+    }
+    for (int k = 0; k < 3; k++) position[k] = closest[k] + n[k] * radius;
+    float normalSpeed = velocity[0] * n[0] + velocity[1] * n[1] + velocity[2] * n[2];
+    if (normalSpeed < 0.0f) {
+        for (int k = 0; k < 3; k++) velocity[k] -= (1.0f + restitution) * normalSpeed * n[k];
+    }
+    return true;
+}
+
+std::vector<std::pair<int, int>> pairsWithin(const std::vector<float>& positions, float radius) {
+    std::vector<std::pair<int, int>> pairs;
+    const int count = static_cast<int>(positions.size() / 3);
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            float dx = positions[i * 3] - positions[j * 3];
+            float dy = positions[i * 3 + 1] - positions[j * 3 + 1];
+            float dz = positions[i * 3 + 2] - positions[j * 3 + 2];
+            if (dx * dx + dy * dy + dz * dz < radius * radius) pairs.emplace_back(i, j);
+        }
+    }
+    return pairs;
+}
+
+} // namespace
+
+TEST(handColliderMatchesBruteForceCapsules) {
+    const std::vector<float> hand = fanHand();
+    const float radius = 0.03f;
+    HandCollider collider;
+    CHECK(collider.update(hand.data(), static_cast<int>(hand.size()), radius));
+
+    // 손 주변 상자에 고르게 뿌려 일부는 캡슐 안, 일부는 밖
+    const int count = 4000;
+    std::vector<float> positions = randomValues(count * 3, 7, 0.5f);
+    for (int i = 0; i < count; i++) {
+        positions[i * 3] += 0.5f;
+        positions[i * 3 + 1] += 0.45f;
+        positions[i * 3 + 2] *= 0.2f;
+    }
+    std::vector<float> velocities = randomValues(count * 3, 8, 1.0f);
+    std::vector<float> expectedPositions = positions;
+    std::vector<float> expectedVelocities = velocities;
+
+    int expectedHits = 0;
+    for (int i = 0; i < count; i++) {
+        expectedHits += collideBruteForce(hand, radius, &expectedPositions[i * 3], &expectedVelocities[i * 3], 0.5f);
+    }
+    int hits = collider.collide(positions.data(), velocities.data(), count, 0.5f);
+
+    CHECK(expectedHits > 50);
+    CHECK(hits == expectedHits);
+    CHECK(maxAbsDiff(positions.data(), expectedPositions.data(), positions.size()) < 1e-5f);
+    CHECK(maxAbsDiff(velocities.data(), expectedVelocities.data(), velocities.size()) < 1e-4f);
+
+    // 비활성이면 아무것도 바꾸지 않음
+    collider.clear();
+    std::vector<float> before = positions;
+    CHECK(collider.collide(positions.data(), velocities.data(), count, 0.5f) == 0);
+    CHECK(positions == before);
+    CHECK(!collider.update(hand.data(), 20, radius));
+}
+
+TEST(particleGridVisitsEveryNearbyPairOnce) {
+    // 음수 좌표, 셀 경계 위 좌표, 같은 위치의 파티클을 섞음
+    const int count = 3000;
+    std::vector<float> positions = randomValues(count * 3, 21, 6.0f);
+    for (int k = 0; k < 3; k++) {
+        positions[3 + k] = positions[k];
+        positions[6 + k] = 2.0f;
+        positions[9 + k] = 1.0f;
+    }
+
+    ParticleGrid grid;
+    grid.build(positions.data(), count, 1.0f);
+    std::vector<std::pair<int, int>> candidates;
+    grid.forEachPair([&](int i, int j) { candidates.emplace_back(i, j); });
+
+    std::vector<std::pair<int, int>> found;
+    for (const auto& pair : candidates) {
+        CHECK(pair.first < pair.second);
+        float dx = positions[pair.first * 3] - positions[pair.second * 3];
+        float dy = positions[pair.first * 3 + 1] - positions[pair.second * 3 + 1];
+        float dz = positions[pair.first * 3 + 2] - positions[pair.second * 3 + 2];
+        if (dx * dx + dy * dy + dz * dz < 1.0f) found.push_back(pair);
+    }
+    std::vector<std::pair<int, int>> unique = candidates;
+    std::sort(unique.begin(), unique.end());
+    CHECK(std::adjacent_find(unique.begin(), unique.end()) == unique.end());
+
+    std::sort(found.begin(), found.end());
+    std::vector<std::pair<int, int>> expected = pairsWithin(positions, 1.0f);
+    CHECK(!expected.empty());
+    CHECK(found == expected);
+    // 넓은 단계가 실제로 후보를 줄임 (전체 쌍의 일부만 검사)
+    CHECK(candidates.size() < static_cast<size_t>(count) * (count - 1) / 20);
+
+    // 같은 객체로 더 작은 입력을 다시 만들어도 이전 내용이 남지 않음
+    grid.build(positions.data(), 3, 1.0f);
+    int visits = 0;
+    grid.forEachPair([&](int, int) { visits++; });
+    CHECK(visits == 1);
+}
+
+TEST(simulateParticlesMatchesPairwiseReference) {
+    const int count = 600;
+    const float deltaTime = 1.0f / 60.0f;
+    std::vector<float> positions = randomValues(count * 3, 31, 3.0f);
+    for (int i = 0; i < count; i++) positions[i * 3 + 1] += 3.0f;
+    std::vector<float> velocities = randomValues(count * 3, 32, 0.5f);
+    std::vector<float> expectedPositions = positions;
+    std::vector<float> expectedVelocities = velocities;
+
+    // 기준: 모든 파티클 적분 + 바닥 반사 → 모든 쌍 (i < j) 반발력
+    for (int i = 0; i < count; i++) {
+        float* p = &expectedPositions[i * 3];
+        float* v = &expectedVelocities[i * 3];
+        v[1] += -9.8f * deltaTime;
+        for (int k = 0; k < 3; k++) p[k] += v[k] * deltaTime;
+        if (p[1] < 0) {
+            p[1] = 0;
+            v[1] = -v[1] * 0.99f;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            float d[3];
+            for (int k = 0; k < 3; k++) d[k] = expectedPositions[i * 3 + k] - expectedPositions[j * 3 + k];
+            float distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+            if (distance < 1.0f && distance > 0.001f) {
+                float force = 0.1f / distance;
+                for (int k = 0; k < 3; k++) {
+                    expectedVelocities[i * 3 + k] += d[k] * force * deltaTime;
+                    expectedVelocities[j * 3 + k] -= d[k] * force * deltaTime;
+                }
+            }
+        }
+    }
+
+    SignRecognizer recognizer;
+    recognizer.simulateParticles(positions.data(), velocities.data(), count, deltaTime);
+    CHECK(maxAbsDiff(positions.data(), expectedPositions.data(), positions.size()) == 0.0f);
+    CHECK(maxAbsDiff(velocities.data(), expectedVelocities.data(), velocities.size()) < 1e-4f);
+}
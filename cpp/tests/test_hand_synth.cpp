@@ -0,0 +1,113 @@
+#include <cmath>
+#include <cstring>
+#include "hand_synth.h"
+#include "test_framework.h"
+
+namespace {
+
+HandSynthConfig cleanConfig() {
+    HandSynthConfig config;
+    config.jitter = 0.0f;
+    config.dropoutRate = 0.0f;
+    return config;
+}
+
+float jointDistance(const float* hand, int joint) {
+    return std::sqrt(hand[joint * 3] * hand[joint * 3] + hand[joint * 3 + 1] * hand[joint * 3 + 1] +
+                     hand[joint * 3 + 2] * hand[joint * 3 + 2]);
+}
+
+} // namespace
+
+TEST(handSynthIsReproducibleFromSeed) {
+    HandSynthConfig config;
+    config.hands = 2;
+    config.seed = 7;
+    const int frames = 200;
+    std::vector<float> a(frames * 2 * HAND_FLOATS), b(a.size()), c(a.size());
+    std::vector<uint8_t> presentA(frames * 2), presentB(frames * 2);
+
+    HandSynthesizer first(config), second(config);
+    first.generateLandmarks(a.data(), frames, presentA.data());
+    second.generateLandmarks(b.data(), frames, presentB.data());
+    CHECK(a == b);
+    CHECK(presentA == presentB);
+
+    first.reset();
+    first.generateLandmarks(c.data(), frames);
+    CHECK(a == c);
+
+    config.seed = 8;
+    HandSynthesizer other(config);
+    other.generateLandmarks(c.data(), frames);
+    CHECK(a != c);
+}
+
+TEST(handSynthFollowsHoldTransitionSchedule) {
+    HandSynthConfig config = cleanConfig();
+    config.fps = 10.0f;
+    config.holdSeconds = 0.5f;        // 5프레임
+    config.transitionSeconds = 0.2f;  // 2프레임
+    config.sequence = {SynthGesture::Fist, SynthGesture::Open};
+    HandSynthesizer synth(config);
+
+    const int frames = 28;
+    std::vector<float> out(frames * SYNTH_XY_FLOATS);
+    std::vector<int32_t> labels(frames);
+    synth.generateRecognizerFrames(out.data(), frames, labels.data());
+    for (int f = 0; f < frames; f++) {
+        int within = f % 7;
+        int expected = within >= 5 ? -1 : static_cast<int>((f / 7) % 2 == 0 ? SynthGesture::Fist : SynthGesture::Open);
+        CHECK(labels[f] == expected);
+    }
+    for (float v : out) CHECK(v > 0.0f && v < 1.0f);
+}
+
+TEST(handSynthFeaturesAreWristRelativeAndPoseDependent) {
+    HandSynthConfig config = cleanConfig();
+    config.hands = 2;
+    config.sequence = {SynthGesture::Open, SynthGesture::Fist};
+    config.fps = 10.0f;
+    config.holdSeconds = 1.0f;
+    config.transitionSeconds = 0.0f;
+    HandSynthesizer synth(config);
+
+    const int frames = 20;
+    std::vector<float> features(frames * SYNTH_FEATURE_FLOATS);
+    std::vector<int32_t> labels(frames);
+    synth.generateFeatures(features.data(), frames, labels.data());
+
+    float openTip = 0.0f, fistTip = 0.0f;
+    for (int f = 0; f < frames; f++) {
+        const float* right = &features[static_cast<size_t>(f) * SYNTH_FEATURE_FLOATS + HAND_FLOATS];
+        const float* left = &features[static_cast<size_t>(f) * SYNTH_FEATURE_FLOATS];
+        for (const float* hand : {left, right}) {
+            CHECK(hand[0] == 0.0f && hand[1] == 0.0f && hand[2] == 0.0f);
+            CHECK_NEAR(jointDistance(hand, 9), 1.0f, 1e-5f);   // 중지 기저부 거리로 정규화
+        }
+        if (labels[f] == static_cast<int>(SynthGesture::Open)) openTip = jointDistance(right, 8);
+        if (labels[f] == static_cast<int>(SynthGesture::Fist)) fistTip = jointDistance(right, 8);
+    }
+    CHECK(openTip > 0.0f && fistTip > 0.0f);
+    CHECK(openTip > fistTip * 1.3f);   // 편 검지 끝이 주먹보다 손목에서 멂
+}
+
+TEST(handSynthDropoutZeroesMissingHands) {
+    HandSynthConfig config;
+    config.dropoutRate = 0.2f;
+    config.dropoutFrames = 3;
+    HandSynthesizer synth(config);
+
+    const int frames = 400;
+    std::vector<float> out(frames * HAND_FLOATS);
+    std::vector<uint8_t> present(frames);
+    synth.generateLandmarks(out.data(), frames, present.data());
+
+    int missing = 0;
+    for (int f = 0; f < frames; f++) {
+        if (present[f]) continue;
+        missing++;
+        for (int i = 0; i < HAND_FLOATS; i++) CHECK(out[static_cast<size_t>(f) * HAND_FLOATS + i] == 0.0f);
+    }
+    CHECK(missing > 20 && missing < frames - 20);
+}
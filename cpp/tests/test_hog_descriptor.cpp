@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cmath>
+#include "hog_descriptor.h"
+#include "test_framework.h"
+
+namespace {
+
+// 밝기 함수 value(x, y)로 채운 RGBA 이미지
+template <typename Fn>
+std::vector<uint8_t> grayImage(int w, int h, Fn value) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(w) * h * 4);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint8_t v = static_cast<uint8_t>(value(x, y));
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * w + x) * 4];
+            p[0] = p[1] = p[2] = v;
+            p[3] = 255;
+        }
+    }
+    return rgba;
+}
+
+// 모든 블록/셀에 걸친 방향 구간별 합
+std::vector<float> binTotals(const std::vector<float>& descriptor, int bins) {
+    std::vector<float> totals(bins, 0.0f);
+    for (size_t i = 0; i < descriptor.size(); i++) totals[i % bins] += descriptor[i];
+    return totals;
+}
+
+} // namespace
+
+TEST(hogSizeAndBlockNormalization) {
+    HogDescriptor hog;
+    CHECK(hog.descriptorSize(64, 128) == 7 * 15 * 36);
+    CHECK(hog.descriptorSize(7, 64) == 0);
+    CHECK(hog.descriptorSize(8, 8) == 0);   // 2×2 블록이 하나도 없음
+
+    auto image = grayImage(96, 96, [](int x, int y) { return 128 + 100 * std::sin(x * 0.3) * std::cos(y * 0.2); });
+    std::vector<float> out(hog.descriptorSize(64, 64));
+    CHECK(hog.compute(image.data(), 96, 96, 16, 16, 64, 64, out.data()) == static_cast<int>(out.size()));
+    for (size_t b = 0; b < out.size(); b += 36) {
+        float sum = 0.0f, peak = 0.0f;
+        for (int i = 0; i < 36; i++) {
+            CHECK(out[b + i] >= 0.0f);
+            sum += out[b + i] * out[b + i];
+            peak = std::max(peak, out[b + i]);
+        }
+        CHECK_NEAR(std::sqrt(sum), 1.0f, 1e-3f);   // L2-Hys 뒤 다시 단위 길이
+        CHECK(peak < 0.5f);   // 잘라낸 뒤 재정규화하므로 한 성분이 지배하지 않음
+    }
+
+    auto flat = grayImage(32, 32, [](int, int) { return 90; });
+    std::vector<float> flatOut(hog.descriptorSize(32, 32));
+    hog.compute(flat.data(), 32, 32, 0, 0, 32, 32, flatOut.data());
+    for (float v : flatOut) CHECK(v == 0.0f);
+}
+
+TEST(hogOrientationFollowsEdges) {
+    HogDescriptor hog;
+    const int bins = hog.config().bins;
+    std::vector<float> out(hog.descriptorSize(48, 48));
+
+    // 세로 줄무늬: 기울기가 x 방향(0°) → 0°를 끼고 있는 첫/마지막 구간
+    auto vertical = grayImage(48, 48, [](int x, int) { return (x / 4) % 2 ? 200 : 40; });
+    hog.compute(vertical.data(), 48, 48, 0, 0, 48, 48, out.data());
+    std::vector<float> totals = binTotals(out, bins);
+    float edge = totals[0] + totals[bins - 1];
+    float rest = 0.0f;
+    for (int b = 1; b < bins - 1; b++) rest += totals[b];
+    CHECK(edge > 10.0f * rest);
+
+    // 가로 줄무늬: 90° → 가운데 구간
+    auto horizontal = grayImage(48, 48, [](int, int y) { return (y / 4) % 2 ? 200 : 40; });
+    hog.compute(horizontal.data(), 48, 48, 0, 0, 48, 48, out.data());
+    totals = binTotals(out, bins);
+    int strongest = static_cast<int>(std::max_element(totals.begin(), totals.end()) - totals.begin());
+    CHECK(strongest == bins / 2);
+}
+
+TEST(hogIsContrastInvariantAndReusable) {
+    auto low = grayImage(80, 72, [](int x, int y) { return 100 + ((x * 7 + y * 13) % 23); });
+    auto high = grayImage(80, 72, [](int x, int y) { return 100 + 3 * ((x * 7 + y * 13) % 23); });
+
+    HogDescriptor reused;
+    std::vector<float> small(reused.descriptorSize(24, 40));
+    reused.compute(high.data(), 80, 72, 3, 5, 24, 40, small.data());   // 다른 크기로 버퍼를 먼저 씀
+
+    std::vector<float> a(reused.descriptorSize(64, 64)), b(a.size()), c(a.size());
+    reused.compute(low.data(), 80, 72, 8, 4, 64, 64, a.data());
+    reused.compute(high.data(), 80, 72, 8, 4, 64, 64, b.data());
+    HogDescriptor fresh;
+    fresh.compute(low.data(), 80, 72, 8, 4, 64, 64, c.data());
+
+    CHECK(a == c);
+    float worst = 0.0f;
+    for (size_t i = 0; i < a.size(); i++) worst = std::max(worst, std::fabs(a[i] - b[i]));
+    CHECK(worst < 0.02f);
+
+    // 이미지를 벗어난 영역은 잘라서 계산
+    int clipped = fresh.compute(low.data(), 80, 72, 40, 40, 64, 64, c.data());
+    CHECK(clipped == fresh.descriptorSize(40, 32));
+}
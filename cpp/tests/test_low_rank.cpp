@@ -0,0 +1,120 @@
+#include <cmath>
+#include "low_rank.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// rows × cols 행렬 P(rows × rank) · Q(rank × cols)
+std::vector<float> lowRankMatrix(int rows, int cols, int rank, uint32_t seed) {
+    std::vector<float> p = randomValues(static_cast<size_t>(rows) * rank, seed);
+    std::vector<float> q = randomValues(static_cast<size_t>(rank) * cols, seed + 1);
+    std::vector<float> m(static_cast<size_t>(rows) * cols, 0.0f);
+    for (int i = 0; i < rows; i++) {
+        for (int k = 0; k < rank; k++) {
+            for (int j = 0; j < cols; j++) m[static_cast<size_t>(i) * cols + j] += p[i * rank + k] * q[k * cols + j];
+        }
+    }
+    return m;
+}
+
+float reconstructionError(const LowRankFactors& f, const std::vector<float>& m, int rank) {
+    float worst = 0.0f;
+    for (int i = 0; i < f.rows; i++) {
+        for (int j = 0; j < f.cols; j++) {
+            float sum = 0.0f;
+            for (int k = 0; k < rank; k++) sum += f.u[i * f.rank + k] * f.singular[k] * f.vt[k * f.cols + j];
+            worst = std::max(worst, std::fabs(sum - m[static_cast<size_t>(i) * f.cols + j]));
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+TEST(lowRankFactorizeRecoversRankAndOrthogonality) {
+    const int rows = 48, cols = 36;
+    std::vector<float> m = lowRankMatrix(rows, cols, 5, 1);
+    LowRankFactors factors;
+    CHECK(LowRankCompressor::factorize(m.data(), rows, cols, 8, factors));
+    CHECK(factors.rank == 8 && factors.rows == rows && factors.cols == cols);
+    for (int k = 1; k < factors.rank; k++) CHECK(factors.singular[k] <= factors.singular[k - 1] + 1e-4f);
+    CHECK(factors.singular[5] < 1e-3f * factors.singular[0]);   // 랭크 5 밖은 거의 0
+    CHECK(reconstructionError(factors, m, 5) < 1e-3f);
+
+    for (int a = 0; a < 5; a++) {
+        for (int b = 0; b < 5; b++) {
+            float uDot = 0.0f, vDot = 0.0f;
+            for (int i = 0; i < rows; i++) uDot += factors.u[i * factors.rank + a] * factors.u[i * factors.rank + b];
+            for (int j = 0; j < cols; j++) vDot += factors.vt[a * cols + j] * factors.vt[b * cols + j];
+            CHECK_NEAR(uDot, a == b ? 1.0f : 0.0f, 1e-3f);
+            CHECK_NEAR(vDot, a == b ? 1.0f : 0.0f, 1e-3f);
+        }
+    }
+
+    // 전체 랭크면 정확한 분해: 특이값 제곱합 = 프로베니우스 노름 제곱
+    std::vector<float> full = randomValues(static_cast<size_t>(20) * 12, 3);
+    CHECK(LowRankCompressor::factorize(full.data(), 20, 12, 12, factors));
+    double energy = 0.0, frobenius = 0.0;
+    for (float s : factors.singular) energy += static_cast<double>(s) * s;
+    for (float v : full) frobenius += static_cast<double>(v) * v;
+    CHECK_NEAR(energy, frobenius, 1e-3 * frobenius);
+    CHECK(reconstructionError(factors, full, 12) < 1e-4f);
+}
+
+TEST(lowRankLayersReproduceDenseLayer) {
+    const int rows = 40, cols = 56;
+    std::vector<float> m = lowRankMatrix(rows, cols, 6, 5);
+    std::vector<float> bias = randomValues(rows, 6, 0.1f);
+    LowRankFactors factors;
+    CHECK(LowRankCompressor::factorize(m.data(), rows, cols, 6, factors));
+
+    DenseLayer dense, first, second;
+    dense.pack(m.data(), bias.data(), rows, cols);
+    LowRankCompressor::buildLayers(factors, 6, bias, first, second);
+    CHECK(first.linear && first.outDim == 6 && first.inDim == cols);
+    CHECK(second.outDim == rows && second.inDim == 6);
+
+    AlignedFloatVector x(dense.stride, 0.0f);
+    std::vector<float> values = randomValues(cols, 7);
+    std::copy(values.begin(), values.end(), x.begin());
+    AlignedFloatVector expected(rows), hidden(second.stride, 0.0f), actual(rows);
+    dense.forward(x.data(), expected.data(), true);
+    first.forward(x.data(), hidden.data(), false);
+    second.forward(hidden.data(), actual.data(), true);
+    CHECK(maxAbsDiff(expected.data(), actual.data(), rows) < 1e-3f);
+}
+
+TEST(lowRankCompressPicksSmallestRankMeetingTarget) {
+    // 126 → 128 (실제 랭크 6) → 16 → 5
+    std::vector<float> w1 = lowRankMatrix(128, 126, 6, 11);
+    std::vector<float> b1 = randomValues(128, 12, 0.1f);
+    std::vector<float> w2 = randomValues(16 * 128, 13), b2 = randomValues(16, 14, 0.1f);
+    std::vector<float> w3 = randomValues(5 * 16, 15), b3 = randomValues(5, 16, 0.1f);
+    MlpModel model;
+    model.addLayer(w1.data(), b1.data(), 128, 126);
+    model.addLayer(w2.data(), b2.data(), 16, 128);
+    model.addLayer(w3.data(), b3.data(), 5, 16);
+    size_t originalBytes = model.byteSize();
+
+    const int frames = 200;
+    std::vector<float> inputs = randomValues(static_cast<size_t>(frames) * 126, 17);
+    std::vector<float> before(frames * 5), after(frames * 5);
+    model.forwardBatch(inputs.data(), before.data(), frames);
+
+    LowRankReport report;
+    std::string error;
+    CHECK(LowRankCompressor::compress(model, 0, inputs.data(), nullptr, frames, 1.0f, report, error));
+    CHECK(report.rank >= 6 && report.rank <= 8);
+    CHECK(!report.trials.empty() && report.trials.back().rank == report.maxRank);
+    CHECK(model.layers.size() == 4 && model.layers[0].linear);
+    CHECK(model.byteSize() < originalBytes);
+
+    model.forwardBatch(inputs.data(), after.data(), frames);
+    CHECK(maxAbsDiff(before.data(), after.data(), before.size()) < 1e-2f);
+    CHECK(LowRankCompressor::reportJson(report).find("\"trials\":[{") != std::string::npos);
+
+    // 이미 분해한 레이어는 다시 분해하지 않음
+    CHECK(!LowRankCompressor::compress(model, 0, inputs.data(), nullptr, frames, 1.0f, report, error));
+    CHECK(!error.empty());
+}
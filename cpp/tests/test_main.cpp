@@ -0,0 +1,41 @@
+// 단위 테스트 실행기
+//
+//   make test                          # 전체 실행
+//   ./build/unit_tests 이름일부          # 이름에 포함된 테스트만
+
+#include <cstdio>
+#include <cstring>
+#include "test_framework.h"
+
+namespace {
+
+int failures = 0;
+
+} // namespace
+
+std::vector<TestCase>& testRegistry() {
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+void reportFailure(const char* file, int line, const std::string& message) {
+    std::printf("  %s:%d: %s\n", file, line, message.c_str());
+    failures++;
+}
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    int failed = 0;
+    for (const TestCase& test : testRegistry()) {
+        if (filter != nullptr && std::strstr(test.name, filter) == nullptr) continue;
+        int before = failures;
+        test.run();
+        run++;
+        bool ok = failures == before;
+        failed += ok ? 0 : 1;
+        std::printf("[%s] %s\n", ok ? "  OK  " : "FAILED", test.name);
+    }
+    std::printf("%d tests, %d failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}
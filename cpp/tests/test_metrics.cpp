@@ -0,0 +1,105 @@
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "metrics.h"
+#include "test_framework.h"
+
+TEST(metricsCountersGaugesAndHighWater) {
+    Metrics::reset();
+    Metrics::add(Metric::FramesProcessed);
+    Metrics::add(Metric::FramesProcessed, 4);
+    Metrics::set(Metric::ModelBytes, 1000);
+    Metrics::set(Metric::ModelBytes, 600);
+    Metrics::setMax(Metric::ScratchHighWaterBytes, 300);
+    Metrics::setMax(Metric::ScratchHighWaterBytes, 100);
+    CHECK(Metrics::get(Metric::FramesProcessed) == 5);
+    CHECK(Metrics::get(Metric::ModelBytes) == 600);
+    CHECK(Metrics::get(Metric::ScratchHighWaterBytes) == 300);
+
+    int64_t snap[METRIC_COUNT + 4];
+    bool consistent = false;
+    CHECK(Metrics::snapshot(snap, METRIC_COUNT + 4, &consistent) == METRIC_COUNT);
+    CHECK(consistent);
+    CHECK(snap[static_cast<int>(Metric::FramesProcessed)] == 5);
+    CHECK(Metrics::snapshot(snap, 2) == 2);
+    CHECK(Metrics::snapshot(nullptr, 4) == 0);
+
+    CHECK(std::strcmp(Metrics::name(Metric::DroppedFrames), "droppedFrames") == 0);
+    CHECK(Metrics::toText().find("framesProcessed 5\n") != std::string::npos);
+
+    Metrics::reset();
+    CHECK(Metrics::get(Metric::FramesProcessed) == 0);
+}
+
+TEST(metricsSnapshotsNeverTearAcrossWriters) {
+    // 쓰는 쪽은 항상 FramesProcessed → DroppedFrames 순으로 올리므로,
+    // 일관된 스냅샷에서는 두 값의 차가 0 또는 1이어야 함 (찢어진 복사는 Dropped가 앞설 수 있음)
+    Metrics::reset();
+    std::atomic<bool> stop{false};
+    std::thread writer([&stop]() {
+        while (!stop.load()) {
+            Metrics::add(Metric::FramesProcessed);
+            Metrics::add(Metric::DroppedFrames);
+        }
+    });
+
+    int consistentCount = 0;
+    int torn = 0;
+    for (int i = 0; i < 20000; i++) {
+        int64_t snap[METRIC_COUNT];
+        bool consistent = false;
+        Metrics::snapshot(snap, METRIC_COUNT, &consistent, 1000);
+        if (!consistent) continue;
+        consistentCount++;
+        int64_t difference = snap[static_cast<int>(Metric::FramesProcessed)] - snap[static_cast<int>(Metric::DroppedFrames)];
+        torn += difference != 0 && difference != 1;
+    }
+    stop.store(true);
+    writer.join();
+
+    CHECK(consistentCount > 0);
+    CHECK(torn == 0);
+    CHECK(Metrics::get(Metric::FramesProcessed) == Metrics::get(Metric::DroppedFrames));
+    Metrics::reset();
+}
+
+TEST(metricsShardedWritersSumAndSnapshotAcrossShards) {
+    // 스레드마다 다른 샤드에 쓰므로 카운터는 샤드 합, 최고치는 샤드 최댓값
+    // 각 스레드가 FramesProcessed → DroppedFrames 순으로 올리므로 일관된 스냅샷에서 차는 0..writers
+    Metrics::reset();
+    const int writers = 3, rounds = 20000;
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < writers; t++) {
+        threads.emplace_back([&go, t]() {
+            while (!go.load()) {}
+            for (int i = 0; i < rounds; i++) {
+                Metrics::add(Metric::FramesProcessed);
+                Metrics::add(Metric::DroppedFrames);
+            }
+            Metrics::setMax(Metric::ScratchHighWaterBytes, 100 * (t + 1));
+            Metrics::set(Metric::ModelGeneration, 7);
+        });
+    }
+
+    go.store(true);
+    int torn = 0;
+    for (int i = 0; i < 5000; i++) {
+        int64_t snap[METRIC_COUNT];
+        bool consistent = false;
+        Metrics::snapshot(snap, METRIC_COUNT, &consistent, 1000);
+        if (!consistent) continue;
+        int64_t difference = snap[static_cast<int>(Metric::FramesProcessed)] - snap[static_cast<int>(Metric::DroppedFrames)];
+        torn += difference < 0 || difference > writers;
+    }
+    for (auto& thread : threads) thread.join();
+
+    CHECK(torn == 0);
+    CHECK(Metrics::get(Metric::FramesProcessed) == int64_t(writers) * rounds);
+    CHECK(Metrics::get(Metric::DroppedFrames) == int64_t(writers) * rounds);
+    CHECK(Metrics::get(Metric::ScratchHighWaterBytes) == 100 * writers);
+    CHECK(Metrics::get(Metric::ModelGeneration) == 7);
+    Metrics::reset();
+    CHECK(Metrics::get(Metric::ScratchHighWaterBytes) == 0 && Metrics::get(Metric::ModelGeneration) == 0);
+}
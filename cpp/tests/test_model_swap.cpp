@@ -0,0 +1,96 @@
+#include <atomic>
+#include <thread>
+#include "rcu_slot.h"
+#include "sign_recognition.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 126 → 16 → classes 모델 NPZ
+std::vector<uint8_t> modelNpz(int classes, uint32_t seed) {
+    return makeNpz({{"w1", makeNpyF32({16, 126}, randomValues(16 * 126, seed))},
+                    {"b1", makeNpyF32({16}, randomValues(16, seed + 1, 0.1f))},
+                    {"w2", makeNpyF32({classes, 16}, randomValues(static_cast<size_t>(classes) * 16, seed + 2))},
+                    {"b2", makeNpyF32({classes}, randomValues(classes, seed + 3, 0.1f))}});
+}
+
+// 현재 모델의 클래스 수 (predictBatchLogits 반환값)
+int currentClasses(SignRecognition& recognition) {
+    std::vector<float> features(126, 0.1f);
+    std::vector<float> logits(64);
+    return recognition.predictBatchLogits(reinterpret_cast<uintptr_t>(features.data()), 1,
+                                          reinterpret_cast<uintptr_t>(logits.data()));
+}
+
+void waitForSwap(SignRecognition& recognition) {
+    while (recognition.isModelSwapPending()) std::this_thread::yield();
+}
+
+} // namespace
+
+TEST(syncLoadPublishesAndFailureKeepsModel) {
+    SignRecognition recognition;
+    CHECK(currentClasses(recognition) == 4);
+    std::vector<uint8_t> npz = modelNpz(7, 1);
+    CHECK(recognition.loadModelFromBuffer(reinterpret_cast<uintptr_t>(npz.data()), static_cast<int>(npz.size())));
+    CHECK(currentClasses(recognition) == 7);
+    CHECK(recognition.getModelGeneration() == 1);
+
+    std::vector<uint8_t> garbage(100, 0);
+    CHECK(!recognition.loadModelFromBuffer(reinterpret_cast<uintptr_t>(garbage.data()), 100));
+    CHECK(!recognition.getLastError().empty());
+    CHECK(currentClasses(recognition) == 7);
+    CHECK(recognition.getModelGeneration() == 1);
+}
+
+// 비동기 로드와 복사-수정-게시 변경이 겹쳐도 로드한 모델이 사라지지 않아야 함
+TEST(asyncLoadSurvivesConcurrentPruneAndScaler) {
+    std::vector<uint8_t> npz = modelNpz(7, 11);
+    const std::vector<float> mean(126, 0.0f), scale(126, 2.0f);
+    for (int trial = 0; trial < 20; trial++) {
+        SignRecognition recognition;
+        CHECK(recognition.loadModelAsync(reinterpret_cast<uintptr_t>(npz.data()), static_cast<int>(npz.size())));
+        int changes = 0;
+        do {
+            if (changes % 2 == 0) recognition.pruneModel(0.1f);
+            else recognition.setScaler(mean, scale);
+            changes++;
+        } while (recognition.isModelSwapPending() || changes < 4);
+        waitForSwap(recognition);
+
+        CHECK(currentClasses(recognition) == 7);
+        CHECK(recognition.getModelGeneration() == changes + 1);
+    }
+}
+
+TEST(asyncLoadReportsBusyAndErrors) {
+    SignRecognition recognition;
+    std::vector<uint8_t> garbage(64, 1);
+    CHECK(recognition.loadModelAsync(reinterpret_cast<uintptr_t>(garbage.data()), 64));
+    waitForSwap(recognition);
+    CHECK(!recognition.getLastError().empty());
+    CHECK(currentClasses(recognition) == 4);
+    CHECK(!recognition.loadModelAsync(0, 0));
+}
+
+TEST(rcuReadersNeverSeeFreedObjects) {
+    struct Payload {
+        int a;
+        int b;   // 항상 a의 두 배
+    };
+    RcuSlot<Payload> slot(new Payload{0, 0});
+    std::atomic<bool> stop(false);
+    std::atomic<int> inconsistent(0);
+    std::thread reader([&]() {
+        while (!stop.load()) {
+            auto guard = slot.read();
+            if (guard->b != guard->a * 2) inconsistent++;
+        }
+    });
+    for (int i = 1; i <= 2000; i++) slot.publish(new Payload{i, i * 2});
+    stop.store(true);
+    reader.join();
+    CHECK(inconsistent.load() == 0);
+    CHECK(slot.read()->a == 2000);
+}
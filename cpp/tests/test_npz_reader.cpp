@@ -0,0 +1,120 @@
+#include <cstring>
+#include <map>
+#include "mlp_model.h"
+#include "npz_reader.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+TEST(npyParsesFloat32Matrix) {
+    std::vector<float> values = {1.0f, -2.0f, 3.5f, 4.0f, 5.0f, -6.25f};
+    std::vector<uint8_t> bytes = makeNpyF32({2, 3}, values);
+    NpyArray array;
+    std::string error;
+    CHECK(NpzReader::parseNpy(bytes.data(), bytes.size(), array, error));
+    CHECK(array.dtype == NpyDtype::Float32);
+    CHECK(array.shape == std::vector<int>({2, 3}));
+    CHECK(array.data == values);
+}
+
+TEST(npyKeepsHalfPrecisionBits) {
+    const uint16_t half[3] = {0x3C00, 0xC000, 0x0001};   // 1, −2, 최소 subnormal
+    std::vector<uint8_t> f16 = makeNpy("<f2", "(3,)", half, sizeof(half));
+    std::vector<uint8_t> bf16 = makeNpy("<u2", "(3,)", half, sizeof(half));
+    NpyArray array;
+    std::string error;
+    CHECK(NpzReader::parseNpy(f16.data(), f16.size(), array, error));
+    CHECK(array.dtype == NpyDtype::Float16);
+    CHECK(array.halfData.size() == 3 && array.halfData[2] == 0x0001);
+    CHECK(array.data.empty());
+    CHECK(NpzReader::parseNpy(bf16.data(), bf16.size(), array, error));
+    CHECK(array.dtype == NpyDtype::BFloat16);
+}
+
+TEST(npyRejectsMalformedHeaders) {
+    const float payload[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    NpyArray array;
+    std::string error;
+
+    std::vector<uint8_t> truncated = makeNpy("<f4", "(5,)", payload, sizeof(payload));
+    CHECK(!NpzReader::parseNpy(truncated.data(), truncated.size(), array, error));
+
+    std::vector<uint8_t> fortran = makeNpy("<f4", "(4,)", payload, sizeof(payload));
+    std::string text(fortran.begin(), fortran.end());
+    size_t at = text.find("False");
+    std::memcpy(&fortran[at], "True ", 5);
+    CHECK(!NpzReader::parseNpy(fortran.data(), fortran.size(), array, error));
+
+    std::vector<uint8_t> wrongType = makeNpy("<f8", "(2,)", payload, sizeof(payload));
+    CHECK(!NpzReader::parseNpy(wrongType.data(), wrongType.size(), array, error));
+
+    std::vector<uint8_t> header = makeNpy("<f4", "(4,)", payload, sizeof(payload));
+    CHECK(!NpzReader::parseNpy(header.data(), 9, array, error));
+}
+
+TEST(npyRejectsOverflowingShapes) {
+    const float payload[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    NpyArray array;
+    std::string error;
+
+    // 원소 수 곱이 size_t를 넘어 작은 값으로 돌아오는 모양
+    std::vector<uint8_t> wrapping = makeNpy("<f4", "(4294967296, 4294967296, 4)", payload, sizeof(payload));
+    CHECK(!NpzReader::parseNpy(wrapping.data(), wrapping.size(), array, error));
+
+    // int로 누적하면 음수/작은 값이 되는 차원
+    std::vector<uint8_t> hugeDim = makeNpy("<f4", "(18446744073709551617,)", payload, sizeof(payload));
+    CHECK(!NpzReader::parseNpy(hugeDim.data(), hugeDim.size(), array, error));
+
+    // count · elementSize가 넘치는 경우 (count ≈ SIZE_MAX / 2)
+    std::vector<uint8_t> byteWrap = makeNpy("<f4", "(2147483647, 2147483647, 2147483647)", payload, sizeof(payload));
+    CHECK(!NpzReader::parseNpy(byteWrap.data(), byteWrap.size(), array, error));
+}
+
+TEST(npzParsesStoredArchive) {
+    std::vector<uint8_t> zip = makeNpz({{"w1", makeNpyF32({2, 2}, {1, 2, 3, 4})}, {"b1", makeNpyF32({2}, {5, 6})}});
+    std::map<std::string, NpyArray> arrays;
+    std::string error;
+    CHECK(NpzReader::parse(zip.data(), zip.size(), arrays, error));
+    CHECK(arrays.size() == 2);
+    CHECK(arrays.count("w1") == 1 && arrays["w1"].data[3] == 4.0f);
+    CHECK(arrays.count("b1") == 1 && arrays["b1"].shape == std::vector<int>({2}));
+
+    // 잘린 아카이브와 zip이 아닌 버퍼
+    CHECK(!NpzReader::parse(zip.data(), zip.size() / 2, arrays, error));
+    std::vector<uint8_t> garbage(64, 0x55);
+    CHECK(!NpzReader::parse(garbage.data(), garbage.size(), arrays, error));
+}
+
+TEST(mlpLoadsNpzAndMatchesReference) {
+    const std::vector<float> w1 = {0.5f, -1.0f, 0.25f, 2.0f, 1.0f, 0.0f, -0.5f, 0.5f, -1.0f, 1.0f, 1.0f, 1.0f};
+    const std::vector<float> b1 = {0.1f, -0.2f, 0.3f};
+    const std::vector<float> w2 = {1.0f, 2.0f, -1.0f, 0.5f, -0.5f, 1.5f};
+    const std::vector<float> b2 = {0.0f, 1.0f};
+    std::vector<uint8_t> zip = makeNpz({{"w1", makeNpyF32({3, 4}, w1)}, {"b1", makeNpyF32({3}, b1)},
+                                        {"w2", makeNpyF32({2, 3}, w2)}, {"b2", makeNpyF32({2}, b2)}});
+    MlpModel model;
+    std::string error;
+    CHECK(model.loadFromNpzBuffer(zip.data(), zip.size(), error));
+    CHECK(model.inputDim() == 4 && model.outputDim() == 2);
+    CHECK(model.shapeSignature() == "4x3x2");
+
+    const float input[4] = {1.0f, 2.0f, -1.0f, 0.5f};
+    float hidden[3];
+    for (int o = 0; o < 3; o++) {
+        float sum = b1[o];
+        for (int i = 0; i < 4; i++) sum += w1[o * 4 + i] * input[i];
+        hidden[o] = sum > 0.0f ? sum : 0.0f;
+    }
+    float output[2];
+    model.forward(input, output);
+    for (int o = 0; o < 2; o++) {
+        float expected = b2[o];
+        for (int i = 0; i < 3; i++) expected += w2[o * 3 + i] * hidden[i];
+        CHECK_NEAR(output[o], expected, 1e-5);
+    }
+
+    // 이전 레이어와 크기가 맞지 않으면 실패하고 기존 모델 유지
+    std::vector<uint8_t> bad = makeNpz({{"w1", makeNpyF32({3, 4}, w1)}, {"b1", makeNpyF32({3}, b1)},
+                                        {"w2", makeNpyF32({2, 2}, {1, 2, 3, 4})}, {"b2", makeNpyF32({2}, b2)}});
+    CHECK(!model.loadFromNpzBuffer(bad.data(), bad.size(), error));
+    CHECK(model.shapeSignature() == "4x3x2");
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cmath>
+#include "output_head.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+TEST(fusedSoftmaxPiecesMatchScalarMath) {
+    for (int count : {1, 7, 8, 9, 33, 1000}) {
+        std::vector<float> x = randomValues(count, count, 20.0f);
+        double maxValue = *std::max_element(x.begin(), x.end());
+        double sum = 0.0;
+        for (float v : x) sum += std::exp(v - maxValue);
+        CHECK_NEAR(logSumExp(x.data(), count), maxValue + std::log(sum), 1e-4 * std::fabs(maxValue) + 1e-5);
+
+        std::vector<float> out(count);
+        float fused = expShiftSum(x.data(), count, static_cast<float>(maxValue), out.data());
+        CHECK_NEAR(fused, sum, 1e-5 * sum);
+        for (int i = 0; i < count; i++) CHECK_NEAR(out[i], std::exp(x[i] - maxValue), 1e-6);
+    }
+}
+
+TEST(selectTopKMatchesFullSort) {
+    for (int count : {5, 64, 1001}) {
+        std::vector<float> values = randomValues(count, 40 + count);
+        for (int k : {1, 3, 10, count + 2}) {
+            std::vector<int> indices(std::min(k, count));
+            int n = selectTopK(values.data(), count, k, indices.data());
+            CHECK(n == std::min(k, count));
+
+            std::vector<int> expected(count);
+            for (int i = 0; i < count; i++) expected[i] = i;
+            std::sort(expected.begin(), expected.end(), [&](int a, int b) { return values[a] > values[b]; });
+            for (int i = 0; i < n; i++) CHECK(indices[i] == expected[i]);
+        }
+    }
+}
+
+TEST(outputHeadFlatTopKMatchesSoftmax) {
+    const int classes = 300, hidden = 40;
+    std::vector<float> weights = randomValues(static_cast<size_t>(classes) * hidden, 1);
+    std::vector<float> bias = randomValues(classes, 2, 0.1f);
+    OutputHead head;
+    CHECK(head.setWeights(weights.data(), bias.data(), classes, hidden));
+    CHECK(head.classes() == classes && head.hiddenSize() == hidden);
+
+    std::vector<float> h = randomValues(hidden, 3);
+    std::vector<float> probabilities(classes);
+    head.softmax(h.data(), probabilities.data());
+    double total = 0.0;
+    for (float p : probabilities) total += p;
+    CHECK_NEAR(total, 1.0, 1e-4);
+
+    // 기준: 직접 계산한 logit의 softmax
+    std::vector<double> logits(classes);
+    for (int c = 0; c < classes; c++) {
+        double sum = bias[c];
+        for (int i = 0; i < hidden; i++) sum += static_cast<double>(weights[c * hidden + i]) * h[i];
+        logits[c] = sum;
+    }
+    double maxLogit = *std::max_element(logits.begin(), logits.end()), norm = 0.0;
+    for (double l : logits) norm += std::exp(l - maxLogit);
+    for (int c = 0; c < classes; c++) CHECK_NEAR(probabilities[c], std::exp(logits[c] - maxLogit) / norm, 1e-5);
+
+    HeadCandidate top[5];
+    CHECK(head.topK(h.data(), 5, top) == 5);
+    CHECK(head.lastEvaluated() == classes);
+    for (int i = 0; i < 5; i++) {
+        CHECK_NEAR(top[i].probability, probabilities[top[i].label], 1e-5f);
+        if (i > 0) CHECK(top[i].probability <= top[i - 1].probability);
+    }
+    CHECK(top[0].label == static_cast<int>(std::max_element(logits.begin(), logits.end()) - logits.begin()));
+}
+
+TEST(outputHeadClustersEvaluateFewerClassesAndFindTop) {
+    // 군집 구조가 뚜렷한 가중치: 클래스 c는 중심 c % 16에 작은 잡음
+    const int classes = 1024, hidden = 32, groups = 16;
+    std::vector<float> centers = randomValues(static_cast<size_t>(groups) * hidden, 5, 2.0f);
+    std::vector<float> noise = randomValues(static_cast<size_t>(classes) * hidden, 6, 0.2f);
+    std::vector<float> weights(noise.size());
+    for (int c = 0; c < classes; c++) {
+        for (int i = 0; i < hidden; i++) weights[c * hidden + i] = centers[(c % groups) * hidden + i] + noise[c * hidden + i];
+    }
+    std::vector<float> bias(classes, 0.0f);
+
+    OutputHead flat, clustered;
+    flat.setWeights(weights.data(), bias.data(), classes, hidden);
+    clustered.setWeights(weights.data(), bias.data(), classes, hidden);
+    clustered.buildClusters(groups, 2);
+    CHECK(clustered.clusterCount() == groups);
+
+    int agree = 0;
+    for (uint32_t t = 0; t < 20; t++) {
+        std::vector<float> h = randomValues(hidden, 100 + t);
+        HeadCandidate a, b;
+        flat.topK(h.data(), 1, &a);
+        clustered.topK(h.data(), 1, &b);
+        CHECK(clustered.lastEvaluated() < classes / 4);
+        agree += a.label == b.label;
+    }
+    CHECK(agree >= 18);
+
+    clustered.setWeightPrecision(WeightPrecision::F16);
+    std::vector<float> h = randomValues(hidden, 7);
+    CHECK(clustered.topKJson(h.data(), 3).find("\"evaluated\":") != std::string::npos);
+}
@@ -0,0 +1,109 @@
+#include <cmath>
+#include <cstring>
+#include "mlp_model.h"
+#include "sign_recognition.h"
+#include "test_framework.h"
+#include "test_support.h"
+#include "thread_pool.h"
+
+namespace {
+
+// 코어 수와 관계없이 4 참여자 풀로 병렬 경로를 실행 (단일 코어에서는 시분할)
+struct FourThreads {
+    FourThreads() { ThreadPool::setThreadLimit(4); }
+    ~FourThreads() { ThreadPool::setThreadLimit(0); }
+};
+
+MlpModel deepModel() {
+    const int dims[] = {1260, 1024, 96, 5};
+    MlpModel model;
+    for (int l = 0; l < 3; l++) {
+        std::vector<float> weights = randomValues(static_cast<size_t>(dims[l + 1]) * dims[l], 10 + l, 0.05f);
+        std::vector<float> bias = randomValues(dims[l + 1], 20 + l, 0.1f);
+        model.addLayer(weights.data(), bias.data(), dims[l + 1], dims[l]);
+    }
+    return model;
+}
+
+} // namespace
+
+TEST(parallelGemvMatchesSerialExactly) {
+    FourThreads limit;
+    ThreadPool pool(4);
+    CHECK(pool.size() == 4);
+
+    MlpModel serial = deepModel();
+    MlpModel parallel = deepModel();
+    parallel.intraOpPool = &pool;
+    CHECK(serial.layers[0].byteSize() >= PARALLEL_GEMV_MIN_BYTES);
+
+    for (uint32_t seed = 0; seed < 5; seed++) {
+        std::vector<float> input = randomValues(1260, 100 + seed);
+        float expected[5], actual[5];
+        serial.forward(input.data(), expected);
+        parallel.forward(input.data(), actual);
+        CHECK(std::memcmp(expected, actual, sizeof(expected)) == 0);   // 행 구간 분할은 행별 계산을 바꾸지 않음
+    }
+
+    // 가지치기한 희소 레이어도 8행 블록을 쪼개지 않고 같은 결과
+    serial.pruneByMagnitude(0.7f);
+    parallel.pruneByMagnitude(0.7f);
+    std::vector<float> input = randomValues(1260, 7);
+    float expected[5], actual[5];
+    serial.forward(input.data(), expected);
+    parallel.forward(input.data(), actual);
+    CHECK(std::memcmp(expected, actual, sizeof(expected)) == 0);
+
+    // 배치는 타일 단위로 나눔
+    const int batch = 70;
+    std::vector<float> frames = randomValues(static_cast<size_t>(batch) * 1260, 8);
+    std::vector<float> serialOut(batch * 5), parallelOut(batch * 5);
+    serial.forwardBatch(frames.data(), serialOut.data(), batch);
+    parallel.forwardBatch(frames.data(), parallelOut.data(), batch);
+    CHECK(serialOut == parallelOut);
+}
+
+TEST(parallelImageFiltersMatchSingleThread) {
+    FourThreads limit;
+    const int w = 157, h = 203;
+    std::vector<uint8_t> original(static_cast<size_t>(w) * h * 4);
+    uint32_t state = 12345;
+    for (uint8_t& v : original) {
+        state = state * 1664525u + 1013904223u;
+        v = static_cast<uint8_t>(state >> 24);
+    }
+
+    SignRecognizer serial, parallel;
+    parallel.setIntraOpThreads(4);
+    CHECK(parallel.getIntraOpThreads() == 4);
+    for (int filter : {0, 1}) {
+        std::vector<uint8_t> a = original, b = original;
+        serial.processImageData(a.data(), w, h, filter);
+        parallel.processImageData(b.data(), w, h, filter);
+        CHECK(a == b);
+        CHECK(a != original);
+    }
+}
+
+TEST(parallelMatrixMultiplyMatchesReference) {
+    FourThreads limit;
+    const int n = 150;   // 64 블록의 배수가 아닌 크기
+    std::vector<float> a = randomValues(static_cast<size_t>(n) * n, 1), b = randomValues(static_cast<size_t>(n) * n, 2);
+    std::vector<float> serialResult(a.size()), parallelResult(a.size());
+
+    SignRecognizer serial, parallel;
+    parallel.setIntraOpThreads(4);
+    serial.matrixMultiplyLarge(a.data(), b.data(), serialResult.data(), n);
+    parallel.matrixMultiplyLarge(a.data(), b.data(), parallelResult.data(), n);
+    CHECK(serialResult == parallelResult);
+
+    double worst = 0.0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < n; k++) sum += static_cast<double>(a[i * n + k]) * b[k * n + j];
+            worst = std::max(worst, std::fabs(sum - parallelResult[i * n + j]));
+        }
+    }
+    CHECK(worst < 1e-3);
+}
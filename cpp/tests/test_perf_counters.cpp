@@ -0,0 +1,28 @@
+#include <cstring>
+#include "perf_counters.h"
+#include "test_framework.h"
+
+TEST(perfCountersMeasureOrReportWhyNot) {
+    PerfCounters perf;
+    perf.start();
+    volatile uint64_t sink = 0;
+    for (int i = 0; i < 200000; i++) sink = sink + static_cast<uint64_t>(i) * 3;
+    PerfSample sample = perf.stop();
+
+    if (!perf.available()) {
+        // PMU가 없는 환경(가상 머신/컨테이너)에서는 이유를 알려 주고 값은 모두 미지원 0
+        CHECK(!perf.error().empty());
+        for (int i = 0; i < PERF_EVENT_COUNT; i++) CHECK(!sample.supported[i] && sample.values[i] == 0);
+    } else {
+        for (int i = 0; i < PERF_EVENT_COUNT; i++) CHECK(sample.supported[i] || sample.values[i] == 0);
+        if (sample.has(PerfEvent::Instructions)) CHECK(sample.get(PerfEvent::Instructions) > 200000);
+
+        // 다시 시작하면 0부터 셈
+        perf.start();
+        PerfSample empty = perf.stop();
+        if (empty.has(PerfEvent::Instructions) && sample.has(PerfEvent::Instructions)) {
+            CHECK(empty.get(PerfEvent::Instructions) < sample.get(PerfEvent::Instructions));
+        }
+    }
+    CHECK(std::strcmp(PerfCounters::name(PerfEvent::Cycles), "") != 0);
+}
@@ -0,0 +1,50 @@
+#include <string>
+#include <vector>
+#include "sign_log.h"
+#include "test_framework.h"
+
+namespace {
+
+struct Captured {
+    std::vector<LogLevel> levels;
+    std::vector<std::string> messages;
+};
+
+void captureSink(LogLevel level, const char* message, void* userData) {
+    Captured* captured = static_cast<Captured*>(userData);
+    captured->levels.push_back(level);
+    captured->messages.push_back(message);
+}
+
+} // namespace
+
+TEST(logSinkReceivesFormattedMessages) {
+    Captured captured;
+    setLogSink(captureSink, &captured);
+    setLogLevel(LogLevel::Debug);
+    signLogWrite(LogLevel::Info, "model %s (%d bytes)", "126x128", 42);
+    signLogWrite(LogLevel::Error, "plain");
+    setLogSink(nullptr, nullptr);
+
+    CHECK(captured.messages.size() == 2);
+    CHECK(captured.messages[0] == "model 126x128 (42 bytes)");
+    CHECK(captured.levels[0] == LogLevel::Info);
+    CHECK(captured.levels[1] == LogLevel::Error);
+}
+
+TEST(logLevelFiltersAndLongLinesAreTruncated) {
+    Captured captured;
+    setLogSink(captureSink, &captured);
+    setLogLevel(LogLevel::Warn);
+    signLogWrite(LogLevel::Debug, "dropped");
+    signLogWrite(LogLevel::Info, "dropped");
+    signLogWrite(LogLevel::Warn, "kept");
+    signLogWrite(LogLevel::Info, "%s", std::string(2000, 'x').c_str());
+    setLogLevel(LogLevel::Debug);
+    signLogWrite(LogLevel::Debug, "%s", std::string(2000, 'y').c_str());
+    setLogSink(nullptr, nullptr);
+
+    CHECK(captured.messages.size() == 2);
+    CHECK(captured.messages[0] == "kept");
+    CHECK(captured.messages[1].size() < 2000 && captured.messages[1][0] == 'y');
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "sign_recognition.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+// SignRecognizer의 비공개 추론 경로 접근 (헤더의 friend 선언)
+struct SignRecognizerTestAccess {
+    static std::vector<std::vector<float>>& weights() { return SignRecognizer::neuralWeights; }
+    static std::vector<float>& biases() { return SignRecognizer::neuralBiases; }
+    static std::vector<float>& columnSums() { return SignRecognizer::neuralLayer1ColumnSums; }
+
+    static std::vector<float> features(SignRecognizer& recognizer, const std::vector<HandLandmark>& landmarks) {
+        return recognizer.extractComplexFeatures(landmarks);
+    }
+    static bool fusedLayer1(SignRecognizer& recognizer, const std::vector<HandLandmark>& landmarks, float* hidden) {
+        return recognizer.fusedFeatureLayer1(landmarks, hidden);
+    }
+    static std::vector<float> tail(SignRecognizer& recognizer, const float* hidden) {
+        return recognizer.neuralNetworkTail(hidden);
+    }
+    static std::vector<float> unfused(SignRecognizer& recognizer, const std::vector<float>& features) {
+        return recognizer.neuralNetworkInference(features);
+    }
+};
+
+namespace {
+
+// 손 모양에 가까운 임의 랜드마크 (0–1 좌표)
+std::vector<HandLandmark> randomHand(uint32_t seed) {
+    std::vector<float> values = randomValues(63, seed, 0.3f);
+    std::vector<HandLandmark> landmarks(21);
+    for (int i = 0; i < 21; i++) {
+        landmarks[i] = {0.5f + values[i * 3], 0.5f + values[i * 3 + 1], 0.1f * values[i * 3 + 2]};
+    }
+    return landmarks;
+}
+
+} // namespace
+
+TEST(advancedModelStaysFloat32ByDefault) {
+    // 1260×1024 + 1024×512 + 512×256 + 256×128 + 128×5 가중치 (패딩 포함이라 그 이상)
+    const size_t float32Bytes = sizeof(float) * (1260u * 1024 + 1024u * 512 + 512u * 256 + 256u * 128 + 128u * 5);
+    SignRecognizer recognizer;
+    size_t defaultBytes = recognizer.getAdvancedModelBytes();
+    CHECK(defaultBytes >= float32Bytes);
+
+    recognizer.setAdvancedModelPrecision(1);
+    size_t halfBytes = recognizer.getAdvancedModelBytes();
+    CHECK(halfBytes < defaultBytes * 6 / 10);
+
+    recognizer.setAdvancedModelPrecision(2);
+    CHECK(recognizer.getAdvancedModelBytes() == halfBytes);
+
+    recognizer.setAdvancedModelPrecision(0);
+    CHECK(recognizer.getAdvancedModelBytes() == defaultBytes);
+}
+
+TEST(advancedModelPruningIsExplicitAndOrderIndependent) {
+    SignRecognizer pruneFirst;
+    size_t denseBytes = pruneFirst.getAdvancedModelBytes();
+    pruneFirst.pruneAdvancedModel(0.8f);
+    size_t prunedBytes = pruneFirst.getAdvancedModelBytes();
+    CHECK(prunedBytes < denseBytes / 2);
+    pruneFirst.setAdvancedModelPrecision(1);
+
+    // 설정 순서가 달라도 같은 모델 (가지치기 → 형식 변환)
+    SignRecognizer precisionFirst;
+    precisionFirst.setAdvancedModelPrecision(1);
+    precisionFirst.pruneAdvancedModel(0.8f);
+    CHECK(pruneFirst.getAdvancedModelBytes() == precisionFirst.getAdvancedModelBytes());
+
+    pruneFirst.pruneAdvancedModel(0.0f);
+    pruneFirst.setAdvancedModelPrecision(0);
+    CHECK(pruneFirst.getAdvancedModelBytes() == denseBytes);
+}
+
+TEST(fusedLayer1MatchesUnfusedFeaturePath) {
+    SignRecognizer recognizer;
+    CHECK(recognizer.initialize());
+
+    // 고정값 가중치는 열이 모두 같아 열 순서 오류를 못 잡으므로 Layer 1을 난수로 바꿔 비교 (끝나면 되돌림)
+    std::vector<float> savedWeights = SignRecognizerTestAccess::weights()[0];
+    std::vector<float> savedBiases = SignRecognizerTestAccess::biases();
+    std::vector<float> savedSums = SignRecognizerTestAccess::columnSums();
+    const int inputs = 210, hiddenUnits = 128;
+    std::vector<float>& w1 = SignRecognizerTestAccess::weights()[0];
+    w1 = randomValues(w1.size(), 41, 0.2f);
+    SignRecognizerTestAccess::biases() = randomValues(hiddenUnits, 42, 0.3f);
+    std::vector<float>& sums = SignRecognizerTestAccess::columnSums();
+    std::fill(sums.begin(), sums.end(), 0.0f);
+    for (int j = 0; j < inputs; j++) {
+        for (int i = 0; i < hiddenUnits; i++) sums[i] += w1[j * hiddenUnits + i];
+    }
+
+    int active = 0;
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        std::vector<HandLandmark> landmarks = randomHand(seed);
+        std::vector<float> features = SignRecognizerTestAccess::features(recognizer, landmarks);
+        CHECK(features.size() == 256u);
+
+        // 기준: 표준화된 특징 벡터의 앞 210개 × W1 + b, ReLU (double)
+        alignas(32) float hidden[128];
+        CHECK(SignRecognizerTestAccess::fusedLayer1(recognizer, landmarks, hidden));
+        float worst = 0.0f;
+        for (int i = 0; i < hiddenUnits; i++) {
+            double sum = SignRecognizerTestAccess::biases()[i];
+            for (int j = 0; j < inputs; j++) sum += static_cast<double>(features[j]) * w1[j * hiddenUnits + i];
+            float expected = static_cast<float>(std::max(0.0, sum));
+            worst = std::max(worst, std::fabs(hidden[i] - expected) / (1.0f + std::fabs(expected)));
+            active += expected > 0.0f;
+        }
+        CHECK(worst < 1e-4f);
+
+        // 나머지 레이어까지 같은 결과
+        std::vector<float> fused = SignRecognizerTestAccess::tail(recognizer, hidden);
+        std::vector<float> baseline = SignRecognizerTestAccess::unfused(recognizer, features);
+        CHECK(fused.size() == baseline.size());
+        for (size_t k = 0; k < fused.size(); k++) {
+            CHECK_NEAR(fused[k], baseline[k], 1e-3f * (1.0f + std::fabs(baseline[k])));
+        }
+    }
+    // ReLU 양쪽이 모두 나옴
+    CHECK(active > 20 * 128 / 10 && active < 20 * 128 * 9 / 10);
+
+    // 랜드마크 수가 다르면 융합 경로는 실패
+    alignas(32) float hidden[128];
+    CHECK(!SignRecognizerTestAccess::fusedLayer1(recognizer, std::vector<HandLandmark>(20), hidden));
+
+    SignRecognizerTestAccess::weights()[0] = savedWeights;
+    SignRecognizerTestAccess::biases() = savedBiases;
+    SignRecognizerTestAccess::columnSums() = savedSums;
+}
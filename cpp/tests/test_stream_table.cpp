@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "stream_table.h"
+#include "test_framework.h"
+#include "test_support.h"
+
+namespace {
+
+// 스칼라 One-Euro 필터 (좌표 하나)
+struct ReferenceOneEuro {
+    float value = 0.0f;
+    float derivative = 0.0f;
+
+    static float alpha(float cutoff, float dt) {
+        float r = 6.28318530718f * cutoff * dt;
+        return r / (r + 1.0f);
+    }
+
+    float push(float x, float dt, const StreamConfig& config) {
+        float dx = (x - value) / dt;
+        derivative += alpha(config.derivativeCutoff, dt) * (dx - derivative);
+        float cutoff = config.minCutoff + config.beta * std::fabs(derivative);
+        value += alpha(cutoff, dt) * (x - value);
+        return value;
+    }
+};
+
+} // namespace
+
+TEST(streamTableHandlesRejectStaleGenerations) {
+    StreamTable table;
+    CHECK(!table.isValid(INVALID_STREAM));
+
+    // 슬랩 두 개에 걸치게 열기
+    std::vector<StreamHandle> handles;
+    for (int i = 0; i < 70; i++) handles.push_back(table.open(0.0));
+    CHECK(table.size() == 70);
+    CHECK(table.capacity() == 2 * StreamTable::SLAB_STREAMS);
+    for (StreamHandle handle : handles) CHECK(table.isValid(handle));
+
+    StreamHandle closed = handles[5];
+    CHECK(table.close(closed));
+    CHECK(!table.close(closed));
+    CHECK(!table.isValid(closed));
+    CHECK(table.size() == 69);
+
+    // 같은 슬롯을 재사용하지만 세대가 달라 옛 핸들은 계속 무효
+    StreamHandle reopened = table.open(0.0);
+    CHECK(reopened != closed);
+    CHECK((reopened & ((1u << StreamTable::INDEX_BITS) - 1)) == (closed & ((1u << StreamTable::INDEX_BITS) - 1)));
+    CHECK(table.isValid(reopened));
+    CHECK(!table.isValid(closed));
+    CHECK(table.pushResult(closed, 1, 1.0f) == -1);
+    CHECK(table.trackId(closed) == -1);
+    int label = 0;
+    float confidence = 0.0f;
+    CHECK(!table.lastResult(closed, label, confidence));
+
+    // 세대 0인 위조 핸들과 열리지 않은 슬랩은 무효
+    CHECK(!table.isValid(reopened & ((1u << StreamTable::INDEX_BITS) - 1)));
+    CHECK(!table.isValid((1u << StreamTable::INDEX_BITS) | 5000u));
+
+    // 12비트 세대가 여러 번 돌아도 0 세대 핸들을 내주지 않음
+    StreamHandle current = reopened;
+    for (int i = 0; i < 9000; i++) {
+        CHECK(table.close(current));
+        current = table.open(0.0);
+        CHECK((current >> StreamTable::INDEX_BITS) != 0);
+    }
+    CHECK(table.isValid(current));
+    CHECK(table.size() == 70);
+}
+
+TEST(streamTableFiltersLandmarksLikeScalarOneEuro) {
+    StreamConfig config;
+    config.minCutoff = 1.5f;
+    config.beta = 0.3f;
+    StreamTable table(config);
+    StreamHandle handle = table.open(0.0);
+
+    const int frames = 20;
+    std::vector<float> inputs = randomValues(static_cast<size_t>(frames) * 63, 12, 0.2f);
+    std::vector<ReferenceOneEuro> reference(StreamTable::LANDMARK_VALUES);
+    std::vector<float> expectedHistory;
+    double time = 0.0;
+    int track = -1;
+    for (int f = 0; f < frames; f++) {
+        // 고르지 않은 프레임 간격
+        const double dtMs = 25.0 + 10.0 * (f % 3);
+        time += dtMs;
+        const float* frame = &inputs[static_cast<size_t>(f) * 63];
+        float filtered[StreamTable::LANDMARK_VALUES];
+        CHECK(table.pushLandmarks(handle, frame, 63, time, filtered));
+        if (f == 0) track = table.trackId(handle);
+        CHECK(table.trackId(handle) == track);
+
+        for (int i = 0; i < StreamTable::LANDMARK_VALUES; i++) {
+            // 63개 입력은 (x, y)만 사용
+            float x = frame[(i / 2) * 3 + (i % 2)];
+            float expected;
+            if (f == 0) {
+                reference[i].value = x;
+                expected = x;
+            } else {
+                expected = reference[i].push(x, static_cast<float>(dtMs * 1e-3), config);
+            }
+            CHECK_NEAR(filtered[i], expected, 1e-5f);
+            if (f >= frames - StreamTable::HISTORY_FRAMES) expectedHistory.push_back(filtered[i]);
+        }
+    }
+    CHECK(track >= 0);
+
+    // 기록은 최근 16프레임, 오래된 순
+    std::vector<float> history(static_cast<size_t>(32) * StreamTable::LANDMARK_VALUES);
+    CHECK(table.copyHistory(handle, history.data(), 32) == StreamTable::HISTORY_FRAMES);
+    history.resize(expectedHistory.size());
+    CHECK(history == expectedHistory);
+    std::vector<float> latest(StreamTable::LANDMARK_VALUES);
+    CHECK(table.copyHistory(handle, latest.data(), 1) == 1);
+    CHECK(std::equal(latest.begin(), latest.end(), expectedHistory.end() - StreamTable::LANDMARK_VALUES));
+
+    // 손이 사라지면 추적 id가 풀리고, 다음 손은 새 id로 필터를 현재 값에서 다시 시작
+    CHECK(table.pushLandmarks(handle, nullptr, 0, time + 30.0, nullptr));
+    CHECK(table.trackId(handle) == -1);
+    float restarted[StreamTable::LANDMARK_VALUES];
+    CHECK(table.pushLandmarks(handle, inputs.data(), StreamTable::LANDMARK_VALUES, time + 60.0, restarted));
+    CHECK(table.trackId(handle) != track && table.trackId(handle) >= 0);
+    for (int i = 0; i < StreamTable::LANDMARK_VALUES; i++) CHECK(restarted[i] == inputs[i]);
+    CHECK(!table.pushLandmarks(handle, inputs.data(), 50, time + 90.0, nullptr));
+}
+
+TEST(streamTableSmoothsClassScores) {
+    StreamConfig config;
+    config.scoreDecay = 0.5f;
+    StreamTable table(config);
+    StreamHandle handle = table.open(0.0);
+
+    int label = 0;
+    float confidence = 1.0f;
+    CHECK(table.lastResult(handle, label, confidence));
+    CHECK(label == -1 && confidence == 0.0f);
+
+    // 점수 3: 0.45 → 0.225 → 0.1125, 점수 2: 0 → 0.15 → 0.225 (두 번째에 역전)
+    CHECK(table.pushResult(handle, 3, 0.9f) == 3);
+    CHECK(table.pushResult(handle, 2, 0.3f) == 3);
+    CHECK(table.pushResult(handle, 2, 0.3f) == 2);
+    CHECK(table.lastResult(handle, label, confidence));
+    CHECK(label == 2);
+    CHECK_NEAR(confidence, 0.3f, 1e-6f);
+
+    CHECK(table.pushResult(handle, -1, 1.0f) == -1);
+    CHECK(table.pushResult(handle, StreamTable::MAX_CLASSES, 1.0f) == -1);
+}
+
+TEST(streamTableEvictsOnlyIdleStreams) {
+    StreamConfig config;
+    config.idleTimeoutMs = 1000.0;
+    StreamTable table(config);
+    StreamHandle idle = table.open(0.0);
+    StreamHandle active = table.open(0.0);
+    StreamHandle fresh = table.open(1500.0);
+    const std::vector<float> hand = randomValues(StreamTable::LANDMARK_VALUES, 3, 0.5f);
+    CHECK(table.pushLandmarks(active, hand.data(), StreamTable::LANDMARK_VALUES, 1200.0, nullptr));
+
+    CHECK(table.evictIdle(900.0) == 0);
+    CHECK(table.evictIdle(2100.0) == 1);
+    CHECK(!table.isValid(idle));
+    CHECK(table.isValid(active) && table.isValid(fresh));
+    CHECK(table.size() == 2);
+
+    CHECK(table.evictIdle(5000.0) == 2);
+    CHECK(table.size() == 0);
+    CHECK(!table.isValid(active) && !table.isValid(fresh));
+}
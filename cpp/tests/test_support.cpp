@@ -0,0 +1,110 @@
+#include "test_support.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+void appendU16(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+    appendU16(out, value & 0xFFFF);
+    appendU16(out, value >> 16);
+}
+
+} // namespace
+
+std::vector<uint8_t> makeNpy(const std::string& descr, const std::string& shape, const void* data, size_t bytes) {
+    std::string header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+    // 매직 10바이트 + 헤더 + '\n'을 64바이트 경계로 맞춤
+    while ((10 + header.size() + 1) % 64 != 0) header += ' ';
+    header += '\n';
+
+    std::vector<uint8_t> out = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    appendU16(out, static_cast<uint32_t>(header.size()));
+    out.insert(out.end(), header.begin(), header.end());
+    const uint8_t* bytesIn = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytesIn, bytesIn + bytes);
+    return out;
+}
+
+std::vector<uint8_t> makeNpyF32(const std::vector<int>& shape, const std::vector<float>& values) {
+    std::string text = "(";
+    for (size_t i = 0; i < shape.size(); i++) {
+        if (i > 0) text += ", ";
+        text += std::to_string(shape[i]);
+    }
+    text += shape.size() == 1 ? ",)" : ")";
+    return makeNpy("<f4", text, values.data(), values.size() * sizeof(float));
+}
+
+std::vector<uint8_t> makeNpz(const std::vector<std::pair<std::string, std::vector<uint8_t>>>& entries) {
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> central;
+    for (const auto& entry : entries) {
+        const std::string name = entry.first + ".npy";
+        const uint32_t offset = static_cast<uint32_t>(out.size());
+        const uint32_t length = static_cast<uint32_t>(entry.second.size());
+
+        appendU32(out, 0x04034b50);
+        appendU16(out, 20);      // 필요 버전
+        appendU16(out, 0);       // 플래그
+        appendU16(out, 0);       // stored
+        appendU32(out, 0);       // 시각/날짜
+        appendU32(out, 0);       // CRC (리더는 검사하지 않음)
+        appendU32(out, length);
+        appendU32(out, length);
+        appendU16(out, static_cast<uint32_t>(name.size()));
+        appendU16(out, 0);
+        out.insert(out.end(), name.begin(), name.end());
+        out.insert(out.end(), entry.second.begin(), entry.second.end());
+
+        appendU32(central, 0x02014b50);
+        appendU16(central, 20);
+        appendU16(central, 20);
+        appendU16(central, 0);
+        appendU16(central, 0);
+        appendU32(central, 0);
+        appendU32(central, 0);
+        appendU32(central, length);
+        appendU32(central, length);
+        appendU16(central, static_cast<uint32_t>(name.size()));
+        appendU16(central, 0);   // extra
+        appendU16(central, 0);   // 주석
+        appendU16(central, 0);   // 디스크
+        appendU16(central, 0);   // 내부 속성
+        appendU32(central, 0);   // 외부 속성
+        appendU32(central, offset);
+        central.insert(central.end(), name.begin(), name.end());
+    }
+
+    const uint32_t centralOffset = static_cast<uint32_t>(out.size());
+    out.insert(out.end(), central.begin(), central.end());
+    appendU32(out, 0x06054b50);
+    appendU16(out, 0);
+    appendU16(out, 0);
+    appendU16(out, static_cast<uint32_t>(entries.size()));
+    appendU16(out, static_cast<uint32_t>(entries.size()));
+    appendU32(out, static_cast<uint32_t>(central.size()));
+    appendU32(out, centralOffset);
+    appendU16(out, 0);
+    return out;
+}
+
+std::vector<float> randomValues(size_t count, uint32_t seed, float scale) {
+    std::vector<float> values(count);
+    for (float& v : values) {
+        seed = seed * 1664525u + 1013904223u;
+        v = (static_cast<float>(seed >> 8) / 16777216.0f * 2.0f - 1.0f) * scale;
+    }
+    return values;
+}
+
+float maxAbsDiff(const float* a, const float* b, size_t count) {
+    float worst = 0.0f;
+    for (size_t i = 0; i < count; i++) worst = std::max(worst, std::fabs(a[i] - b[i]));
+    return worst;
+}
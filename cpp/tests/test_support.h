@@ -0,0 +1,23 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 테스트용 NPY/NPZ 바이트열 생성 (np.save/np.savez와 같은 무압축 형식)
+// descr: "<f4", "<f2", "<u2", shape: "(2, 3)" 같은 파이썬 튜플 문자열
+std::vector<uint8_t> makeNpy(const std::string& descr, const std::string& shape, const void* data, size_t bytes);
+std::vector<uint8_t> makeNpyF32(const std::vector<int>& shape, const std::vector<float>& values);
+
+// (이름, NPY 바이트열) 목록을 stored zip으로 묶음 (이름에 ".npy"를 붙임)
+std::vector<uint8_t> makeNpz(const std::vector<std::pair<std::string, std::vector<uint8_t>>>& entries);
+
+// 재현 가능한 [-scale, scale) 균등 난수
+std::vector<float> randomValues(size_t count, uint32_t seed, float scale = 1.0f);
+
+// 두 배열의 최대 절대 오차
+float maxAbsDiff(const float* a, const float* b, size_t count);
+
+#endif // TEST_SUPPORT_H
@@ -0,0 +1,139 @@
+#include <atomic>
+#include <numeric>
+#include "sign_recognition.h"
+#include "test_framework.h"
+#include "thread_pool.h"
+
+namespace {
+
+struct FourThreads {
+    FourThreads() { ThreadPool::setThreadLimit(4); }
+    ~FourThreads() { ThreadPool::setThreadLimit(0); }
+};
+
+} // namespace
+
+TEST(threadPoolRunsEveryIndexAndRangeOnce) {
+    FourThreads limit;
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+    for (auto& h : hits) h.store(0);
+
+    auto index = [&](int task) { hits[task].fetch_add(1); };
+    pool.parallelFor(1000, index);
+    for (auto& h : hits) CHECK(h.load() == 1);
+
+    for (int grain : {0, 1, 7, 2000}) {
+        for (auto& h : hits) h.store(0);
+        auto range = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) hits[i].fetch_add(1);
+        };
+        pool.parallelFor(3, 1000, grain, range);
+        for (int i = 0; i < 1000; i++) CHECK(hits[i].load() == (i >= 3 ? 1 : 0));
+    }
+
+    // 작업 안에서 다시 나눠도 모두 끝남
+    std::atomic<long> total{0};
+    auto outer = [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            auto inner = [&](int b, int e) {
+                for (int j = b; j < e; j++) total.fetch_add(j);
+            };
+            pool.parallelFor(0, 100, 10, inner);
+        }
+    };
+    pool.parallelFor(0, 20, 1, outer);
+    CHECK(total.load() == 20L * 4950);
+}
+
+TEST(threadPoolTaskGroupWaitsForNestedTasks) {
+    FourThreads limit;
+    ThreadPool pool(4);
+    std::atomic<int> count{0};
+    {
+        TaskGroup group(&pool);
+        for (int i = 0; i < 50; i++) {
+            group.run([&count, &group]() {
+                count.fetch_add(1);
+                group.run([&count]() { count.fetch_add(1); });
+            });
+        }
+        group.wait();
+        CHECK(count.load() == 100);
+    }
+
+    TaskGroup inline_(nullptr);
+    inline_.run([&count]() { count.fetch_add(1); });
+    CHECK(count.load() == 101);   // 풀이 없으면 즉시 실행
+}
+
+TEST(threadPoolParticipantCapLimitsConcurrency) {
+    FourThreads limit;
+    ThreadPool pool(4);
+    std::atomic<int> active{0}, peak{0}, done{0};
+    auto enterWork = [&]() {
+        int now = active.fetch_add(1) + 1;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+        for (volatile int spin = 0; spin < 2000; spin++) {}
+        active.fetch_sub(1);
+        done.fetch_add(1);
+    };
+
+    for (int cap : {1, 2, 3}) {
+        peak.store(0);
+        done.store(0);
+        auto range = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) enterWork();
+        };
+        pool.parallelFor(0, 400, 1, range, cap);
+        auto index = [&](int) { enterWork(); };
+        pool.parallelFor(16, index, cap);
+        {
+            TaskGroup group(&pool, cap);
+            for (int i = 0; i < 40; i++) group.run([&]() { enterWork(); });
+        }
+        CHECK(done.load() == 456);
+        CHECK(peak.load() <= cap);
+    }
+    CHECK(pool.participantsFor(0) == 4 && pool.participantsFor(9) == 4 && pool.participantsFor(2) == 2);
+}
+
+TEST(sharedPoolIsSizedOnce) {
+    FourThreads limit;
+    std::shared_ptr<ThreadPool> a = ThreadPool::shared();
+    CHECK(a && a->size() == 4 && !a->pinned());
+    ThreadPool::setThreadLimit(2);
+    CHECK(ThreadPool::shared() == a);                 // 살아 있는 동안 크기는 그대로
+
+    a.reset();
+    ThreadPool::setPinWorkers(true);
+    std::shared_ptr<ThreadPool> b = ThreadPool::shared();
+    CHECK(b && b->size() == 2 && b->pinned());        // 다시 만들 때 새 설정 적용
+    ThreadPool::setPinWorkers(false);
+}
+
+TEST(setThreadsSharesOnePoolAcrossEngines) {
+    FourThreads limit;
+    SignRecognition recognition;
+    SignRecognizer recognizer;
+
+    recognition.setThreads(4);
+    CHECK(recognition.getThreads() == 4);
+    recognition.setThreads(2);
+    CHECK(recognition.getThreads() == 2);
+
+    recognizer.setIntraOpThreads(3);              // 같은 풀, 다른 참여자 수
+    CHECK(recognizer.getIntraOpThreads() == 3);
+    CHECK(recognition.getThreads() == 2);
+    recognition.setThreads(8);                    // 풀 크기로 제한
+    CHECK(recognition.getThreads() == 4);
+
+    std::vector<float> features(3 * 126, 0.2f), logits(3 * 16);
+    CHECK(recognition.predictBatchLogits(reinterpret_cast<uintptr_t>(features.data()), 3,
+                                         reinterpret_cast<uintptr_t>(logits.data())) > 0);
+    recognition.setThreads(1);
+    CHECK(recognition.getThreads() == 1);
+    recognizer.setIntraOpThreads(1);
+    CHECK(recognizer.getIntraOpThreads() == 1);
+}
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+#include "test_framework.h"
+#include "test_support.h"
+#include "transformer_encoder.h"
+
+namespace {
+
+// 작은 구성: 입력 10차원(패딩 경로), d = 16, 헤드 2개, FFN 24, 2레이어, 창 5프레임, 3클래스
+constexpr int INPUTS = 10;
+constexpr int MODEL = 16;
+constexpr int HEADS = 2;
+constexpr int FF = 24;
+constexpr int LAYERS = 2;
+constexpr int WINDOW = 5;
+constexpr int CLASSES = 3;
+
+using Weights = std::map<std::string, std::vector<float>>;
+
+Weights randomWeights(uint32_t seed) {
+    Weights w;
+    auto add = [&](const std::string& name, size_t count, float scale, float offset = 0.0f) {
+        std::vector<float> values = randomValues(count, seed++, scale);
+        for (float& v : values) v += offset;
+        w[name] = values;
+    };
+    add("embed_w", MODEL * INPUTS, 0.4f);
+    add("embed_b", MODEL, 0.1f);
+    for (int l = 0; l < LAYERS; l++) {
+        const std::string p = "l" + std::to_string(l) + "_";
+        add(p + "ln1_g", MODEL, 0.2f, 1.0f);
+        add(p + "ln1_b", MODEL, 0.1f);
+        add(p + "qkv_w", 3 * MODEL * MODEL, 0.35f);
+        add(p + "qkv_b", 3 * MODEL, 0.1f);
+        add(p + "out_w", MODEL * MODEL, 0.3f);
+        add(p + "out_b", MODEL, 0.1f);
+        add(p + "ln2_g", MODEL, 0.2f, 1.0f);
+        add(p + "ln2_b", MODEL, 0.1f);
+        add(p + "ff1_w", FF * MODEL, 0.3f);
+        add(p + "ff1_b", FF, 0.1f);
+        add(p + "ff2_w", MODEL * FF, 0.3f);
+        add(p + "ff2_b", MODEL, 0.1f);
+    }
+    add("final_ln_g", MODEL, 0.2f, 1.0f);
+    add("final_ln_b", MODEL, 0.1f);
+    add("head_w", CLASSES * MODEL, 0.4f);
+    add("head_b", CLASSES, 0.1f);
+    return w;
+}
+
+std::vector<uint8_t> toNpz(const Weights& weights) {
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> entries;
+    for (const auto& entry : weights) {
+        const std::string& name = entry.first;
+        const int count = static_cast<int>(entry.second.size());
+        std::vector<int> shape{count};
+        if (name.size() > 2 && name.compare(name.size() - 2, 2, "_w") == 0) {
+            int inputs = name == "embed_w" ? INPUTS : (name.find("ff2") != std::string::npos ? FF : MODEL);
+            shape = {count / inputs, inputs};
+        }
+        entries.emplace_back(name, makeNpyF32(shape, entry.second));
+    }
+    return makeNpz(entries);
+}
+
+// y = W x + b ([outputs][inputs] 행 우선)
+std::vector<double> affine(const Weights& w, const std::string& name, const std::vector<double>& x) {
+    const std::vector<float>& weights = w.at(name + "_w");
+    const std::vector<float>& bias = w.at(name + "_b");
+    std::vector<double> y(bias.begin(), bias.end());
+    const size_t inputs = x.size();
+    for (size_t o = 0; o < y.size(); o++) {
+        for (size_t i = 0; i < inputs; i++) y[o] += static_cast<double>(weights[o * inputs + i]) * x[i];
+    }
+    return y;
+}
+
+std::vector<double> layerNorm(const Weights& w, const std::string& name, const std::vector<double>& x) {
+    double mean = 0.0, variance = 0.0;
+    for (double v : x) mean += v;
+    mean /= x.size();
+    for (double v : x) variance += (v - mean) * (v - mean);
+    const double inv = 1.0 / std::sqrt(variance / x.size() + 1e-5);
+    std::vector<double> y(x.size());
+    for (size_t i = 0; i < x.size(); i++) y[i] = (x[i] - mean) * inv * w.at(name + "_g")[i] + w.at(name + "_b")[i];
+    return y;
+}
+
+// 시퀀스 전체의 프레임별 logits (인과적 창 주의 + ALiBi, double)
+std::vector<double> referenceEncode(const Weights& w, const std::vector<float>& features, int frames) {
+    std::vector<std::vector<double>> hidden(frames);
+    for (int t = 0; t < frames; t++) {
+        std::vector<double> x(features.begin() + t * INPUTS, features.begin() + (t + 1) * INPUTS);
+        hidden[t] = affine(w, "embed", x);
+    }
+    const int headDim = MODEL / HEADS;
+    for (int l = 0; l < LAYERS; l++) {
+        const std::string p = "l" + std::to_string(l) + "_";
+        std::vector<std::vector<double>> qkv(frames);
+        for (int t = 0; t < frames; t++) qkv[t] = affine(w, p + "qkv", layerNorm(w, p + "ln1", hidden[t]));
+        for (int t = 0; t < frames; t++) {
+            std::vector<double> attention(MODEL, 0.0);
+            const int first = std::max(0, t - WINDOW + 1);
+            for (int h = 0; h < HEADS; h++) {
+                const double slope = std::pow(2.0, -8.0 * (h + 1) / HEADS);
+                std::vector<double> scores;
+                for (int j = first; j <= t; j++) {
+                    double dot = 0.0;
+                    for (int c = 0; c < headDim; c++) dot += qkv[t][h * headDim + c] * qkv[j][MODEL + h * headDim + c];
+                    scores.push_back(dot / std::sqrt(static_cast<double>(headDim)) - slope * (t - j));
+                }
+                const double best = *std::max_element(scores.begin(), scores.end());
+                double sum = 0.0;
+                for (double& s : scores) sum += (s = std::exp(s - best));
+                for (int j = first; j <= t; j++) {
+                    for (int c = 0; c < headDim; c++) {
+                        attention[h * headDim + c] += scores[j - first] / sum * qkv[j][2 * MODEL + h * headDim + c];
+                    }
+                }
+            }
+            std::vector<double> projected = affine(w, p + "out", attention);
+            for (int i = 0; i < MODEL; i++) hidden[t][i] += projected[i];
+        }
+        for (int t = 0; t < frames; t++) {
+            std::vector<double> inner = affine(w, p + "ff1", layerNorm(w, p + "ln2", hidden[t]));
+            for (double& v : inner) v = std::max(0.0, v);
+            std::vector<double> projected = affine(w, p + "ff2", inner);
+            for (int i = 0; i < MODEL; i++) hidden[t][i] += projected[i];
+        }
+    }
+    std::vector<double> logits;
+    for (int t = 0; t < frames; t++) {
+        std::vector<double> row = affine(w, "head", layerNorm(w, "final_ln", hidden[t]));
+        logits.insert(logits.end(), row.begin(), row.end());
+    }
+    return logits;
+}
+
+bool loadEncoder(TransformerEncoder& encoder, const Weights& weights) {
+    std::vector<uint8_t> npz = toNpz(weights);
+    std::string error;
+    return encoder.loadFromNpzBuffer(npz.data(), npz.size(), HEADS, WINDOW, error);
+}
+
+} // namespace
+
+TEST(transformerMatchesScalarReference) {
+    const Weights weights = randomWeights(100);
+    TransformerEncoder encoder;
+    CHECK(loadEncoder(encoder, weights));
+    CHECK(encoder.config().modelDim == MODEL && encoder.config().layers == LAYERS);
+    CHECK(encoder.config().ffDim == FF && encoder.config().classes == CLASSES);
+
+    // 창(5)보다 긴 시퀀스: 링 버퍼가 여러 번 돎, 경로마다 누적 순서가 달라 오차 범위로 비교
+    const int frames = 13;
+    std::vector<float> features = randomValues(static_cast<size_t>(frames) * INPUTS, 7, 1.0f);
+    std::vector<double> expected = referenceEncode(weights, features, frames);
+
+    std::vector<float> sequence(static_cast<size_t>(frames) * CLASSES);
+    encoder.encodeSequence(features.data(), frames, sequence.data());
+    TransformerState state = encoder.createState();
+    for (int t = 0; t < frames; t++) {
+        float logits[CLASSES];
+        int best = encoder.step(state, &features[static_cast<size_t>(t) * INPUTS], logits);
+        CHECK(best == static_cast<int>(std::max_element(logits, logits + CLASSES) - logits));
+        for (int c = 0; c < CLASSES; c++) {
+            const float reference = static_cast<float>(expected[t * CLASSES + c]);
+            CHECK_NEAR(sequence[t * CLASSES + c], reference, 1e-3f);
+            CHECK_NEAR(logits[c], reference, 1e-3f);
+            CHECK_NEAR(logits[c], sequence[t * CLASSES + c], 1e-4f);
+        }
+    }
+    CHECK(state.position == frames);
+
+    // reset 후 다시 넣으면 오차 범위 안에서 같은 결과
+    state.reset();
+    float first[CLASSES];
+    encoder.step(state, features.data(), first);
+    for (int c = 0; c < CLASSES; c++) CHECK_NEAR(first[c], sequence[c], 1e-4f);
+}
+
+TEST(transformerStepBatchMatchesSingleStreams) {
+    const Weights weights = randomWeights(200);
+    TransformerEncoder batched, single;
+    CHECK(loadEncoder(batched, weights));
+    CHECK(loadEncoder(single, weights));
+
+    // 스트림마다 다른 길이의 기록을 먼저 쌓은 뒤 창(5)을 넘도록 한 프레임씩 묶어 진행 (GEMM 누적 순서 차이는 오차 범위로 비교)
+    const int streams = 3;
+    std::vector<TransformerState> batchStates, singleStates;
+    for (int s = 0; s < streams; s++) {
+        batchStates.push_back(batched.createState());
+        singleStates.push_back(single.createState());
+        std::vector<float> warmup = randomValues(static_cast<size_t>(s * 3) * INPUTS, 30 + s, 1.0f);
+        for (int t = 0; t < s * 3; t++) {
+            batched.step(batchStates[s], &warmup[static_cast<size_t>(t) * INPUTS], nullptr);
+            single.step(singleStates[s], &warmup[static_cast<size_t>(t) * INPUTS], nullptr);
+        }
+    }
+    TransformerState* pointers[streams] = {&batchStates[0], &batchStates[1], &batchStates[2]};
+
+    for (int frame = 0; frame < 8; frame++) {
+        std::vector<float> features = randomValues(static_cast<size_t>(streams) * INPUTS, 50 + frame, 1.0f);
+        std::vector<float> logits(static_cast<size_t>(streams) * CLASSES);
+        batched.stepBatch(pointers, features.data(), streams, logits.data());
+        for (int s = 0; s < streams; s++) {
+            float expected[CLASSES];
+            single.step(singleStates[s], &features[static_cast<size_t>(s) * INPUTS], expected);
+            for (int c = 0; c < CLASSES; c++) CHECK_NEAR(logits[s * CLASSES + c], expected[c], 1e-4f);
+            CHECK(batchStates[s].position == singleStates[s].position);
+        }
+    }
+}
+
+TEST(transformerRejectsInvalidModels) {
+    Weights weights = randomWeights(300);
+    TransformerEncoder encoder;
+    std::string error;
+
+    // 헤드 3개는 d = 16을 8의 배수 폭으로 나누지 못함
+    std::vector<uint8_t> npz = toNpz(weights);
+    CHECK(!encoder.loadFromNpzBuffer(npz.data(), npz.size(), 3, WINDOW, error));
+    CHECK(!error.empty());
+    CHECK(encoder.empty());
+
+    weights.erase("l1_ff2_b");
+    npz = toNpz(weights);
+    CHECK(!encoder.loadFromNpzBuffer(npz.data(), npz.size(), HEADS, WINDOW, error));
+    CHECK(encoder.empty());
+
+    // 실패한 설정은 기존 모델을 바꾸지 않음
+    TransformerConfig config;
+    CHECK(encoder.initializeRandom(config, 1, error));
+    TransformerConfig bad = config;
+    bad.ffDim = 100;
+    CHECK(!encoder.initializeRandom(bad, 1, error));
+    CHECK(encoder.config().ffDim == config.ffDim);
+    TransformerState state = encoder.createState();
+    CHECK(encoder.step(state, randomValues(config.inputDim, 1).data(), nullptr) >= 0);
+}
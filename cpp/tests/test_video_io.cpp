@@ -0,0 +1,117 @@
+#include <cstdlib>
+#include <cstring>
+#include "test_framework.h"
+#include "video_io.h"
+
+namespace {
+
+// 2×2 블록마다 같은 색인 RGBA (4:2:0 크로마 평균이 정확함)
+std::vector<uint8_t> blockImage(int w, int h) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(w) * h * 4);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * w + x) * 4];
+            int bx = x / 2, by = y / 2;
+            p[0] = static_cast<uint8_t>(40 + (bx * 37) % 180);
+            p[1] = static_cast<uint8_t>(30 + (by * 53) % 190);
+            p[2] = static_cast<uint8_t>(50 + ((bx + by) * 29) % 170);
+            p[3] = 255;
+        }
+    }
+    return rgba;
+}
+
+VideoSource sourceOf(const std::vector<uint8_t>& bytes) {
+    VideoSource video;
+    video.data = bytes.data();
+    video.size = bytes.size();
+    video.y4m = true;
+    return video;
+}
+
+} // namespace
+
+TEST(y4mHeaderFramesAndRoundTrip) {
+    const int w = 16, h = 10;
+    std::vector<uint8_t> image = blockImage(w, h);
+    std::vector<uint8_t> planes;
+    encodeYuv420(image.data(), w, h, planes);
+    CHECK(planes.size() == static_cast<size_t>(w * h + 2 * 8 * 5));
+
+    std::string header = "YUV4MPEG2 W16 H10 F30:1 Ip A1:1 C420jpeg\n";
+    std::vector<uint8_t> file(header.begin(), header.end());
+    for (int f = 0; f < 2; f++) {
+        const char frame[] = "FRAME\n";
+        file.insert(file.end(), frame, frame + 6);
+        file.insert(file.end(), planes.begin(), planes.end());
+    }
+    // 잘린 마지막 프레임은 무시
+    file.insert(file.end(), {'F', 'R', 'A', 'M', 'E', '\n', 1, 2, 3});
+
+    VideoSource video = sourceOf(file);
+    std::string error;
+    CHECK(parseY4mHeader(video, error));
+    CHECK(video.width == w && video.height == h);
+    CHECK(video.chroma == ChromaFormat::Yuv420 && !video.fullRange);
+    CHECK(video.frameOffsets.size() == 2);
+    CHECK(video.streamHeader + "\n" == header);
+
+    std::vector<uint8_t> decoded(image.size());
+    decodeFrame(video, 1, decoded.data());
+    int worst = 0;
+    for (size_t i = 0; i < image.size(); i++) worst = std::max(worst, std::abs(image[i] - decoded[i]));
+    CHECK(worst <= 3);   // 8비트 YUV 양자화 오차
+}
+
+TEST(y4mMonoAndFullRangeDecode) {
+    std::string header = "YUV4MPEG2 W4 H2 Cmono XCOLORRANGE=FULL\nFRAME\n";
+    std::vector<uint8_t> file(header.begin(), header.end());
+    const uint8_t luma[8] = {0, 16, 128, 255, 1, 2, 3, 4};
+    file.insert(file.end(), luma, luma + 8);
+
+    VideoSource video = sourceOf(file);
+    std::string error;
+    CHECK(parseY4mHeader(video, error));
+    CHECK(video.chroma == ChromaFormat::Mono && video.fullRange);
+    CHECK(video.frameOffsets.size() == 1);
+
+    uint8_t rgba[32];
+    decodeFrame(video, 0, rgba);
+    for (int i = 0; i < 8; i++) {
+        CHECK(rgba[i * 4] == luma[i] && rgba[i * 4 + 1] == luma[i] && rgba[i * 4 + 2] == luma[i]);
+        CHECK(rgba[i * 4 + 3] == 255);
+    }
+}
+
+TEST(y4mRejectsUnsupportedHeaders) {
+    std::string error;
+    std::string bad = "YUV4MPEG2 W4 H2 C422\n";
+    std::vector<uint8_t> file(bad.begin(), bad.end());
+    VideoSource video = sourceOf(file);
+    CHECK(!parseY4mHeader(video, error));
+    CHECK(error.find("C422") != std::string::npos);
+
+    for (const char* deep : {"C420p10", "C420p12", "C420p16", "C420x"}) {
+        std::string header = std::string("YUV4MPEG2 W4 H2 ") + deep + "\n";
+        file.assign(header.begin(), header.end());
+        video = sourceOf(file);
+        CHECK(!parseY4mHeader(video, error));
+        CHECK(error.find(deep) != std::string::npos);
+    }
+    for (const char* tag : {"C420", "C420paldv", "C420mpeg2"}) {
+        std::string header = std::string("YUV4MPEG2 W4 H2 ") + tag + "\n";
+        file.assign(header.begin(), header.end());
+        video = sourceOf(file);
+        CHECK(parseY4mHeader(video, error) && video.chroma == ChromaFormat::Yuv420);
+    }
+
+    std::string sizeless = "YUV4MPEG2 C420\n";
+    file.assign(sizeless.begin(), sizeless.end());
+    video = sourceOf(file);
+    CHECK(!parseY4mHeader(video, error));
+
+    std::string noNewline = "YUV4MPEG2 W4 H2";
+    file.assign(noNewline.begin(), noNewline.end());
+    video = sourceOf(file);
+    CHECK(!parseY4mHeader(video, error));
+}